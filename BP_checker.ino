@@ -3,6 +3,7 @@
 #include <time.h>                    // configTime / tzset / setenv("TZ", ...)
 #include <bootloader_random.h>
 #include <esp_random.h>
+#include <atomic>
 // ArduinoJson、ESPmDNS 由 WebHandler.h / WiFiManager.h 已 transitively include
 #include "lib/BP_Parser.h"           // 血壓機解析器
 #include "lib/BPRecordManager.h"     // 血壓記錄管理器
@@ -14,6 +15,9 @@
 #include "lib/BoundedWebServer.h"
 #include "lib/DeviceSecurity.h"
 #include "lib/FirmwareUpdateRuntime.h"
+#include "lib/MeasurementLatency.h"
+#include "lib/MeasurementSnapshot.h"
+#include "lib/ReceiveDiagnostic.h"
 #include "lib/WebRequestGate.h"
 #include "lib/transports/MonitorTransport.h"
 #include "lib/transports/UartTransport.h"
@@ -33,11 +37,15 @@ const char* hostname = "bp_checker"; // mDNS主機名
 // 血壓機型號參數
 String bp_model = "OMRON-HBP9030"; // 預設型號
 
-// 串口通訊狀態（lastData/transportName/transportStatus 給 WebHandler 也用，所以仍是全域；
-// inactivity 追蹤已封裝進 DataProcessor）
-String lastData = "";
+// 串口通訊狀態（receiveDiagnostic/transportName/transportStatus 給 WebHandler 也用，所以仍是全域；
+// inactivity 追蹤已封裝進 DataProcessor）。接收診斷是固定大小 POD，只在網頁要求時渲染。
+ReceiveDiagnostic receiveDiagnostic;
 String transportName = "";
 String transportStatus = "";
+MonitorTransportSummary transportSummary;
+MeasurementSnapshotPublisher measurementSnapshot;
+// 量測各階段延遲（USB -> frame -> 解析 -> 儲存 -> 網頁送出），只由 main loop 寫入。
+MeasurementLatencyTracker measurementLatency;
 
 // 建立有固定 request/response 邊界的 Web 伺服器
 bp_web::BoundedWebServer server(80);
@@ -70,8 +78,129 @@ WebHandler* webHandler;
 WiFiManager* wifiManager;
 DataProcessor* dataProcessor;
 MonitorTransport* monitorTransport;
+UsbCdcTransport* usbTransport = nullptr;
+UartTransport* uartTransport = nullptr;
 bool runtimeReady = false;
 
+// USB RX stream buffer 大小依現場資料調整：開機讀取上次建議值；執行中若出現
+// overflow 或高水位進入上四分之一，就把下次開機的大小加倍寫回 NVS。只增不減，
+// 一輩子最多寫入數次，不會與量測紀錄搶 NVS。
+constexpr unsigned long kUsbRxSizingCheckMs = 60000;
+
+size_t loadUsbRxBufferBytes() {
+  size_t bytes = kUsbCdcRxMinBytes;
+  if (preferences.begin("usb-rx", true)) {
+    bytes = preferences.getUInt("rx_bytes", kUsbCdcRxMinBytes);
+    preferences.end();
+  }
+  return bytes;
+}
+
+void persistUsbRxSizing(unsigned long nowMs) {
+  static unsigned long lastCheckMs = 0;
+  if (usbTransport == nullptr || nowMs - lastCheckMs < kUsbRxSizingCheckMs) {
+    return;
+  }
+  lastCheckMs = nowMs;
+  // 多台血壓計共用同一設定值，以壓力最大的那台決定下次開機的大小。
+  size_t current = 0;
+  size_t next = 0;
+  for (uint8_t device = 0; device < usbTransport->deviceCount(); ++device) {
+    const UsbCdcRxTelemetry telemetry = usbTransport->rxTelemetry(device);
+    if (telemetry.capacityBytes == 0) continue;
+    const size_t candidate = usbCdcRxNextCapacity(
+      telemetry, telemetry.psram ? kUsbCdcRxMaxPsramBytes
+                                 : kUsbCdcRxMaxInternalBytes);
+    if (telemetry.capacityBytes > current) current = telemetry.capacityBytes;
+    if (candidate > next) next = candidate;
+  }
+  static size_t persistedBytes = 0;
+  if (current == 0 || next <= current || next == persistedBytes) return;
+  if (preferences.begin("usb-rx", false)) {
+    if (preferences.putUInt("rx_bytes", static_cast<uint32_t>(next)) > 0) {
+      persistedBytes = next;
+    }
+    preferences.end();
+  }
+}
+
+// UART fallback 鎖定的線路設定：開機先用上次的結果；ingest task 換線或重新
+// 鎖定後，由 loop() 寫回 NVS。只有設定真的改變（換了不同 baud 的血壓計）才寫。
+constexpr unsigned long kUartLineCheckMs = 1000;
+uint32_t persistedUartLine = 0;
+
+uint32_t loadUartLineSetting() {
+  if (preferences.begin("uart-line", true)) {
+    persistedUartLine = preferences.getUInt("line", 0);
+    preferences.end();
+  }
+  return persistedUartLine;
+}
+
+void persistUartLineSetting(unsigned long nowMs) {
+  static unsigned long lastCheckMs = 0;
+  if (uartTransport == nullptr || nowMs - lastCheckMs < kUartLineCheckMs) {
+    return;
+  }
+  lastCheckMs = nowMs;
+  uint32_t packed = 0;
+  if (!uartTransport->lockedLineSetting(packed) ||
+      packed == persistedUartLine) {
+    return;
+  }
+  if (preferences.begin("uart-line", false)) {
+    if (preferences.putUInt("line", packed) > 0) persistedUartLine = packed;
+    preferences.end();
+  }
+}
+
+// DataProcessor 的 ingest 半部（transport drain、framing、parsing）在另一顆核心
+// 執行；loop() 只從 SPSC queue 套用結果並持久化，網頁產生再久也不會延後 byte drain。
+// Arduino loop() 固定在 core 1，ingest 放在 core 0 與 USB host daemon 同核。
+constexpr BaseType_t kIngestTaskCore = 0;
+constexpr UBaseType_t kIngestTaskPriority = 2;
+constexpr uint32_t kIngestTaskStackBytes = 6144;
+// transport 支援喚醒時，ingest task 平時阻塞在 task notification 上；
+// 這個上限只負責 checkActivity() 與 transport 的重試計時，不是資料路徑。
+constexpr uint32_t kIngestIdleWaitMs = 100;
+TaskHandle_t ingestTask = nullptr;
+// 由 ingest task 自己發布，USB driver/daemon task 的喚醒 callback 才讀得到。
+std::atomic<TaskHandle_t> ingestWakeTarget{nullptr};
+bool ingestWakeSupported = false;
+
+// 在 USB driver/daemon task 執行，只能發 notification，不可阻塞。
+void wakeIngestTask(void*) {
+  TaskHandle_t task = ingestWakeTarget.load(std::memory_order_acquire);
+  if (task != nullptr) xTaskNotifyGive(task);
+}
+
+void ingestTaskMain(void*) {
+  ingestWakeTarget.store(xTaskGetCurrentTaskHandle(),
+                         std::memory_order_release);
+  for (;;) {
+    const bool backlogged = dataProcessor->ingestIncomingData();
+    dataProcessor->checkActivity();
+    if (backlogged || !ingestWakeSupported) {
+      // 每輪讓出 1 tick：transport 自身仍有緩衝，core 0 的 idle/WiFi task 不會被餓死。
+      vTaskDelay(1);
+      continue;
+    }
+    // 新 byte 或 lifecycle 事件一到就被喚醒；閒置時不再每 tick 醒來。
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(kIngestIdleWaitMs));
+  }
+}
+
+bool startIngestTask() {
+  dataProcessor->useConcurrentIngest(true);
+  const BaseType_t created = xTaskCreatePinnedToCore(
+    ingestTaskMain, "bp_ingest", kIngestTaskStackBytes, nullptr,
+    kIngestTaskPriority, &ingestTask, kIngestTaskCore);
+  if (created == pdPASS) return true;
+  ingestTask = nullptr;
+  dataProcessor->useConcurrentIngest(false);
+  return false;
+}
+
 bool removePreferenceIfPresent(Preferences& store, const char* key) {
   return !store.isKey(key) || store.remove(key);
 }
@@ -157,11 +286,9 @@ bool provideWebRuntimeSnapshot(
 bool loadHistoryFromStorage() {
   const bool historyLoaded = recordManager.loadFromStorage();
   if (!historyLoaded) {
-    lastData =
-      "<div class='diagnostic-data' data-status='storage_error'>"
-      "<h3>儲存診斷</h3><p><strong>狀態：</strong>storage_error</p>"
-      "<p class='helper-text'>歷史記錄載入未完成；請勿將目前列表視為完整記錄。"
-      "請聯絡管理人員檢查儲存空間，修復後重新啟動裝置。</p></div>";
+    receiveDiagnostic.set(ReceiveDiagnosticStatus::STORAGE_ERROR,
+                          ReceiveDiagnosticAction::HISTORY_LOAD_FAILED,
+                          millis());
     Serial.println("history_load_failed");
     return false;
   }
@@ -242,17 +369,27 @@ void setup() {
   // 初始化各個模組。先建立 transport，讓 Web operations state 直接讀取
   // main-loop 擁有的累計計數，不另複製或重設診斷狀態。
   if (kTransportMode == TRANSPORT_MODE_OTG_PRIMARY) {
-    monitorTransport = new UsbCdcTransport();
+    usbTransport = new UsbCdcTransport(loadUsbRxBufferBytes(),
+                                       kUsbMonitorDeviceCount);
+    monitorTransport = usbTransport;
   } else {
-    monitorTransport = new UartTransport(&Serial1, kUartRxPin, kUartTxPin,
-                                         kMonitorBaudRate);
+    uartTransport = new UartTransport(
+      UART_NUM_1, kUartRxPin, kUartTxPin, kMonitorLineCandidates,
+      sizeof(kMonitorLineCandidates) / sizeof(kMonitorLineCandidates[0]),
+      loadUartLineSetting());
+    monitorTransport = uartTransport;
   }
+  // 必須在 begin() 之前設定；不支援的 transport 讓 ingest task 維持每 tick 輪詢。
+  ingestWakeSupported =
+    monitorTransport->setWakeCallback(wakeIngestTask, nullptr);
 
   webHandler = new WebHandler(&server, &deviceSecurity,
                               &preferences, &recordManager,
                               &bpParser,
-                              &bp_model, &lastData, &transportName,
-                              &transportStatus, monitorTransport,
+                              &bp_model, &receiveDiagnostic, &transportName,
+                              &transportStatus, &transportSummary,
+                              &measurementSnapshot,
+                              &measurementLatency,
                               &uptimeClock,
                               &measurementPolicyStore,
                               &firmwareUpdateRuntime,
@@ -263,8 +400,10 @@ void setup() {
     deviceSecurity.secret(DeviceSecretKind::AP), hostname);
   
   dataProcessor = new DataProcessor(&bpParser, &recordManager,
-                                   &lastData,
-                                   &transportName, &transportStatus, monitorTransport);
+                                   &receiveDiagnostic,
+                                   &transportName, &transportStatus,
+                                   &transportSummary, &measurementSnapshot,
+                                   monitorTransport, &measurementLatency);
   
   // 舊版可能留下實驗型號；boot 也必須走 production allowlist，不能只靠 UI。
   String storedModel = "OMRON-HBP9030";
@@ -330,6 +469,10 @@ void setup() {
       return;
     }
   }
+  if (!startIngestTask()) {
+    // 退回單執行緒：loop() 內 inline ingest，功能不變，只是失去跨核隔離。
+    Serial.println("ingest_task_start_failed_inline_fallback");
+  }
   runtimeReady = true;
 }
 
@@ -342,12 +485,15 @@ void loop() {
   // 處理數據接收
   dataProcessor->processIncomingData();
 
-  // 檢查TTL串口通訊活動狀態
-  dataProcessor->checkActivity();
+  // 檢查TTL串口通訊活動狀態（ingest task 執行時由該 task 自行檢查）
+  if (ingestTask == nullptr) dataProcessor->checkActivity();
 
   // 偵測 STA 上線並延遲啟動 mDNS
   wifiManager->tick(millis());
 
+  persistUsbRxSizing(millis());
+  persistUartLineSetting(millis());
+
   // 非阻塞 reset button：按住 3 秒才重置，避免誤觸卡 loop
   static unsigned long resetPressStart = 0;
   static bool recoveryTriggered = false;
@@ -1,6 +1,8 @@
 #ifndef BP_CONFIG_H
 #define BP_CONFIG_H
 
+#include "transports/UartLineDetector.h"
+
 enum MonitorTransportMode {
   TRANSPORT_MODE_OTG_PRIMARY = 0,
   TRANSPORT_MODE_UART_FALLBACK = 1,
@@ -8,9 +10,25 @@ enum MonitorTransportMode {
 
 static constexpr MonitorTransportMode kTransportMode = TRANSPORT_MODE_OTG_PRIMARY;
 
+// 經 USB hub 同時接入的血壓計數量（1..kMaxMonitorDevices）。每台各自配置
+// RX buffer，紀錄會標註來源 slot；只接一台時保持 1，行為與格式不變。
+static constexpr uint8_t kUsbMonitorDeviceCount = 1;
+
 static constexpr int kUartRxPin = 44;
 static constexpr int kUartTxPin = 43;
-static constexpr unsigned long kMonitorBaudRate = 9600;
+// UART fallback 依序嘗試的線路設定（baud、data bits、parity、stop bits）。
+// 以 ingest framer/parser 的有效 frame 評分，鎖定後存入 NVS，下次開機先用。
+// 只接固定型號時可縮成一項，等同舊的固定 9600 8N1。
+static constexpr UartLineSetting kMonitorLineCandidates[] = {
+  {9600, 8, 'N', 1},
+  {19200, 8, 'N', 1},
+  {4800, 8, 'N', 1},
+  {2400, 8, 'N', 1},
+  {38400, 8, 'N', 1},
+  {115200, 8, 'N', 1},
+  {9600, 7, 'E', 1},
+  {9600, 8, 'E', 1},
+};
 
 // 多數 ESP32 開發板有 GPIO0 boot/reset 按鈕，長按 3 秒清空 WiFi 設定
 static constexpr int kResetPin = 0;
@@ -41,6 +41,8 @@ struct BPData {
   int movementCount = 0;
   BPMeasurementQuality quality = BPMeasurementQuality::CLEAN;
   bool valid = false;
+  // Monitor slot on a multi-device transport; 0 for single-monitor bridges.
+  uint8_t deviceSlot = 0;
 };
 
 struct BPParseResult {
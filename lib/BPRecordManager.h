@@ -26,7 +26,11 @@ private:
   // shorter accepted value is the fixed legacy-unsynced sentinel.
   static constexpr size_t kMaxTimestampBytes = 19;
   static constexpr size_t kSlotFixedSize = 45;
-  static constexpr size_t kMaxSlotSize = kSlotFixedSize + kMaxTimestampBytes;
+  // Optional device-slot byte before the CRC. Slot 0 omits it, so records
+  // from single-monitor bridges stay byte-identical to earlier v3 firmware.
+  static constexpr size_t kDeviceSlotBytes = 1;
+  static constexpr size_t kMaxSlotSize =
+    kSlotFixedSize + kMaxTimestampBytes + kDeviceSlotBytes;
 
   const int _maxRecords;
   BPData* _records;
@@ -38,6 +42,8 @@ private:
   bool _sequenceExhausted = false;
   uint64_t _lastSuccessfulRecordSequence = 0;
   uint64_t _lastSuccessfulReceiveMs = 0;
+  // RAM-only; see contentVersion().
+  uint64_t _contentVersion = 0;
   MonotonicMillis64* _uptimeClock = nullptr;
   Preferences _preferences;
 
@@ -46,6 +52,20 @@ private:
     bool duplicate = false;
   };
 
+  int firstIndexBelow(uint64_t sequence) const {
+    int low = 0;
+    int high = _recordCount;
+    while (low < high) {
+      const int mid = low + (high - low) / 2;
+      if (getRecord(mid).recordSequence < sequence) {
+        high = mid;
+      } else {
+        low = mid + 1;
+      }
+    }
+    return low;
+  }
+
   static uint32_t crc32(const uint8_t* data, size_t length) {
     uint32_t crc = 0xffffffffU;
     for (size_t i = 0; i < length; ++i) {
@@ -193,10 +213,13 @@ private:
                            uint8_t (&encoded)[kMaxSlotSize]) {
     if (generation == 0 || !validMeasurementFields(record, true)) return 0;
     const size_t timestampLength = record.timestamp.length();
-    const size_t length = kSlotFixedSize + timestampLength;
+    const bool taggedDevice = record.deviceSlot != 0;
+    const size_t length = kSlotFixedSize + timestampLength +
+                          (taggedDevice ? kDeviceSlotBytes : 0);
     // Offsets: v[0], gen[1..4], record seq[5..12], session seq[13..20],
     // timestamp length[21], bytes[22..], source, four LE32 values, quality,
-    // valid byte, then CRC32 LE covering every preceding byte.
+    // valid byte, optional device slot, then CRC32 LE covering every
+    // preceding byte.
     size_t offset = 0;
     encoded[offset++] = kSchemaVersion;
     writeLe32(encoded + offset, generation);
@@ -220,6 +243,7 @@ private:
     offset += 4;
     encoded[offset++] = static_cast<uint8_t>(record.quality);
     encoded[offset++] = record.valid ? 1 : 0;
+    if (taggedDevice) encoded[offset++] = record.deviceSlot;
     writeLe32(encoded + offset, crc32(encoded, offset));
     offset += 4;
     return offset == length ? length : 0;
@@ -233,8 +257,12 @@ private:
       return false;
     }
     const size_t timestampLength = encoded[21];
-    if (timestampLength == 0 || timestampLength > kMaxTimestampBytes ||
-        length != kSlotFixedSize + timestampLength) {
+    if (timestampLength == 0 || timestampLength > kMaxTimestampBytes) {
+      return false;
+    }
+    const size_t untaggedLength = kSlotFixedSize + timestampLength;
+    if (length != untaggedLength &&
+        length != untaggedLength + kDeviceSlotBytes) {
       return false;
     }
 
@@ -267,8 +295,14 @@ private:
     if (quality > static_cast<uint8_t>(BPMeasurementQuality::MOTION)) return false;
     record.quality = static_cast<BPMeasurementQuality>(quality);
     const uint8_t valid = encoded[offset++];
-    if (valid > 1 || offset + 4 != length) return false;
+    if (valid > 1) return false;
     record.valid = valid == 1;
+    if (length != untaggedLength) {
+      // A tagged slot never stores 0; that form is reserved for the short one.
+      record.deviceSlot = encoded[offset++];
+      if (record.deviceSlot == 0) return false;
+    }
+    if (offset + 4 != length) return false;
     return validMeasurementFields(record, true);
   }
 
@@ -351,9 +385,11 @@ private:
   void resetRecords() {
     for (int i = 0; i < _maxRecords; ++i) _records[i] = BPData{};
     _recordCount = 0;
+    _contentVersion++;
   }
 
   void appendChronological(BPData record) {
+    _contentVersion++;
     if (_recordCount < _maxRecords) {
       _records[_recordCount++] = std::move(record);
       return;
@@ -744,6 +780,61 @@ public:
     return _records[_recordCount - index - 1];
   }
 
+  // Index 0 is newest and sequences strictly decrease with the index, so a
+  // reader that pauses between chunks resumes by sequence even after adds
+  // have shifted the indexes. Newest record older than `sequence`, or -1.
+  int indexBeforeSequence(uint64_t sequence) const {
+    const int index = firstIndexBelow(sequence);
+    return index < _recordCount ? index : -1;
+  }
+
+  // Oldest record newer than `sequence`, or -1.
+  int indexAfterSequence(uint64_t sequence) const {
+    if (sequence == UINT64_MAX) return -1;
+    return firstIndexBelow(sequence + 1) - 1;
+  }
+
+  // One page of a delta read: up to `limit` records newer than `since`,
+  // oldest first. `nextSince` is the cursor for the following page. `gap`
+  // means records behind a cursor the reader already held are no longer
+  // stored (ring overwrite, clear, or a cursor ahead of this store), so it
+  // must resync. `since == 0` is that resync: it starts at the oldest
+  // retained record and never reports a gap.
+  struct SequencePage {
+    int firstIndex = -1;  // oldest returned record, -1 when empty
+    int count = 0;
+    uint64_t nextSince = 0;
+    bool hasMore = false;
+    bool gap = false;
+  };
+
+  SequencePage pageAfterSequence(uint64_t since, int limit) const {
+    SequencePage page;
+    const uint64_t revision = getRevision();
+    if (since > revision) {
+      page.gap = true;
+      page.nextSince = revision;
+      return page;
+    }
+    if (since != 0 && _recordCount > 0 &&
+        getRecord(_recordCount - 1).recordSequence - 1ULL > since) {
+      page.gap = true;
+    }
+    page.firstIndex = indexAfterSequence(since);
+    const int available = page.firstIndex + 1;
+    page.count = limit < available ? limit : available;
+    if (page.count <= 0) {
+      page.firstIndex = -1;
+      page.count = 0;
+      page.nextSince = since;
+      return page;
+    }
+    page.nextSince =
+      getRecord(page.firstIndex - page.count + 1).recordSequence;
+    page.hasMore = page.count < available;
+    return page;
+  }
+
   const BPData& getLatestRecord() const { return getRecord(0); }
   int getRecordCount() const { return _recordCount; }
   int getMaxRecords() const { return _maxRecords; }
@@ -754,11 +845,25 @@ public:
     return _recordCount > 0 ? getLatestRecord().recordSequence : 0;
   }
 
+  // Changes whenever the in-memory records change: add, ring overwrite,
+  // clear or reload. Unlike the revision it also moves when a clear or
+  // reload leaves the same latest sequence, so caches of rendered records
+  // key on it.
+  uint64_t contentVersion() const { return _contentVersion; }
+
   bool latestReceivedThisBoot() const {
     return _recordCount > 0 && _lastSuccessfulRecordSequence != 0 &&
       getLatestRecord().recordSequence == _lastSuccessfulRecordSequence;
   }
 
+  // Uptime of the latest durable receive this boot; snapshots publish the
+  // absolute value so readers can age it against their own clock sample.
+  bool lastSuccessfulReceiveMs(uint64_t& receivedMs) const {
+    if (!latestReceivedThisBoot()) return false;
+    receivedMs = _lastSuccessfulReceiveMs;
+    return true;
+  }
+
   bool lastSuccessfulReceiveAgeMs(uint64_t nowMs, uint64_t& ageMs) const {
     if (!latestReceivedThisBoot()) return false;
     if (nowMs < _lastSuccessfulReceiveMs) return false;
@@ -0,0 +1,175 @@
+#ifndef BOUNDED_CONNECTION_TABLE_H
+#define BOUNDED_CONNECTION_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "BoundedHttpTransaction.h"
+#include "BoundedSocketRuntime.h"
+#include "BoundedWebInput.h"
+#include "WebAccessPolicy.h"
+
+namespace bp_web {
+
+using BoundedWebDeferredAction = void (*)(void* context);
+
+// Connections served at once. Each slot owns a full transaction (request
+// parser plus the fixed response buffer), so this bounds web RAM up front:
+// a client beyond it waits in the listen backlog instead of allocating.
+static constexpr size_t kBoundedWebSlots = 4;
+
+// Everything one connection needs between loop passes: its transaction,
+// unread TCP tail, drain state and deadlines, and the route and role the
+// gate granted. Handlers still run one at a time on the loop task; only
+// socket progress is multiplexed.
+class BoundedConnection {
+public:
+  explicit BoundedConnection(BoundedSocketOps ops) : _socketRuntime(ops) {}
+
+  BoundedConnection(const BoundedConnection&) = delete;
+  BoundedConnection& operator=(const BoundedConnection&) = delete;
+
+  bp_http::BoundedHttpTransaction transaction;
+  BoundedIngressBuffer ingress;
+  uint32_t acceptedLocalAddress = 0;
+  uint32_t remoteAddress = 0;
+  AccessRole role = AccessRole::NONE;
+  RequestInterface requestInterface = RequestInterface::UNKNOWN;
+  const RoutePolicy* route = nullptr;
+  BoundedWebDeferredAction deferredAction = nullptr;
+  void* deferredContext = nullptr;
+  bool deferredFallbackPending = false;
+
+  void open(int socket, uint32_t localAddress, uint32_t peerAddress,
+            uint32_t nowMs) {
+    close();
+    _socket = socket;
+    _active = true;
+    acceptedLocalAddress = localAddress;
+    remoteAddress = peerAddress;
+    transaction.begin(nowMs);
+  }
+
+  void close() {
+    if (!transaction.terminal()) transaction.abort();
+    _socketRuntime.cancelDrain();
+    ingress.clear();
+    clearGrant();
+    acceptedLocalAddress = 0;
+    remoteAddress = 0;
+    deferredAction = nullptr;
+    deferredContext = nullptr;
+    deferredFallbackPending = false;
+    _socket = -1;
+    _active = false;
+  }
+
+  void clearGrant() {
+    role = AccessRole::NONE;
+    requestInterface = RequestInterface::UNKNOWN;
+    route = nullptr;
+  }
+
+  bool active() const { return _active; }
+  int socket() const { return _socket; }
+  BoundedSocketRuntime& socketRuntime() { return _socketRuntime; }
+
+  // One bounded read into the empty ingress buffer; a tail still waiting
+  // for the parser is consumed before more is read.
+  IngressIoResult receive() {
+    if (ingress.length() != 0) return IngressIoResult::PROGRESS;
+    return _socketRuntime.receiveInto(_socket, ingress);
+  }
+
+  // At most one send budget per call, so a fast reader cannot starve the
+  // other slots and a blocked one only skips its own turn.
+  void pumpResponse(uint32_t nowMs) {
+    if (transaction.state() !=
+        bp_http::TransactionState::SENDING_RESPONSE) {
+      return;
+    }
+    if (!transaction.poll(nowMs) || transaction.awaitingStreamData()) return;
+    const bp_http::ResponseChunk chunk = transaction.nextOutput();
+    if (chunk.data == nullptr || chunk.length == 0 || _socket < 0) {
+      transaction.abort();
+      return;
+    }
+    const SocketWriteResult sent = _socketRuntime.sendSome(
+      _socket, chunk.data, chunk.length);
+    if (sent.status == SocketWriteStatus::WOULD_BLOCK) return;
+    if (sent.status != SocketWriteStatus::PROGRESS ||
+        !transaction.acknowledgeOutput(sent.length)) {
+      transaction.abort();
+    }
+  }
+
+private:
+  BoundedSocketRuntime _socketRuntime;
+  int _socket = -1;
+  bool _active = false;
+};
+
+// Fixed slot table with round-robin service order. Admission takes the
+// first free slot; a full table admits nothing, so memory never grows with
+// the number of clients.
+template <size_t N>
+class BoundedConnectionTable {
+public:
+  static_assert(N > 0, "at least one connection slot");
+
+  explicit BoundedConnectionTable(BoundedSocketOps ops)
+    : BoundedConnectionTable(ops, std::make_index_sequence<N>()) {}
+
+  BoundedConnectionTable(const BoundedConnectionTable&) = delete;
+  BoundedConnectionTable& operator=(const BoundedConnectionTable&) = delete;
+
+  static constexpr size_t capacity() { return N; }
+
+  BoundedConnection* acquire() {
+    for (BoundedConnection& slot : _slots) {
+      if (!slot.active()) return &slot;
+    }
+    return nullptr;
+  }
+
+  bool full() const { return activeCount() == N; }
+
+  size_t activeCount() const {
+    size_t count = 0;
+    for (const BoundedConnection& slot : _slots) {
+      if (slot.active()) ++count;
+    }
+    return count;
+  }
+
+  BoundedConnection& slot(size_t index) { return _slots[index]; }
+
+  size_t indexOf(const BoundedConnection& connection) const {
+    return static_cast<size_t>(&connection - _slots);
+  }
+
+  // Visits every active slot once, starting one further each pass so no
+  // slot is always first in line for the loop's time.
+  template <typename Visit>
+  void forEachActive(Visit visit) {
+    const size_t start = _nextStart;
+    _nextStart = (_nextStart + 1) % N;
+    for (size_t i = 0; i < N; ++i) {
+      BoundedConnection& connection = _slots[(start + i) % N];
+      if (connection.active()) visit(connection);
+    }
+  }
+
+private:
+  BoundedConnection _slots[N];
+  size_t _nextStart = 0;
+
+  template <size_t... I>
+  BoundedConnectionTable(BoundedSocketOps ops, std::index_sequence<I...>)
+    : _slots{BoundedConnection(((void)I, ops))...} {}
+};
+
+}  // namespace bp_web
+
+#endif
@@ -88,10 +88,38 @@ struct RequestView {
   char origin[257] = {};
   char referer[257] = {};
   char contentType[129] = {};
+  char ifNoneMatch[129] = {};
   uint32_t contentLength = 0;
   bool hasContentLength = false;
+  // The client listed `close` in a Connection header.
+  bool connectionClose = false;
 };
 
+// If-None-Match comparison (RFC 9110 13.1.2): a comma-separated list of
+// entity tags compared weakly, or "*". `etag` is the current tag, quoted and
+// optionally W/-prefixed.
+inline bool etagListMatches(const char* header, const char* etag) {
+  if (header == nullptr || etag == nullptr || etag[0] == '\0') return false;
+  if (etag[0] == 'W' && etag[1] == '/') etag += 2;
+  const size_t etagLength = std::strlen(etag);
+  if (etagLength == 0) return false;
+  const char* cursor = header;
+  while (*cursor != '\0') {
+    while (*cursor == ' ' || *cursor == '\t' || *cursor == ',') ++cursor;
+    const char* start = cursor;
+    while (*cursor != '\0' && *cursor != ',') ++cursor;
+    const char* end = cursor;
+    while (end > start && (end[-1] == ' ' || end[-1] == '\t')) --end;
+    if (end - start == 1 && *start == '*') return true;
+    if (end - start > 2 && start[0] == 'W' && start[1] == '/') start += 2;
+    if (static_cast<size_t>(end - start) == etagLength &&
+        std::memcmp(start, etag, etagLength) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 struct ConsumeResult {
   size_t consumed;
   RequestState state;
@@ -143,6 +171,7 @@ public:
     _originSeen = false;
     _refererSeen = false;
     _contentTypeSeen = false;
+    _ifNoneMatchSeen = false;
     _headerBytes = 0;
     _headerCount = 0;
     _bodyLength = 0;
@@ -376,6 +405,7 @@ private:
   bool _originSeen = false;
   bool _refererSeen = false;
   bool _contentTypeSeen = false;
+  bool _ifNoneMatchSeen = false;
   size_t _headerBytes = 0;
   size_t _headerCount = 0;
   uint32_t _startedAt = 0;
@@ -614,6 +644,34 @@ private:
                        _contentTypeSeen, value, valueLength);
       return;
     }
+    if (nameEquals(_line, colon, "if-none-match")) {
+      copyUniqueHeader(_view.ifNoneMatch, sizeof(_view.ifNoneMatch),
+                       _ifNoneMatchSeen, value, valueLength);
+      return;
+    }
+    if (nameEquals(_line, colon, "connection")) {
+      // A token list and may repeat; only `close` changes anything here.
+      size_t start = 0;
+      while (start < valueLength) {
+        size_t end = start;
+        while (end < valueLength && value[end] != ',') ++end;
+        size_t tokenStart = start;
+        size_t tokenEnd = end;
+        while (tokenStart < tokenEnd &&
+               (value[tokenStart] == ' ' || value[tokenStart] == '\t')) {
+          ++tokenStart;
+        }
+        while (tokenEnd > tokenStart &&
+               (value[tokenEnd - 1] == ' ' || value[tokenEnd - 1] == '\t')) {
+          --tokenEnd;
+        }
+        if (nameEquals(value + tokenStart, tokenEnd - tokenStart, "close")) {
+          _view.connectionClose = true;
+        }
+        start = end + 1;
+      }
+      return;
+    }
     if (nameEquals(_line, colon, "content-length")) {
       if (_contentLengthSeen || valueLength == 0) {
         reject(RequestError::INVALID_CONTENT_LENGTH);
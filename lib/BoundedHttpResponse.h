@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 
 namespace bp_http {
@@ -19,11 +20,40 @@ struct ResponseChunk {
   size_t length;
 };
 
+enum class StreamFill : uint8_t {
+  MORE,
+  DONE,
+  FAILED,
+  IDLE,
+};
+
+// Fills `window` with up to `capacity` body bytes and reports the count in
+// `written`. MORE must make progress; DONE may be empty. IDLE means the
+// bytes written, possibly none, are all that is ready: the stream stays open
+// and the generator is asked again on the next poll. The context must stay
+// valid until the response completes or aborts.
+using ResponseGenerator = StreamFill (*)(void* context, uint8_t* window,
+                                         size_t capacity, size_t& written);
+
 class BoundedHttpResponse {
 public:
   static constexpr size_t kCapacity = 16384;
   static constexpr size_t kSendBudget = 1024;
+  // An idle event stream waits without a deadline; each window produced
+  // after idling gets a fresh kSendDeadlineMs to drain.
   static constexpr uint32_t kSendDeadlineMs = 1500;
+  // Streaming mode: the captured head goes out first, then the generator
+  // refills the same buffer one chunk-encoded window at a time.
+  static constexpr size_t kChunkPrefixCapacity = 6;
+  static constexpr size_t kStreamWindow =
+    kCapacity - kChunkPrefixCapacity - 2 - 5;
+  static_assert(kStreamWindow <= 0xFFFF,
+                "chunk size must fit the fixed hex prefix");
+  // Every product response is no-store. A content-addressed static asset is
+  // the only exception and carries the immutable policy without Pragma.
+  static constexpr const char* kNoStoreCacheControl = "no-store, max-age=0";
+  static constexpr const char* kImmutableCacheControl =
+    "private, max-age=31536000, immutable";
 
   BoundedHttpResponse() { begin(); }
 
@@ -39,9 +69,72 @@ public:
     _offered = 0;
     _sendStartedAt = 0;
     _overflowed = false;
+    _generator = nullptr;
+    _generatorContext = nullptr;
+    _streamFinished = false;
+    _lastFillIdle = false;
+    _awaitingStream = false;
+    _cacheable = false;
     _state = ResponseState::BUILDING;
   }
 
+  bool allowCaching() {
+    if (_state != ResponseState::BUILDING || _overflowed) return false;
+    _cacheable = true;
+    return true;
+  }
+
+  // Rewrites the captured `Connection: close` line so the socket stays open
+  // for another request, and tells the client how long and how many more.
+  // Runs after validation; false leaves the response untouched and closing.
+  bool keepAlive(uint32_t timeoutSeconds, uint32_t remainingRequests) {
+    if (_state != ResponseState::BUILDING || _overflowed ||
+        _generator != nullptr || _length == 0) {
+      return false;
+    }
+    static constexpr char kCloseLine[] = "Connection: close";
+    char replacement[64] = {};
+    const int written = std::snprintf(
+      replacement, sizeof(replacement),
+      "Connection: keep-alive\r\nKeep-Alive: timeout=%lu, max=%lu",
+      static_cast<unsigned long>(timeoutSeconds),
+      static_cast<unsigned long>(remainingRequests));
+    if (written <= 0 || static_cast<size_t>(written) >= sizeof(replacement)) {
+      return false;
+    }
+    const size_t statusEnd = findCrlf(0, _length);
+    if (statusEnd == kNotFound) return false;
+    size_t cursor = statusEnd + 2;
+    while (cursor < _length) {
+      const size_t lineEnd = findCrlf(cursor, _length);
+      if (lineEnd == kNotFound || lineEnd == cursor) return false;
+      const size_t lineLength = lineEnd - cursor;
+      if (lineLength == sizeof(kCloseLine) - 1 &&
+          asciiCaseEqual(cursor, lineLength, kCloseLine)) {
+        const size_t grow = static_cast<size_t>(written) - lineLength;
+        if (grow > kCapacity - _length) return false;
+        std::memmove(_bytes + lineEnd + grow, _bytes + lineEnd,
+                     _length - lineEnd);
+        std::memcpy(_bytes + cursor, replacement,
+                    static_cast<size_t>(written));
+        _length += grow;
+        return true;
+      }
+      cursor = lineEnd + 2;
+    }
+    return false;
+  }
+
+  bool stream(ResponseGenerator generator, void* context) {
+    if (_state != ResponseState::BUILDING || _overflowed ||
+        generator == nullptr || _generator != nullptr) {
+      return false;
+    }
+    _generator = generator;
+    _generatorContext = context;
+    return true;
+  }
+
   size_t append(const uint8_t* data, size_t length) {
     if (_state != ResponseState::BUILDING || _overflowed) return 0;
     if ((data == nullptr && length != 0) ||
@@ -73,6 +166,8 @@ public:
       secureZero(_bytes, sizeof(_bytes));
       std::memcpy(_bytes, kOverflowResponse, sizeof(kOverflowResponse) - 1);
       _length = sizeof(kOverflowResponse) - 1;
+      _generator = nullptr;
+      _generatorContext = nullptr;
     }
     if (_length == 0) return false;
     _sendStartedAt = nowMs;
@@ -82,7 +177,9 @@ public:
   }
 
   ResponseChunk nextChunk(size_t budget = kSendBudget) {
-    if (_state != ResponseState::SENDING) return {nullptr, 0};
+    if (_state != ResponseState::SENDING || _awaitingStream) {
+      return {nullptr, 0};
+    }
     if (_offered != 0) return {_bytes + _offset, _offered};
     if (budget > kSendBudget) budget = kSendBudget;
     size_t pending = _length - _offset;
@@ -103,18 +200,42 @@ public:
     secureZero(_bytes + _offset, length);
     _offset += length;
     _offered = 0;
+    if (_offset == _length && _generator != nullptr && !_streamFinished) {
+      if (_lastFillIdle) {
+        secureZero(_bytes, sizeof(_bytes));
+        _length = 0;
+        _offset = 0;
+        _awaitingStream = true;
+        return true;
+      }
+      return refillStream();
+    }
     if (_offset == _length) {
       secureZero(_bytes, sizeof(_bytes));
       _length = 0;
       _offset = 0;
       _offered = 0;
+      _generator = nullptr;
+      _generatorContext = nullptr;
+      _awaitingStream = false;
       _state = ResponseState::COMPLETE;
     }
     return true;
   }
 
+  // Asks an idle generator for the next window. False when it failed and
+  // the response aborted.
+  bool pollStream(uint32_t nowMs) {
+    if (_state != ResponseState::SENDING) return false;
+    if (!_awaitingStream) return true;
+    if (!refillStream()) return false;
+    if (!_awaitingStream) _sendStartedAt = nowMs;
+    return true;
+  }
+
   bool enforceDeadline(uint32_t nowMs) {
     if (_state != ResponseState::SENDING) return false;
+    if (_awaitingStream) return true;
     if (static_cast<uint32_t>(nowMs - _sendStartedAt) >=
         kSendDeadlineMs) {
       abort();
@@ -132,11 +253,19 @@ public:
     _length = 0;
     _offset = 0;
     _offered = 0;
+    _generator = nullptr;
+    _generatorContext = nullptr;
+    _awaitingStream = false;
     _state = ResponseState::ABORTED;
   }
 
   ResponseState state() const { return _state; }
   bool overflowed() const { return _overflowed; }
+  bool streaming() const { return _generator != nullptr; }
+  bool awaitingStream() const {
+    return _state == ResponseState::SENDING && _awaitingStream;
+  }
+  bool cacheable() const { return _cacheable; }
   size_t responseLength() const { return _length; }
   size_t pendingLength() const {
     return _state == ResponseState::SENDING ? _length - _offset : 0;
@@ -167,6 +296,7 @@ public:
     size_t pragmaCount = 0;
     size_t contentOptionsCount = 0;
     size_t connectionCount = 0;
+    size_t transferEncodingCount = 0;
     size_t cursor = statusEnd + 2;
     size_t bodyOffset = kNotFound;
 
@@ -220,11 +350,12 @@ public:
       } else if (asciiCaseEqual(cursor, nameLength, "Cache-Control")) {
         if (++cacheControlCount != 1 ||
             !bytesEqual(valueStart, valueLength,
-                        "no-store, max-age=0")) {
+                        _cacheable ? kImmutableCacheControl
+                                   : kNoStoreCacheControl)) {
           return false;
         }
       } else if (asciiCaseEqual(cursor, nameLength, "Pragma")) {
-        if (++pragmaCount != 1 ||
+        if (_cacheable || ++pragmaCount != 1 ||
             !bytesEqual(valueStart, valueLength, "no-cache")) {
           return false;
         }
@@ -241,18 +372,25 @@ public:
         }
       } else if (asciiCaseEqual(cursor, nameLength,
                                 "Transfer-Encoding")) {
-        return false;
+        if (_generator == nullptr || ++transferEncodingCount != 1 ||
+            !asciiCaseEqual(valueStart, valueLength, "chunked")) {
+          return false;
+        }
       }
       cursor = lineEnd + 2;
     }
 
     if (bodyOffset == kNotFound || contentTypeCount != 1 ||
-        contentLengthCount != 1 || cacheControlCount != 1 ||
-        pragmaCount != 1 || contentOptionsCount != 1 ||
-        connectionCount != 1) {
+        cacheControlCount != 1 || pragmaCount != (_cacheable ? 0U : 1U) ||
+        contentOptionsCount != 1 || connectionCount != 1) {
       return false;
     }
-    return contentLength == _length - bodyOffset;
+    if (_generator != nullptr) {
+      return transferEncodingCount == 1 && contentLengthCount == 0 &&
+             bodyOffset == _length;
+    }
+    return contentLengthCount == 1 &&
+           contentLength == _length - bodyOffset;
   }
 
 private:
@@ -264,6 +402,12 @@ private:
   size_t _offered = 0;
   uint32_t _sendStartedAt = 0;
   bool _overflowed = false;
+  ResponseGenerator _generator = nullptr;
+  void* _generatorContext = nullptr;
+  bool _streamFinished = false;
+  bool _lastFillIdle = false;
+  bool _awaitingStream = false;
+  bool _cacheable = false;
   ResponseState _state = ResponseState::BUILDING;
 
   static void secureZero(void* target, size_t length) {
@@ -271,6 +415,55 @@ private:
     while (length-- != 0) *bytes++ = 0;
   }
 
+  // Runs with the buffer fully acknowledged and wiped. The window is written
+  // behind a fixed prefix slot, so the hex size line is placed right-aligned
+  // in front of it and the chunk goes out without a copy.
+  bool refillStream() {
+    static constexpr char kLastChunk[] = "0\r\n\r\n";
+    secureZero(_bytes, sizeof(_bytes));
+    size_t written = 0;
+    const StreamFill fill = _generator(
+      _generatorContext, _bytes + kChunkPrefixCapacity, kStreamWindow,
+      written);
+    if (fill == StreamFill::FAILED || written > kStreamWindow ||
+        (fill == StreamFill::MORE && written == 0)) {
+      abort();
+      return false;
+    }
+    _lastFillIdle = fill == StreamFill::IDLE;
+    if (_lastFillIdle && written == 0) {
+      _offset = 0;
+      _length = 0;
+      _awaitingStream = true;
+      return true;
+    }
+    _awaitingStream = false;
+    size_t start = kChunkPrefixCapacity;
+    size_t end = kChunkPrefixCapacity;
+    if (written != 0) {
+      static constexpr char kHex[] = "0123456789abcdef";
+      _bytes[--start] = '\n';
+      _bytes[--start] = '\r';
+      size_t remaining = written;
+      do {
+        _bytes[--start] = static_cast<uint8_t>(kHex[remaining & 0xf]);
+        remaining >>= 4;
+      } while (remaining != 0);
+      end += written;
+      _bytes[end++] = '\r';
+      _bytes[end++] = '\n';
+    }
+    if (fill == StreamFill::DONE) {
+      std::memcpy(_bytes + end, kLastChunk, sizeof(kLastChunk) - 1);
+      end += sizeof(kLastChunk) - 1;
+      _streamFinished = true;
+    }
+    if (written == 0) start = kChunkPrefixCapacity;
+    _offset = start;
+    _length = end;
+    return true;
+  }
+
   size_t findCrlf(size_t start, size_t limit) const {
     if (limit > _length) limit = _length;
     for (size_t i = start; i + 1 < limit; ++i) {
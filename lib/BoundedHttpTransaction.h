@@ -13,6 +13,9 @@ namespace bp_http {
 
 enum class TransactionState : uint8_t {
   IDLE,
+  // Keep-alive: the previous response is out, the next request has not
+  // started. Idle expiry closes silently instead of answering 408.
+  AWAITING_REQUEST,
   READING_HEADERS,
   WAIT_POLICY,
   READING_BODY,
@@ -38,6 +41,10 @@ class BoundedHttpTransaction {
 public:
   static constexpr size_t kReadBudget = BoundedHttpRequest::kByteBudget;
   static constexpr uint32_t kHandoffDeadlineMs = 1500;
+  // A persistent connection holds one of the few server slots, so both its
+  // idle time and its lifetime are capped; the client reconnects after.
+  static constexpr uint32_t kKeepAliveIdleMs = 5000;
+  static constexpr uint32_t kMaxRequestsPerConnection = 32;
 
   BoundedHttpTransaction() = default;
 
@@ -49,12 +56,39 @@ public:
     _response.begin();
     _queuedStatus = 0;
     _phaseStartedAt = nowMs;
+    _requestsServed = 0;
+    _closeRequired = false;
+    _persistent = false;
     _state = TransactionState::READING_HEADERS;
   }
 
+  // After a COMPLETE keep-alive response: wipes the previous exchange and
+  // waits for the next request on the same socket. False means close.
+  bool awaitNextRequest(uint32_t nowMs) {
+    if (_state != TransactionState::COMPLETE || !_persistent) return false;
+    ++_requestsServed;
+    _request.reset(nowMs);
+    _response.begin();
+    _queuedStatus = 0;
+    _closeRequired = false;
+    _persistent = false;
+    _phaseStartedAt = nowMs;
+    _state = TransactionState::AWAITING_REQUEST;
+    return true;
+  }
+
+  // The server knows things the request does not, such as an action that
+  // must run after the socket is gone; this response then closes.
+  void closeAfterResponse() { _closeRequired = true; }
+
   TransactionConsume consume(const uint8_t* data, size_t length,
                              uint32_t nowMs,
                              size_t budget = kReadBudget) {
+    if (_state == TransactionState::AWAITING_REQUEST && length != 0) {
+      // The header deadline runs from the first byte, not from idle time.
+      _request.reset(nowMs);
+      transitionTo(TransactionState::READING_HEADERS, nowMs);
+    }
     if (_state != TransactionState::READING_HEADERS &&
         _state != TransactionState::READING_BODY) {
       return {0, _state};
@@ -141,6 +175,16 @@ public:
     return _response.append(data, length);
   }
 
+  bool captureStream(ResponseGenerator generator, void* context) {
+    if (_state != TransactionState::CAPTURING_RESPONSE) return false;
+    return _response.stream(generator, context);
+  }
+
+  bool allowCaching() {
+    if (_state != TransactionState::CAPTURING_RESPONSE) return false;
+    return _response.allowCaching();
+  }
+
   bool capturedResponseIsValidHttp1() const {
     return _state == TransactionState::CAPTURING_RESPONSE &&
            _response.validHttp1Envelope();
@@ -156,6 +200,11 @@ public:
       return queueError(500, nowMs);
     }
     if (_response.overflowed()) _queuedStatus = 503;
+    _persistent = !_closeRequired && !_request.view().connectionClose &&
+                  _requestsServed + 1 < kMaxRequestsPerConnection &&
+                  _response.keepAlive(
+                    kKeepAliveIdleMs / 1000,
+                    kMaxRequestsPerConnection - _requestsServed - 1);
     if (!_response.finalize(nowMs)) {
       abort();
       return false;
@@ -183,6 +232,14 @@ public:
   }
 
   bool poll(uint32_t nowMs) {
+    if (_state == TransactionState::AWAITING_REQUEST) {
+      if (static_cast<uint32_t>(nowMs - _phaseStartedAt) >=
+          kKeepAliveIdleMs) {
+        abort();
+        return false;
+      }
+      return true;
+    }
     if (_state == TransactionState::READING_HEADERS ||
         _state == TransactionState::READING_BODY) {
       (void)_request.consume(nullptr, 0, nowMs);
@@ -199,7 +256,8 @@ public:
       return queueError(503, nowMs);
     }
     if (_state == TransactionState::SENDING_RESPONSE) {
-      if (!_response.enforceDeadline(nowMs)) {
+      if (!_response.pollStream(nowMs) ||
+          !_response.enforceDeadline(nowMs)) {
         _state = TransactionState::ABORTED;
         return false;
       }
@@ -211,11 +269,20 @@ public:
     wipeRequest(0);
     _response.abort();
     _queuedStatus = 0;
+    _persistent = false;
     _state = TransactionState::ABORTED;
   }
 
   TransactionState state() const { return _state; }
+  // An event stream with nothing to send yet: not an error, poll again.
+  bool awaitingStreamData() const {
+    return _state == TransactionState::SENDING_RESPONSE &&
+           _response.awaitingStream();
+  }
   const BoundedHttpRequest& request() const { return _request; }
+  // The response in flight keeps the connection open after it completes.
+  bool persistent() const { return _persistent; }
+  uint32_t requestsServed() const { return _requestsServed; }
   int queuedStatus() const { return _queuedStatus; }
   bool terminal() const {
     return _state == TransactionState::COMPLETE ||
@@ -228,6 +295,9 @@ private:
   TransactionState _state = TransactionState::IDLE;
   int _queuedStatus = 0;
   uint32_t _phaseStartedAt = 0;
+  uint32_t _requestsServed = 0;
+  bool _closeRequired = false;
+  bool _persistent = false;
 
   static const char* reasonPhrase(int status) {
     switch (status) {
@@ -344,6 +414,7 @@ private:
     }
 
     _response.begin();
+    _persistent = false;
     const size_t length = static_cast<size_t>(written);
     if (_response.append(reinterpret_cast<const uint8_t*>(response), length) !=
         length || !_response.finalize(nowMs)) {
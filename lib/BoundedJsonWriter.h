@@ -0,0 +1,202 @@
+#ifndef BOUNDED_JSON_WRITER_H
+#define BOUNDED_JSON_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace bp_json {
+
+// Emits compact JSON tokens straight into a caller-owned buffer, such as a
+// response stream window, with no tree and no heap. Output matches
+// ArduinoJson's serializeJson for the same calls: keys in call order,
+// commas inserted automatically, UTF-8 passed through, and only quotes,
+// backslashes and control characters escaped.
+//
+// Containers may be left open so a response can be written in pieces; a
+// later writer continues the same array after continueSequence(). Running
+// out of room latches overflowed() and the partial bytes must be discarded.
+class BoundedJsonWriter {
+public:
+  static constexpr size_t kMaxDepth = 8;
+
+  BoundedJsonWriter(char* out, size_t capacity)
+    : _out(out), _capacity(out == nullptr ? 0 : capacity) {}
+
+  BoundedJsonWriter(const BoundedJsonWriter&) = delete;
+  BoundedJsonWriter& operator=(const BoundedJsonWriter&) = delete;
+
+  bool overflowed() const { return _overflowed; }
+  size_t length() const { return _length; }
+
+  // The first value written follows earlier elements of an open array.
+  void continueSequence() { _needComma[_depth] = true; }
+
+  void beginObject() { open('{'); }
+  void endObject() { close('}'); }
+  void beginArray() { open('['); }
+  void endArray() { close(']'); }
+
+  void key(const char* name) {
+    separate();
+    writeString(name);
+    put(':');
+    _afterKey = true;
+  }
+
+  void value(const char* text) {
+    separate();
+    if (text == nullptr) {
+      append("null", 4);
+    } else {
+      writeString(text);
+    }
+  }
+
+  void value(bool flag) {
+    separate();
+    if (flag) {
+      append("true", 4);
+    } else {
+      append("false", 5);
+    }
+  }
+
+  // Any integer width; int32_t is `long` on some toolchains, so a fixed
+  // set of overloads would be ambiguous for small fields like uint8_t.
+  template <typename T,
+            typename std::enable_if<std::is_integral<T>::value &&
+                                      !std::is_same<T, bool>::value,
+                                    int>::type = 0>
+  void value(T number) {
+    char encoded[24];
+    const int length = std::is_signed<T>::value
+      ? snprintf(encoded, sizeof(encoded), "%lld",
+                 static_cast<long long>(number))
+      : snprintf(encoded, sizeof(encoded), "%llu",
+                 static_cast<unsigned long long>(number));
+    separate();
+    if (length <= 0) {
+      _overflowed = true;
+      return;
+    }
+    append(encoded, static_cast<size_t>(length));
+  }
+
+  void nullValue() {
+    separate();
+    append("null", 4);
+  }
+
+  // Opaque uint64 identifiers travel as decimal strings so JavaScript
+  // readers keep every digit; same convention as setUInt64Json.
+  void uint64String(uint64_t number) {
+    char encoded[24];
+    snprintf(encoded, sizeof(encoded), "%llu",
+             static_cast<unsigned long long>(number));
+    value(static_cast<const char*>(encoded));
+  }
+
+  template <typename T>
+  void field(const char* name, T fieldValue) {
+    key(name);
+    value(fieldValue);
+  }
+
+  void uint64Field(const char* name, uint64_t number) {
+    key(name);
+    uint64String(number);
+  }
+
+private:
+  char* _out;
+  size_t _capacity;
+  size_t _length = 0;
+  size_t _depth = 0;
+  bool _needComma[kMaxDepth + 1] = {};
+  bool _afterKey = false;
+  bool _overflowed = false;
+
+  void put(char c) {
+    if (_length >= _capacity) {
+      _overflowed = true;
+      return;
+    }
+    _out[_length++] = c;
+  }
+
+  void append(const char* text, size_t length) {
+    if (length > _capacity - _length) {
+      _overflowed = true;
+      _length = _capacity;
+      return;
+    }
+    memcpy(_out + _length, text, length);
+    _length += length;
+  }
+
+  // Every value and key is preceded by a comma unless it opens its
+  // container or completes a key.
+  void separate() {
+    if (_afterKey) {
+      _afterKey = false;
+      return;
+    }
+    if (_needComma[_depth]) put(',');
+    _needComma[_depth] = true;
+  }
+
+  void open(char bracket) {
+    separate();
+    if (_depth == kMaxDepth) {
+      _overflowed = true;
+      return;
+    }
+    put(bracket);
+    _needComma[++_depth] = false;
+  }
+
+  void close(char bracket) {
+    if (_depth == 0) {
+      _overflowed = true;
+      return;
+    }
+    --_depth;
+    put(bracket);
+  }
+
+  void writeString(const char* text) {
+    put('"');
+    for (const char* p = text; *p != '\0'; ++p) {
+      const uint8_t c = static_cast<uint8_t>(*p);
+      const char* escape = nullptr;
+      switch (c) {
+        case '"': escape = "\\\""; break;
+        case '\\': escape = "\\\\"; break;
+        case '\b': escape = "\\b"; break;
+        case '\f': escape = "\\f"; break;
+        case '\n': escape = "\\n"; break;
+        case '\r': escape = "\\r"; break;
+        case '\t': escape = "\\t"; break;
+        default: break;
+      }
+      if (escape != nullptr) {
+        append(escape, 2);
+      } else if (c < 0x20) {
+        static const char kHex[] = "0123456789abcdef";
+        const char encoded[6] = {'\\', 'u', '0', '0',
+                                 kHex[c >> 4], kHex[c & 0x0f]};
+        append(encoded, sizeof(encoded));
+      } else {
+        put(static_cast<char>(c));
+      }
+    }
+    put('"');
+  }
+};
+
+}  // namespace bp_json
+
+#endif
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "BoundedConnectionTable.h"
 #include "BoundedHttpTransaction.h"
 #include "BoundedSocketRuntime.h"
 #include "BoundedStreamConsumer.h"
@@ -30,7 +31,6 @@ struct BoundedWebRuntimeSnapshot {
 
 using BoundedWebSnapshotProvider = bool (*)(
   void* context, BoundedWebRuntimeSnapshot& snapshot);
-using BoundedWebDeferredAction = void (*)(void* context);
 
 class BoundedWebServer final : public WebServer {
 public:
@@ -49,15 +49,41 @@ public:
   void close() override;
 
   bool deferAfterResponse(BoundedWebDeferredAction action, void* context);
+  // Body of unbounded length: headers are captured now with
+  // Transfer-Encoding: chunked, and `generator` fills the fixed response
+  // buffer window by window while the response is sent. `context` must
+  // outlive the response.
+  bool sendStream(int code, const char* contentType,
+                  bp_http::ResponseGenerator generator, void* context);
   bool recordClaimResult(bool tokenAccepted, uint32_t nowMs);
-
-  AccessRole currentRole() const { return _currentRole; }
+  // True when the request's If-None-Match lists `etag` (or "*"), so the
+  // handler may answer 304 instead of resending the body.
+  bool requestMatchesEtag(const char* etag) const;
+
+  // Accessors below describe the request being dispatched. Handlers run one
+  // at a time, so there is always at most one.
+  AccessRole currentRole() const {
+    return _dispatching == nullptr ? AccessRole::NONE : _dispatching->role;
+  }
   RequestInterface currentRequestInterface() const {
-    return _currentRequestInterface;
+    return _dispatching == nullptr ? RequestInterface::UNKNOWN
+                                   : _dispatching->requestInterface;
+  }
+  const RoutePolicy* currentRoute() const {
+    return _dispatching == nullptr ? nullptr : _dispatching->route;
+  }
+  uint32_t currentRemoteAddress() const {
+    return _dispatching == nullptr ? 0 : _dispatching->remoteAddress;
+  }
+  // Slot of the request being dispatched; per-connection response state
+  // such as stream cursors is indexed by it.
+  size_t currentSlot() const {
+    return _dispatching == nullptr ? 0 : _connections.indexOf(*_dispatching);
   }
-  const RoutePolicy* currentRoute() const { return _currentRoute; }
-  uint32_t currentRemoteAddress() const { return _remoteAddress; }
-  bool hasActiveClient() const { return _clientActive; }
+  bool hasActiveClient() const { return _connections.activeCount() != 0; }
+  // A connection is queued and every slot is busy, so a long-lived stream
+  // should end early to let it in.
+  bool clientWaiting();
 
 protected:
   size_t _currentClientWrite(const char* bytes, size_t length) override;
@@ -68,24 +94,19 @@ private:
   BoundedWebSnapshotProvider _snapshotProvider = nullptr;
   void* _snapshotContext = nullptr;
 
+  // Clock and socket I/O shared by every slot; drain state is per slot.
   BoundedSocketRuntime _socketRuntime;
-  bp_http::BoundedHttpTransaction _transaction;
-  BoundedIngressBuffer _ingress;
+  BoundedConnectionTable<kBoundedWebSlots> _connections;
+  NetworkClient _clients[kBoundedWebSlots];
+  // Handler-time state: one form and one runtime snapshot suffice because
+  // dispatch and policy evaluation never overlap.
   BoundedFormValidator _formValidator;
+  BoundedWebRuntimeSnapshot _runtimeSnapshot{};
+  BoundedConnection* _dispatching = nullptr;
+  // The firmware sink accepts one upload; its slot owns it until finished.
   bp_http::BoundedStreamConsumer _streamConsumer;
   bp_http::StreamConsumerCallbacks _streamCallbacks{};
-  BoundedWebRuntimeSnapshot _runtimeSnapshot{};
-
-  bool _clientActive = false;
-  uint32_t _acceptedLocalAddress = 0;
-  uint32_t _remoteAddress = 0;
-  AccessRole _currentRole = AccessRole::NONE;
-  RequestInterface _currentRequestInterface = RequestInterface::UNKNOWN;
-  const RoutePolicy* _currentRoute = nullptr;
-
-  BoundedWebDeferredAction _deferredAction = nullptr;
-  void* _deferredContext = nullptr;
-  bool _deferredFallbackPending = false;
+  BoundedConnection* _streamOwner = nullptr;
 
   static void secureZero(void* target, size_t length);
   static void secureWipeString(String& value);
@@ -94,15 +115,19 @@ private:
   static bp_http::AllowedMethods allowedMethodsForPath(const char* path,
                                                        bool& known);
 
-  void acceptClient(uint32_t nowMs);
-  void processIngress(uint32_t nowMs);
-  void processPolicy();
-  bool processStreamChunk(uint32_t nowMs);
-  void dispatchReadyRequest();
-  void pumpResponse(uint32_t nowMs);
-  void finishActiveClient(bool runDeferredAction);
+  void acceptClients(uint32_t nowMs);
+  void serviceConnection(BoundedConnection& connection);
+  void processIngress(BoundedConnection& connection, uint32_t nowMs);
+  void processPolicy(BoundedConnection& connection);
+  bool processStreamChunk(BoundedConnection& connection, uint32_t nowMs);
+  void releaseStreamConsumer(BoundedConnection& connection);
+  void dispatchReadyRequest(BoundedConnection& connection);
+  void finishConnection(BoundedConnection& connection,
+                        bool runDeferredAction);
 
   bool snapshotIsWellFormed() const;
+  bp_http::BoundedHttpTransaction* dispatchTransaction() const;
+  bool currentRouteIsCacheable() const;
   bool mandatoryResponseHeadersAreExact() const;
   bool materializeBaseRequest();
   void selectCurrentHandler();
@@ -21,24 +21,33 @@ inline void __appendCsvField(String& out, const String& value) {
   out += '"';
 }
 
+inline void appendHistoryCsvHeader(String& out) {
+  out += "\xEF\xBB\xBF";
+  out += "\"測量時間\",\"收縮壓(mmHg)\",\"舒張壓(mmHg)\",\"脈搏(bpm)\"\r\n";
+}
+
+// 單列輸出；invalid 記錄回 false 不寫入。串流匯出逐列呼叫。
+inline bool appendHistoryCsvRow(String& out, const BPData& r) {
+  if (!r.valid) return false;
+  __appendCsvField(out, r.timestamp);
+  out += ",\"";
+  out += r.systolic;
+  out += "\",\"";
+  out += r.diastolic;
+  out += "\",\"";
+  out += r.pulse;
+  out += "\"\r\n";
+  return true;
+}
+
 inline void appendHistoryCsv(String& out, const BP_RecordManager& mgr) {
   int count = mgr.getRecordCount();
   out.reserve(out.length() + 96 + count * 48);
-  out += "\xEF\xBB\xBF";
-  out += "\"測量時間\",\"收縮壓(mmHg)\",\"舒張壓(mmHg)\",\"脈搏(bpm)\"\r\n";
+  appendHistoryCsvHeader(out);
 
   // getRecord(0)=最新；倒序走訪 = 由舊到新
   for (int i = count - 1; i >= 0; i--) {
-    const BPData& r = mgr.getRecord(i);
-    if (!r.valid) continue;
-    __appendCsvField(out, r.timestamp);
-    out += ",\"";
-    out += r.systolic;
-    out += "\",\"";
-    out += r.diastolic;
-    out += "\",\"";
-    out += r.pulse;
-    out += "\"\r\n";
+    appendHistoryCsvRow(out, mgr.getRecord(i));
   }
 }
 
@@ -2,147 +2,245 @@
 #define DATA_PROCESSOR_H
 
 #include <Arduino.h>
+#include <string.h>
 #include <utility>
 
 #include "BP_Parser.h"
 #include "BPRecordManager.h"
+#include "MeasurementLatency.h"
+#include "MeasurementSnapshot.h"
 #include "ProtocolFramer.h"
+#include "ReceiveDiagnostic.h"
+#include "SpscQueue.h"
 #include "transports/MonitorTransport.h"
 
+// Ingest 與網頁兩側只透過兩條 SPSC queue 交換資料：
+//   ingest -> web：transport 狀態、接收診斷、待持久化的量測
+//   web -> ingest：型號設定變更
+// BP_RecordManager、ReceiveDiagnostic 與 transport 狀態字串只由 web 側寫入，
+// 並經 MeasurementSnapshotPublisher（seqlock）發布給網頁讀取端；
+// transport、framer 與 ingest parser 只由 ingest 側使用。
+// 同一個 transport 可能服務多台血壓計（USB hub）；每個 device slot 有自己的
+// framer、epoch 與延遲追蹤，parser 只依型號解析單一 frame，因此共用。
+enum class IngestEventType : uint8_t {
+  TRANSPORT_STATUS = 0,
+  DIAGNOSTIC,
+  MEASUREMENT,
+};
+
+struct IngestEvent {
+  IngestEventType type = IngestEventType::DIAGNOSTIC;
+  ReceiveDiagnostic diagnostic;
+  BPData measurement;
+  MeasurementLatencyTrace latency;
+  MonitorTransportSummary transport;
+  String transportDetail;
+};
+
+struct IngestModelUpdate {
+  static constexpr size_t kModelCapacity = 32;
+  // 超長型號留空字串，parser 會視為未支援型號而不是截斷後誤判。
+  char model[kModelCapacity] = {};
+};
+
 class DataProcessor {
+public:
+  static constexpr size_t kIngestQueueDepth = 8;
+  static constexpr size_t kModelQueueDepth = 4;
+
 private:
+  // 每讀一個 rx event 最多產生一筆結果；迴圈後還可能再送 unsupported 診斷與
+  // transport 狀態，所以讀取前保留三格，已讀出的 byte 永遠有位置交付。
+  static constexpr size_t kReservedIngestSlots = 3;
+
+  // ---- web 側（main loop）----
   BP_Parser* bpParser;
   BP_RecordManager* recordManager;
-  String* lastData;
+  ReceiveDiagnostic* diagnostic;
   String* transportName;
   String* transportStatus;
-  MonitorTransport* transport;
+  MonitorTransportSummary* transportSummary;
+  MeasurementSnapshotPublisher* snapshot;
+  MeasurementLatencyTracker* latency;
+  String publishedModel;
+  bool modelPublished = false;
+  bool concurrentIngest = false;
+
+  // ---- 跨 task 邊界 ----
+  SpscQueue<IngestEvent, kIngestQueueDepth> ingestEvents;
+  SpscQueue<IngestModelUpdate, kModelQueueDepth> modelUpdates;
 
+  // ---- ingest 側 ----
+  MonitorTransport* transport;
+  BP_Parser ingestParser{String()};
   bool transportActive = false;
   unsigned long lastTransportActivity = 0;
 
-  ProtocolFramer framer;
+  struct IngestStream {
+    ProtocolFramer framer;
+    uint32_t rxEpoch = 0;
+    bool rxEpochKnown = false;
+    MeasurementLatencyTrace frameTrace;
+  };
+
+  IngestStream streams[kMaxMonitorDevices];
   ProtocolFrameContract frameContract;
-  String framedModel;
-  uint32_t rxEpoch = 0;
-  bool rxEpochKnown = false;
-
-  MonitorTransportState lastSyncedState = TRANSPORT_STATE_STARTING;
-  String lastSyncedDetail;
-  bool statusEverSynced = false;
-
-  const char* stateLabel(MonitorTransportState state) const {
-    switch (state) {
-      case TRANSPORT_STATE_STARTING:       return "啟動中";
-      case TRANSPORT_STATE_WAITING_DEVICE: return "等待裝置";
-      case TRANSPORT_STATE_READY:          return "就緒";
-      case TRANSPORT_STATE_RECEIVING:      return "接收中";
-      case TRANSPORT_STATE_UNSUPPORTED:    return "未就緒";
-      case TRANSPORT_STATE_ERROR:          return "錯誤";
-      default:                             return "未知";
+
+  MonitorTransportStatus lastSampledStatus;
+  bool statusEverSampled = false;
+
+  // ingest 側：以 POD 狀態與版本比對，版本有變才格式化 detail() 文字；
+  // queue 滿時保留舊取樣，下一輪重試。
+  void sampleTransportStatus() {
+    const MonitorTransportStatus status = transport->status();
+    if (statusEverSampled && status == lastSampledStatus) return;
+    IngestEvent event;
+    event.type = IngestEventType::TRANSPORT_STATUS;
+    event.transport.statusVersion = status.version;
+    event.transport.state = status.state;
+    event.transport.dataLossCount = status.dataLossCount;
+    event.transport.reconnectCount = status.reconnectCount;
+    const uint8_t devices = transport->deviceCount();
+    event.transport.deviceCount =
+      devices < kMaxMonitorDevices ? devices : kMaxMonitorDevices;
+    for (uint8_t i = 0; i < event.transport.deviceCount; ++i) {
+      event.transport.devices[i] = transport->deviceSummary(i);
     }
+    event.transportDetail = transport->detail();
+    if (!ingestEvents.push(std::move(event))) return;
+    lastSampledStatus = status;
+    statusEverSampled = true;
   }
 
-  void syncTransportStatus() {
-    MonitorTransportState state = transport->state();
-    String detail = transport->detail();
-    if (statusEverSynced && state == lastSyncedState &&
-        detail == lastSyncedDetail) {
-      return;
+  void applyModelUpdates() {
+    IngestModelUpdate update;
+    bool changed = false;
+    while (modelUpdates.pop(update)) {
+      ingestParser.setModel(String(update.model));
+      changed = true;
     }
-    lastSyncedState = state;
-    lastSyncedDetail = detail;
-    statusEverSynced = true;
-    String& target = *transportStatus;
-    target = stateLabel(state);
-    target += " - ";
-    target += detail;
+    if (!changed) return;
+    for (IngestStream& stream : streams) stream.framer.reset();
+    frameContract = ingestParser.framingContract();
   }
 
-  void syncFramingContract() {
-    if (framedModel == bpParser->getModel()) return;
-    framer.reset();
-    framedModel = bpParser->getModel();
-    frameContract = bpParser->framingContract();
+  void pushDiagnostic(ReceiveDiagnosticStatus status,
+                      ReceiveDiagnosticAction action) {
+    IngestEvent event;
+    event.type = IngestEventType::DIAGNOSTIC;
+    event.diagnostic.set(status, action, millis());
+    // 讀取前已保留容量，這裡不會失敗。
+    (void)ingestEvents.push(std::move(event));
   }
 
-  static const char* operatorAction(BPParseError error) {
-    switch (error) {
-      case BPParseError::INVALID_TIMESTAMP:
-        return "請校正血壓計日期與時間後重新量測。";
-      case BPParseError::DEVICE_ERROR:
-        return "請依血壓計錯誤碼處理後重新量測。";
-      case BPParseError::OUT_OF_RANGE:
-        return "請確認量測流程與設備狀態後重新量測。";
-      case BPParseError::UNSUPPORTED_FORMAT:
-        return "請將 HBP-9030 USB 輸出設定為格式 5。";
-      case BPParseError::UNSUPPORTED_MODEL:
-        return "請選用已驗證的 HBP-9030 設定。";
-      default:
-        return "請確認 USB 輸出格式與連線後重新量測。";
+  void pushFrameEvent(ProtocolFrameEvent event) {
+    if (event == ProtocolFrameEvent::FRAME_OVERFLOW) {
+      pushDiagnostic(ReceiveDiagnosticStatus::OVERFLOW,
+                     ReceiveDiagnosticAction::FRAME_OVERFLOW);
+    } else if (event == ProtocolFrameEvent::DISCONTINUITY) {
+      pushDiagnostic(ReceiveDiagnosticStatus::DISCONTINUITY,
+                     ReceiveDiagnosticAction::LINK_DISCONTINUITY);
+    } else {
+      pushDiagnostic(ReceiveDiagnosticStatus::MALFORMED,
+                     receiveDiagnosticActionFor(BPParseError::MALFORMED));
     }
   }
 
-  void renderDiagnostic(const char* status, const char* action,
-                        const BPData* measurement = nullptr) {
-    String& target = *lastData;
-    target = "";
-    target.reserve(480);
-    target += "<div class='diagnostic-data' data-status='";
-    target += status;
-    target += "'><h3>接收診斷</h3><p><strong>狀態：</strong>";
-    target += status;
-    target += "</p>";
-    if (measurement != nullptr && measurement->valid) {
-      target += "<p><strong>量測：</strong>SYS ";
-      target += measurement->systolic;
-      target += " / DIA ";
-      target += measurement->diastolic;
-      target += " / PULSE ";
-      target += measurement->pulse;
-      target += "</p><p><strong>設備時間：</strong>";
-      target += measurement->timestamp;
-      target += "</p>";
-    }
-    target += "<p class='helper-text'>";
-    target += action;
-    target += "</p></div>";
+  void beginFrameTrace(IngestStream& stream, uint8_t device) {
+    stream.frameTrace = MeasurementLatencyTrace();
+    stream.frameTrace.hasRxAccepted =
+      transport->deviceRxAcceptedUs(device, stream.frameTrace.rxAcceptedUs);
   }
 
-  void renderFrameEvent(ProtocolFrameEvent event) {
-    if (event == ProtocolFrameEvent::FRAME_OVERFLOW) {
-      renderDiagnostic("overflow", "資料過長已丟棄；請確認輸出格式後重新量測。");
-    } else if (event == ProtocolFrameEvent::DISCONTINUITY) {
-      renderDiagnostic("discontinuity", "資料傳輸中斷；請確認連線後重新量測。");
-    } else {
-      renderDiagnostic("malformed", operatorAction(BPParseError::MALFORMED));
+  // 回報給 transport 的線路證據：frame 有依協定解出（即使量測本身被拒）才算
+  // 有效；格式錯誤才算 rejected；型號未支援時不判斷。
+  static void noteFrameOutcome(MonitorFramingReport& report,
+                               BPParseError error) {
+    switch (error) {
+      case BPParseError::MALFORMED:
+      case BPParseError::UNSUPPORTED_FORMAT:
+        report.rejectedFrames++;
+        break;
+      case BPParseError::UNSUPPORTED_MODEL:
+        break;
+      default:
+        report.validFrames++;
+        break;
     }
   }
 
-  bool finishFrame(const uint8_t* data, size_t length) {
-    BPParseResult result = bpParser->parseResult(data, static_cast<int>(length));
+  BPParseError finishFrame(IngestStream& stream, uint8_t device,
+                           const uint8_t* data, size_t length) {
+    BPParseResult result = ingestParser.parseResult(data, static_cast<int>(length));
     if (!result.ok() ||
         result.measurement.timestampSource != BPTimestampSource::DEVICE) {
       BPParseError error = result.error;
       if (result.ok()) error = BPParseError::INVALID_TIMESTAMP;
-      renderDiagnostic(bpParseErrorCode(error), operatorAction(error));
+      pushDiagnostic(receiveDiagnosticStatusFor(error),
+                     receiveDiagnosticActionFor(error));
       Serial.print("measurement_rejected reason=");
       Serial.println(bpParseErrorCode(error));
-      return true;
+      return error;
+    }
+
+    stream.frameTrace.parsedUs = micros();
+    IngestEvent event;
+    event.type = IngestEventType::MEASUREMENT;
+    event.measurement = std::move(result.measurement);
+    event.measurement.deviceSlot = device;
+    event.latency = stream.frameTrace;
+    (void)ingestEvents.push(std::move(event));
+    return BPParseError::NONE;
+  }
+
+  // ---- web 側 ----
+
+  void publishModelChange() {
+    const String& model = bpParser->getModel();
+    if (modelPublished && model == publishedModel) return;
+    IngestModelUpdate update;
+    if (model.length() < sizeof(update.model)) {
+      memcpy(update.model, model.c_str(), model.length());
+      update.model[model.length()] = '\0';
     }
+    if (!modelUpdates.push(std::move(update))) return;
+    publishedModel = model;
+    modelPublished = true;
+  }
+
+  void recordDiagnostic(ReceiveDiagnosticStatus status,
+                        ReceiveDiagnosticAction action,
+                        const BPData* measurement = nullptr) {
+    diagnostic->set(status, action, millis());
+    if (measurement != nullptr) diagnostic->attachVitals(*measurement);
+  }
+
+  void applyTransportStatus(const IngestEvent& event) {
+    *transportSummary = event.transport;
+    String& target = *transportStatus;
+    target = monitorTransportStateLabel(event.transport.state);
+    target += " - ";
+    target += event.transportDetail;
+  }
 
-    BPData measurement = std::move(result.measurement);
+  void persistMeasurement(BPData&& measurement,
+                          const MeasurementLatencyTrace& trace) {
     const int systolic = measurement.systolic;
     const int diastolic = measurement.diastolic;
     const int pulse = measurement.pulse;
+    const uint8_t device = measurement.deviceSlot;
     if (!recordManager->addRecord(std::move(measurement))) {
-      renderDiagnostic(
-        "storage_error",
-        "儲存系統未能確認本次量測；請先查看歷史記錄確認是否已保存，再依診所流程重新量測。");
+      recordDiagnostic(ReceiveDiagnosticStatus::STORAGE_ERROR,
+                       ReceiveDiagnosticAction::STORAGE_UNCONFIRMED);
       Serial.println("measurement_storage_failed");
-      return true;
+      return;
     }
-    renderDiagnostic("valid", "量測已接收；如需複測請依診所流程進行。",
+    if (latency != nullptr) {
+      latency->recordDurable(trace, recordManager->getRevision(), micros(),
+                             millis());
+    }
+    recordDiagnostic(ReceiveDiagnosticStatus::VALID,
+                     ReceiveDiagnosticAction::MEASUREMENT_ACCEPTED,
                      &recordManager->getLatestRecord());
 
     Serial.print("measurement_accepted SYS=");
@@ -150,25 +248,72 @@ private:
     Serial.print(" DIA=");
     Serial.print(diastolic);
     Serial.print(" PULSE=");
-    Serial.println(pulse);
-    return true;
+    if (transportSummary->deviceCount > 1) {
+      Serial.print(pulse);
+      Serial.print(" DEV=");
+      Serial.println(device);
+    } else {
+      Serial.println(pulse);
+    }
+  }
+
+  void publishSnapshot() {
+    snapshot->publish(captureMeasurementSnapshot(
+      *recordManager, *diagnostic, *transportSummary));
+  }
+
+  // 每批結果套用後只發布一次 snapshot；沒有結果時不重寫。
+  bool applyIngestEvents() {
+    bool produced = false;
+    bool applied = false;
+    IngestEvent event;
+    while (ingestEvents.pop(event)) {
+      applied = true;
+      switch (event.type) {
+        case IngestEventType::TRANSPORT_STATUS:
+          applyTransportStatus(event);
+          break;
+        case IngestEventType::DIAGNOSTIC:
+          *diagnostic = event.diagnostic;
+          produced = true;
+          break;
+        case IngestEventType::MEASUREMENT:
+          persistMeasurement(std::move(event.measurement), event.latency);
+          produced = true;
+          break;
+      }
+    }
+    if (applied) publishSnapshot();
+    return produced;
   }
 
 public:
-  DataProcessor(BP_Parser* parser, BP_RecordManager* manager, String* diagnostics,
-                String* name, String* status, MonitorTransport* monitor)
+  DataProcessor(BP_Parser* parser, BP_RecordManager* manager,
+                ReceiveDiagnostic* diagnostics,
+                String* name, String* status,
+                MonitorTransportSummary* summary,
+                MeasurementSnapshotPublisher* snapshots,
+                MonitorTransport* monitor,
+                MeasurementLatencyTracker* latencyTracker = nullptr)
     : bpParser(parser),
       recordManager(manager),
-      lastData(diagnostics),
+      diagnostic(diagnostics),
       transportName(name),
       transportStatus(status),
+      transportSummary(summary),
+      snapshot(snapshots),
+      latency(latencyTracker),
       transport(monitor) {}
 
   bool setup() {
     const bool ok = transport->begin();
     *transportName = transport->name();
-    syncTransportStatus();
-    syncFramingContract();
+    publishModelChange();
+    applyModelUpdates();
+    sampleTransportStatus();
+    applyIngestEvents();
+    // 開機時的儲存診斷與已載入歷史也要在第一個網頁請求前發布。
+    publishSnapshot();
     Serial.println("與電腦通訊: 115200 bps");
     Serial.print("血壓機資料通道: ");
     Serial.println(*transportName);
@@ -180,22 +325,38 @@ public:
     return ok;
   }
 
-  bool processIncomingData() {
+  // 在啟動 ingest task 之前呼叫；之後 ingestIncomingData()/checkActivity()
+  // 只能由該 task 執行，processIncomingData() 只套用 queue 內的結果。
+  void useConcurrentIngest(bool enabled) { concurrentIngest = enabled; }
+
+  // Ingest 側：drain transport、framing、parsing，結果送進 SPSC queue。
+  // 回傳 true 表示因 web 側尚未取走結果而提前停止，剩餘資料仍留在 transport。
+  bool ingestIncomingData() {
+    applyModelUpdates();
     transport->poll();
-    syncTransportStatus();
-    syncFramingContract();
+    sampleTransportStatus();
 
     bool produced = false;
     bool unsupportedBytes = false;
+    bool backlogged = false;
+    MonitorFramingReport framing[kMaxMonitorDevices];
     MonitorRxEvent rxEvent;
-    while (transport->nextRxEvent(rxEvent)) {
+    while (true) {
+      if (ingestEvents.freeSlots() < kReservedIngestSlots) {
+        backlogged = true;
+        break;
+      }
+      if (!transport->nextRxEvent(rxEvent)) break;
       lastTransportActivity = millis();
       transportActive = true;
+      if (rxEvent.device >= kMaxMonitorDevices) continue;
+      IngestStream& stream = streams[rxEvent.device];
+      ProtocolFramer& framer = stream.framer;
 
       if (rxEvent.type == MonitorRxEventType::DISCONTINUITY ||
           rxEvent.type == MonitorRxEventType::STREAM_RESET) {
-        rxEpoch = rxEvent.epoch;
-        rxEpochKnown = true;
+        stream.rxEpoch = rxEvent.epoch;
+        stream.rxEpochKnown = true;
         if (rxEvent.type == MonitorRxEventType::STREAM_RESET) {
           framer.reset();
         } else {
@@ -203,42 +364,79 @@ public:
         }
         continue;
       }
-      if (rxEpochKnown && rxEvent.epoch != rxEpoch) {
+      if (stream.rxEpochKnown && rxEvent.epoch != stream.rxEpoch) {
         framer.discardUntilBoundary();
       }
-      rxEpoch = rxEvent.epoch;
-      rxEpochKnown = true;
+      stream.rxEpoch = rxEvent.epoch;
+      stream.rxEpochKnown = true;
 
       if (frameContract.mode == ProtocolFrameMode::UNSUPPORTED) {
         unsupportedBytes = true;
         continue;
       }
 
+      if (!framer.pending()) beginFrameTrace(stream, rxEvent.device);
+      MonitorFramingReport& report = framing[rxEvent.device];
+      report.bytes++;
       ProtocolFrameEvent event =
         framer.feed(rxEvent.byte, frameContract);
       if (event == ProtocolFrameEvent::FRAME) {
-        produced = finishFrame(framer.frameData(), framer.frameLength()) || produced;
+        stream.frameTrace.frameCompleteUs = micros();
+        noteFrameOutcome(report,
+                         finishFrame(stream, rxEvent.device,
+                                     framer.frameData(),
+                                     framer.frameLength()));
         framer.clearCompletedFrame();
+        produced = true;
       } else if (event != ProtocolFrameEvent::NONE) {
-        renderFrameEvent(event);
+        if (event == ProtocolFrameEvent::REJECTED ||
+            event == ProtocolFrameEvent::FRAME_OVERFLOW) {
+          report.rejectedFrames++;
+        }
+        pushFrameEvent(event);
         produced = true;
       }
     }
 
+    // 一輪結束才回報：這一輪的 byte 都是在同一組線路設定下收到的。
+    for (uint8_t device = 0; device < kMaxMonitorDevices; ++device) {
+      if (!framing[device].empty()) {
+        transport->noteFraming(device, framing[device]);
+      }
+    }
+
     if (unsupportedBytes) {
-      renderDiagnostic("unsupported_model",
-                       operatorAction(BPParseError::UNSUPPORTED_MODEL));
+      pushDiagnostic(ReceiveDiagnosticStatus::UNSUPPORTED_MODEL,
+                     ReceiveDiagnosticAction::SELECT_VERIFIED_MODEL);
       produced = true;
     }
-    if (produced) syncTransportStatus();
+    if (produced) sampleTransportStatus();
+    return backlogged;
+  }
+
+  // Web 側（main loop）：送出型號變更並套用 ingest 結果。未啟用 ingest task
+  // 時在同一個 loop 內先 ingest 再套用，行為與單執行緒版本相同。
+  bool processIncomingData() {
+    publishModelChange();
+    if (concurrentIngest) return applyIngestEvents();
+
+    bool produced = false;
+    bool backlogged = false;
+    do {
+      backlogged = ingestIncomingData();
+      produced = applyIngestEvents() || produced;
+    } while (backlogged);
     return produced;
   }
 
+  // 與 ingestIncomingData() 同一個 task 執行；只讀 ingest 側狀態。
   void checkActivity() {
     if (transportActive && millis() - lastTransportActivity > 5000) {
       transportActive = false;
       Serial.print("資料通道已超過 5 秒沒有新資料: ");
-      Serial.println(*transportStatus);
+      Serial.print(transport->name());
+      Serial.print(" - ");
+      Serial.println(monitorTransportStateLabel(lastSampledStatus.state));
     }
   }
 };
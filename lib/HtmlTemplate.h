@@ -0,0 +1,203 @@
+#ifndef HTML_TEMPLATE_H
+#define HTML_TEMPLATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace bp_html {
+
+// Appends markup to a caller-owned buffer, normally the remainder of a
+// response stream window. It takes the same `+=` operands page helpers
+// already use with String, so one helper template renders into either.
+// Running out of room latches overflowed(); the partial bytes must be
+// discarded and the piece rendered again into a fresh window.
+class BoundedHtmlWriter {
+public:
+  BoundedHtmlWriter(char* out, size_t capacity)
+    : _out(out), _capacity(out == nullptr ? 0 : capacity) {}
+
+  BoundedHtmlWriter(const BoundedHtmlWriter&) = delete;
+  BoundedHtmlWriter& operator=(const BoundedHtmlWriter&) = delete;
+
+  bool overflowed() const { return _overflowed; }
+  size_t length() const { return _length; }
+
+  void append(const char* text, size_t length) {
+    if (length > _capacity - _length) {
+      _overflowed = true;
+      _length = _capacity;
+      return;
+    }
+    memcpy(_out + _length, text, length);
+    _length += length;
+  }
+
+  BoundedHtmlWriter& operator+=(const char* text) {
+    if (text != nullptr) append(text, strlen(text));
+    return *this;
+  }
+
+  BoundedHtmlWriter& operator+=(char c) {
+    append(&c, 1);
+    return *this;
+  }
+
+  // Decimal text, as String's integer overloads produce. Formatted by hand:
+  // rows carry several numbers and snprintf dominated their render time.
+  template <typename T,
+            typename std::enable_if<std::is_integral<T>::value &&
+                                      !std::is_same<T, bool>::value &&
+                                      !std::is_same<T, char>::value,
+                                    int>::type = 0>
+  BoundedHtmlWriter& operator+=(T number) {
+    char encoded[24];
+    char* end = encoded + sizeof(encoded);
+    char* p = end;
+    const bool negative = std::is_signed<T>::value && number < 0;
+    unsigned long long magnitude = negative
+      ? 0ULL - static_cast<unsigned long long>(number)
+      : static_cast<unsigned long long>(number);
+    do {
+      *--p = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative) *--p = '-';
+    append(p, static_cast<size_t>(end - p));
+    return *this;
+  }
+
+private:
+  char* _out;
+  size_t _capacity;
+  size_t _length = 0;
+  bool _overflowed = false;
+};
+
+// Minimal escape for user-controlled text (SSID, model, policy name) so a
+// '<' cannot open a tag. Works with String and BoundedHtmlWriter alike.
+template <typename Out>
+void appendHtmlEscaped(Out& out, const char* text) {
+  if (text == nullptr) return;
+  for (const char* p = text; *p != '\0'; ++p) {
+    switch (*p) {
+      case '<':  out += "&lt;"; break;
+      case '>':  out += "&gt;"; break;
+      case '&':  out += "&amp;"; break;
+      case '"':  out += "&quot;"; break;
+      case '\'': out += "&#39;"; break;
+      default:   out += *p;
+    }
+  }
+}
+
+// The writer copies runs of safe bytes at once instead of one at a time.
+inline void appendHtmlEscaped(BoundedHtmlWriter& out, const char* text) {
+  if (text == nullptr) return;
+  const char* run = text;
+  for (const char* p = text;; ++p) {
+    const char* entity = nullptr;
+    switch (*p) {
+      case '<':  entity = "&lt;"; break;
+      case '>':  entity = "&gt;"; break;
+      case '&':  entity = "&amp;"; break;
+      case '"':  entity = "&quot;"; break;
+      case '\'': entity = "&#39;"; break;
+      case '\0': break;
+      default:   continue;
+    }
+    out.append(run, static_cast<size_t>(p - run));
+    if (entity == nullptr) return;
+    out += entity;
+    run = p + 1;
+  }
+}
+
+// A precompiled page is a constexpr table of segments: fixed markup kept
+// in flash with its length known at compile time, and numbered slots
+// whose dynamic content is rendered when the stream reaches them.
+static constexpr uint8_t kLiteralSegment = 0xFF;
+
+struct HtmlSegment {
+  const char* text;
+  size_t length;
+  uint8_t slot;
+};
+
+template <size_t N>
+constexpr HtmlSegment htmlLiteral(const char (&text)[N]) {
+  return {text, N - 1, kLiteralSegment};
+}
+
+constexpr HtmlSegment htmlSlot(uint8_t slot) {
+  return {nullptr, 0, slot};
+}
+
+// Renders one slot. It may be called again for the same slot when its
+// output did not fit the rest of a window, so it must not change state.
+using HtmlSlotRenderer = void (*)(void* context, uint8_t slot,
+                                  BoundedHtmlWriter& out);
+
+enum class RenderProgress : uint8_t {
+  DONE,    // every segment written
+  FULL,    // window full; call again with the next window
+  FAILED,  // a slot does not fit even an empty window
+};
+
+// Resumable position in a segment table. Literals split freely across
+// windows; a slot is written whole into one window or retried in the next.
+class HtmlTemplateCursor {
+public:
+  template <size_t N>
+  void begin(const HtmlSegment (&segments)[N]) {
+    begin(segments, N);
+  }
+
+  void begin(const HtmlSegment* segments, size_t count) {
+    _segments = segments;
+    _count = count;
+    _index = 0;
+    _offset = 0;
+  }
+
+  bool done() const { return _index >= _count; }
+
+  // Appends to `window` from `written` on and advances `written`.
+  RenderProgress render(char* window, size_t capacity, size_t& written,
+                        HtmlSlotRenderer renderSlot, void* context) {
+    while (!done()) {
+      if (written >= capacity) return RenderProgress::FULL;
+      const HtmlSegment& segment = _segments[_index];
+      if (segment.slot == kLiteralSegment) {
+        const size_t remaining = segment.length - _offset;
+        const size_t room = capacity - written;
+        const size_t count = remaining < room ? remaining : room;
+        memcpy(window + written, segment.text + _offset, count);
+        written += count;
+        _offset += count;
+        if (_offset < segment.length) return RenderProgress::FULL;
+      } else {
+        BoundedHtmlWriter out(window + written, capacity - written);
+        renderSlot(context, segment.slot, out);
+        if (out.overflowed()) {
+          return written == 0 ? RenderProgress::FAILED : RenderProgress::FULL;
+        }
+        written += out.length();
+      }
+      ++_index;
+      _offset = 0;
+    }
+    return RenderProgress::DONE;
+  }
+
+private:
+  const HtmlSegment* _segments = nullptr;
+  size_t _count = 0;
+  size_t _index = 0;
+  size_t _offset = 0;
+};
+
+}  // namespace bp_html
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef MEASUREMENT_LATENCY_H
+#define MEASUREMENT_LATENCY_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 量測端到端延遲追蹤：USB 接收 -> frame 完成 -> 解析 -> NVS 持久化 ->
+// 第一次由網頁送出。前三個時間戳在 ingest 側以 micros() 取得並隨
+// IngestEvent 交給 main loop；持久化與送出都在 main loop 記錄，因此
+// tracker 只有單一寫入者，不需要額外同步。
+enum class MeasurementLatencyStage : uint8_t {
+  USB_TO_FRAME = 0,
+  FRAME_TO_PARSED,
+  PARSED_TO_DURABLE,
+  DURABLE_TO_SERVED,
+  COUNT,
+};
+
+inline const char* measurementLatencyStageCode(MeasurementLatencyStage stage) {
+  switch (stage) {
+    case MeasurementLatencyStage::USB_TO_FRAME:      return "usb_to_frame";
+    case MeasurementLatencyStage::FRAME_TO_PARSED:   return "frame_to_parsed";
+    case MeasurementLatencyStage::PARSED_TO_DURABLE: return "parsed_to_durable";
+    case MeasurementLatencyStage::DURABLE_TO_SERVED: return "durable_to_served";
+    default:                                         return "unknown";
+  }
+}
+
+inline const char* measurementLatencyStageLabel(MeasurementLatencyStage stage) {
+  switch (stage) {
+    case MeasurementLatencyStage::USB_TO_FRAME:      return "USB 接收到完整資料框";
+    case MeasurementLatencyStage::FRAME_TO_PARSED:   return "資料框到解析完成";
+    case MeasurementLatencyStage::PARSED_TO_DURABLE: return "解析到寫入儲存";
+    case MeasurementLatencyStage::DURABLE_TO_SERVED: return "寫入儲存到網頁首次送出";
+    default:                                         return "未知";
+  }
+}
+
+// Ingest 側量測時間戳（POD）。USB 階段取自 transport 最近一次接受資料的
+// 時間；consumer 落後時會略為低估，但每 tick 都 drain 時誤差不超過一批。
+struct MeasurementLatencyTrace {
+  bool hasRxAccepted = false;
+  uint32_t rxAcceptedUs = 0;
+  uint32_t frameCompleteUs = 0;
+  uint32_t parsedUs = 0;
+};
+
+// 最近 kWindow 筆的滾動視窗；bucket 在讀取時才計算。
+class MeasurementLatencyHistogram {
+public:
+  static constexpr size_t kWindow = 32;
+  static constexpr size_t kBucketCount = 7;
+
+  // 上界（含），單位微秒；最後一格收納其餘。
+  static uint32_t bucketUpperBoundUs(size_t bucket) {
+    static constexpr uint32_t kBounds[kBucketCount - 1] = {
+      1000U, 10000U, 100000U, 1000000U, 3000000U, 10000000U
+    };
+    return bucket < kBucketCount - 1 ? kBounds[bucket] : UINT32_MAX;
+  }
+
+  static const char* bucketLabel(size_t bucket) {
+    static const char* const kLabels[kBucketCount] = {
+      "1ms", "10ms", "100ms", "1s", "3s", "10s", "inf"
+    };
+    return bucket < kBucketCount ? kLabels[bucket] : "inf";
+  }
+
+  void add(uint32_t elapsedUs) {
+    _samples[_next] = elapsedUs;
+    _next = (_next + 1) % kWindow;
+    if (_count < kWindow) _count++;
+    _last = elapsedUs;
+  }
+
+  size_t sampleCount() const { return _count; }
+  uint32_t lastUs() const { return _last; }
+
+  uint32_t maxUs() const {
+    uint32_t result = 0;
+    for (size_t i = 0; i < _count; ++i) {
+      if (_samples[i] > result) result = _samples[i];
+    }
+    return result;
+  }
+
+  void bucketCounts(uint16_t (&counts)[kBucketCount]) const {
+    for (size_t bucket = 0; bucket < kBucketCount; ++bucket) counts[bucket] = 0;
+    for (size_t i = 0; i < _count; ++i) {
+      size_t bucket = 0;
+      while (bucket < kBucketCount - 1 &&
+             _samples[i] > bucketUpperBoundUs(bucket)) {
+        bucket++;
+      }
+      counts[bucket]++;
+    }
+  }
+
+private:
+  uint32_t _samples[kWindow] = {};
+  size_t _next = 0;
+  size_t _count = 0;
+  uint32_t _last = 0;
+};
+
+class MeasurementLatencyTracker {
+public:
+  static constexpr size_t kStageCount =
+    static_cast<size_t>(MeasurementLatencyStage::COUNT);
+
+  // main loop：BP_RecordManager 寫入成功後呼叫。
+  void recordDurable(const MeasurementLatencyTrace& trace, uint64_t revision,
+                     uint32_t nowUs, uint32_t nowMs) {
+    if (trace.hasRxAccepted) {
+      add(MeasurementLatencyStage::USB_TO_FRAME,
+          trace.frameCompleteUs - trace.rxAcceptedUs);
+    }
+    add(MeasurementLatencyStage::FRAME_TO_PARSED,
+        trace.parsedUs - trace.frameCompleteUs);
+    add(MeasurementLatencyStage::PARSED_TO_DURABLE, nowUs - trace.parsedUs);
+    // 尚未送出的前一筆被新記錄取代時不計入，送出階段只量最新一筆。
+    _awaitingRevision = revision;
+    _durableMs = nowMs;
+    _awaitingServe = true;
+  }
+
+  // main loop：/ 或 /api/latest 送出 snapshot 時呼叫；每個 revision 只記第一次。
+  // 送出階段可能跨越 micros() 回繞，改以 millis() 計算並飽和。
+  void noteServed(uint64_t servedRevision, uint32_t nowMs) {
+    if (!_awaitingServe || servedRevision < _awaitingRevision) return;
+    _awaitingServe = false;
+    const uint32_t elapsedMs = nowMs - _durableMs;
+    add(MeasurementLatencyStage::DURABLE_TO_SERVED,
+        elapsedMs > UINT32_MAX / 1000U ? UINT32_MAX : elapsedMs * 1000U);
+  }
+
+  const MeasurementLatencyHistogram& histogram(
+      MeasurementLatencyStage stage) const {
+    const size_t index = static_cast<size_t>(stage);
+    return _stages[index < kStageCount ? index : 0];
+  }
+
+private:
+  MeasurementLatencyHistogram _stages[kStageCount];
+  uint64_t _awaitingRevision = 0;
+  uint32_t _durableMs = 0;
+  bool _awaitingServe = false;
+
+  void add(MeasurementLatencyStage stage, uint32_t elapsedUs) {
+    _stages[static_cast<size_t>(stage)].add(elapsedUs);
+  }
+};
+
+#endif
@@ -86,6 +86,22 @@ inline bool formatOpaqueSequence(uint64_t value, char* output,
   return true;
 }
 
+// Inverse of formatOpaqueSequence for cursors echoed back by API readers.
+// Only the canonical decimal form is accepted: no sign, no leading zero.
+inline bool parseOpaqueSequence(const char* text, uint64_t& value) {
+  if (text == nullptr || *text == '\0') return false;
+  if (text[0] == '0' && text[1] != '\0') return false;
+  uint64_t parsed = 0;
+  for (size_t i = 0; text[i] != '\0'; ++i) {
+    if (text[i] < '0' || text[i] > '9') return false;
+    const uint64_t digit = static_cast<uint64_t>(text[i] - '0');
+    if (parsed > (UINT64_MAX - digit) / 10U) return false;
+    parsed = parsed * 10U + digit;
+  }
+  value = parsed;
+  return true;
+}
+
 inline bool validMeasurementPolicyName(const char* name) {
   if (name == nullptr) return false;
   size_t length = 0;
@@ -385,15 +401,18 @@ private:
   }
 };
 
-inline bool validMeasurementForReview(const BPData& value) {
+// BPData 與 snapshot 的 POD 記錄欄位同名，兩者都可直接分類，免轉成 String 版本。
+template <typename Measurement>
+inline bool validMeasurementForReview(const Measurement& value) {
   return value.valid &&
          value.systolic >= 60 && value.systolic <= 260 &&
          value.diastolic >= 30 && value.diastolic <= 215 &&
          value.pulse >= 40 && value.pulse <= 180;
 }
 
+template <typename Measurement>
 inline MeasurementReviewState classifyMeasurement(
-    const BPData& value,
+    const Measurement& value,
     const MeasurementPolicyConfig& policy) {
   if (!validMeasurementPolicy(policy) ||
       !validMeasurementForReview(value)) {
@@ -0,0 +1,183 @@
+#ifndef MEASUREMENT_SNAPSHOT_H
+#define MEASUREMENT_SNAPSHOT_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "BPProtocol.h"
+#include "BPRecordManager.h"
+#include "MeasurementPolicy.h"
+#include "ReceiveDiagnostic.h"
+#include "SeqlockSnapshot.h"
+#include "transports/MonitorTransport.h"
+
+// 最新一筆量測的 POD 副本；BPData 的 String timestamp 改為固定長度字元陣列。
+struct MeasurementSnapshotRecord {
+  uint64_t recordSequence = 0;
+  uint64_t sessionSequence = 0;
+  char timestamp[ReceiveDiagnostic::kTimestampCapacity] = {};
+  BPTimestampSource timestampSource = BPTimestampSource::UNSYNCED;
+  BPMeasurementQuality quality = BPMeasurementQuality::CLEAN;
+  bool valid = false;
+  int16_t systolic = -1;
+  int16_t diastolic = -1;
+  int16_t pulse = -1;
+  int16_t movementCount = 0;
+  uint8_t deviceSlot = 0;
+
+  // Reader-side conversion for helpers that take BPData (review policy).
+  BPData toBPData() const {
+    BPData record;
+    record.recordSequence = recordSequence;
+    record.sessionSequence = sessionSequence;
+    record.timestamp = timestamp;
+    record.timestampSource = timestampSource;
+    record.systolic = systolic;
+    record.diastolic = diastolic;
+    record.pulse = pulse;
+    record.movementCount = movementCount;
+    record.quality = quality;
+    record.valid = valid;
+    record.deviceSlot = deviceSlot;
+    return record;
+  }
+};
+
+// 網頁讀取的量測狀態：最新記錄、revision、freshness 輸入與 transport 診斷。
+// 由 main loop 在每次套用 ingest 結果或清除歷史後發布；讀取端不碰
+// BP_RecordManager 的即時狀態。
+struct MeasurementSnapshot {
+  uint64_t revision = 0;
+  int32_t recordCount = 0;
+  bool receivedThisBoot = false;
+  bool hasSuccessfulReceive = false;
+  uint64_t lastSuccessfulReceiveMs = 0;
+  MeasurementSnapshotRecord latest;
+  MonitorTransportSummary transport;
+  ReceiveDiagnostic diagnostic;
+
+  bool hasRecord() const { return recordCount > 0; }
+
+  bool lastSuccessfulReceiveAgeMs(uint64_t nowMs, uint64_t& ageMs) const {
+    if (!hasSuccessfulReceive || nowMs < lastSuccessfulReceiveMs) return false;
+    ageMs = nowMs - lastSuccessfulReceiveMs;
+    return true;
+  }
+
+  MeasurementFreshnessInput freshnessInput(uint64_t nowMs,
+                                           uint32_t staleAfterMs) const {
+    MeasurementFreshnessInput input;
+    input.hasRecord = hasRecord();
+    input.valid = hasRecord() && latest.valid;
+    input.receivedThisBoot = receivedThisBoot;
+    input.transportConnected = transport.connected();
+    input.nowMs = nowMs;
+    input.staleAfterMs = staleAfterMs;
+    if (hasSuccessfulReceive) input.lastSuccessfulReceiveMs = lastSuccessfulReceiveMs;
+    return input;
+  }
+};
+
+using MeasurementSnapshotPublisher = SeqlockSnapshot<MeasurementSnapshot>;
+
+inline MeasurementSnapshot captureMeasurementSnapshot(
+    const BP_RecordManager& records, const ReceiveDiagnostic& diagnostic,
+    const MonitorTransportSummary& transport) {
+  MeasurementSnapshot snapshot;
+  snapshot.revision = records.getRevision();
+  snapshot.recordCount = records.getRecordCount();
+  snapshot.receivedThisBoot = records.latestReceivedThisBoot();
+  snapshot.hasSuccessfulReceive =
+    records.lastSuccessfulReceiveMs(snapshot.lastSuccessfulReceiveMs);
+  if (snapshot.recordCount > 0) {
+    const BPData& latest = records.getLatestRecord();
+    MeasurementSnapshotRecord& target = snapshot.latest;
+    target.recordSequence = latest.recordSequence;
+    target.sessionSequence = latest.sessionSequence;
+    const size_t length = latest.timestamp.length();
+    if (length < sizeof(target.timestamp)) {
+      memcpy(target.timestamp, latest.timestamp.c_str(), length);
+      target.timestamp[length] = '\0';
+    }
+    target.timestampSource = latest.timestampSource;
+    target.quality = latest.quality;
+    target.valid = latest.valid;
+    target.systolic = static_cast<int16_t>(latest.systolic);
+    target.diastolic = static_cast<int16_t>(latest.diastolic);
+    target.pulse = static_cast<int16_t>(latest.pulse);
+    target.movementCount = static_cast<int16_t>(latest.movementCount);
+    target.deviceSlot = latest.deviceSlot;
+  }
+  snapshot.transport = transport;
+  snapshot.diagnostic = diagnostic;
+  return snapshot;
+}
+
+// JSON API 的 weak ETag 組成。各欄位任一改變即換 tag；開機 nonce 讓重開機後
+// revision 與 transport 版本重新起算時不會和舊 tag 撞號。與請求時間相關的
+// age 欄位不在其中，輪詢端收到 304 時自行以本地時鐘推進。
+struct MeasurementEtagParts {
+  uint32_t bootNonce = 0;
+  uint64_t revision = 0;
+  int32_t recordCount = 0;
+  uint32_t policyVersion = 0;
+  uint32_t transportVersion = 0;
+  uint32_t diagnosticStamp = 0;
+  uint8_t freshness = 0;
+  uint8_t role = 0;
+};
+
+static constexpr size_t kMeasurementEtagCapacity = 80;
+
+inline void formatMeasurementEtag(char (&out)[kMeasurementEtagCapacity],
+                                  const MeasurementEtagParts& parts) {
+  snprintf(out, sizeof(out), "W/\"%08lx-%llx-%lx-%lx-%lx-%lx-%x%x\"",
+           static_cast<unsigned long>(parts.bootNonce),
+           static_cast<unsigned long long>(parts.revision),
+           static_cast<unsigned long>(static_cast<uint32_t>(parts.recordCount)),
+           static_cast<unsigned long>(parts.policyVersion),
+           static_cast<unsigned long>(parts.transportVersion),
+           static_cast<unsigned long>(parts.diagnosticStamp),
+           static_cast<unsigned>(parts.freshness & 0x0fU),
+           static_cast<unsigned>(parts.role & 0x0fU));
+}
+
+// /api/events 推送的事件種類：比較上次推送與目前的 tag 組成。記錄或政策變動
+// 優先於通道狀態；其餘（診斷、新鮮度）歸為 diagnostic。
+enum class MeasurementEventKind : uint8_t {
+  NONE,
+  MEASUREMENT,
+  TRANSPORT,
+  DIAGNOSTIC,
+};
+
+inline MeasurementEventKind classifyMeasurementEvent(
+    const MeasurementEtagParts& sent, const MeasurementEtagParts& current) {
+  if (sent.revision != current.revision ||
+      sent.recordCount != current.recordCount ||
+      sent.policyVersion != current.policyVersion) {
+    return MeasurementEventKind::MEASUREMENT;
+  }
+  if (sent.transportVersion != current.transportVersion) {
+    return MeasurementEventKind::TRANSPORT;
+  }
+  if (sent.diagnosticStamp != current.diagnosticStamp ||
+      sent.freshness != current.freshness) {
+    return MeasurementEventKind::DIAGNOSTIC;
+  }
+  return MeasurementEventKind::NONE;
+}
+
+inline const char* measurementEventName(MeasurementEventKind kind) {
+  switch (kind) {
+    case MeasurementEventKind::MEASUREMENT: return "measurement";
+    case MeasurementEventKind::TRANSPORT: return "transport";
+    case MeasurementEventKind::DIAGNOSTIC: return "diagnostic";
+    case MeasurementEventKind::NONE: break;
+  }
+  return "";
+}
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef RECEIVE_DIAGNOSTIC_H
+#define RECEIVE_DIAGNOSTIC_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "BPProtocol.h"
+
+// 接收診斷只保存 allowlisted 狀態碼、操作指引編號與已驗證的數值。
+// ingest 路徑只寫這個固定大小 POD，不配置 heap；HTML/JSON 只在網頁要求時才產生。
+enum class ReceiveDiagnosticStatus : uint8_t {
+  WAITING = 0,
+  VALID,
+  STORAGE_ERROR,
+  INVALID_TIMESTAMP,
+  DEVICE_ERROR,
+  OUT_OF_RANGE,
+  UNSUPPORTED_FORMAT,
+  UNSUPPORTED_MODEL,
+  OVERFLOW,
+  DISCONTINUITY,
+  MALFORMED,
+};
+
+enum class ReceiveDiagnosticAction : uint8_t {
+  NONE = 0,
+  MEASUREMENT_ACCEPTED,
+  STORAGE_UNCONFIRMED,
+  HISTORY_LOAD_FAILED,
+  CORRECT_DEVICE_TIME,
+  HANDLE_DEVICE_ERROR,
+  CHECK_MEASUREMENT_PROCESS,
+  SELECT_FORMAT_5,
+  SELECT_VERIFIED_MODEL,
+  CHECK_FORMAT_AND_LINK,
+  FRAME_OVERFLOW,
+  LINK_DISCONTINUITY,
+};
+
+struct ReceiveDiagnostic {
+  // BPData 的設備時間固定為 "YYYY-MM-DD HH:MM:SS"。
+  static constexpr size_t kTimestampCapacity = 20;
+
+  ReceiveDiagnosticStatus status = ReceiveDiagnosticStatus::WAITING;
+  ReceiveDiagnosticAction action = ReceiveDiagnosticAction::NONE;
+  bool hasVitals = false;
+  int16_t systolic = 0;
+  int16_t diastolic = 0;
+  int16_t pulse = 0;
+  char deviceTimestamp[kTimestampCapacity] = {};
+  // millis() at the time the diagnostic was recorded; 0 while WAITING.
+  uint32_t recordedAtMs = 0;
+
+  bool isWaiting() const { return status == ReceiveDiagnosticStatus::WAITING; }
+
+  void clear() { *this = ReceiveDiagnostic(); }
+
+  void set(ReceiveDiagnosticStatus nextStatus,
+           ReceiveDiagnosticAction nextAction, uint32_t nowMs) {
+    clear();
+    status = nextStatus;
+    action = nextAction;
+    recordedAtMs = nowMs;
+  }
+
+  // Only a persisted, valid measurement may attach vitals. A timestamp that
+  // does not fit is dropped instead of truncated.
+  void attachVitals(const BPData& measurement) {
+    if (!measurement.valid) return;
+    hasVitals = true;
+    systolic = static_cast<int16_t>(measurement.systolic);
+    diastolic = static_cast<int16_t>(measurement.diastolic);
+    pulse = static_cast<int16_t>(measurement.pulse);
+    const size_t length = measurement.timestamp.length();
+    if (length < sizeof(deviceTimestamp)) {
+      memcpy(deviceTimestamp, measurement.timestamp.c_str(), length);
+      deviceTimestamp[length] = '\0';
+    }
+  }
+};
+
+inline const char* receiveDiagnosticStatusCode(ReceiveDiagnosticStatus status) {
+  switch (status) {
+    case ReceiveDiagnosticStatus::WAITING:            return "waiting";
+    case ReceiveDiagnosticStatus::VALID:              return "valid";
+    case ReceiveDiagnosticStatus::STORAGE_ERROR:      return "storage_error";
+    case ReceiveDiagnosticStatus::INVALID_TIMESTAMP:  return "invalid_timestamp";
+    case ReceiveDiagnosticStatus::DEVICE_ERROR:       return "device_error";
+    case ReceiveDiagnosticStatus::OUT_OF_RANGE:       return "out_of_range";
+    case ReceiveDiagnosticStatus::UNSUPPORTED_FORMAT: return "unsupported_format";
+    case ReceiveDiagnosticStatus::UNSUPPORTED_MODEL:  return "unsupported_model";
+    case ReceiveDiagnosticStatus::OVERFLOW:           return "overflow";
+    case ReceiveDiagnosticStatus::DISCONTINUITY:      return "discontinuity";
+    case ReceiveDiagnosticStatus::MALFORMED:          return "malformed";
+    default:                                          return "unavailable";
+  }
+}
+
+inline ReceiveDiagnosticStatus receiveDiagnosticStatusFor(BPParseError error) {
+  switch (error) {
+    case BPParseError::NONE:               return ReceiveDiagnosticStatus::VALID;
+    case BPParseError::INVALID_TIMESTAMP:  return ReceiveDiagnosticStatus::INVALID_TIMESTAMP;
+    case BPParseError::DEVICE_ERROR:       return ReceiveDiagnosticStatus::DEVICE_ERROR;
+    case BPParseError::OUT_OF_RANGE:       return ReceiveDiagnosticStatus::OUT_OF_RANGE;
+    case BPParseError::UNSUPPORTED_FORMAT: return ReceiveDiagnosticStatus::UNSUPPORTED_FORMAT;
+    case BPParseError::UNSUPPORTED_MODEL:  return ReceiveDiagnosticStatus::UNSUPPORTED_MODEL;
+    default:                               return ReceiveDiagnosticStatus::MALFORMED;
+  }
+}
+
+inline ReceiveDiagnosticAction receiveDiagnosticActionFor(BPParseError error) {
+  switch (error) {
+    case BPParseError::INVALID_TIMESTAMP:
+      return ReceiveDiagnosticAction::CORRECT_DEVICE_TIME;
+    case BPParseError::DEVICE_ERROR:
+      return ReceiveDiagnosticAction::HANDLE_DEVICE_ERROR;
+    case BPParseError::OUT_OF_RANGE:
+      return ReceiveDiagnosticAction::CHECK_MEASUREMENT_PROCESS;
+    case BPParseError::UNSUPPORTED_FORMAT:
+      return ReceiveDiagnosticAction::SELECT_FORMAT_5;
+    case BPParseError::UNSUPPORTED_MODEL:
+      return ReceiveDiagnosticAction::SELECT_VERIFIED_MODEL;
+    default:
+      return ReceiveDiagnosticAction::CHECK_FORMAT_AND_LINK;
+  }
+}
+
+inline const char* receiveDiagnosticActionText(ReceiveDiagnosticAction action) {
+  switch (action) {
+    case ReceiveDiagnosticAction::MEASUREMENT_ACCEPTED:
+      return "量測已接收；如需複測請依診所流程進行。";
+    case ReceiveDiagnosticAction::STORAGE_UNCONFIRMED:
+      return "儲存系統未能確認本次量測；請先查看歷史記錄確認是否已保存，再依診所流程重新量測。";
+    case ReceiveDiagnosticAction::HISTORY_LOAD_FAILED:
+      return "歷史記錄載入未完成；請勿將目前列表視為完整記錄。"
+             "請聯絡管理人員檢查儲存空間，修復後重新啟動裝置。";
+    case ReceiveDiagnosticAction::CORRECT_DEVICE_TIME:
+      return "請校正血壓計日期與時間後重新量測。";
+    case ReceiveDiagnosticAction::HANDLE_DEVICE_ERROR:
+      return "請依血壓計錯誤碼處理後重新量測。";
+    case ReceiveDiagnosticAction::CHECK_MEASUREMENT_PROCESS:
+      return "請確認量測流程與設備狀態後重新量測。";
+    case ReceiveDiagnosticAction::SELECT_FORMAT_5:
+      return "請將 HBP-9030 USB 輸出設定為格式 5。";
+    case ReceiveDiagnosticAction::SELECT_VERIFIED_MODEL:
+      return "請選用已驗證的 HBP-9030 設定。";
+    case ReceiveDiagnosticAction::FRAME_OVERFLOW:
+      return "資料過長已丟棄；請確認輸出格式後重新量測。";
+    case ReceiveDiagnosticAction::LINK_DISCONTINUITY:
+      return "資料傳輸中斷；請確認連線後重新量測。";
+    case ReceiveDiagnosticAction::CHECK_FORMAT_AND_LINK:
+      return "請確認 USB 輸出格式與連線後重新量測。";
+    default:
+      return "";
+  }
+}
+
+// 去識別化 HTML 片段；WAITING 時回空字串，讓呼叫端決定等待文案。
+// 所有輸出都來自上面的固定表或數值，不含任何輸入位元組。
+// Out 可為 String 或直接寫入回應視窗的 bp_html::BoundedHtmlWriter。
+template <typename Out>
+inline void appendReceiveDiagnosticHtml(Out& out,
+                                        const ReceiveDiagnostic& diagnostic) {
+  if (diagnostic.isWaiting()) return;
+  const char* status = receiveDiagnosticStatusCode(diagnostic.status);
+  out += "<div class='diagnostic-data' data-status='";
+  out += status;
+  out += "'><h3>";
+  out += diagnostic.action == ReceiveDiagnosticAction::HISTORY_LOAD_FAILED
+    ? "儲存診斷" : "接收診斷";
+  out += "</h3><p><strong>狀態：</strong>";
+  out += status;
+  out += "</p>";
+  if (diagnostic.hasVitals) {
+    out += "<p><strong>量測：</strong>SYS ";
+    out += diagnostic.systolic;
+    out += " / DIA ";
+    out += diagnostic.diastolic;
+    out += " / PULSE ";
+    out += diagnostic.pulse;
+    out += "</p>";
+    if (diagnostic.deviceTimestamp[0] != '\0') {
+      out += "<p><strong>設備時間：</strong>";
+      out += diagnostic.deviceTimestamp;
+      out += "</p>";
+    }
+  }
+  out += "<p class='helper-text'>";
+  out += receiveDiagnosticActionText(diagnostic.action);
+  out += "</p></div>";
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef RENDERED_PAGE_CACHE_H
+#define RENDERED_PAGE_CACHE_H
+
+#include "WebAccessPolicy.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace bp_web {
+
+// What a cached body was rendered from. Equal keys mean byte-identical
+// pages: the record manager's contentVersion() moves on every add, ring
+// overwrite, clear and reload, and the policy version on every update.
+struct RenderedPageKey {
+  uint64_t contentVersion = 0;
+  uint32_t policyVersion = 0;
+
+  bool operator==(const RenderedPageKey& other) const {
+    return contentVersion == other.contentVersion &&
+           policyVersion == other.policyVersion;
+  }
+};
+
+// The last rendered body of each cacheable page, one fixed buffer per
+// (route, role) so staff never receive the admin variant. A page larger than
+// Capacity is not stored and keeps rendering every time.
+//
+// Only routes accepted by renderedPageCacheable() may be cached: they carry
+// de-identified measurements and never credentials. A stale entry is wiped
+// the first time a lookup sees a newer key, and invalidate() wipes all of
+// them, so cleared or overwritten records do not linger here.
+template <size_t Routes, size_t Capacity>
+class RenderedPageCache {
+public:
+  static constexpr size_t kCapacity = Capacity;
+
+  RenderedPageCache() = default;
+  RenderedPageCache(const RenderedPageCache&) = delete;
+  RenderedPageCache& operator=(const RenderedPageCache&) = delete;
+
+  // Body rendered for `key`, or nullptr.
+  const char* find(size_t route, AccessRole role, const RenderedPageKey& key,
+                   size_t& length) {
+    length = 0;
+    Entry* slot = entry(route, role);
+    if (slot == nullptr || !slot->valid) return nullptr;
+    if (!(slot->key == key)) {
+      wipe(*slot);
+      return nullptr;
+    }
+    length = slot->length;
+    return slot->body;
+  }
+
+  // Replaces the entry; false when the body does not fit or the role has no
+  // entry. The caller must have rendered `body` from exactly `key`.
+  bool store(size_t route, AccessRole role, const RenderedPageKey& key,
+             const char* body, size_t length) {
+    Entry* slot = entry(route, role);
+    if (slot == nullptr) return false;
+    if (body == nullptr || length > Capacity) {
+      wipe(*slot);
+      return false;
+    }
+    memcpy(slot->body, body, length);
+    if (length < slot->length) {
+      volatile char* tail = slot->body + length;
+      for (size_t i = length; i < slot->length; ++i) *tail++ = 0;
+    }
+    slot->length = length;
+    slot->key = key;
+    slot->valid = true;
+    return true;
+  }
+
+  void invalidate() {
+    for (Entry& slot : _entries) wipe(slot);
+  }
+
+private:
+  // Only signed-in roles render these pages; NONE never gets an entry.
+  static constexpr size_t kRoles = 2;
+
+  struct Entry {
+    bool valid = false;
+    RenderedPageKey key;
+    size_t length = 0;
+    char body[Capacity];
+  };
+  Entry _entries[Routes * kRoles];
+
+  Entry* entry(size_t route, AccessRole role) {
+    if (route >= Routes) return nullptr;
+    size_t index;
+    switch (role) {
+      case AccessRole::STAFF: index = 0; break;
+      case AccessRole::ADMIN: index = 1; break;
+      default: return nullptr;
+    }
+    return &_entries[route * kRoles + index];
+  }
+
+  static void wipe(Entry& slot) {
+    volatile char* bytes = slot.body;
+    for (size_t i = 0; i < slot.length; ++i) *bytes++ = 0;
+    slot.length = 0;
+    slot.key = RenderedPageKey();
+    slot.valid = false;
+  }
+};
+
+}  // namespace bp_web
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef SEQLOCK_SNAPSHOT_H
+#define SEQLOCK_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+// Double-buffered sequence lock for one writer task and any number of reader
+// tasks. publish() never waits: it fills the slot readers are not directed
+// to, then flips the published index. A reader retries only when the writer
+// publishes twice during one copy, so readers cannot stall ingest and cannot
+// return a torn value.
+//
+// The payload is stored as atomic words so the protocol is free of data races
+// under the C++ memory model. Word stores are release and word loads acquire
+// instead of using standalone fences: a reader that observes any word of a
+// newer publication also observes the odd sequence that preceded it, and
+// GCC's ThreadSanitizer does not model atomic_thread_fence.
+template <typename T>
+class SeqlockSnapshot {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "seqlock payload must be trivially copyable");
+
+public:
+  SeqlockSnapshot() {
+    const T initial{};
+    storeWords(_slots[0], initial, std::memory_order_relaxed);
+    storeWords(_slots[1], initial, std::memory_order_relaxed);
+  }
+
+  SeqlockSnapshot(const SeqlockSnapshot&) = delete;
+  SeqlockSnapshot& operator=(const SeqlockSnapshot&) = delete;
+
+  // Writer task only.
+  void publish(const T& value) {
+    const uint32_t next = _published.load(std::memory_order_relaxed) + 1U;
+    Slot& slot = _slots[next & 1U];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1U, std::memory_order_relaxed);
+    storeWords(slot, value, std::memory_order_release);
+    slot.sequence.store(sequence + 2U, std::memory_order_release);
+    _published.store(next, std::memory_order_release);
+  }
+
+  // Any task. Lock-free: retries only while the writer is mid-publication.
+  T read() const {
+    for (;;) {
+      const uint32_t published = _published.load(std::memory_order_acquire);
+      const Slot& slot = _slots[published & 1U];
+      const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+      if ((before & 1U) != 0) continue;
+      uint32_t words[kWords];
+      for (size_t i = 0; i < kWords; ++i) {
+        words[i] = slot.words[i].load(std::memory_order_acquire);
+      }
+      if (slot.sequence.load(std::memory_order_relaxed) != before) continue;
+      T value;
+      memcpy(&value, words, sizeof(T));
+      return value;
+    }
+  }
+
+  // Number of completed publications; lets readers skip unchanged snapshots.
+  uint32_t publication() const {
+    return _published.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) /
+                                   sizeof(uint32_t);
+
+  struct Slot {
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<uint32_t> words[kWords];
+  };
+
+  static void storeWords(Slot& slot, const T& value, std::memory_order order) {
+    uint32_t words[kWords] = {};
+    memcpy(words, &value, sizeof(T));
+    for (size_t i = 0; i < kWords; ++i) slot.words[i].store(words[i], order);
+  }
+
+  Slot _slots[2];
+  std::atomic<uint32_t> _published{0};
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <utility>
+
+// Bounded lock-free single-producer/single-consumer queue. Exactly one task
+// may call push()/freeSlots() and exactly one other task may call pop().
+// A slot is owned by the producer until the release store of _head publishes
+// it, and by the consumer until the release store of _tail returns it, so
+// moved-in values (including heap-owning Strings) never race.
+template <typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscQueue capacity must be a power of two");
+
+public:
+  bool push(T&& value) {
+    const uint32_t head = _head.load(std::memory_order_relaxed);
+    const uint32_t tail = _tail.load(std::memory_order_acquire);
+    if (head - tail >= Capacity) return false;
+    _slots[head & kMask] = std::move(value);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& value) {
+    const uint32_t tail = _tail.load(std::memory_order_relaxed);
+    const uint32_t head = _head.load(std::memory_order_acquire);
+    if (head == tail) return false;
+    value = std::move(_slots[tail & kMask]);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Producer-side lower bound: the consumer can only make more room.
+  size_t freeSlots() const {
+    const uint32_t head = _head.load(std::memory_order_relaxed);
+    const uint32_t tail = _tail.load(std::memory_order_acquire);
+    return Capacity - static_cast<size_t>(head - tail);
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  static constexpr uint32_t kMask = static_cast<uint32_t>(Capacity - 1);
+
+  T _slots[Capacity] = {};
+  std::atomic<uint32_t> _head{0};
+  std::atomic<uint32_t> _tail{0};
+};
+
+#endif
@@ -0,0 +1,151 @@
+// Generated by scripts/generate_static_assets.sh from web/style.css. Do not edit.
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace bp_web {
+
+inline constexpr char kStyleCssSourceSha256[] = "84b4cfc167946d70607aa6a172d11aef27cc004d314fba13d40f48497bf18189";
+inline constexpr char kStyleCssPath[] = "/static/style-84b4cfc167946d70.css";
+inline constexpr char kStyleCssEtag[] = "\"84b4cfc167946d70\"";
+inline constexpr uint8_t kStyleCssGzip[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x58, 0x5b, 0x8b, 0xe4, 0xc6,
+  0x15, 0x7e, 0x9f, 0x5f, 0x21, 0x68, 0xcc, 0x4c, 0x2f, 0x52, 0x8f, 0x2e, 0x7d, 0x51, 0x4b, 0x04,
+  0xb2, 0xe4, 0x29, 0x2f, 0x7e, 0xd9, 0xe4, 0xc9, 0x18, 0x53, 0x92, 0xaa, 0x5a, 0x95, 0x51, 0xab,
+  0x84, 0x54, 0x3d, 0xd3, 0x63, 0xd1, 0x10, 0x02, 0x21, 0x6b, 0x58, 0xe3, 0x84, 0x2c, 0xfb, 0xe2,
+  0x40, 0x42, 0x4c, 0xc0, 0x90, 0xb0, 0x49, 0x9e, 0x72, 0xf1, 0x66, 0xfd, 0x63, 0xb2, 0x3d, 0x13,
+  0x3f, 0xf9, 0x2f, 0xe4, 0x54, 0xe9, 0x7e, 0xe9, 0x9d, 0xb5, 0x17, 0x56, 0xd3, 0x2a, 0x95, 0x4e,
+  0x9d, 0xeb, 0x77, 0xbe, 0xa3, 0xcb, 0x47, 0xca, 0xf1, 0x97, 0x7f, 0xbf, 0x7f, 0xfe, 0xe5, 0xdd,
+  0x97, 0x5f, 0x1c, 0x5f, 0x7d, 0xf6, 0xdf, 0x9f, 0xff, 0x22, 0xf3, 0x53, 0x9a, 0xf0, 0xec, 0x72,
+  0x83, 0x63, 0x9c, 0x22, 0x8e, 0x3f, 0xca, 0x38, 0xe2, 0xd4, 0xff, 0x08, 0x65, 0x19, 0xe6, 0xd9,
+  0x2c, 0x0b, 0x95, 0xbb, 0x17, 0xaf, 0x8e, 0x5f, 0xfd, 0xfb, 0xfe, 0x3f, 0x2f, 0x8f, 0x9f, 0x7c,
+  0x7a, 0xfc, 0xe2, 0xb7, 0xf7, 0xff, 0x7c, 0x79, 0xf7, 0xf4, 0xd7, 0x4a, 0x44, 0xbd, 0xcb, 0x27,
+  0x72, 0xeb, 0xe3, 0x62, 0x67, 0xf8, 0xed, 0xab, 0x67, 0x67, 0x8a, 0xa2, 0xbc, 0xf9, 0xea, 0x4f,
+  0xca, 0x65, 0x21, 0xe4, 0x52, 0xb9, 0xff, 0xe4, 0xe9, 0xdd, 0xef, 0xfe, 0x72, 0x7c, 0xf6, 0xe2,
+  0x7f, 0xff, 0xf8, 0xeb, 0xf1, 0xf5, 0x6f, 0xde, 0xbc, 0xfe, 0xfc, 0xf8, 0xf5, 0x9f, 0x8f, 0x9f,
+  0xbd, 0xf8, 0xf6, 0xd5, 0xe7, 0x6f, 0xbe, 0x7e, 0x79, 0xf7, 0xfc, 0x5f, 0xc7, 0xd7, 0xcf, 0xbe,
+  0xf9, 0xc3, 0xd3, 0x6f, 0x7e, 0xf5, 0xe9, 0xdd, 0x8b, 0xbf, 0xdd, 0x3f, 0xff, 0xe3, 0xfd, 0xf3,
+  0xdf, 0x83, 0x4e, 0xca, 0xa3, 0xcb, 0x33, 0x27, 0x65, 0x8c, 0xe7, 0x20, 0x50, 0xd3, 0xbc, 0x8d,
+  0x33, 0xc1, 0x01, 0xb1, 0x88, 0xe7, 0xca, 0xfb, 0x6c, 0x97, 0x12, 0xe4, 0x63, 0x67, 0x42, 0xe4,
+  0xbf, 0xce, 0xa2, 0x66, 0xc2, 0xf2, 0x8a, 0xa0, 0x6a, 0x99, 0xe3, 0x3d, 0x77, 0x26, 0x86, 0x69,
+  0xce, 0x2d, 0xbf, 0x58, 0xd9, 0xee, 0x38, 0x0e, 0x9c, 0xc9, 0x52, 0x5f, 0xe9, 0x36, 0x2a, 0x96,
+  0x92, 0x94, 0x6e, 0x51, 0x7a, 0xeb, 0x4c, 0x74, 0xb2, 0x34, 0x09, 0xee, 0x2c, 0x6a, 0x34, 0xbe,
+  0xea, 0x9e, 0x54, 0x3d, 0xc8, 0x18, 0x01, 0xd1, 0x81, 0x8f, 0xed, 0x46, 0x07, 0xdf, 0xc7, 0x59,
+  0x06, 0xe7, 0x19, 0x36, 0x9a, 0x97, 0xe7, 0x05, 0x28, 0xde, 0xe0, 0x14, 0x36, 0xae, 0x2d, 0xdd,
+  0x5c, 0x14, 0x6b, 0x37, 0x28, 0x8d, 0x69, 0x0c, 0x66, 0x91, 0xc5, 0x1a, 0xeb, 0xa5, 0x59, 0x1e,
+  0x4b, 0x03, 0xb9, 0x71, 0x89, 0x4d, 0x62, 0x94, 0x12, 0x43, 0x14, 0xb0, 0x1b, 0x47, 0x57, 0x8c,
+  0x79, 0xb2, 0x57, 0x2c, 0x13, 0x2e, 0xe9, 0xc6, 0x43, 0x17, 0x86, 0xa1, 0x5a, 0x0b, 0x75, 0x35,
+  0x57, 0x67, 0x86, 0x3e, 0x75, 0xcf, 0x0e, 0x67, 0x8f, 0x72, 0x8f, 0xed, 0xb5, 0x8c, 0x7e, 0x2c,
+  0xc4, 0x16, 0x92, 0x40, 0xe0, 0xde, 0x3d, 0x9c, 0x79, 0x2c, 0xb8, 0xcd, 0x41, 0xe1, 0x0d, 0x8d,
+  0x1d, 0xdd, 0x25, 0x2c, 0xe6, 0x1a, 0x41, 0x5b, 0x1a, 0xdd, 0x3a, 0xe7, 0x8f, 0xaf, 0x71, 0x4c,
+  0x53, 0xe5, 0x7d, 0xf0, 0xd1, 0xb9, 0x7a, 0xfe, 0x04, 0x6f, 0x18, 0x56, 0x7e, 0xfa, 0x63, 0xf8,
+  0xf9, 0x3e, 0xe3, 0x4c, 0x79, 0x82, 0xe2, 0x4c, 0xf9, 0xc9, 0x8f, 0xce, 0xd5, 0xc7, 0x29, 0x45,
+  0x91, 0x9a, 0xc1, 0xad, 0x96, 0xe1, 0x94, 0x12, 0xd7, 0x43, 0xfe, 0xd5, 0x26, 0x65, 0xbb, 0x38,
+  0x70, 0x22, 0x1a, 0x63, 0x94, 0x6a, 0x9b, 0x14, 0x05, 0x14, 0xc7, 0xfc, 0xc2, 0xb0, 0xf5, 0x00,
+  0x6f, 0xd4, 0x09, 0x46, 0xc4, 0x20, 0x9e, 0xa2, 0xbf, 0xa7, 0x4e, 0x88, 0x4d, 0x3c, 0x42, 0x94,
+  0xf9, 0x02, 0x7e, 0x63, 0x4c, 0x16, 0xf0, 0xdb, 0xd0, 0xf5, 0xf7, 0xa6, 0xae, 0xcf, 0x22, 0x96,
+  0x3a, 0xd7, 0x28, 0xbd, 0x28, 0xe2, 0x34, 0x05, 0x6d, 0x67, 0x28, 0x49, 0xc0, 0x6a, 0x1c, 0x45,
+  0xa0, 0xf3, 0x5e, 0xbb, 0xa1, 0x01, 0x0f, 0x1d, 0xc3, 0x30, 0xf5, 0x64, 0xef, 0x56, 0x46, 0x28,
+  0x68, 0xc7, 0x99, 0x9b, 0xa0, 0x20, 0x10, 0xc6, 0x9a, 0xc2, 0x33, 0x86, 0x0d, 0x97, 0x39, 0x5c,
+  0x84, 0x88, 0x10, 0x23, 0x69, 0x3e, 0x4a, 0xf3, 0x80, 0x66, 0x49, 0x84, 0x6e, 0x1d, 0x12, 0xe1,
+  0xbd, 0xfb, 0xb3, 0x5d, 0xc6, 0x29, 0xb9, 0xd5, 0x7c, 0xf0, 0x01, 0xe8, 0xea, 0x64, 0x89, 0x48,
+  0x18, 0x0f, 0xf3, 0x1b, 0x8c, 0x63, 0x17, 0x45, 0x74, 0x13, 0x6b, 0x94, 0xe3, 0x6d, 0x26, 0xb7,
+  0x6b, 0x38, 0x0e, 0xdc, 0x0d, 0x4a, 0x1c, 0x63, 0x59, 0x9f, 0x0d, 0x2e, 0xe5, 0x9c, 0x6d, 0x1d,
+  0x11, 0x0d, 0x57, 0x6e, 0xba, 0x49, 0x61, 0x87, 0xb8, 0x88, 0x83, 0x13, 0xb4, 0xc1, 0x1a, 0xa7,
+  0x3c, 0xc2, 0x3d, 0x87, 0x43, 0x5c, 0xb0, 0x63, 0x09, 0x1b, 0x84, 0xbf, 0xb4, 0x10, 0xd3, 0x4d,
+  0xc8, 0x1d, 0x63, 0x66, 0xb8, 0x11, 0xe6, 0x1c, 0x74, 0x15, 0xaa, 0x08, 0x63, 0x66, 0x56, 0x61,
+  0x82, 0x1f, 0xd2, 0xa4, 0x56, 0x9e, 0xc6, 0xf2, 0x2d, 0x69, 0x43, 0x5b, 0x4b, 0x1f, 0x8c, 0xc0,
+  0xa9, 0xd4, 0x51, 0xa8, 0x58, 0x39, 0x64, 0x25, 0xfc, 0x01, 0x99, 0xe2, 0x96, 0x69, 0x20, 0x42,
+  0xb3, 0xcb, 0x9c, 0xf5, 0x7a, 0x2d, 0xd6, 0x9a, 0xd0, 0x15, 0x89, 0xb4, 0x50, 0xd7, 0xb6, 0x6a,
+  0x2e, 0x44, 0x26, 0x99, 0x55, 0x48, 0x26, 0xba, 0x37, 0x0f, 0x82, 0xb6, 0xee, 0x52, 0x9e, 0xbc,
+  0xbd, 0x29, 0x74, 0x5f, 0xe9, 0xba, 0x2b, 0x62, 0xa6, 0xf1, 0x14, 0xf2, 0x82, 0xb0, 0x74, 0xeb,
+  0xec, 0x92, 0x04, 0xa7, 0x3e, 0xca, 0xf0, 0xc0, 0x28, 0xdd, 0xc6, 0x5b, 0xb0, 0xea, 0x6c, 0xc6,
+  0x59, 0xa2, 0xc5, 0xe8, 0xba, 0x1b, 0x16, 0xe9, 0x63, 0x7d, 0xe8, 0xd0, 0x9e, 0xcb, 0xcb, 0xe0,
+  0x96, 0x22, 0x34, 0x70, 0xc9, 0x55, 0x5e, 0x99, 0x2c, 0x5e, 0x97, 0x25, 0xd2, 0xb3, 0x59, 0xaa,
+  0x2d, 0xd5, 0x0c, 0xb0, 0xcf, 0x00, 0xde, 0x28, 0x8b, 0x9d, 0x98, 0xc5, 0xb8, 0x32, 0xd4, 0x20,
+  0xd6, 0x62, 0x61, 0x0f, 0xbc, 0x62, 0x2e, 0x16, 0x6a, 0xf5, 0x7f, 0xb6, 0xb4, 0xa7, 0xa5, 0x58,
+  0xc7, 0x80, 0x63, 0x32, 0x16, 0xd1, 0x40, 0x29, 0xb2, 0xb6, 0x58, 0x9e, 0x0e, 0x3c, 0xd3, 0x72,
+  0xdc, 0x7c, 0xa8, 0xf6, 0x0c, 0xf9, 0x9c, 0x5e, 0xe3, 0xbc, 0x75, 0x6a, 0x21, 0xae, 0x44, 0x96,
+  0x6e, 0x65, 0xb4, 0x70, 0xa8, 0xd2, 0x43, 0x1b, 0x79, 0x2e, 0x9e, 0xed, 0x1b, 0xbc, 0xb0, 0xab,
+  0xa2, 0xe8, 0x47, 0xd9, 0xb4, 0x45, 0x99, 0x21, 0x87, 0x30, 0x7f, 0x97, 0x69, 0xd7, 0x34, 0xa3,
+  0x5e, 0x84, 0x55, 0x6f, 0x07, 0x4e, 0x8e, 0x7b, 0x8b, 0x34, 0x4e, 0x76, 0xbc, 0xb7, 0x96, 0xe1,
+  0x08, 0xfb, 0x83, 0xc5, 0xdd, 0x56, 0xe2, 0x67, 0x67, 0x35, 0x67, 0x3b, 0x2e, 0xf2, 0xd6, 0xb1,
+  0x6a, 0xa7, 0x01, 0x2e, 0x1a, 0xb6, 0xb9, 0x72, 0xcb, 0x27, 0x1a, 0x23, 0x04, 0x5a, 0x87, 0x53,
+  0xe4, 0xbc, 0x28, 0x9f, 0x18, 0x47, 0x43, 0xaf, 0x94, 0xc8, 0xfe, 0x60, 0x10, 0x7a, 0xa1, 0xb7,
+  0x5b, 0x25, 0x21, 0x3d, 0xd1, 0xc2, 0x90, 0x3a, 0xa9, 0x96, 0x32, 0x65, 0x6a, 0xbf, 0x95, 0x07,
+  0xca, 0x9b, 0x69, 0x51, 0xd1, 0xa0, 0x92, 0x12, 0x9a, 0x75, 0x3d, 0x2b, 0x00, 0xc5, 0x7a, 0x55,
+  0x0b, 0x32, 0xc2, 0xa6, 0x59, 0x44, 0xb8, 0xdc, 0x6a, 0xb5, 0xb7, 0xda, 0x9d, 0x9d, 0x55, 0x0a,
+  0x67, 0xe0, 0x41, 0x48, 0x44, 0x4d, 0xe0, 0x54, 0xb7, 0x14, 0x06, 0x18, 0x04, 0x7d, 0x34, 0xe5,
+  0x0f, 0x00, 0x97, 0xac, 0x1f, 0xf3, 0xc1, 0xfa, 0x31, 0x2b, 0x70, 0x8c, 0xa0, 0x4c, 0x25, 0xde,
+  0xe6, 0xed, 0x34, 0x92, 0x6d, 0x71, 0xea, 0xf6, 0xed, 0xec, 0xe2, 0xd5, 0x72, 0x24, 0xb3, 0x23,
+  0x94, 0x71, 0x6d, 0x97, 0x04, 0xc0, 0x1d, 0x82, 0xfc, 0x01, 0xc4, 0x28, 0xab, 0x0e, 0x6a, 0x6e,
+  0x65, 0xfb, 0xee, 0xa9, 0xfc, 0x97, 0x9d, 0x75, 0x5a, 0x07, 0x6f, 0x29, 0x52, 0x59, 0x3f, 0x81,
+  0x67, 0x22, 0x6f, 0x3c, 0x1e, 0xbf, 0x2b, 0x56, 0xf6, 0x3d, 0x79, 0x02, 0x42, 0xdf, 0x8a, 0x27,
+  0xdf, 0xa3, 0x6c, 0x47, 0x21, 0xa8, 0x4c, 0xe7, 0x02, 0x8e, 0x76, 0x69, 0x06, 0xaf, 0x26, 0x8c,
+  0x4a, 0x7d, 0x7a, 0x5e, 0xee, 0xbb, 0xf1, 0x20, 0x6d, 0x76, 0x42, 0x76, 0x8d, 0xd3, 0x9c, 0x09,
+  0x94, 0xe5, 0xb7, 0xce, 0x6c, 0x3d, 0x2f, 0x1f, 0x40, 0x97, 0x06, 0xfb, 0x02, 0x38, 0xbd, 0x5d,
+  0x4c, 0x00, 0xea, 0xc0, 0x8b, 0xbc, 0x6a, 0xcf, 0x26, 0x64, 0x19, 0x3f, 0x59, 0x6c, 0x5a, 0xd3,
+  0x0b, 0x2a, 0x88, 0x7c, 0x7b, 0xf1, 0x95, 0x52, 0x0b, 0xb2, 0x33, 0x14, 0x5b, 0xac, 0xd7, 0x32,
+  0x05, 0x97, 0x12, 0x91, 0x8b, 0x20, 0x69, 0x20, 0x7b, 0xae, 0x29, 0x47, 0x51, 0x96, 0x27, 0x2c,
+  0xa3, 0xd2, 0x3d, 0x29, 0x86, 0x07, 0x80, 0x90, 0xae, 0x30, 0x90, 0x44, 0x50, 0x98, 0x21, 0x0d,
+  0x02, 0x48, 0x75, 0x38, 0xe5, 0x2a, 0xa1, 0xc0, 0x36, 0x68, 0x53, 0x38, 0xe2, 0xc6, 0x15, 0x17,
+  0xc8, 0xe9, 0x6d, 0x22, 0x24, 0x0a, 0x78, 0xdc, 0x6d, 0xe3, 0x0c, 0xe4, 0x24, 0x18, 0xf1, 0x0b,
+  0x4b, 0xdd, 0xd2, 0x18, 0xd8, 0xc4, 0x85, 0xae, 0x1a, 0x24, 0x9d, 0x4e, 0x8b, 0x8a, 0x29, 0xd3,
+  0x57, 0xc8, 0xf3, 0x51, 0x1a, 0xe4, 0xef, 0x40, 0x6a, 0x0a, 0x16, 0x08, 0x7f, 0x17, 0x64, 0x4d,
+  0xc8, 0x77, 0x05, 0xa4, 0x79, 0x3b, 0xc1, 0xc4, 0x0d, 0x68, 0x55, 0x97, 0x96, 0x65, 0x36, 0xea,
+  0x44, 0xc8, 0x03, 0x1c, 0x6c, 0xe5, 0x80, 0x00, 0xc8, 0x91, 0x5a, 0xed, 0xa7, 0xc5, 0xf7, 0x24,
+  0x3b, 0xad, 0x1a, 0xb0, 0x1b, 0x25, 0xae, 0x51, 0xb4, 0xc3, 0x2d, 0x25, 0xe6, 0x03, 0x34, 0xe8,
+  0x9c, 0x6f, 0xc3, 0xf9, 0x25, 0x76, 0xc8, 0xe2, 0x29, 0xb0, 0x0f, 0x64, 0x49, 0x39, 0xda, 0x86,
+  0xb1, 0xa0, 0x03, 0x37, 0x25, 0x55, 0x9e, 0x36, 0x5b, 0x3c, 0xd4, 0xdd, 0x51, 0xa5, 0x4c, 0xbd,
+  0x21, 0x46, 0x63, 0x80, 0x25, 0xf0, 0x94, 0x8b, 0xa0, 0x27, 0x14, 0x38, 0x63, 0x0f, 0x06, 0xbc,
+  0x88, 0xf9, 0x57, 0xb5, 0xd3, 0x05, 0x51, 0xb4, 0x4f, 0xe0, 0xc8, 0x03, 0xc0, 0x55, 0x9f, 0xc2,
+  0xae, 0xf2, 0x01, 0x85, 0x5a, 0xa9, 0x86, 0x65, 0xab, 0xab, 0x65, 0x9b, 0x42, 0x0d, 0xad, 0x2c,
+  0xde, 0x47, 0x11, 0x4e, 0xf9, 0x40, 0x84, 0x09, 0x32, 0xe6, 0xb6, 0x6a, 0xad, 0x86, 0x22, 0x5a,
+  0x6e, 0x28, 0x24, 0x80, 0x1b, 0xfa, 0xaf, 0xaf, 0x97, 0x2a, 0x50, 0x64, 0xa9, 0xc5, 0xcc, 0x98,
+  0x4f, 0xdd, 0x71, 0x37, 0x91, 0x14, 0x67, 0x61, 0x0c, 0xea, 0x80, 0xab, 0x63, 0x18, 0xf6, 0x1a,
+  0xf6, 0x64, 0x76, 0xd1, 0xce, 0x31, 0x9b, 0x8e, 0x5d, 0x41, 0xf5, 0x5b, 0x61, 0xb0, 0xa4, 0xf5,
+  0x27, 0x12, 0xa2, 0x43, 0x9a, 0x47, 0xf4, 0xf8, 0x00, 0x5a, 0x07, 0xd2, 0xa4, 0x71, 0x3f, 0x38,
+  0x87, 0x3f, 0x11, 0x3e, 0xff, 0x50, 0x7d, 0xfb, 0x2e, 0x08, 0x33, 0xe4, 0x75, 0x0c, 0x7d, 0x14,
+  0x07, 0x0f, 0x6e, 0xa6, 0x31, 0xe4, 0x0f, 0x85, 0x7d, 0xf9, 0x08, 0x7b, 0xaa, 0xdc, 0xdb, 0xb6,
+  0x06, 0x6a, 0x7c, 0x4e, 0x2c, 0x09, 0x50, 0x29, 0x16, 0xd5, 0xa1, 0x71, 0x04, 0x84, 0x46, 0x91,
+  0x57, 0x75, 0x16, 0xd2, 0x8c, 0x33, 0x40, 0xf6, 0xd6, 0x62, 0x5e, 0xce, 0x29, 0x30, 0xd6, 0xb4,
+  0x28, 0x5a, 0x84, 0x92, 0x0c, 0x3b, 0xd5, 0x8f, 0x3e, 0xa8, 0xf7, 0xb1, 0x6d, 0xc4, 0xc5, 0x87,
+  0xbe, 0x02, 0xa1, 0xda, 0x5b, 0x08, 0x06, 0xea, 0x84, 0x83, 0x95, 0xa0, 0x09, 0xb4, 0xd1, 0x6b,
+  0xa5, 0x55, 0x64, 0x9a, 0x78, 0xe3, 0x05, 0x4c, 0xda, 0xab, 0xa2, 0x61, 0x49, 0x90, 0xa8, 0xe0,
+  0x61, 0x4c, 0x97, 0xfe, 0xd1, 0x9d, 0x76, 0x83, 0x49, 0x93, 0x13, 0x4d, 0x61, 0x0d, 0x46, 0x83,
+  0x25, 0x8c, 0x06, 0x27, 0x07, 0x89, 0xb2, 0x5d, 0xcc, 0x83, 0xa5, 0x69, 0x9b, 0x43, 0x15, 0xa0,
+  0x79, 0xf2, 0x50, 0x83, 0x59, 0x29, 0x0a, 0x2e, 0x30, 0xcc, 0xb2, 0xd3, 0x81, 0x4a, 0x83, 0x1d,
+  0x1d, 0x15, 0x61, 0x2e, 0x0d, 0x64, 0x27, 0x9a, 0xc9, 0xed, 0x5a, 0xe6, 0xa7, 0xac, 0x3b, 0x78,
+  0x8a, 0x80, 0x56, 0x81, 0xd2, 0xf6, 0x8e, 0x1c, 0x3c, 0x21, 0xc3, 0xbd, 0x2b, 0xca, 0xb5, 0x7a,
+  0xbd, 0x78, 0x4d, 0x98, 0xc3, 0xd9, 0xce, 0x0f, 0x41, 0x9e, 0x8f, 0x12, 0xd1, 0xc8, 0xf2, 0x96,
+  0x1b, 0x23, 0x4c, 0xf8, 0xa0, 0x40, 0xaa, 0xc0, 0xd4, 0x74, 0xab, 0x34, 0xd8, 0x34, 0x2d, 0xb4,
+  0x28, 0x5a, 0xa4, 0x48, 0x62, 0x20, 0xd5, 0x11, 0xd8, 0x95, 0x8b, 0x0b, 0x64, 0xf5, 0x6d, 0x84,
+  0x0b, 0xd6, 0x50, 0x0f, 0x99, 0xb5, 0x1c, 0xb7, 0xdb, 0x15, 0x1b, 0x48, 0x6f, 0x89, 0x51, 0x22,
+  0xfa, 0x5d, 0xe6, 0xe2, 0x9a, 0x5e, 0x56, 0x87, 0xd8, 0xe3, 0x7c, 0xac, 0x58, 0x6a, 0x7b, 0xb7,
+  0xf8, 0x0c, 0x33, 0x68, 0x92, 0x13, 0xbc, 0x02, 0xbc, 0x58, 0x4b, 0xeb, 0x02, 0x8a, 0x36, 0x31,
+  0x10, 0x11, 0xea, 0x6b, 0xa2, 0x64, 0x95, 0x72, 0x92, 0xc8, 0xc7, 0xf8, 0x50, 0x0b, 0x8e, 0xab,
+  0xd1, 0x42, 0x7a, 0xe1, 0x30, 0x10, 0xf3, 0x01, 0x4b, 0x70, 0xfc, 0x61, 0x2d, 0x6c, 0x94, 0x08,
+  0x03, 0x0e, 0x41, 0xae, 0x0d, 0x3e, 0x35, 0xac, 0x96, 0x7a, 0x89, 0x52, 0xf5, 0x53, 0x45, 0xfc,
+  0xcc, 0x07, 0x8e, 0x35, 0xaa, 0x8d, 0x14, 0x47, 0xc1, 0xb0, 0x67, 0xf7, 0x79, 0x9b, 0xdd, 0xd0,
+  0xdf, 0x3a, 0xba, 0x72, 0xc0, 0x2a, 0x47, 0xaa, 0x36, 0x84, 0x74, 0x69, 0x68, 0x33, 0xca, 0xb7,
+  0x9d, 0xe8, 0xdb, 0xc1, 0x0a, 0xa3, 0x07, 0x63, 0xd0, 0xad, 0xc0, 0x45, 0x99, 0x0c, 0x3e, 0x8a,
+  0xb5, 0x14, 0x4b, 0xd4, 0xcc, 0x6f, 0x42, 0xa0, 0x01, 0xb2, 0x20, 0x85, 0x3f, 0xcb, 0x4f, 0x19,
+  0x67, 0xb3, 0xb2, 0x83, 0x22, 0x39, 0xaa, 0x64, 0xef, 0x36, 0xb1, 0x8f, 0xb0, 0x0a, 0x11, 0x1c,
+  0x09, 0xb1, 0xda, 0xc7, 0x10, 0xab, 0x2e, 0x02, 0xf7, 0x5b, 0x9f, 0x35, 0x75, 0xdf, 0x8d, 0x84,
+  0xc9, 0xcb, 0x92, 0x2c, 0xa7, 0x3d, 0xf1, 0xca, 0xc8, 0x74, 0x33, 0x59, 0x21, 0x8b, 0x58, 0xbe,
+  0x2c, 0x72, 0x51, 0x8d, 0xf2, 0xbb, 0x41, 0xfd, 0x99, 0x63, 0x31, 0xc7, 0xe6, 0x38, 0x3b, 0x1f,
+  0x32, 0x80, 0xb3, 0x1f, 0x6e, 0x31, 0x24, 0x9a, 0x72, 0xd1, 0x64, 0xcb, 0xda, 0x06, 0x2f, 0x4c,
+  0xf3, 0x86, 0x94, 0x8e, 0xf3, 0x50, 0x60, 0x9d, 0xee, 0x41, 0x69, 0x7f, 0x1e, 0x6a, 0x8d, 0x8f,
+  0x62, 0xee, 0x38, 0x1c, 0x46, 0x84, 0x2f, 0xe7, 0x85, 0xf0, 0xe6, 0x8b, 0x58, 0x67, 0x9c, 0x95,
+  0x5d, 0xbb, 0xa0, 0x8d, 0x4a, 0x39, 0x3a, 0x77, 0xd8, 0x25, 0xac, 0xb6, 0x3f, 0x3a, 0xa8, 0x72,
+  0x4c, 0x6a, 0x25, 0xd9, 0x89, 0x51, 0x08, 0x5e, 0x3b, 0x11, 0x7a, 0x99, 0xf9, 0xf0, 0x78, 0x8c,
+  0x1d, 0x5a, 0xe5, 0x89, 0x27, 0x60, 0xa6, 0xe0, 0x61, 0x07, 0xe5, 0x70, 0xf6, 0x7f, 0x9a, 0xe4,
+  0x70, 0xbf, 0x81, 0x16, 0x00, 0x00,
+};
+inline constexpr size_t kStyleCssGzipLength = sizeof(kStyleCssGzip);
+
+}  // namespace bp_web
+
+#endif
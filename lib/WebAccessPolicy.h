@@ -3,6 +3,7 @@
 
 #include "DeviceSecurity.h"
 #include "BoundedHttpRequest.h"
+#include "StaticAssets.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -92,6 +93,8 @@ struct RoutePolicy {
 // wildcard entry: a new handler remains unreachable until it is classified
 // here. All responses can contain credentials, configuration, measurements,
 // or operational state, so every route requests Cache-Control: no-store.
+// The one exception is a build-time asset under /static/: its path carries
+// a content hash, so the response never changes and may be cached.
 inline constexpr RoutePolicy kRoutePolicies[] = {
   {HttpMethod::GET, "/claim", AccessRole::NONE, 0, RouteBodyKind::NONE, false, true},
   {HttpMethod::POST, "/claim", AccessRole::NONE, 96, RouteBodyKind::FORM, true, true},
@@ -101,6 +104,7 @@ inline constexpr RoutePolicy kRoutePolicies[] = {
   {HttpMethod::GET, "/export.csv", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
   {HttpMethod::GET, "/api/history", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
   {HttpMethod::GET, "/api/latest", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+  {HttpMethod::GET, "/api/events", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
   {HttpMethod::GET, "/config", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false, true},
   {HttpMethod::POST, "/configure", AccessRole::ADMIN, 512, RouteBodyKind::FORM, true, true},
   {HttpMethod::POST, "/clear_history", AccessRole::ADMIN, 0, RouteBodyKind::NONE, true, true},
@@ -114,6 +118,7 @@ inline constexpr RoutePolicy kRoutePolicies[] = {
   {HttpMethod::GET, "/firmware_update", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false, true},
   {HttpMethod::POST, "/authorize_firmware", AccessRole::ADMIN, 1024, RouteBodyKind::FORM, true, true},
   {HttpMethod::POST, "/install_firmware", AccessRole::ADMIN, 1310720, RouteBodyKind::STREAM, true, true},
+  {HttpMethod::GET, kStyleCssPath, AccessRole::STAFF, 0, RouteBodyKind::NONE, false, false},
 };
 
 inline constexpr size_t kRoutePolicyCount =
@@ -144,11 +149,24 @@ constexpr bool routeBodyPolicyIsValid(const RoutePolicy& route) {
   }
 }
 
+constexpr bool isStaticAssetRoute(const RoutePolicy& route) {
+  constexpr char kPrefix[] = "/static/";
+  if (route.method != HttpMethod::GET || route.mutation ||
+      route.bodyKind != RouteBodyKind::NONE || route.path == nullptr) {
+    return false;
+  }
+  for (size_t i = 0; i + 1 < sizeof(kPrefix); ++i) {
+    if (route.path[i] != kPrefix[i]) return false;
+  }
+  return route.path[sizeof(kPrefix) - 1] != '\0';
+}
+
 constexpr bool routeTableIsValid() {
-  if (kRoutePolicyCount != 21) return false;
+  if (kRoutePolicyCount != 23) return false;
   for (size_t i = 0; i < kRoutePolicyCount; ++i) {
     const RoutePolicy& route = kRoutePolicies[i];
-    if (route.path == nullptr || route.path[0] != '/' || !route.noStore) {
+    if (route.path == nullptr || route.path[0] != '/' ||
+        (!route.noStore && !isStaticAssetRoute(route))) {
       return false;
     }
     if (!routeBodyPolicyIsValid(route)) return false;
@@ -186,6 +204,35 @@ constexpr bool isClaimRoute(const RoutePolicy& route) {
   return cStringEquals(route.path, "/claim");
 }
 
+// Pages RenderedPageCache may keep in RAM between requests. Each must be a
+// staff-readable GET whose body depends only on records, policy and role.
+// Claim and admin-only pages show credentials, one-time codes or
+// configuration and are refused even if listed here.
+inline constexpr const char* kRenderedPageCacheRoutes[] = {"/history"};
+
+constexpr bool renderedPageCacheable(HttpMethod method, const char* path) {
+  const RoutePolicy* route = findRoutePolicy(method, path);
+  if (route == nullptr || route->method != HttpMethod::GET ||
+      route->mutation || isClaimRoute(*route) ||
+      route->requiredRole != AccessRole::STAFF) {
+    return false;
+  }
+  for (const char* cacheable : kRenderedPageCacheRoutes) {
+    if (cStringEquals(route->path, cacheable)) return true;
+  }
+  return false;
+}
+
+static_assert(renderedPageCacheable(HttpMethod::GET, "/history"),
+              "history page is the cached page");
+static_assert(!renderedPageCacheable(HttpMethod::GET, "/claim") &&
+                !renderedPageCacheable(HttpMethod::GET, "/security") &&
+                !renderedPageCacheable(HttpMethod::GET, "/config") &&
+                !renderedPageCacheable(HttpMethod::POST, "/claim") &&
+                !renderedPageCacheable(HttpMethod::POST,
+                                       "/rotate_credentials"),
+              "pages with secrets are never cached");
+
 constexpr bool isKnownHttpMethod(HttpMethod method) {
   return method == HttpMethod::GET || method == HttpMethod::POST;
 }
@@ -4,14 +4,21 @@
 #include <Preferences.h>
 #include <ArduinoJson.h>
 #include <WiFi.h>
+#include <esp_random.h>
+#include "BoundedJsonWriter.h"
 #include "BoundedWebServer.h"
 #include "BPRecordManager.h"
 #include "BP_Parser.h"
 #include "CsvExport.h"
 #include "DeviceSecurity.h"
+#include "HtmlTemplate.h"
 #include "BuildInfo.h"
 #include "MeasurementPolicy.h"
 #include "FirmwareUpdateRuntime.h"
+#include "MeasurementLatency.h"
+#include "MeasurementSnapshot.h"
+#include "ReceiveDiagnostic.h"
+#include "RenderedPageCache.h"
 #include "WebAccessPolicy.h"
 #include "transports/MonitorTransport.h"
 
@@ -24,10 +31,12 @@ private:
   BP_RecordManager* recordManager;
   BP_Parser* bpParser;
   String* bp_model;
-  String* lastData;
+  ReceiveDiagnostic* receiveDiagnostic;
   String* transportName;
   String* transportStatus;
-  MonitorTransport* monitorTransport;
+  const MonitorTransportSummary* transportSummary;
+  MeasurementSnapshotPublisher* measurementSnapshot;
+  MeasurementLatencyTracker* latencyTracker;
   MonotonicMillis64* uptimeClock;
   MeasurementPolicyStore* measurementPolicyStore;
   FirmwareUpdateRuntime* firmwareUpdateRuntime;
@@ -36,6 +45,95 @@ private:
   const char* hostname;
   const char* ap_ssid;
 
+  // /history、/api/history、/export.csv 以 chunked 串流送出：handler 只產生
+  // 表頭，表身在送出期間由 BoundedWebServer 逐窗呼叫 fillHistoryStream 產生，
+  // 記憶體固定、不隨歷史筆數成長。伺服器同時服務多個連線，每個 slot 一份
+  // 游標，串流 context 就是該 slot 的游標。
+  // 游標是上一筆已輸出的 recordSequence，分段之間新增記錄不會錯位或重複。
+  // JSON_SINCE 是 /api/history?since= 的增量頁：由舊到新，只到 lastSequence。
+  enum class HistoryStreamKind : uint8_t { HTML, JSON, CSV, JSON_SINCE };
+  struct HistoryStream {
+    WebHandler* owner = nullptr;
+    HistoryStreamKind kind = HistoryStreamKind::HTML;
+    uint64_t cursor = 0;
+    // CSV/增量頁由舊到新：開始後才新增的記錄不輸出，與 JSON/HTML 的快照一致
+    uint64_t lastSequence = 0;
+    uint32_t rows = 0;
+    bool clearControl = false;
+    bool rowsDone = false;
+    bp_web::AccessRole role = bp_web::AccessRole::NONE;
+    bp_html::HtmlTemplateCursor page;  // HTML 表頭與收尾樣板的位置
+    bool pageStarted = false;  // HTML 第一個視窗已查過頁面快取
+    String pending;  // 尚未寫進視窗的文字（CSV 與 JSON 表頭）
+    size_t pendingOffset = 0;
+  };
+  HistoryStream historyStreams[bp_web::kBoundedWebSlots];
+  // / 與 /history 以預編譯樣板串流：固定片段是 flash 常數、長度編譯期已知，
+  // 動態欄位在送出時才直接寫進回應視窗，整頁不配置 heap。快照、角色與 nowMs
+  // 在 handler 內擷取；之後的輸出只讀這份副本與 record manager。
+  enum PageSlot : uint8_t {
+    MONITOR_PAGE_START,
+    MONITOR_FRESHNESS,
+    MONITOR_LATEST,
+    MONITOR_RECENT,
+    MONITOR_DIAGNOSTIC,
+    MONITOR_LATENCY,
+    MONITOR_CONNECTION,
+    MONITOR_RESET_CONTROL,
+    MONITOR_SCRIPT_STATE,
+    HISTORY_PAGE_START,
+    HISTORY_EMPTY_ROW,
+    HISTORY_CLEAR_CONTROL,
+  };
+  struct MonitorStream {
+    WebHandler* owner = nullptr;
+    bp_html::HtmlTemplateCursor page;
+    MeasurementSnapshot snapshot;
+    uint64_t nowMs = 0;
+    bp_web::AccessRole role = bp_web::AccessRole::NONE;
+  };
+  MonitorStream monitorStreams[bp_web::kBoundedWebSlots];
+  // /history 是記錄內容、政策版本與角色的純函式（管理者多一個清除區塊），每個
+  // 角色保留最後一次輸出的整頁，內容未變時直接複製、不再逐筆分類。快取只在串流
+  // 的第一個視窗查詢與存入；容量不超過一個視窗，命中時一次送完，之後的存入不會
+  // 覆寫仍在送出的位元組。20 筆約 7 KB，超過容量就照常逐筆輸出、不快取。
+  static constexpr size_t kHistoryPageRoute = 0;
+  static constexpr size_t kRenderedPageCapacity = 8192;
+  static_assert(kRenderedPageCapacity <= bp_http::BoundedHttpResponse::kStreamWindow,
+                "a cached page must replay in one stream window");
+  static_assert(bp_web::renderedPageCacheable(bp_web::HttpMethod::GET,
+                                              "/history"),
+                "only allow-listed pages without secrets may be cached");
+  bp_web::RenderedPageCache<1, kRenderedPageCapacity> renderedPages;
+  // /api/events 是 Server-Sent Events 長連線：handler 只送表頭與目前狀態，之後
+  // 由 fillEventStream 在 snapshot 有新發布或每秒一次時比較 tag 組成，有變化才
+  // 推送事件，沒有就回 IDLE 等下一輪 poll。每個 slot 一份狀態；所有 slot 都
+  // 忙且有連線排隊，或連線到期就結束串流，瀏覽器依 retry 重連並重新驗證。
+  struct EventStream {
+    WebHandler* owner = nullptr;
+    uint32_t openedAtMs = 0;
+    uint32_t checkedAtMs = 0;
+    uint32_t sentAtMs = 0;
+    uint32_t publication = 0;
+    MeasurementEtagParts sent;
+    bool primed = false;
+    String pending;
+    size_t pendingOffset = 0;
+  };
+  EventStream eventStreams[bp_web::kBoundedWebSlots];
+  static constexpr uint32_t kEventStreamLifetimeMs = 60000;
+  static constexpr uint32_t kEventCheckIntervalMs = 1000;
+  // 低於 dashboard 的 8 秒 watchdog，沒有新資料時也證明連線仍在
+  static constexpr uint32_t kEventHeartbeatMs = 4000;
+  static constexpr uint32_t kEventRetryMs = 1000;
+  // /api/history 增量頁：未帶 limit 時的筆數與上限
+  static constexpr int kHistoryPageDefault = 50;
+  static constexpr int kHistoryPageMax = 100;
+  // /api/history 表頭（revision、政策、韌體、protocol、游標欄位）的固定緩衝
+  static constexpr size_t kHistoryJsonHeadCapacity = 384;
+  // JSON API ETag 的開機 nonce；重開機後 revision/transport 版本重新起算也不撞號。
+  const uint32_t etagBootNonce = esp_random();
+
   static void restartDevice(void*) {
     ESP.restart();
   }
@@ -51,7 +149,8 @@ private:
     return result == DeviceSecurityResult::OK;
   }
 
-  static void appendUInt64(String& out, uint64_t value) {
+  template <typename Out>
+  static void appendUInt64(Out& out, uint64_t value) {
     char encoded[24];
     if (formatOpaqueSequence(value, encoded, sizeof(encoded))) {
       out += encoded;
@@ -79,70 +178,132 @@ private:
     return measurementPolicyStore->config();
   }
 
-  bool isTransportConnected() const {
-    if (monitorTransport == nullptr) return false;
-    const MonitorTransportState state = monitorTransport->state();
-    return state == TRANSPORT_STATE_READY ||
-           state == TRANSPORT_STATE_RECEIVING;
+  // 最新量測、freshness 輸入與 transport 診斷一律讀 seqlock snapshot：
+  // 一次 read() 取得一致副本，不阻塞 ingest 側的發布。
+  MeasurementSnapshot latestSnapshot() const {
+    return measurementSnapshot->read();
   }
 
-  MeasurementFreshnessState latestFreshness(uint64_t nowMs) const {
-    MeasurementFreshnessInput input;
-    input.hasRecord = recordManager->getRecordCount() > 0;
-    if (input.hasRecord) {
-      input.valid = recordManager->getLatestRecord().valid;
-    }
-    input.receivedThisBoot = recordManager->latestReceivedThisBoot();
-    input.transportConnected = isTransportConnected();
-    input.nowMs = nowMs;
-    input.staleAfterMs = activePolicy().staleAfterMs;
-    uint64_t receiveAge = 0;
-    if (recordManager->lastSuccessfulReceiveAgeMs(nowMs, receiveAge)) {
-      input.lastSuccessfulReceiveMs = nowMs - receiveAge;
+  // 新 revision 第一次經 / 或 /api/latest 送出時記錄延遲；只在 main loop 呼叫。
+  void noteMeasurementServed(const MeasurementSnapshot& snapshot) {
+    if (latencyTracker == nullptr || !snapshot.hasRecord()) return;
+    latencyTracker->noteServed(snapshot.revision, millis());
+  }
+
+  template <typename Out>
+  static void appendLatencyMs(Out& html, uint32_t elapsedUs) {
+    html += elapsedUs / 1000U;
+    html += '.';
+    html += (elapsedUs % 1000U) / 100U;
+    html += " ms";
+  }
+
+  template <typename Out>
+  void appendLatencyTraceHtml(Out& html) const {
+    if (latencyTracker == nullptr) return;
+    html += "<details class='panel latency-trace'>";
+    html += "<summary>量測延遲追蹤</summary>";
+    html += "<div class='table-scroll'><table>";
+    html += "<caption>最近 ";
+    html += static_cast<unsigned>(MeasurementLatencyHistogram::kWindow);
+    html += " 筆量測各階段延遲</caption><thead><tr>";
+    html += "<th scope='col'>階段</th><th scope='col'>筆數</th>";
+    html += "<th scope='col'>最近</th><th scope='col'>最大</th>";
+    for (size_t bucket = 0; bucket < MeasurementLatencyHistogram::kBucketCount;
+         ++bucket) {
+      html += "<th scope='col'>&le;";
+      html += MeasurementLatencyHistogram::bucketLabel(bucket);
+      html += "</th>";
+    }
+    html += "</tr></thead><tbody>";
+    for (size_t index = 0; index < MeasurementLatencyTracker::kStageCount;
+         ++index) {
+      const MeasurementLatencyStage stage =
+        static_cast<MeasurementLatencyStage>(index);
+      const MeasurementLatencyHistogram& histogram =
+        latencyTracker->histogram(stage);
+      uint16_t counts[MeasurementLatencyHistogram::kBucketCount];
+      histogram.bucketCounts(counts);
+      html += "<tr data-stage='";
+      html += measurementLatencyStageCode(stage);
+      html += "'><th scope='row'>";
+      html += measurementLatencyStageLabel(stage);
+      html += "</th><td>";
+      html += static_cast<unsigned>(histogram.sampleCount());
+      html += "</td><td>";
+      if (histogram.sampleCount() > 0) appendLatencyMs(html, histogram.lastUs());
+      else html += "-";
+      html += "</td><td>";
+      if (histogram.sampleCount() > 0) appendLatencyMs(html, histogram.maxUs());
+      else html += "-";
+      html += "</td>";
+      for (uint16_t count : counts) {
+        html += "<td>";
+        html += count;
+        html += "</td>";
+      }
+      html += "</tr>";
     }
-    return measurementFreshness(input);
+    html += "</tbody></table></div></details>";
   }
 
-  const char* sanitizedDiagnosticState() const {
-    static constexpr const char* kStates[] = {
-      "valid", "storage_error", "invalid_timestamp", "device_error",
-      "out_of_range", "unsupported_format", "unsupported_model",
-      "overflow", "discontinuity", "malformed"
-    };
-    for (const char* state : kStates) {
-      char marker[48];
-      const int length = snprintf(marker, sizeof(marker), "data-status='%s'",
-                                  state);
-      if (length > 0 && static_cast<size_t>(length) < sizeof(marker) &&
-          lastData->indexOf(marker) >= 0) {
-        return state;
+  void setLatencyJson(JsonObject stages) const {
+    for (size_t index = 0; index < MeasurementLatencyTracker::kStageCount;
+         ++index) {
+      const MeasurementLatencyStage stage =
+        static_cast<MeasurementLatencyStage>(index);
+      const MeasurementLatencyHistogram& histogram =
+        latencyTracker->histogram(stage);
+      JsonObject stageObj =
+        stages[measurementLatencyStageCode(stage)].to<JsonObject>();
+      stageObj["samples"] = static_cast<uint32_t>(histogram.sampleCount());
+      if (histogram.sampleCount() > 0) {
+        stageObj["last_us"] = histogram.lastUs();
+        stageObj["max_us"] = histogram.maxUs();
+      } else {
+        stageObj["last_us"] = nullptr;
+        stageObj["max_us"] = nullptr;
+      }
+      uint16_t counts[MeasurementLatencyHistogram::kBucketCount];
+      histogram.bucketCounts(counts);
+      JsonObject buckets = stageObj["buckets"].to<JsonObject>();
+      for (size_t bucket = 0; bucket < MeasurementLatencyHistogram::kBucketCount;
+           ++bucket) {
+        buckets[MeasurementLatencyHistogram::bucketLabel(bucket)] = counts[bucket];
       }
     }
-    return lastData->isEmpty() ? "waiting" : "unavailable";
+  }
+
+  MeasurementFreshnessState latestFreshness(const MeasurementSnapshot& snapshot,
+                                            uint64_t nowMs) const {
+    return measurementFreshness(
+      snapshot.freshnessInput(nowMs, activePolicy().staleAfterMs));
+  }
+
+  static const char* sanitizedDiagnosticState(
+      const MeasurementSnapshot& snapshot) {
+    return receiveDiagnosticStatusCode(snapshot.diagnostic.status);
+  }
+
+  // 清除歷史由 main loop 執行，與 DataProcessor 套用 ingest 結果同屬唯一寫入端。
+  void republishMeasurementSnapshot() {
+    measurementSnapshot->publish(captureMeasurementSnapshot(
+      *recordManager, *receiveDiagnostic, *transportSummary));
   }
 
   // 針對使用者可控字串做最小 HTML escape，防止 SSID/型號名含 '<' 把後續解讀成 tag
   String htmlEscape(const String& s) const {
     String out;
     out.reserve(s.length());
-    for (size_t i = 0; i < s.length(); i++) {
-      char c = s.charAt(i);
-      switch (c) {
-        case '<':  out += "&lt;"; break;
-        case '>':  out += "&gt;"; break;
-        case '&':  out += "&amp;"; break;
-        case '"':  out += "&quot;"; break;
-        case '\'': out += "&#39;"; break;
-        default:   out += c;
-      }
-    }
+    bp_html::appendHtmlEscaped(out, s.c_str());
     return out;
   }
 
   // 表格中單一欄位：對 invalid record 顯示 "—" 並用中性樣式，避免 -1 紅字。
   // 直接 append 進 out，免每次呼叫都建一個 ~48 byte 的回傳 String 暫物件
   // （20 筆 × 3 欄 × 兩個表格 ≈ 120 個 alloc/render）。
-  void renderTableValueCell(String& out, int value, bool valid) const {
+  template <typename Out>
+  void renderTableValueCell(Out& out, int value, bool valid) const {
     bool ok = valid && value > 0;
     if (!ok) { out += "<td class='value-na'>—</td>"; return; }
     out += "<td>";
@@ -152,7 +313,8 @@ private:
 
   // KPI 卡片：valueOk=false 顯示 "—" + 中性提示，避免無效值看似可用。
   // 直接 append 進 out，省每次呼叫一個 ~320B 的中介 String（dashboard 一次 render 3 次）
-  void renderKpiCard(String& out, const char* idVal, const char* idPill,
+  template <typename Out>
+  void renderKpiCard(Out& out, const char* idVal, const char* idPill,
                      const char* label, const char* unit,
                      int value, bool valueOk,
                      MeasurementReviewState state) const {
@@ -189,11 +351,14 @@ private:
   }
 
   // 直接 append 進 out，省每次呼叫一個 ~80B 的中介 String（buildPageStart 4 次 / 渲染）
-  void navLink(String& out, const String& href, const String& label, const String& activePath) const {
+  template <typename Out>
+  static void navLink(Out& out, const char* href, const char* label,
+                      const char* activePath) {
+    const bool active = strcmp(href, activePath) == 0;
     out += "<a class='top-nav-link";
-    if (href == activePath) out += " active";
+    if (active) out += " active";
     out += "'";
-    if (href == activePath) out += " aria-current='page'";
+    if (active) out += " aria-current='page'";
     out += " href='";
     out += href;
     out += "'>";
@@ -201,153 +366,74 @@ private:
     out += "</a>";
   }
 
-  const String& sharedStyle() const {
-    static String css; // 函式 local 靜態，與 instance const 性無關
-    if (!css.isEmpty()) return css;
-    css.reserve(5200); // 量測實際 CSS ~5025 bytes，4500 會觸發一次 realloc
-    css += "<style>";
-    css += ":root{";
-    css += "--bg:#edf3fb;";
-    css += "--surface:#ffffff;";
-    css += "--surface-2:#f7faff;";
-    css += "--text:#12243c;";
-    css += "--muted:#60708a;";
-    css += "--primary:#0f62fe;";
-    css += "--primary-ink:#ffffff;";
-    css += "--primary-soft:#dce8ff;";
-    css += "--success:#118a4c;";
-    css += "--danger:#d93025;";
-    css += "--warning:#f59e0b;";
-    css += "--border:#d6e2f1;";
-    css += "--shadow:0 14px 32px rgba(11,35,74,.10);";
-    css += "}";
-    css += "*{box-sizing:border-box;}";
-    css += "body{margin:0;font-family:'Avenir Next','Segoe UI','Noto Sans TC',Arial,sans-serif;background:linear-gradient(180deg,#eaf1fb 0%,#f8fbff 45%,#eef5ff 100%);color:var(--text);} ";
-    css += ".app-shell{max-width:1120px;margin:0 auto;padding:24px 18px 48px;}";
-    css += ".header-bar{display:flex;justify-content:space-between;align-items:flex-end;gap:16px;margin-bottom:14px;flex-wrap:wrap;}";
-    css += ".page-title{margin:0;font-size:30px;line-height:1.1;letter-spacing:.3px;}";
-    css += ".chip{display:inline-flex;align-items:center;gap:6px;padding:7px 12px;border-radius:999px;background:rgba(15,98,254,.12);color:#0b4dd0;font-size:12px;font-weight:700;text-transform:uppercase;letter-spacing:.08em;}";
-
-    css += ".top-nav{display:flex;gap:10px;flex-wrap:wrap;margin-bottom:18px;}";
-    css += ".top-nav-link{padding:10px 14px;border-radius:12px;text-decoration:none;color:#1f3558;background:rgba(255,255,255,.68);border:1px solid var(--border);font-weight:700;font-size:14px;}";
-    css += ".top-nav-link.active{background:var(--primary);color:var(--primary-ink);border-color:var(--primary);box-shadow:0 8px 18px rgba(15,98,254,.28);} ";
-    css += "a:focus-visible,button:focus-visible,input:focus-visible,select:focus-visible,summary:focus-visible{outline:3px solid #111827;outline-offset:3px;}";
-
-    css += ".panel{background:var(--surface);border:1px solid var(--border);border-radius:18px;padding:18px 20px;margin-bottom:16px;box-shadow:var(--shadow);} ";
-    css += ".panel h2{margin:0 0 10px;font-size:22px;}";
-    css += ".panel h3{margin:0 0 8px;font-size:18px;}";
-    css += ".section-head{display:flex;align-items:flex-start;justify-content:space-between;gap:12px;flex-wrap:wrap;margin-bottom:12px;}";
-    css += ".helper-text{color:var(--muted);margin:0 0 10px;line-height:1.6;font-size:14px;}";
-    css += ".last-updated{font-size:12px;font-weight:700;color:#35578c;background:var(--primary-soft);padding:6px 10px;border-radius:999px;}";
-
-    css += ".btn{display:inline-flex;align-items:center;justify-content:center;gap:6px;padding:10px 14px;border-radius:12px;background:var(--primary);color:var(--primary-ink);text-decoration:none;border:none;cursor:pointer;font-size:14px;font-weight:700;}";
-    css += ".btn:hover{opacity:.94;}";
-    css += ".btn-secondary{background:#0b7fab;}";
-    css += ".btn-ghost{background:var(--surface-2);color:#1f3558;border:1px solid var(--border);}";
-    css += ".btn-danger{background:var(--danger);color:#fff;}";
-
-    css += ".latest-vitals{position:relative;overflow:hidden;}";
-    css += ".kpi-grid{display:grid;grid-template-columns:repeat(3,minmax(0,1fr));gap:14px;}";
-    css += ".kpi-card{background:linear-gradient(180deg,#ffffff,#f5f9ff);border:1px solid var(--border);border-radius:14px;padding:14px;min-height:132px;}";
-    css += ".kpi-label{font-size:13px;color:var(--muted);font-weight:700;display:flex;justify-content:space-between;align-items:center;gap:8px;}";
-    css += ".kpi-value{font-size:40px;line-height:1;font-weight:800;margin:10px 0 8px;}";
-    css += ".value-good{color:var(--success);}";
-    css += ".value-bad{color:var(--danger);}";
-    css += ".value-na{color:var(--muted);}";
-    css += ".state-pill{display:inline-block;padding:4px 8px;border-radius:999px;font-size:12px;font-weight:700;}";
-    css += ".state-ok{background:rgba(17,138,76,.12);color:var(--success);}";
-    css += ".state-alert{background:rgba(217,48,37,.12);color:var(--danger);}";
-    css += ".state-na{background:rgba(96,112,138,.14);color:var(--muted);}";
-    css += ".freshness-banner{padding:12px 14px;border:2px solid #35578c;border-radius:12px;background:#eef5ff;font-weight:800;margin-bottom:14px;}";
-    css += ".freshness-banner[data-state='stale'],.freshness-banner[data-state='disconnected'],.freshness-banner[data-state='invalid']{border-color:var(--danger);background:#fff4f3;}";
-
-    css += ".recent-table table,.history-table table{width:100%;border-collapse:collapse;font-size:14px;overflow:hidden;border-radius:12px;}";
-    css += ".recent-table th,.recent-table td,.history-table th,.history-table td{padding:11px 10px;border-bottom:1px solid #e5edf7;text-align:center;}";
-    css += ".recent-table th,.history-table th{background:#eff5ff;font-size:12px;letter-spacing:.06em;text-transform:uppercase;color:#4d6282;}";
-    css += ".recent-table tr:nth-child(even),.history-table tr:nth-child(even){background:#fbfdff;}";
-    css += ".table-scroll{max-width:100%;overflow-x:auto;-webkit-overflow-scrolling:touch;}";
-    css += "caption{text-align:left;font-weight:800;padding:0 0 10px;color:#223a5f;}";
-
-    css += ".status-list{list-style:none;margin:0;padding:0;display:grid;gap:8px;}";
-    css += ".status-list li{display:flex;justify-content:space-between;gap:12px;padding:8px 10px;border-radius:10px;background:#f7faff;border:1px solid #e7eef9;}";
-
-    css += ".diagnostic-data summary{cursor:pointer;font-weight:700;outline:none;}";
-    css += ".diagnostic-data[open] summary{margin-bottom:12px;}";
-
-    css += ".form-shell{max-width:760px;}";
-    css += ".form-shell form{display:grid;gap:10px;}";
-    css += ".field-label{font-size:14px;font-weight:800;color:#223a5f;}";
-    css += "input,select{width:100%;padding:10px 12px;border:1px solid #c8d7ea;border-radius:10px;background:#fff;font-size:15px;}";
-    css += ".scan-refresh{white-space:nowrap;}";
-
-    css += ".inline-actions{display:flex;gap:10px;flex-wrap:wrap;align-items:center;}";
-    css += ".danger-zone{border-color:rgba(217,48,37,.3);background:linear-gradient(180deg,#fff,#fff6f6);}";
-    css += ".danger-zone .helper-text{color:#7a3f3c;}";
-    css += ".text-link{color:#0b54e2;text-decoration:none;font-weight:700;}";
-
-    css += "@media (max-width:980px){.kpi-grid{grid-template-columns:1fr;} .page-title{font-size:26px;}}";
-    css += "@media (max-width:640px){.app-shell{padding:18px 12px 32px;} .panel{padding:14px;} .top-nav-link,.btn{width:100%;justify-content:center;} .inline-actions{display:grid;} .kpi-value{font-size:34px;} .status-list li{display:block;} }";
-    css += "</style>";
-    return css;
-  }
-
-  String buildPageStart(const String& title, const String& activePath, bool autoRefresh = false, const String& extraHead = "") const {
-    String html;
-    // CSS ~5.2KB + head/nav 樣板 ~700B + 留一點給小頁面 body 共 ~2KB ≈ 8KB
-    // 大頁面（handleMonitor/handleHistory）會在自己的 handler 再 reserve 更多
-    html.reserve(8192);
-    html = "<!DOCTYPE html><html lang='zh-Hant'><head><meta charset='UTF-8'>";
-    html += "<title>" + title + "</title>";
+  // head 與導覽列。角色由呼叫端傳入：串流頁面在 handler 回傳後才輸出，
+  // 那時伺服器已清掉本次請求的角色。
+  template <typename Out>
+  static void appendPageStart(Out& html, const char* title,
+                              const char* activePath, bp_web::AccessRole role,
+                              bool autoRefresh, const char* extraHead) {
+    html += "<!DOCTYPE html><html lang='zh-Hant'><head><meta charset='UTF-8'>";
+    html += "<title>";
+    html += title;
+    html += "</title>";
     html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
     if (autoRefresh) {
       html += "<meta http-equiv='refresh' content='3'>";
     }
-    html += sharedStyle();
+    html += "<link rel='stylesheet' href='";
+    html += bp_web::kStyleCssPath;
+    html += "'>";
     html += extraHead;
     html += "</head><body>";
     html += "<div class='app-shell'>";
     html += "<header class='header-bar'>";
-    html += "<h1 class='page-title'>" + title + "</h1>";
+    html += "<h1 class='page-title'>";
+    html += title;
+    html += "</h1>";
     html += "<span class='chip'>Health Monitor</span>";
     html += "</header>";
     html += "<nav class='top-nav' aria-label='主要導覽'>";
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::MONITOR_NAV)) {
+    if (bp_web::surfaceVisible(role, bp_web::WebSurface::MONITOR_NAV)) {
       navLink(html, "/", "監控", activePath);
     }
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::HISTORY_NAV)) {
+    if (bp_web::surfaceVisible(role, bp_web::WebSurface::HISTORY_NAV)) {
       navLink(html, "/history", "歷史記錄", activePath);
     }
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::ADMIN_WIFI_NAV)) {
+    if (bp_web::surfaceVisible(role, bp_web::WebSurface::ADMIN_WIFI_NAV)) {
       navLink(html, "/config", "WiFi 設定", activePath);
     }
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::ADMIN_MODEL_NAV)) {
+    if (bp_web::surfaceVisible(role, bp_web::WebSurface::ADMIN_MODEL_NAV)) {
       navLink(html, "/bp_model", "型號設定", activePath);
     }
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::ADMIN_SECURITY_NAV)) {
+    if (bp_web::surfaceVisible(role, bp_web::WebSurface::ADMIN_SECURITY_NAV)) {
       navLink(html, "/security", "管理者安全設定", activePath);
     }
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::ADMIN_POLICY_NAV)) {
+    if (bp_web::surfaceVisible(role, bp_web::WebSurface::ADMIN_POLICY_NAV)) {
       navLink(html, "/measurement_policy", "量測政策", activePath);
     }
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::ADMIN_UPDATE_NAV)) {
+    if (bp_web::surfaceVisible(role, bp_web::WebSurface::ADMIN_UPDATE_NAV)) {
       navLink(html, "/firmware_update", "韌體更新", activePath);
     }
     html += "</nav>";
     html += "<main id='main-content'>";
+  }
+
+  String buildPageStart(const String& title, const String& activePath, bool autoRefresh = false, const String& extraHead = "") const {
+    String html;
+    // head/nav 樣板 ~800B + 留給小頁面 body ~2KB；CSS 改由 /static/ 快取。
+    // 監控與歷史頁改用預編譯樣板直接串流，不經這裡。
+    html.reserve(3072);
+    appendPageStart(html, title.c_str(), activePath.c_str(),
+                    server->currentRole(), autoRefresh, extraHead.c_str());
     return html;
   }
 
+  static constexpr char kPageEnd[] = "</main></div></body></html>";
+
   // 回 const char*：caller 用 `html += buildPageEnd()` 是 String += const char*，
   // 不會建臨時 String（每頁 render 省一個 ~30 byte alloc）
   const char* buildPageEnd() const {
-    return "</main></div></body></html>";
+    return kPageEnd;
   }
 
 public:
@@ -355,8 +441,11 @@ public:
              DeviceSecurity* deviceSecurity,
              Preferences* preferences, BP_RecordManager* recordManager,
              BP_Parser* bpParser,
-             String* bp_model, String* lastData, String* transportName, String* transportStatus,
-             MonitorTransport* monitorTransport,
+             String* bp_model, ReceiveDiagnostic* receiveDiagnostic,
+             String* transportName, String* transportStatus,
+             const MonitorTransportSummary* transportSummary,
+             MeasurementSnapshotPublisher* measurementSnapshot,
+             MeasurementLatencyTracker* latencyTracker,
              MonotonicMillis64* uptimeClock,
              MeasurementPolicyStore* measurementPolicyStore,
              FirmwareUpdateRuntime* firmwareUpdateRuntime,
@@ -367,10 +456,12 @@ public:
       recordManager(recordManager),
       bpParser(bpParser),
       bp_model(bp_model),
-      lastData(lastData),
+      receiveDiagnostic(receiveDiagnostic),
       transportName(transportName),
       transportStatus(transportStatus),
-      monitorTransport(monitorTransport),
+      transportSummary(transportSummary),
+      measurementSnapshot(measurementSnapshot),
+      latencyTracker(latencyTracker),
       uptimeClock(uptimeClock),
       measurementPolicyStore(measurementPolicyStore),
       firmwareUpdateRuntime(firmwareUpdateRuntime),
@@ -383,9 +474,11 @@ public:
     server->on("/", HTTP_GET, [this]() { this->handleMonitor(); });
     server->on("/config", HTTP_GET, [this]() { this->handleRoot(); });
     server->on("/configure", HTTP_POST, [this]() { this->handleConfigure(); });
-    // /data 只回傳去識別化的結構化接收診斷 HTML 片段。
+    // /data 只回傳去識別化的結構化接收診斷 HTML 片段，於請求時才由 POD 產生。
     server->on("/data", HTTP_GET, [this]() {
-      server->send(200, "text/html; charset=UTF-8", *lastData);
+      String fragment;
+      appendReceiveDiagnosticHtml(fragment, latestSnapshot().diagnostic);
+      server->send(200, "text/html; charset=UTF-8", fragment);
     });
 
     // 添加歷史記錄相關API
@@ -394,6 +487,7 @@ public:
     server->on("/export.csv", HTTP_GET, [this]() { this->handleExportCsv(); });
     server->on("/api/history", HTTP_GET, [this]() { this->handleHistoryAPI(); });
     server->on("/api/latest", HTTP_GET, [this]() { this->handleLatestAPI(); });
+    server->on("/api/events", HTTP_GET, [this]() { this->handleEvents(); });
     // 破壞性操作改為 POST，避免瀏覽器 link prefetch、爬蟲、誤點 GET 觸發。
     server->on("/clear_history", HTTP_POST, [this]() { this->handleClearHistory(); });
 
@@ -416,6 +510,9 @@ public:
     server->on("/install_firmware", HTTP_POST,
                [this]() { this->handleInstallFirmware(); });
     server->on("/reset", HTTP_POST, [this]() { this->handleReset(); });
+    // 建置時產生的 gzip CSS；路徑含內容雜湊，route policy 允許 immutable 快取。
+    server->on(bp_web::kStyleCssPath, HTTP_GET,
+               [this]() { this->handleStyleSheet(); });
   }
 
 private:
@@ -446,6 +543,20 @@ private:
     return true;
   }
 
+  // 直接由 flash 送出 gzip bytes，不經 heap String。ETag 相符回 304 省下本體；
+  // 所有支援的瀏覽器都接受 gzip，故不解析 Accept-Encoding。
+  void handleStyleSheet() {
+    server->sendHeader("ETag", bp_web::kStyleCssEtag);
+    if (server->requestMatchesEtag(bp_web::kStyleCssEtag)) {
+      server->send(304, "text/css", "");
+      return;
+    }
+    server->sendHeader("Content-Encoding", "gzip");
+    server->send_P(200, "text/css",
+                   reinterpret_cast<const char*>(bp_web::kStyleCssGzip),
+                   bp_web::kStyleCssGzipLength);
+  }
+
   void handleClaimPage() {
     const bool recovery = deviceSecurity != nullptr &&
       deviceSecurity->claimState() == DeviceClaimState::CLAIMED &&
@@ -626,7 +737,7 @@ private:
   void handleMeasurementPolicyPage() {
     const MeasurementPolicyConfig& policy = activePolicy();
     String html = buildPageStart("量測複核政策", "/measurement_policy");
-    html.reserve(12288);
+    html.reserve(7168);
     html += "<section class='panel form-shell'><h2>目前政策</h2>";
     html += "<p class='helper-text'>此設定由診所管理者維護；每次變更必須使用更大的政策版本。";
     html += measurementReferencePolicyName();
@@ -728,6 +839,7 @@ private:
     candidate.urgentDiastolic = static_cast<int>(values[6]);
     candidate.staleAfterMs = values[7] * 1000U;
     const MeasurementPolicyResult result = measurementPolicyStore->update(candidate);
+    renderedPages.invalidate();  // 失敗時 store 可能已鎖定，一律重新輸出
     if (result == MeasurementPolicyResult::INVALID_POLICY) {
       server->send(400, "text/plain; charset=UTF-8",
                    "量測政策門檻或版本無效；未變更目前政策");
@@ -956,7 +1068,7 @@ private:
       "</script>";
 
     String html = buildPageStart("WiFi 設定", "/config", false, js);
-    html.reserve(8192); // reserve 必須在 buildPageStart 之後；含 CSS + scan 結果 dropdown
+    html.reserve(4096); // reserve 必須在 buildPageStart 之後；含 scan 結果 dropdown
     html += "<section class='panel form-shell'>";
     html += "<h2>網路連線設定</h2>";
     html += "<p class='helper-text'>選擇可用 WiFi，或使用手動輸入 SSID。儲存後裝置會自動重啟並嘗試連線。</p>";
@@ -1161,131 +1273,388 @@ private:
     }
   }
 
+  // 監控頁的輪詢/推送腳本；開頭接在 MONITOR_SCRIPT_STATE 輸出的初始狀態之後
+  static constexpr char kMonitorScript[] =
+    ";let bpRequestDeadlineMs=8000;"
+    "let bpLastReceiveObservedAt=Date.now();"
+    "let bpLastSuccessfulResponseAt=Date.now();"
+    "let bpLastPollSuccess='頁面載入';"
+    "let bpPollInFlight=false,bpPollTimer=0,bpWatchdogTimer=0;"
+    "let bpDeadlineTimer=0,bpAbortController=null,bpTimersStopped=false;"
+    "let bpEtag='',bpLastData=null,bpEvents=null;"
+    // 優先用 /api/events 推送；瀏覽器不支援或串流被拒時改回 3 秒條件式輪詢
+    "function bpListen(){"
+      "if(bpTimersStopped)return;"
+      "if(!window.EventSource){bpRefresh();return;}"
+      "bpEvents=new EventSource('/api/events');"
+      "const apply=(e)=>{"
+        "try{bpApply(JSON.parse(e.data),true);}"
+        "catch(err){bpConnectionProblem('poll-failure');}"
+      "};"
+      "for(const name of ['measurement','transport','diagnostic'])bpEvents.addEventListener(name,apply);"
+      "bpEvents.addEventListener('heartbeat',()=>{bpLastSuccessfulResponseAt=Date.now();});"
+      "bpEvents.onerror=()=>{"
+        "if(bpEvents&&bpEvents.readyState===EventSource.CLOSED){bpEvents=null;bpRefresh();}"
+      "};"
+    "}"
+    "async function bpRefresh(){"
+      "if(bpTimersStopped||bpPollInFlight)return;"
+      "if(document.hidden){bpSchedulePoll();return;}"
+      "bpPollInFlight=true;"
+      "bpAbortController=new AbortController();"
+      "bpDeadlineTimer=setTimeout(()=>{if(bpAbortController)bpAbortController.abort();},bpRequestDeadlineMs);"
+      "try{"
+      "const r=await fetch('/api/latest',{cache:'no-store',signal:bpAbortController.signal,"
+        "headers:bpEtag?{'If-None-Match':bpEtag}:{}});"
+      "const unchanged=r.status===304&&bpLastData!==null;"
+      "if(!unchanged&&!r.ok)throw new Error('poll-failure');"
+      "const d=unchanged?bpLastData:await r.json();"
+      "if(!unchanged){bpLastData=d;bpEtag=r.headers.get('ETag')||'';}"
+      "bpApply(d,!unchanged);"
+      "}catch(e){"
+        "bpConnectionProblem(e&&e.name==='AbortError'?'request-timeout':'poll-failure');"
+      "}finally{"
+        "clearTimeout(bpDeadlineTimer);bpDeadlineTimer=0;bpAbortController=null;"
+        "bpPollInFlight=false;bpSchedulePoll();"
+      "}"
+    "}"
+    // 輪詢回應與推送事件共用；changed 為 false 表示 304 沿用上次的內容
+    "function bpApply(d,changed){"
+      "if(String(d.policy_version)!==bpPolicyVersion){location.reload();return;}"
+      "if(String(d.revision)!==bpRevision){location.reload();return;}"
+      "const now=Date.now();"
+      "bpLastSuccessfulResponseAt=now;"
+      // 304 沿用上次的 age 觀測點，由本地時鐘繼續推進
+      "if(changed){"
+        "bpLastReceiveAgeMs=bpBoundedAge(d.last_successful_receive_age_ms);"
+        "bpLastReceiveObservedAt=now;"
+      "}"
+      "bpLastPollSuccess=new Date().toLocaleTimeString('zh-TW',{hour12:false});"
+      "const t=document.getElementById('conn-transport');if(t)t.textContent=d.transport_name;"
+      "const s=document.getElementById('conn-status');if(s)s.textContent=d.transport_status;"
+      "const ip=document.getElementById('conn-ip');if(ip)ip.textContent=d.wifi_ip||'未連線';"
+      "const x=document.getElementById('diagnostic-state');if(x)x.textContent=d.diagnostic_state;"
+      "const loss=document.getElementById('data-loss-count');if(loss)loss.textContent=d.data_loss_count;"
+      "const reconnect=document.getElementById('reconnect-count');if(reconnect)reconnect.textContent=d.reconnect_count;"
+      "const age=bpLastReceiveAgeMs===null?null:"
+        "bpLastReceiveAgeMs+Math.max(0,now-bpLastReceiveObservedAt);"
+      "bpFreshness(d.freshness_state,d.freshness_label,age,false);"
+      "if(d.count>0){"
+        "if(!document.getElementById('kpi-sys')){location.reload();return;}"
+        "const v=d.valid===true;"
+        "bpKpi('kpi-sys','pill-sys',d.systolic,d.review_state,d.review_label,v&&d.systolic>0);"
+        "bpKpi('kpi-dia','pill-dia',d.diastolic,d.review_state,d.review_label,v&&d.diastolic>0);"
+        "bpKpi('kpi-pul','pill-pul',d.pulse,d.review_state,d.review_label,v&&d.pulse>0);"
+        "const u=document.getElementById('last-updated');"
+        "if(u)u.textContent='最後更新：'+d.timestamp+'（即時更新）';"
+      "}else if(document.getElementById('kpi-sys')){"
+        "location.reload();"
+      "}"
+    "}"
+    "function bpSchedulePoll(){"
+      "if(bpTimersStopped)return;clearTimeout(bpPollTimer);"
+      "bpPollTimer=setTimeout(bpRefresh,3000);"
+    "}"
+    "function bpBoundedAge(value){"
+      "if(value===null||value===undefined)return null;const text=String(value);"
+      "if(!/^[0-9]+$/.test(text)||text.length>15)return bpStaleAfterMs;"
+      "const age=Number(text);"
+      "return Number.isSafeInteger(age)&&age>=0?Math.min(age,bpStaleAfterMs):bpStaleAfterMs;"
+    "}"
+    "function bpConnectionProblem(reason){"
+      "const b=document.getElementById('measurement-freshness');"
+      "if(b){b.dataset.state='disconnected';b.dataset.reason=reason;"
+      "b.textContent='資料更新中斷；畫面可能過期。請檢查資料通道並重新整理。最後成功更新：'+bpLastPollSuccess;}"
+      "const s=document.getElementById('conn-status');if(s)s.textContent='資料輪詢無回應';"
+    "}"
+    "function bpWatchdog(){"
+      "if(bpTimersStopped)return;const now=Date.now();"
+      "const responseAge=Math.max(0,now-bpLastSuccessfulResponseAt);"
+      "const receiveAge=bpLastReceiveAgeMs===null?null:"
+        "bpLastReceiveAgeMs+Math.max(0,now-bpLastReceiveObservedAt);"
+      "if(responseAge>=bpRequestDeadlineMs){"
+        "bpConnectionProblem('watchdog-timeout');return;"
+      "}"
+      "if(receiveAge!==null&&receiveAge>=bpStaleAfterMs){"
+        "bpFreshness('stale','已逾時',receiveAge,true);"
+      "}"
+    "}"
+    "function bpStopTimers(){"
+      "bpTimersStopped=true;clearTimeout(bpPollTimer);clearTimeout(bpDeadlineTimer);"
+      "clearInterval(bpWatchdogTimer);if(bpAbortController)bpAbortController.abort();"
+      "if(bpEvents){bpEvents.close();bpEvents=null;}"
+    "}"
+    "function bpFreshness(state,label,age,needsAction){"
+      "const b=document.getElementById('measurement-freshness');if(!b)return;"
+      "b.dataset.state=state;let suffix='';"
+      "if(age!==null&&age!==undefined)suffix='；最後成功接收約 '+Math.floor(age/1000)+' 秒前';"
+      "if(needsAction)suffix+='；請重新量測並確認資料通道';"
+      "b.textContent='資料新鮮度：'+label+suffix;"
+    "}"
+    "function bpKpi(iv,ip,v,state,label,ok){"
+      "const a=document.getElementById(iv),b=document.getElementById(ip);"
+      "if(!ok){"
+        "if(a){a.textContent='—';a.className='kpi-value value-na';}"
+        "if(b){b.textContent='未解析';b.className='state-pill state-na';}"
+        "return;"
+      "}"
+      "const review=state!=='within_reference';"
+      "if(a){a.textContent=v;a.className='kpi-value '+(review?'value-bad':'value-good');}"
+      "if(b){b.textContent=label;b.className='state-pill '+(review?'state-alert':'state-ok');}"
+    "}"
+    "bpWatchdogTimer=setInterval(bpWatchdog,1000);"
+    "window.addEventListener('pagehide',bpStopTimers,{once:true});"
+    "window.addEventListener('pageshow',(event)=>{if(event.persisted)location.reload();});"
+    "bpListen();"
+    "</script>";
+
+  static constexpr bp_html::HtmlSegment kMonitorPage[] = {
+    bp_html::htmlSlot(MONITOR_PAGE_START),
+    bp_html::htmlSlot(MONITOR_FRESHNESS),
+    bp_html::htmlSlot(MONITOR_LATEST),
+    bp_html::htmlSlot(MONITOR_RECENT),
+    bp_html::htmlLiteral(
+      "<details class='panel diagnostic-data' role='status' aria-live='polite'>"
+      "<summary>接收診斷</summary>"),
+    bp_html::htmlSlot(MONITOR_DIAGNOSTIC),
+    bp_html::htmlLiteral("</details>"),
+    bp_html::htmlSlot(MONITOR_LATENCY),
+    bp_html::htmlLiteral(
+      "<section class='panel'>"
+      "<h2>連線資訊</h2>"
+      "<ul class='status-list'>"
+      "<li><span>設備名稱</span><strong>BP_checker</strong></li>"
+      "<li><span>血壓機型號</span><strong>"),
+    bp_html::htmlSlot(MONITOR_CONNECTION),
+    bp_html::htmlLiteral("</ul></section>"),
+    bp_html::htmlSlot(MONITOR_RESET_CONTROL),
+    bp_html::htmlLiteral("<script>let bpRevision='"),
+    bp_html::htmlSlot(MONITOR_SCRIPT_STATE),
+    bp_html::htmlLiteral(kMonitorScript),
+    bp_html::htmlLiteral(kPageEnd),
+  };
+
   void handleMonitor() {
-    String html = buildPageStart("血壓監控儀表板", "/", false);
-    html.reserve(14336);
+    MonitorStream& stream = monitorStreams[server->currentSlot()];
+    stream.owner = this;
+    stream.nowMs = uptimeClock == nullptr ? 0 : uptimeClock->nowMs();
+    stream.snapshot = latestSnapshot();
+    // 角色在 handler 回傳後就清掉，導覽與維護區塊依這份副本輸出
+    stream.role = server->currentRole();
+    stream.page.begin(kMonitorPage);
+    noteMeasurementServed(stream.snapshot);
+    (void)server->sendStream(200, "text/html; charset=UTF-8",
+                             &WebHandler::fillMonitorStream, &stream);
+  }
 
-    const uint64_t nowMs = uptimeClock == nullptr ? 0 : uptimeClock->nowMs();
-    const int recordCount = recordManager->getRecordCount();
-    const MeasurementFreshnessState freshness = latestFreshness(nowMs);
+  static bp_http::StreamFill streamFill(bp_html::RenderProgress progress) {
+    switch (progress) {
+      case bp_html::RenderProgress::DONE:
+        return bp_http::StreamFill::DONE;
+      case bp_html::RenderProgress::FULL:
+        return bp_http::StreamFill::MORE;
+      default:
+        return bp_http::StreamFill::FAILED;
+    }
+  }
+
+  static bp_http::StreamFill fillMonitorStream(void* context, uint8_t* window,
+                                               size_t capacity,
+                                               size_t& written) {
+    MonitorStream& stream = *static_cast<MonitorStream*>(context);
+    written = 0;
+    return streamFill(stream.page.render(
+      reinterpret_cast<char*>(window), capacity, written,
+      &WebHandler::renderMonitorSlot, &stream));
+  }
+
+  static void renderMonitorSlot(void* context, uint8_t slot,
+                                bp_html::BoundedHtmlWriter& html) {
+    MonitorStream& stream = *static_cast<MonitorStream*>(context);
+    stream.owner->writeMonitorSlot(stream, slot, html);
+  }
+
+  // 同一個 slot 放不下時會在下一個視窗重寫，這裡只讀不改狀態。
+  template <typename Out>
+  void writeMonitorSlot(const MonitorStream& stream, uint8_t slot,
+                        Out& html) const {
+    const MeasurementSnapshot& snapshot = stream.snapshot;
+    switch (slot) {
+      case MONITOR_PAGE_START:
+        appendPageStart(html, "血壓監控儀表板", "/", stream.role, false, "");
+        break;
+      case MONITOR_FRESHNESS:
+        appendMonitorFreshness(html, stream);
+        break;
+      case MONITOR_LATEST:
+        appendMonitorLatest(html, snapshot);
+        break;
+      case MONITOR_RECENT:
+        if (snapshot.recordCount > 0) appendMonitorRecent(html);
+        break;
+      case MONITOR_DIAGNOSTIC:
+        if (snapshot.diagnostic.isWaiting()) {
+          html += "<p class='helper-text'>等待數據...</p>";
+        } else {
+          appendReceiveDiagnosticHtml(html, snapshot.diagnostic);
+        }
+        break;
+      case MONITOR_LATENCY:
+        appendLatencyTraceHtml(html);
+        break;
+      case MONITOR_CONNECTION:
+        appendMonitorConnection(html, snapshot);
+        break;
+      case MONITOR_RESET_CONTROL:
+        if (bp_web::surfaceVisible(stream.role,
+                                   bp_web::WebSurface::RESET_CONTROL)) {
+          html += "<section class='panel danger-zone'>";
+          html += "<h3>僅限管理者：維護操作</h3>";
+          html += "<p class='helper-text'>若要重新配網，可重置 WiFi 設定並重啟。</p>";
+          html += "<form method='post' action='/reset' onsubmit=\"return confirm('確定要重置 WiFi 設定並重啟嗎？');\" style='display:inline'>";
+          html += "<button type='submit' class='btn btn-danger'>重置 WiFi 設定</button>";
+          html += "</form></section>";
+        }
+        break;
+      case MONITOR_SCRIPT_STATE:
+        appendMonitorScriptState(html, stream);
+        break;
+      default:
+        break;
+    }
+  }
+
+  template <typename Out>
+  void appendMonitorFreshness(Out& html, const MonitorStream& stream) const {
+    const MeasurementFreshnessState freshness =
+      latestFreshness(stream.snapshot, stream.nowMs);
     html += "<div id='measurement-freshness' class='freshness-banner' data-state='";
     html += measurementFreshnessCode(freshness);
     html += "' role='status' aria-live='polite'>資料新鮮度：";
     html += measurementFreshnessLabel(freshness);
     html += "</div>";
+  }
 
-    if (recordCount > 0) {
-      const BPData& latest = recordManager->getLatestRecord();
-      const bool sysOk = latest.valid && latest.systolic > 0;
-      const bool diaOk = latest.valid && latest.diastolic > 0;
-      const bool pulOk = latest.valid && latest.pulse > 0;
-      const MeasurementReviewState review =
-        classifyMeasurement(latest, activePolicy());
-
-      html += "<section class='panel latest-vitals'>";
-      html += "<div class='section-head'><h2>最新量測</h2>";
-      html += "<span id='last-updated' class='last-updated'>最後更新：";
-      html += latest.timestamp;
-      html += "（每 3 秒刷新）</span></div>";
-      html += "<p class='helper-text'><strong>複核提示：</strong>";
-      html += measurementReviewLabel(review);
-      html += "。";
-      html += measurementReferencePolicyName();
-      html += "。目前政策：";
-      html += htmlEscape(String(activePolicy().policyName));
-      html += " v";
-      html += activePolicy().policyVersion;
-      html += "。</p>";
-      html += "<div class='kpi-grid'>";
-
-      renderKpiCard(html, "kpi-sys", "pill-sys", "收縮壓", "mmHg",
-                    latest.systolic, sysOk, review);
-      renderKpiCard(html, "kpi-dia", "pill-dia", "舒張壓", "mmHg",
-                    latest.diastolic, diaOk, review);
-      renderKpiCard(html, "kpi-pul", "pill-pul", "脈搏", "bpm",
-                    latest.pulse, pulOk, review);
-
-      html += "</div><p class='helper-text'>";
-      html += repeatedMeasurementGuidance();
-      html += "</p><p class='helper-text'><strong>交接序號：</strong>記錄 ";
-      appendUInt64(html, latest.recordSequence);
-      html += "；量測工作階段 ";
-      appendUInt64(html, latest.sessionSequence);
-      html += "。僅將此不識別序號交給受信任的診所流程。</p></section>";
-
-      html += "<section class='panel recent-table'>";
-      html += "<div class='section-head'>";
-      html += "<h2>最近 5 筆數據</h2>";
-      html += "<a class='btn btn-ghost' href='/history'>查看完整歷史</a>";
-      html += "</div>";
-      html += "<div class='table-scroll'><table>";
-      html += "<caption>最近五筆不識別量測記錄</caption><thead><tr>";
-      html += "<th scope='col'>記錄序號</th><th scope='col'>測量時間</th>";
-      html += "<th scope='col'>時間來源</th>";
-      html += "<th scope='col'>收縮壓 (mmHg)</th><th scope='col'>舒張壓 (mmHg)</th>";
-      html += "<th scope='col'>脈搏 (bpm)</th><th scope='col'>品質</th>";
-      html += "<th scope='col'>複核提示</th></tr></thead><tbody>";
-
-      const int displayCount = min(5, recordCount);
-      for (int i = 0; i < displayCount; i++) {
-        const BPData& record = recordManager->getRecord(i);
-        html += "<tr><td>";
-        appendUInt64(html, record.recordSequence);
-        html += "</td><td>";
-        html += record.timestamp;
-        html += "</td><td>";
-        html += timestampSourceCode(record.timestampSource);
-        html += "</td>";
-        renderTableValueCell(html, record.systolic, record.valid);
-        renderTableValueCell(html, record.diastolic, record.valid);
-        renderTableValueCell(html, record.pulse, record.valid);
-        html += "<td>";
-        html += measurementQualityCode(record.quality);
-        html += record.movementCount > 0 ? "（偵測到移動）" : "（未偵測到移動）";
-        html += "</td><td>";
-        html += measurementReviewLabel(
-          classifyMeasurement(record, activePolicy()));
-        html += "</td>";
-        html += "</tr>";
-      }
-
-      html += "</tbody></table></div></section>";
-    } else {
+  template <typename Out>
+  void appendMonitorLatest(Out& html,
+                           const MeasurementSnapshot& snapshot) const {
+    if (snapshot.recordCount <= 0) {
       html += "<section class='panel latest-vitals'>";
       html += "<h2>最新量測</h2>";
       html += "<p class='helper-text'>尚未收到血壓數據。請先確認目前資料通道狀態，再檢查血壓機連線。</p>";
-      html += "<span class='last-updated'>每 3 秒自動刷新</span>";
+      html += "<span class='last-updated'>自動即時更新</span>";
       html += "</section>";
+      return;
     }
+    // snapshot 的 POD 記錄直接分類與輸出，不轉成帶 String 的 BPData
+    const MeasurementSnapshotRecord& latest = snapshot.latest;
+    const bool sysOk = latest.valid && latest.systolic > 0;
+    const bool diaOk = latest.valid && latest.diastolic > 0;
+    const bool pulOk = latest.valid && latest.pulse > 0;
+    const MeasurementReviewState review =
+      classifyMeasurement(latest, activePolicy());
+
+    html += "<section class='panel latest-vitals'>";
+    html += "<div class='section-head'><h2>最新量測</h2>";
+    html += "<span id='last-updated' class='last-updated'>最後更新：";
+    html += latest.timestamp;
+    html += "（即時更新）</span></div>";
+    html += "<p class='helper-text'><strong>複核提示：</strong>";
+    html += measurementReviewLabel(review);
+    html += "。";
+    html += measurementReferencePolicyName();
+    html += "。目前政策：";
+    bp_html::appendHtmlEscaped(html, activePolicy().policyName);
+    html += " v";
+    html += activePolicy().policyVersion;
+    html += "。</p>";
+    html += "<div class='kpi-grid'>";
+
+    renderKpiCard(html, "kpi-sys", "pill-sys", "收縮壓", "mmHg",
+                  latest.systolic, sysOk, review);
+    renderKpiCard(html, "kpi-dia", "pill-dia", "舒張壓", "mmHg",
+                  latest.diastolic, diaOk, review);
+    renderKpiCard(html, "kpi-pul", "pill-pul", "脈搏", "bpm",
+                  latest.pulse, pulOk, review);
+
+    html += "</div><p class='helper-text'>";
+    html += repeatedMeasurementGuidance();
+    html += "</p><p class='helper-text'><strong>交接序號：</strong>記錄 ";
+    appendUInt64(html, latest.recordSequence);
+    html += "；量測工作階段 ";
+    appendUInt64(html, latest.sessionSequence);
+    html += "。僅將此不識別序號交給受信任的診所流程。</p></section>";
+  }
 
-    html += "<details class='panel diagnostic-data' role='status' aria-live='polite'>";
-    html += "<summary>接收診斷</summary>";
-    if (*lastData == "") {
-      html += "<p class='helper-text'>等待數據...</p>";
-    } else {
-      html += *lastData;
+  template <typename Out>
+  void appendMonitorRecent(Out& html) const {
+    html += "<section class='panel recent-table'>";
+    html += "<div class='section-head'>";
+    html += "<h2>最近 5 筆數據</h2>";
+    html += "<a class='btn btn-ghost' href='/history'>查看完整歷史</a>";
+    html += "</div>";
+    html += "<div class='table-scroll'><table>";
+    html += "<caption>最近五筆不識別量測記錄</caption><thead><tr>";
+    html += "<th scope='col'>記錄序號</th><th scope='col'>測量時間</th>";
+    html += "<th scope='col'>時間來源</th>";
+    html += "<th scope='col'>收縮壓 (mmHg)</th><th scope='col'>舒張壓 (mmHg)</th>";
+    html += "<th scope='col'>脈搏 (bpm)</th><th scope='col'>品質</th>";
+    html += "<th scope='col'>複核提示</th></tr></thead><tbody>";
+
+    // 最近記錄表格在 main loop 直接讀 record manager；snapshot 只承載最新一筆。
+    const int displayCount = min(5, recordManager->getRecordCount());
+    for (int i = 0; i < displayCount; i++) {
+      const BPData& record = recordManager->getRecord(i);
+      html += "<tr><td>";
+      appendUInt64(html, record.recordSequence);
+      html += "</td><td>";
+      html += record.timestamp.c_str();
+      html += "</td><td>";
+      html += timestampSourceCode(record.timestampSource);
+      html += "</td>";
+      renderTableValueCell(html, record.systolic, record.valid);
+      renderTableValueCell(html, record.diastolic, record.valid);
+      renderTableValueCell(html, record.pulse, record.valid);
+      html += "<td>";
+      html += measurementQualityCode(record.quality);
+      html += record.movementCount > 0 ? "（偵測到移動）" : "（未偵測到移動）";
+      html += "</td><td>";
+      html += measurementReviewLabel(
+        classifyMeasurement(record, activePolicy()));
+      html += "</td>";
+      html += "</tr>";
     }
-    html += "</details>";
 
-    // ternary 兩端需 common type，會多生一個 String temp；改 if/else 直接 assign
-    String wifiIp;
-    if (WiFi.status() == WL_CONNECTED) wifiIp = WiFi.localIP().toString();
-    else wifiIp = "未連線";
-    html += "<section class='panel'>";
-    html += "<h2>連線資訊</h2>";
-    html += "<ul class='status-list'>";
-    html += "<li><span>設備名稱</span><strong>BP_checker</strong></li>";
-    html += "<li><span>血壓機型號</span><strong>";
-    html += htmlEscape(*bp_model);
+    html += "</tbody></table></div></section>";
+  }
+
+  // IP 逐段寫數字，免 IPAddress::toString() 的 String 配置
+  template <typename Out>
+  static void appendWifiIp(Out& html) {
+    if (WiFi.status() != WL_CONNECTED) {
+      html += "未連線";
+      return;
+    }
+    const IPAddress ip = WiFi.localIP();
+    for (int octet = 0; octet < 4; ++octet) {
+      if (octet > 0) html += '.';
+      html += static_cast<unsigned>(ip[octet]);
+    }
+  }
+
+  template <typename Out>
+  void appendMonitorConnection(Out& html,
+                               const MeasurementSnapshot& snapshot) const {
+    bp_html::appendHtmlEscaped(html, bp_model->c_str());
     html += "</strong></li>";
     html += "<li><span>資料通道</span><strong id='conn-transport'>";
-    html += *transportName;
+    html += transportName->c_str();
     html += "</strong></li>";
     html += "<li><span>通道狀態</span><strong id='conn-status'>";
-    html += *transportStatus;
+    html += transportStatus->c_str();
     html += "</strong></li>";
     html += "<li><span>接收診斷狀態</span><strong id='diagnostic-state'>";
-    html += sanitizedDiagnosticState();
+    html += sanitizedDiagnosticState(snapshot);
     html += "</strong></li>";
     html += "<li><span>韌體版本</span><strong>" BP_FIRMWARE_VERSION
             "（" BP_BUILD_SHA "）</strong></li>";
@@ -1293,38 +1662,32 @@ private:
     html += supportedMeasurementProtocol();
     html += "</strong></li>";
     html += "<li><span>資料遺失事件</span><strong id='data-loss-count'>";
-    html += monitorTransport == nullptr ? 0U : monitorTransport->dataLossCount();
+    html += snapshot.transport.dataLossCount;
     html += "</strong></li><li><span>重新連線次數</span><strong id='reconnect-count'>";
-    html += monitorTransport == nullptr ? 0U : monitorTransport->reconnectCount();
+    html += snapshot.transport.reconnectCount;
     html += "</strong></li>";
+    appendDeviceStatusItems(html, snapshot.transport);
     html += "<li><span>WiFi IP</span><strong id='conn-ip'>";
-    html += wifiIp;
+    appendWifiIp(html);
     html += "</strong></li>";
     html += "<li><span>可訪問網址</span><strong>http://";
-    html += hostname; // const char* via String += overload, no temporary
+    html += hostname;
     html += ".local</strong></li>";
     // AP 密碼不顯示在頁面上（任何連上網頁的人都看得到 dashboard）
     html += "<li><span>AP 熱點</span><strong>";
     html += ap_ssid;
     html += "</strong></li>";
-    html += "</ul>";
-    html += "</section>";
-
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::RESET_CONTROL)) {
-      html += "<section class='panel danger-zone'>";
-      html += "<h3>僅限管理者：維護操作</h3>";
-      html += "<p class='helper-text'>若要重新配網，可重置 WiFi 設定並重啟。</p>";
-      html += "<form method='post' action='/reset' onsubmit=\"return confirm('確定要重置 WiFi 設定並重啟嗎？');\" style='display:inline'>";
-      html += "<button type='submit' class='btn btn-danger'>重置 WiFi 設定</button>";
-      html += "</form></section>";
-    }
+  }
 
+  // 腳本的初始狀態；接在 "<script>let bpRevision='" 之後、kMonitorScript 之前
+  template <typename Out>
+  void appendMonitorScriptState(Out& html, const MonitorStream& stream) const {
+    const MeasurementSnapshot& snapshot = stream.snapshot;
+    const uint64_t nowMs = stream.nowMs;
     uint64_t initialReceiveAgeMs = 0;
     const bool hasInitialReceiveAge =
-      recordManager->lastSuccessfulReceiveAgeMs(nowMs, initialReceiveAgeMs);
-    html += "<script>let bpRevision='";
-    appendUInt64(html, recordManager->getRevision());
+      snapshot.lastSuccessfulReceiveAgeMs(nowMs, initialReceiveAgeMs);
+    appendUInt64(html, snapshot.revision);
     html += "';let bpPolicyVersion='";
     html += activePolicy().policyVersion;
     html += "';let bpStaleAfterMs=";
@@ -1337,226 +1700,448 @@ private:
     } else {
       html += "null";
     }
-    html += F(
-      ";let bpRequestDeadlineMs=8000;"
-      "let bpLastReceiveObservedAt=Date.now();"
-      "let bpLastSuccessfulResponseAt=Date.now();"
-      "let bpLastPollSuccess='頁面載入';"
-      "let bpPollInFlight=false,bpPollTimer=0,bpWatchdogTimer=0;"
-      "let bpDeadlineTimer=0,bpAbortController=null,bpTimersStopped=false;"
-      "async function bpRefresh(){"
-        "if(bpTimersStopped||bpPollInFlight)return;"
-        "if(document.hidden){bpSchedulePoll();return;}"
-        "bpPollInFlight=true;"
-        "bpAbortController=new AbortController();"
-        "bpDeadlineTimer=setTimeout(()=>{if(bpAbortController)bpAbortController.abort();},bpRequestDeadlineMs);"
-        "try{"
-        "const r=await fetch('/api/latest',{cache:'no-store',signal:bpAbortController.signal});"
-        "if(!r.ok)throw new Error('poll-failure');"
-        "const d=await r.json();"
-        "if(String(d.policy_version)!==bpPolicyVersion){location.reload();return;}"
-        "if(String(d.revision)!==bpRevision){location.reload();return;}"
-        "const now=Date.now();"
-        "bpLastSuccessfulResponseAt=now;"
-        "bpLastReceiveAgeMs=bpBoundedAge(d.last_successful_receive_age_ms);"
-        "bpLastReceiveObservedAt=now;"
-        "bpLastPollSuccess=new Date().toLocaleTimeString('zh-TW',{hour12:false});"
-        "const t=document.getElementById('conn-transport');if(t)t.textContent=d.transport_name;"
-        "const s=document.getElementById('conn-status');if(s)s.textContent=d.transport_status;"
-        "const ip=document.getElementById('conn-ip');if(ip)ip.textContent=d.wifi_ip||'未連線';"
-        "const x=document.getElementById('diagnostic-state');if(x)x.textContent=d.diagnostic_state;"
-        "const loss=document.getElementById('data-loss-count');if(loss)loss.textContent=d.data_loss_count;"
-        "const reconnect=document.getElementById('reconnect-count');if(reconnect)reconnect.textContent=d.reconnect_count;"
-        "bpFreshness(d.freshness_state,d.freshness_label,bpLastReceiveAgeMs,false);"
-        "if(d.count>0){"
-          "if(!document.getElementById('kpi-sys')){location.reload();return;}"
-          "const v=d.valid===true;"
-          "bpKpi('kpi-sys','pill-sys',d.systolic,d.review_state,d.review_label,v&&d.systolic>0);"
-          "bpKpi('kpi-dia','pill-dia',d.diastolic,d.review_state,d.review_label,v&&d.diastolic>0);"
-          "bpKpi('kpi-pul','pill-pul',d.pulse,d.review_state,d.review_label,v&&d.pulse>0);"
-          "const u=document.getElementById('last-updated');"
-          "if(u)u.textContent='最後更新：'+d.timestamp+'（每 3 秒刷新）';"
-        "}else if(document.getElementById('kpi-sys')){"
-          "location.reload();return;"
-        "}}catch(e){"
-          "bpConnectionProblem(e&&e.name==='AbortError'?'request-timeout':'poll-failure');"
-        "}finally{"
-          "clearTimeout(bpDeadlineTimer);bpDeadlineTimer=0;bpAbortController=null;"
-          "bpPollInFlight=false;bpSchedulePoll();"
-        "}"
-      "}"
-      "function bpSchedulePoll(){"
-        "if(bpTimersStopped)return;clearTimeout(bpPollTimer);"
-        "bpPollTimer=setTimeout(bpRefresh,3000);"
-      "}"
-      "function bpBoundedAge(value){"
-        "if(value===null||value===undefined)return null;const text=String(value);"
-        "if(!/^[0-9]+$/.test(text)||text.length>15)return bpStaleAfterMs;"
-        "const age=Number(text);"
-        "return Number.isSafeInteger(age)&&age>=0?Math.min(age,bpStaleAfterMs):bpStaleAfterMs;"
-      "}"
-      "function bpConnectionProblem(reason){"
-        "const b=document.getElementById('measurement-freshness');"
-        "if(b){b.dataset.state='disconnected';b.dataset.reason=reason;"
-        "b.textContent='資料更新中斷；畫面可能過期。請檢查資料通道並重新整理。最後成功更新：'+bpLastPollSuccess;}"
-        "const s=document.getElementById('conn-status');if(s)s.textContent='資料輪詢無回應';"
-      "}"
-      "function bpWatchdog(){"
-        "if(bpTimersStopped)return;const now=Date.now();"
-        "const responseAge=Math.max(0,now-bpLastSuccessfulResponseAt);"
-        "const receiveAge=bpLastReceiveAgeMs===null?null:"
-          "bpLastReceiveAgeMs+Math.max(0,now-bpLastReceiveObservedAt);"
-        "if(responseAge>=bpRequestDeadlineMs){"
-          "bpConnectionProblem('watchdog-timeout');return;"
-        "}"
-        "if(receiveAge!==null&&receiveAge>=bpStaleAfterMs){"
-          "bpFreshness('stale','已逾時',receiveAge,true);"
-        "}"
-      "}"
-      "function bpStopTimers(){"
-        "bpTimersStopped=true;clearTimeout(bpPollTimer);clearTimeout(bpDeadlineTimer);"
-        "clearInterval(bpWatchdogTimer);if(bpAbortController)bpAbortController.abort();"
-      "}"
-      "function bpFreshness(state,label,age,needsAction){"
-        "const b=document.getElementById('measurement-freshness');if(!b)return;"
-        "b.dataset.state=state;let suffix='';"
-        "if(age!==null&&age!==undefined)suffix='；最後成功接收約 '+Math.floor(age/1000)+' 秒前';"
-        "if(needsAction)suffix+='；請重新量測並確認資料通道';"
-        "b.textContent='資料新鮮度：'+label+suffix;"
-      "}"
-      "function bpKpi(iv,ip,v,state,label,ok){"
-        "const a=document.getElementById(iv),b=document.getElementById(ip);"
-        "if(!ok){"
-          "if(a){a.textContent='—';a.className='kpi-value value-na';}"
-          "if(b){b.textContent='未解析';b.className='state-pill state-na';}"
-          "return;"
-        "}"
-        "const review=state!=='within_reference';"
-        "if(a){a.textContent=v;a.className='kpi-value '+(review?'value-bad':'value-good');}"
-        "if(b){b.textContent=label;b.className='state-pill '+(review?'state-alert':'state-ok');}"
-      "}"
-      "bpWatchdogTimer=setInterval(bpWatchdog,1000);"
-      "window.addEventListener('pagehide',bpStopTimers,{once:true});"
-      "window.addEventListener('pageshow',(event)=>{if(event.persisted)location.reload();});"
-      "bpRefresh();"
-      "</script>"
-    );
-
-    html += buildPageEnd();
-    server->send(200, "text/html; charset=UTF-8", html);
   }
 
+  static constexpr bp_html::HtmlSegment kHistoryPageHead[] = {
+    bp_html::htmlSlot(HISTORY_PAGE_START),
+    bp_html::htmlLiteral(
+      "<section class='panel history-table'>"
+      "<div class='section-head'>"
+      "<h2>所有歷史數據</h2>"
+      "<div class='inline-actions'>"
+      "<a href='/export.csv' class='btn btn-secondary'>匯出 CSV</a>"
+      "<a href='/' class='btn btn-ghost'>返回監控</a>"
+      "</div>"
+      "</div>"
+      "<div class='table-scroll'><table>"
+      "<caption>已保存的不識別量測歷史</caption><thead><tr>"
+      "<th scope='col'>記錄序號</th><th scope='col'>工作階段序號</th>"
+      "<th scope='col'>測量時間</th><th scope='col'>時間來源</th>"
+      "<th scope='col'>收縮壓 (mmHg)</th>"
+      "<th scope='col'>舒張壓 (mmHg)</th><th scope='col'>脈搏 (bpm)</th>"
+      "<th scope='col'>品質</th><th scope='col'>複核提示</th></tr></thead><tbody>"),
+  };
+
+  static constexpr bp_html::HtmlSegment kHistoryPageTail[] = {
+    bp_html::htmlSlot(HISTORY_EMPTY_ROW),
+    bp_html::htmlLiteral("</tbody></table></div></section>"),
+    bp_html::htmlSlot(HISTORY_CLEAR_CONTROL),
+    bp_html::htmlLiteral(kPageEnd),
+  };
+
   void handleHistory() {
-    String html = buildPageStart("血壓歷史記錄", "/history");
-    // reserve 必須在 buildPageStart 回傳之後（move-assignment 會把容量重設）。
-    // CSS ~4.5KB + nav/header ~700B + 20 列表（~250B/row × 20 = 5KB）+ danger zone ~300B
-    html.reserve(12288);
+    HistoryStream& stream = beginHistoryStream(HistoryStreamKind::HTML);
+    stream.page.begin(kHistoryPageHead);
+    // 角色在 handler 回傳後就清掉，危險區塊是否顯示要先記下
+    stream.clearControl = bp_web::surfaceVisible(
+      server->currentRole(), bp_web::WebSurface::CLEAR_HISTORY_CONTROL);
+    sendHistoryStream(stream, "text/html; charset=UTF-8");
+  }
 
-    html += "<section class='panel history-table'>";
-    html += "<div class='section-head'>";
-    html += "<h2>所有歷史數據</h2>";
-    html += "<div class='inline-actions'>";
-    html += "<a href='/export.csv' class='btn btn-secondary'>匯出 CSV</a>";
-    html += "<a href='/' class='btn btn-ghost'>返回監控</a>";
-    html += "</div>";
-    html += "</div>";
+  template <typename Out>
+  void appendHistoryTableRow(Out& html, const BPData& record) const {
+    html += "<tr><td>";
+    appendUInt64(html, record.recordSequence);
+    html += "</td><td>";
+    appendUInt64(html, record.sessionSequence);
+    html += "</td><td>";
+    html += record.timestamp.c_str();
+    html += "</td><td>";
+    html += timestampSourceCode(record.timestampSource);
+    html += "</td>";
+    renderTableValueCell(html, record.systolic, record.valid);
+    renderTableValueCell(html, record.diastolic, record.valid);
+    renderTableValueCell(html, record.pulse, record.valid);
+    html += "<td>";
+    html += measurementQualityCode(record.quality);
+    html += record.movementCount > 0 ? "（偵測到移動）" : "（未偵測到移動）";
+    html += "</td><td>";
+    html += measurementReviewLabel(
+      classifyMeasurement(record, activePolicy()));
+    html += "</td>";
+    html += "</tr>";
+  }
 
-    html += "<div class='table-scroll'><table>";
-    html += "<caption>已保存的不識別量測歷史</caption><thead><tr>";
-    html += "<th scope='col'>記錄序號</th><th scope='col'>工作階段序號</th>";
-    html += "<th scope='col'>測量時間</th><th scope='col'>時間來源</th>";
-    html += "<th scope='col'>收縮壓 (mmHg)</th>";
-    html += "<th scope='col'>舒張壓 (mmHg)</th><th scope='col'>脈搏 (bpm)</th>";
-    html += "<th scope='col'>品質</th><th scope='col'>複核提示</th></tr></thead><tbody>";
-
-    int recordCount = recordManager->getRecordCount();
-    if (recordCount > 0) {
-      for (int i = 0; i < recordCount; i++) {
-        const BPData& record = recordManager->getRecord(i);
-        html += "<tr><td>";
-        appendUInt64(html, record.recordSequence);
-        html += "</td><td>";
-        appendUInt64(html, record.sessionSequence);
-        html += "</td><td>";
-        html += record.timestamp;
-        html += "</td><td>";
-        html += timestampSourceCode(record.timestampSource);
-        html += "</td>";
-        renderTableValueCell(html, record.systolic, record.valid);
-        renderTableValueCell(html, record.diastolic, record.valid);
-        renderTableValueCell(html, record.pulse, record.valid);
-        html += "<td>";
-        html += measurementQualityCode(record.quality);
-        html += record.movementCount > 0 ? "（偵測到移動）" : "（未偵測到移動）";
-        html += "</td><td>";
-        html += measurementReviewLabel(
-          classifyMeasurement(record, activePolicy()));
-        html += "</td>";
-        html += "</tr>";
+  static void renderHistorySlot(void* context, uint8_t slot,
+                                bp_html::BoundedHtmlWriter& html) {
+    const HistoryStream& stream = *static_cast<HistoryStream*>(context);
+    switch (slot) {
+      case HISTORY_PAGE_START:
+        appendPageStart(html, "血壓歷史記錄", "/history", stream.role, false,
+                        "");
+        break;
+      case HISTORY_EMPTY_ROW:
+        if (stream.rows == 0) {
+          html += "<tr><td colspan='9'>尚無歷史記錄</td></tr>";
+        }
+        break;
+      case HISTORY_CLEAR_CONTROL:
+        if (stream.clearControl) {
+          html += "<section class='panel danger-zone'>";
+          html += "<h3>僅限管理者：危險操作</h3>";
+          html += "<p class='helper-text'>此操作會清除全部歷史資料且無法復原。</p>";
+          html += "<form method='post' action='/clear_history' onsubmit=\"return confirm('確定要清除所有歷史記錄嗎？');\" style='display:inline'>";
+          html += "<button type='submit' class='btn btn-danger'>清除記錄</button>";
+          html += "</form></section>";
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  HistoryStream& beginHistoryStream(HistoryStreamKind kind) {
+    HistoryStream& stream = historyStreams[server->currentSlot()];
+    stream.owner = this;
+    stream.kind = kind;
+    // HTML/JSON 由新到舊，從「比最新還新」開始；CSV 由舊到新，從 0 開始
+    stream.cursor = kind == HistoryStreamKind::CSV ? 0 : UINT64_MAX;
+    stream.lastSequence = recordManager->getRevision();
+    stream.rows = 0;
+    stream.clearControl = false;
+    stream.rowsDone = false;
+    stream.role = server->currentRole();
+    stream.page.begin(nullptr, 0);
+    stream.pageStarted = false;
+    stream.pending = "";
+    stream.pendingOffset = 0;
+    return stream;
+  }
+
+  void sendHistoryStream(HistoryStream& stream, const char* contentType) {
+    if (!server->sendStream(200, contentType, &WebHandler::fillHistoryStream,
+                            &stream)) {
+      // 表頭未能擷取時伺服器會改回 503；這裡只釋放已產生的表頭
+      stream.pending = String();
+    }
+  }
+
+  static bool jsonHistoryStream(const HistoryStream& stream) {
+    return stream.kind == HistoryStreamKind::JSON ||
+           stream.kind == HistoryStreamKind::JSON_SINCE;
+  }
+
+  // 游標之後下一筆要輸出的記錄；沒有則回 -1。
+  int nextHistoryIndex(const HistoryStream& stream) const {
+    const bool oldestFirst = stream.kind == HistoryStreamKind::CSV ||
+                             stream.kind == HistoryStreamKind::JSON_SINCE;
+    const int index = oldestFirst
+      ? recordManager->indexAfterSequence(stream.cursor)
+      : recordManager->indexBeforeSequence(stream.cursor);
+    if (index < 0) return -1;
+    if (oldestFirst &&
+        recordManager->getRecord(index).recordSequence > stream.lastSequence) {
+      return -1;
+    }
+    return index;
+  }
+
+  // CSV 串流的下一段：一筆記錄，或 JSON/CSV 全部輸出後的收尾。
+  // JSON 記錄與 HTML 頁面直接寫進視窗，不經過這裡。
+  void appendNextHistoryPiece(HistoryStream& stream, int index) {
+    if (index >= 0 && stream.kind == HistoryStreamKind::CSV) {
+      const BPData& record = recordManager->getRecord(index);
+      stream.cursor = record.recordSequence;
+      if (appendHistoryCsvRow(stream.pending, record)) stream.rows++;
+      return;
+    }
+    if (jsonHistoryStream(stream)) stream.pending += "]}";
+    stream.rowsDone = true;
+  }
+
+  bp_web::RenderedPageKey renderedPageKey() const {
+    bp_web::RenderedPageKey key;
+    key.contentVersion = recordManager->contentVersion();
+    key.policyVersion = activePolicy().policyVersion;
+    return key;
+  }
+
+  // 第一個視窗先查快取；未命中就照常輸出，整頁在這個視窗內完成時存入。查詢、
+  // 輸出與存入都在同一次呼叫裡，中間不會有新記錄或政策變更。
+  bp_http::StreamFill fillHistoryPageWindow(HistoryStream& stream,
+                                            uint8_t* window, size_t capacity,
+                                            size_t& written) {
+    char* out = reinterpret_cast<char*>(window);
+    written = 0;
+    if (stream.pageStarted) {
+      return renderHistoryPageWindow(stream, out, capacity, written);
+    }
+    stream.pageStarted = true;
+    const bp_web::RenderedPageKey key = renderedPageKey();
+    size_t length = 0;
+    const char* cached =
+      renderedPages.find(kHistoryPageRoute, stream.role, key, length);
+    if (cached != nullptr && length <= capacity) {
+      memcpy(out, cached, length);
+      written = length;
+      return bp_http::StreamFill::DONE;
+    }
+    const bp_http::StreamFill fill =
+      renderHistoryPageWindow(stream, out, capacity, written);
+    if (fill == bp_http::StreamFill::DONE) {
+      (void)renderedPages.store(kHistoryPageRoute, stream.role, key, out,
+                                written);
+    }
+    return fill;
+  }
+
+  // HTML：表頭樣板 → 逐筆表列 → 收尾樣板，全部直接寫進視窗。表列放不下就先
+  // 送出這個視窗，下一輪從同一個游標重寫。
+  bp_http::StreamFill renderHistoryPageWindow(HistoryStream& stream,
+                                              char* out, size_t capacity,
+                                              size_t& written) {
+    while (true) {
+      if (!stream.page.done()) {
+        const bp_html::RenderProgress progress = stream.page.render(
+          out, capacity, written, &WebHandler::renderHistorySlot, &stream);
+        if (progress != bp_html::RenderProgress::DONE) {
+          return streamFill(progress);
+        }
+        if (stream.rowsDone) return bp_http::StreamFill::DONE;
       }
-    } else {
-      html += "<tr><td colspan='9'>尚無歷史記錄</td></tr>";
+      const int index = nextHistoryIndex(stream);
+      if (index < 0) {
+        stream.rowsDone = true;
+        stream.page.begin(kHistoryPageTail);
+        continue;
+      }
+      if (written >= capacity) return bp_http::StreamFill::MORE;
+      const BPData& record = recordManager->getRecord(index);
+      bp_html::BoundedHtmlWriter html(out + written, capacity - written);
+      appendHistoryTableRow(html, record);
+      if (html.overflowed()) {
+        return written == 0 ? bp_http::StreamFill::FAILED
+                            : bp_http::StreamFill::MORE;
+      }
+      written += html.length();
+      stream.cursor = record.recordSequence;
+      stream.rows++;
     }
+  }
 
-    html += "</tbody></table></div>";
-    html += "</section>";
+  bp_http::StreamFill fillHistoryWindow(HistoryStream& stream,
+                                        uint8_t* window, size_t capacity,
+                                        size_t& written) {
+    if (stream.kind == HistoryStreamKind::HTML) {
+      return fillHistoryPageWindow(stream, window, capacity, written);
+    }
+    written = 0;
+    while (written < capacity) {
+      const size_t pending = stream.pending.length() - stream.pendingOffset;
+      if (pending > 0) {
+        const size_t count = pending < capacity - written
+          ? pending : capacity - written;
+        memcpy(window + written, stream.pending.c_str() + stream.pendingOffset,
+               count);
+        written += count;
+        stream.pendingOffset += count;
+        continue;
+      }
+      if (stream.rowsDone) {
+        stream.pending = String();
+        return bp_http::StreamFill::DONE;
+      }
+      const int index = nextHistoryIndex(stream);
+      if (index >= 0 && jsonHistoryStream(stream)) {
+        // JSON 記錄直接寫進回應視窗：不建 JsonDocument、不經 String。放不下
+        // 就先送出這個視窗，下一輪從同一個游標重寫。
+        const BPData& record = recordManager->getRecord(index);
+        bp_json::BoundedJsonWriter json(
+          reinterpret_cast<char*>(window + written), capacity - written);
+        if (stream.rows > 0) json.continueSequence();
+        writeHistoryJsonRecord(json, record);
+        if (json.overflowed()) {
+          return written == 0 ? bp_http::StreamFill::FAILED
+                              : bp_http::StreamFill::MORE;
+        }
+        written += json.length();
+        stream.cursor = record.recordSequence;
+        stream.rows++;
+        continue;
+      }
+      // 清空但保留容量，逐列重用同一塊 heap
+      stream.pending = "";
+      stream.pendingOffset = 0;
+      appendNextHistoryPiece(stream, index);
+    }
+    return bp_http::StreamFill::MORE;
+  }
 
-    if (bp_web::surfaceVisible(server->currentRole(),
-                               bp_web::WebSurface::CLEAR_HISTORY_CONTROL)) {
-      html += "<section class='panel danger-zone'>";
-      html += "<h3>僅限管理者：危險操作</h3>";
-      html += "<p class='helper-text'>此操作會清除全部歷史資料且無法復原。</p>";
-      html += "<form method='post' action='/clear_history' onsubmit=\"return confirm('確定要清除所有歷史記錄嗎？');\" style='display:inline'>";
-      html += "<button type='submit' class='btn btn-danger'>清除記錄</button>";
-      html += "</form></section>";
+  static bp_http::StreamFill fillHistoryStream(void* context, uint8_t* window,
+                                               size_t capacity,
+                                               size_t& written) {
+    HistoryStream& stream = *static_cast<HistoryStream*>(context);
+    return stream.owner->fillHistoryWindow(stream, window, capacity, written);
+  }
+
+  // 多台血壓計時逐台列出通道狀態；單台時與總計相同，不重複顯示。
+  template <typename Out>
+  static void appendDeviceStatusItems(Out& html,
+                                      const MonitorTransportSummary& summary) {
+    if (summary.deviceCount <= 1) return;
+    for (uint8_t i = 0; i < summary.deviceCount; ++i) {
+      const MonitorDeviceSummary& device = summary.devices[i];
+      html += "<li><span>血壓計 ";
+      html += i + 1;
+      html += "</span><strong class='device-status'>";
+      html += monitorTransportStateLabel(device.state);
+      html += "（遺失 ";
+      html += device.dataLossCount;
+      html += "、重連 ";
+      html += device.reconnectCount;
+      html += "）</strong></li>";
     }
+  }
 
-    html += buildPageEnd();
-    server->send(200, "text/html; charset=UTF-8", html);
+  static void setDevicesJson(JsonArray devices,
+                             const MonitorTransportSummary& summary) {
+    for (uint8_t i = 0; i < summary.deviceCount; ++i) {
+      const MonitorDeviceSummary& device = summary.devices[i];
+      JsonObject entry = devices.add<JsonObject>();
+      entry["slot"] = i;
+      entry["state"] = monitorTransportStateCode(device.state);
+      entry["data_loss_count"] = device.dataLossCount;
+      entry["reconnect_count"] = device.reconnectCount;
+      entry["dropped_bytes"] = device.droppedBytes;
+    }
   }
 
-  void handleHistoryAPI() {
-    // 傳 String 進去會 copy；使用 c_str() 直接引用。在 single-thread handler
-    // 內 BPData 不會被修改，pointer 安全。
-    JsonDocument doc;
-    setUInt64Json(doc["revision"], recordManager->getRevision());
-    doc["policy_name"] = activePolicy().policyName;
-    doc["policy_version"] = activePolicy().policyVersion;
-    doc["firmware_version"] = BP_FIRMWARE_VERSION;
-    doc["protocol"] = supportedMeasurementProtocol();
-    JsonArray records = doc["records"].to<JsonArray>();
+  // 條件式 GET：tag 相符時在建任何 JsonDocument 之前回 304。回應仍是 no-store，
+  // 輪詢端自行保存上次的 ETag 並以 If-None-Match 帶回。
+  bool answerNotModified(MeasurementEtagParts parts) {
+    parts.bootNonce = etagBootNonce;
+    parts.policyVersion = activePolicy().policyVersion;
+    parts.role = static_cast<uint8_t>(server->currentRole());
+    char etag[kMeasurementEtagCapacity];
+    formatMeasurementEtag(etag, parts);
+    server->sendHeader("ETag", etag);
+    if (!server->requestMatchesEtag(etag)) return false;
+    server->send(304, "application/json", "");
+    return true;
+  }
 
-    int recordCount = recordManager->getRecordCount();
-    for (int i = 0; i < recordCount; i++) {
-      const BPData& record = recordManager->getRecord(i);
+  // since/limit 任一存在即為增量查詢；格式錯誤回 false，limit 超過上限則截到上限
+  bool parseHistoryPageArgs(uint64_t& since, int& limit) {
+    since = 0;
+    limit = kHistoryPageDefault;
+    if (server->hasArg("since") &&
+        !parseOpaqueSequence(server->arg("since").c_str(), since)) {
+      return false;
+    }
+    if (!server->hasArg("limit")) return true;
+    uint32_t requested = 0;
+    if (!parseMeasurementPolicyUnsigned(server->arg("limit").c_str(),
+                                        requested) || requested == 0) {
+      return false;
+    }
+    limit = requested < static_cast<uint32_t>(kHistoryPageMax)
+      ? static_cast<int>(requested) : kHistoryPageMax;
+    return true;
+  }
 
-      JsonObject recordObj = records.add<JsonObject>();
-      setUInt64Json(recordObj["record_sequence"], record.recordSequence);
-      setUInt64Json(recordObj["session_sequence"], record.sessionSequence);
-      recordObj["timestamp"] = record.timestamp.c_str();
-      recordObj["timestamp_source"] = timestampSourceCode(record.timestampSource);
-      recordObj["systolic"] = record.systolic;
-      recordObj["diastolic"] = record.diastolic;
-      recordObj["pulse"] = record.pulse;
-      recordObj["quality"] = measurementQualityCode(record.quality);
-      recordObj["movement_count"] = record.movementCount;
-      recordObj["valid"] = record.valid;
-      recordObj["review_state"] = measurementReviewCode(
-        classifyMeasurement(record, activePolicy()));
+  void handleHistoryAPI() {
+    const bool delta = server->hasArg("since") || server->hasArg("limit");
+    uint64_t since = 0;
+    int limit = kHistoryPageDefault;
+    if (delta && !parseHistoryPageArgs(since, limit)) {
+      server->send(400, "text/plain; charset=UTF-8", "無效的歷史游標或筆數");
+      return;
+    }
+    // 歷史內容只隨記錄與政策（review_state）變化，不看 transport/診斷。
+    // 增量頁由網址的 since/limit 決定，validator 依 URL 分開，tag 組成相同。
+    MeasurementEtagParts etag;
+    etag.revision = recordManager->getRevision();
+    etag.recordCount = recordManager->getRecordCount();
+    if (answerNotModified(etag)) return;
+    HistoryStream& stream = beginHistoryStream(
+      delta ? HistoryStreamKind::JSON_SINCE : HistoryStreamKind::JSON);
+    // 表頭以 BoundedJsonWriter 寫進固定緩衝；records 陣列保持開啟，逐筆記錄由
+    // 串流直接寫進回應視窗接上，heap 用量與歷史筆數無關。
+    char head[kHistoryJsonHeadCapacity];
+    bp_json::BoundedJsonWriter json(head, sizeof(head));
+    json.beginObject();
+    json.uint64Field("revision", recordManager->getRevision());
+    json.field("policy_name", activePolicy().policyName);
+    json.field("policy_version", activePolicy().policyVersion);
+    json.field("firmware_version", BP_FIRMWARE_VERSION);
+    json.field("protocol", supportedMeasurementProtocol());
+    if (delta) {
+      // 由舊到新最多 limit 筆；下一頁帶 next_since。gap 表示既有游標之後的
+      // 記錄已被 ring 覆蓋或清除，呼叫端應從 since=0 重新同步；since=0 從最舊的
+      // 保留記錄開始，不回報 gap。
+      const BP_RecordManager::SequencePage page =
+        recordManager->pageAfterSequence(since, limit);
+      stream.cursor = since;
+      stream.lastSequence = page.nextSince;
+      json.uint64Field("since", since);
+      json.uint64Field("next_since", page.nextSince);
+      json.field("has_more", page.hasMore);
+      json.field("gap", page.gap);
+    }
+    json.key("records");
+    json.beginArray();
+    if (json.overflowed()) {
+      server->send(500, "text/plain; charset=UTF-8", "歷史表頭超出緩衝");
+      return;
     }
+    stream.pending.concat(head, json.length());
+    sendHistoryStream(stream, "application/json");
+  }
+
+  void writeHistoryJsonRecord(bp_json::BoundedJsonWriter& json,
+                              const BPData& record) const {
+    json.beginObject();
+    json.uint64Field("record_sequence", record.recordSequence);
+    json.uint64Field("session_sequence", record.sessionSequence);
+    json.field("timestamp", record.timestamp.c_str());
+    json.field("timestamp_source", timestampSourceCode(record.timestampSource));
+    json.field("systolic", record.systolic);
+    json.field("diastolic", record.diastolic);
+    json.field("pulse", record.pulse);
+    json.field("quality", measurementQualityCode(record.quality));
+    json.field("movement_count", record.movementCount);
+    json.field("valid", record.valid);
+    json.field("device_slot", record.deviceSlot);
+    json.field("review_state", measurementReviewCode(
+      classifyMeasurement(record, activePolicy())));
+    json.endObject();
+  }
+
+  // /api/latest 與 /api/events 共用的 tag 組成。延遲統計只在新 revision 時
+  // 改變（noteServed 先記），不必入 tag。
+  MeasurementEtagParts latestEtagParts(
+      const MeasurementSnapshot& snapshot,
+      MeasurementFreshnessState freshness) const {
+    MeasurementEtagParts etag;
+    etag.revision = snapshot.revision;
+    etag.recordCount = snapshot.recordCount;
+    etag.policyVersion = activePolicy().policyVersion;
+    etag.transportVersion = snapshot.transport.statusVersion;
+    etag.diagnosticStamp = snapshot.diagnostic.recordedAtMs;
+    etag.freshness = static_cast<uint8_t>(freshness);
+    return etag;
+  }
+
+  void handleLatestAPI() {
+    const uint64_t nowMs = uptimeClock == nullptr ? 0 : uptimeClock->nowMs();
+    const MeasurementSnapshot snapshot = latestSnapshot();
+    noteMeasurementServed(snapshot);
+    const MeasurementFreshnessState freshness = latestFreshness(snapshot, nowMs);
+    const MeasurementEtagParts etag = latestEtagParts(snapshot, freshness);
+    if (answerNotModified(etag)) return;
 
     String jsonStr;
-    serializeJson(doc, jsonStr);
+    appendLatestJson(jsonStr, snapshot, nowMs, freshness);
     server->send(200, "application/json", jsonStr);
   }
 
-  void handleLatestAPI() {
+  void appendLatestJson(String& out, const MeasurementSnapshot& snapshot,
+                        uint64_t nowMs,
+                        MeasurementFreshnessState freshness) const {
+    const int count = snapshot.recordCount;
     JsonDocument doc;
-    const uint64_t nowMs = uptimeClock == nullptr ? 0 : uptimeClock->nowMs();
-    const int count = recordManager->getRecordCount();
-    const MeasurementFreshnessState freshness = latestFreshness(nowMs);
     doc["count"] = count;
-    setUInt64Json(doc["revision"], recordManager->getRevision());
+    setUInt64Json(doc["revision"], snapshot.revision);
     doc["freshness_state"] = measurementFreshnessCode(freshness);
     doc["freshness_label"] = measurementFreshnessLabel(freshness);
     doc["firmware_version"] = BP_FIRMWARE_VERSION;
@@ -1565,24 +2150,37 @@ private:
     doc["reference_policy"] = measurementReferencePolicyName();
     doc["policy_name"] = activePolicy().policyName;
     doc["policy_version"] = activePolicy().policyVersion;
-    doc["data_loss_count"] = monitorTransport == nullptr
-      ? 0U : monitorTransport->dataLossCount();
-    doc["reconnect_count"] = monitorTransport == nullptr
-      ? 0U : monitorTransport->reconnectCount();
-    doc["diagnostic_state"] = sanitizedDiagnosticState();
+    doc["data_loss_count"] = snapshot.transport.dataLossCount;
+    doc["reconnect_count"] = snapshot.transport.reconnectCount;
+    setDevicesJson(doc["devices"].to<JsonArray>(), snapshot.transport);
+    doc["diagnostic_state"] = sanitizedDiagnosticState(snapshot);
+    if (snapshot.diagnostic.isWaiting()) {
+      doc["diagnostic_action"] = nullptr;
+      doc["diagnostic_age_ms"] = nullptr;
+    } else {
+      doc["diagnostic_action"] =
+        receiveDiagnosticActionText(snapshot.diagnostic.action);
+      doc["diagnostic_age_ms"] = static_cast<uint32_t>(
+        millis() - snapshot.diagnostic.recordedAtMs);
+    }
     uint64_t receiveAgeMs = 0;
-    if (recordManager->lastSuccessfulReceiveAgeMs(nowMs, receiveAgeMs)) {
+    if (snapshot.lastSuccessfulReceiveAgeMs(nowMs, receiveAgeMs)) {
       setUInt64Json(doc["last_successful_receive_age_ms"], receiveAgeMs);
     } else {
       doc["last_successful_receive_age_ms"] = nullptr;
     }
+    if (latencyTracker != nullptr) {
+      setLatencyJson(doc["latency"].to<JsonObject>());
+    } else {
+      doc["latency"] = nullptr;
+    }
     if (count > 0) {
-      const BPData& latest = recordManager->getLatestRecord();
+      const MeasurementSnapshotRecord& latest = snapshot.latest;
       const MeasurementReviewState review =
-        classifyMeasurement(latest, activePolicy());
+        classifyMeasurement(latest.toBPData(), activePolicy());
       setUInt64Json(doc["record_sequence"], latest.recordSequence);
       setUInt64Json(doc["session_sequence"], latest.sessionSequence);
-      doc["timestamp"] = latest.timestamp.c_str();
+      doc["timestamp"] = latest.timestamp;
       doc["timestamp_source"] = timestampSourceCode(latest.timestampSource);
       doc["systolic"] = latest.systolic;
       doc["diastolic"] = latest.diastolic;
@@ -1590,32 +2188,117 @@ private:
       doc["quality"] = measurementQualityCode(latest.quality);
       doc["movement_count"] = latest.movementCount;
       doc["valid"] = latest.valid;
+      doc["device_slot"] = latest.deviceSlot;
       doc["review_state"] = measurementReviewCode(review);
       doc["review_label"] = measurementReviewLabel(review);
     }
-    // 整個 request handler 與 syncTransportStatus 都在 main loop 序列執行，
+    // 整個 request handler 與 DataProcessor 套用 ingest 結果都在 main loop 序列執行，
     // 不會發生 mid-request mutation，可直接 c_str() 引用省 pool 複製
     doc["transport_name"] = transportName->c_str();
     doc["transport_status"] = transportStatus->c_str();
     String wifiIp;
     if (WiFi.status() == WL_CONNECTED) wifiIp = WiFi.localIP().toString();
     doc["wifi_ip"] = wifiIp.c_str();
+    serializeJson(doc, out);
+  }
 
-    String jsonStr;
-    serializeJson(doc, jsonStr);
-    server->send(200, "application/json", jsonStr);
+  void handleEvents() {
+    EventStream& stream = eventStreams[server->currentSlot()];
+    stream.owner = this;
+    const uint32_t now = millis();
+    stream.openedAtMs = now;
+    stream.checkedAtMs = now;
+    stream.sentAtMs = now;
+    stream.publication = measurementSnapshot->publication();
+    stream.primed = false;
+    stream.pending = "retry: ";
+    stream.pending += kEventRetryMs;
+    stream.pending += "\n\n";
+    stream.pendingOffset = 0;
+    // 連線一建立就送目前狀態，頁面不必另外輪詢一次
+    appendMeasurementEvent(stream);
+    if (!server->sendStream(200, "text/event-stream",
+                            &WebHandler::fillEventStream, &stream)) {
+      stream.pending = String();
+    }
+  }
+
+  // 狀態與上次推送相同時不輸出；第一次一律以 measurement 送出完整狀態。
+  void appendMeasurementEvent(EventStream& stream) {
+    const uint64_t nowMs = uptimeClock == nullptr ? 0 : uptimeClock->nowMs();
+    const MeasurementSnapshot snapshot = latestSnapshot();
+    const MeasurementFreshnessState freshness = latestFreshness(snapshot, nowMs);
+    const MeasurementEtagParts parts = latestEtagParts(snapshot, freshness);
+    const MeasurementEventKind kind = stream.primed
+      ? classifyMeasurementEvent(stream.sent, parts)
+      : MeasurementEventKind::MEASUREMENT;
+    if (kind == MeasurementEventKind::NONE) return;
+    noteMeasurementServed(snapshot);
+    stream.sent = parts;
+    stream.primed = true;
+    stream.pending += "event: ";
+    stream.pending += measurementEventName(kind);
+    stream.pending += "\ndata: ";
+    // serializeJson 不輸出換行，整份 JSON 是單一 data 行
+    appendLatestJson(stream.pending, snapshot, nowMs, freshness);
+    stream.pending += "\n\n";
+  }
+
+  bp_http::StreamFill fillEventWindow(EventStream& stream, uint8_t* window,
+                                      size_t capacity, size_t& written) {
+    written = 0;
+    if (stream.pendingOffset >= stream.pending.length()) {
+      // 清空但保留容量，逐個事件重用同一塊 heap
+      stream.pending = "";
+      stream.pendingOffset = 0;
+      const uint32_t now = millis();
+      if (now - stream.openedAtMs >= kEventStreamLifetimeMs ||
+          server->clientWaiting()) {
+        stream.pending = String();
+        return bp_http::StreamFill::DONE;
+      }
+      const uint32_t publication = measurementSnapshot->publication();
+      if (publication != stream.publication ||
+          now - stream.checkedAtMs >= kEventCheckIntervalMs) {
+        stream.publication = publication;
+        stream.checkedAtMs = now;
+        appendMeasurementEvent(stream);
+      }
+      if (stream.pending.length() == 0 &&
+          now - stream.sentAtMs >= kEventHeartbeatMs) {
+        stream.pending = "event: heartbeat\ndata: {}\n\n";
+      }
+      if (stream.pending.length() == 0) return bp_http::StreamFill::IDLE;
+      stream.sentAtMs = now;
+    }
+    const size_t pending = stream.pending.length() - stream.pendingOffset;
+    written = pending < capacity ? pending : capacity;
+    memcpy(window, stream.pending.c_str() + stream.pendingOffset, written);
+    stream.pendingOffset += written;
+    return stream.pendingOffset < stream.pending.length()
+      ? bp_http::StreamFill::MORE : bp_http::StreamFill::IDLE;
+  }
+
+  static bp_http::StreamFill fillEventStream(void* context, uint8_t* window,
+                                             size_t capacity,
+                                             size_t& written) {
+    EventStream& stream = *static_cast<EventStream*>(context);
+    return stream.owner->fillEventWindow(stream, window, capacity, written);
   }
 
   void handleExportCsv() {
-    String csv;
-    appendHistoryCsv(csv, *recordManager);
+    HistoryStream& stream = beginHistoryStream(HistoryStreamKind::CSV);
+    appendHistoryCsvHeader(stream.pending);
     server->sendHeader("Content-Disposition", "attachment; filename=\"bp_history.csv\"");
-    server->send(200, "text/csv; charset=UTF-8", csv);
+    sendHistoryStream(stream, "text/csv; charset=UTF-8");
   }
 
   void handleClearHistory() {
+    // 不在 RAM 留下即將清除記錄的頁面；之後 contentVersion 已變，不會再命中
+    renderedPages.invalidate();
     if (!recordManager->clearRecords()) {
       Serial.println("history_clear_failed");
+      republishMeasurementSnapshot();  // 失敗時 record manager 可能已重新載入
       String errorHtml = buildPageStart("清除未完成", "/history");
       errorHtml += "<section class='panel danger-zone'>";
       errorHtml += "<h2>無法確認歷史記錄已清除</h2>";
@@ -1625,7 +2308,8 @@ private:
       server->send(503, "text/html; charset=UTF-8", errorHtml);
       return;
     }
-    *lastData = ""; // 同步清掉舊診斷，避免 dashboard 顯示陳舊狀態
+    receiveDiagnostic->clear(); // 同步清掉舊診斷，避免 dashboard 顯示陳舊狀態
+    republishMeasurementSnapshot();
 
     String html = buildPageStart("記錄已清除", "/history", false, "<meta http-equiv='refresh' content='2;url=/history'>");
     html += "<section class='panel danger-zone'>";
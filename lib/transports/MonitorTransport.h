@@ -13,6 +13,35 @@ enum MonitorTransportState {
   TRANSPORT_STATE_ERROR = 5,
 };
 
+// Stable API code and operator-facing label for a transport state.
+inline const char* monitorTransportStateCode(MonitorTransportState state) {
+  switch (state) {
+    case TRANSPORT_STATE_STARTING:       return "starting";
+    case TRANSPORT_STATE_WAITING_DEVICE: return "waiting_device";
+    case TRANSPORT_STATE_READY:          return "ready";
+    case TRANSPORT_STATE_RECEIVING:      return "receiving";
+    case TRANSPORT_STATE_UNSUPPORTED:    return "unsupported";
+    case TRANSPORT_STATE_ERROR:          return "error";
+    default:                             return "unknown";
+  }
+}
+
+inline const char* monitorTransportStateLabel(MonitorTransportState state) {
+  switch (state) {
+    case TRANSPORT_STATE_STARTING:       return "啟動中";
+    case TRANSPORT_STATE_WAITING_DEVICE: return "等待裝置";
+    case TRANSPORT_STATE_READY:          return "就緒";
+    case TRANSPORT_STATE_RECEIVING:      return "接收中";
+    case TRANSPORT_STATE_UNSUPPORTED:    return "未就緒";
+    case TRANSPORT_STATE_ERROR:          return "錯誤";
+    default:                             return "未知";
+  }
+}
+
+// Upper bound on monitors one bridge serves (e.g. through a USB hub). Events,
+// records and per-device status carry a slot index below this.
+static constexpr uint8_t kMaxMonitorDevices = 3;
+
 enum class MonitorRxEventType : uint8_t {
   BYTE = 0,
   DISCONTINUITY,
@@ -20,13 +49,104 @@ enum class MonitorRxEventType : uint8_t {
 };
 
 // POD event boundary shared by transports and the main-loop frame owner.
-// `epoch` orders a loss marker with the bytes it invalidates.
+// `epoch` orders a loss marker with the bytes it invalidates; both are scoped
+// to `device`, so markers from one monitor never touch another's frames.
 struct MonitorRxEvent {
   MonitorRxEventType type = MonitorRxEventType::BYTE;
   uint8_t byte = 0;
+  uint8_t device = 0;
   uint32_t epoch = 0;
 };
 
+// What the ingest framer and parser made of one pass of a device's bytes.
+// `validFrames` decoded under the protocol (even if the measurement itself
+// was refused); `rejectedFrames` did not frame or parse at all.
+struct MonitorFramingReport {
+  uint32_t bytes = 0;
+  uint32_t validFrames = 0;
+  uint32_t rejectedFrames = 0;
+
+  bool empty() const {
+    return bytes == 0 && validFrames == 0 && rejectedFrames == 0;
+  }
+};
+
+// Per-device counters for transports that serve more than one monitor.
+struct MonitorDeviceSummary {
+  MonitorTransportState state = TRANSPORT_STATE_STARTING;
+  uint32_t dataLossCount = 0;
+  uint32_t reconnectCount = 0;
+  uint32_t droppedBytes = 0;
+
+  bool operator==(const MonitorDeviceSummary& other) const {
+    return state == other.state && dataLossCount == other.dataLossCount &&
+           reconnectCount == other.reconnectCount &&
+           droppedBytes == other.droppedBytes;
+  }
+  bool operator!=(const MonitorDeviceSummary& other) const {
+    return !(*this == other);
+  }
+};
+
+// Web-side copy of the transport counters. The ingest owner samples the
+// transport and the main loop applies the copy, so page handlers never call
+// into a transport that another task is polling.
+struct MonitorTransportSummary {
+  // MonitorTransportStatus::version of the sample; keys web ETags.
+  uint32_t statusVersion = 0;
+  MonitorTransportState state = TRANSPORT_STATE_STARTING;
+  uint32_t dataLossCount = 0;
+  uint32_t reconnectCount = 0;
+  uint8_t deviceCount = 1;
+  MonitorDeviceSummary devices[kMaxMonitorDevices];
+
+  bool connected() const {
+    return state == TRANSPORT_STATE_READY ||
+           state == TRANSPORT_STATE_RECEIVING;
+  }
+};
+
+// POD transport status. `version` advances whenever a field or the detail()
+// text changes, so the owner can skip formatting text on unchanged ticks.
+struct MonitorTransportStatus {
+  uint32_t version = 0;
+  MonitorTransportState state = TRANSPORT_STATE_STARTING;
+  uint32_t dataLossCount = 0;
+  uint32_t reconnectCount = 0;
+  uint32_t droppedBytes = 0;
+  uint32_t overflowEpisodes = 0;
+
+  bool sameFields(const MonitorTransportStatus& other) const {
+    return state == other.state && dataLossCount == other.dataLossCount &&
+           reconnectCount == other.reconnectCount &&
+           droppedBytes == other.droppedBytes &&
+           overflowEpisodes == other.overflowEpisodes;
+  }
+
+  bool operator==(const MonitorTransportStatus& other) const {
+    return version == other.version && sameFields(other);
+  }
+  bool operator!=(const MonitorTransportStatus& other) const {
+    return !(*this == other);
+  }
+};
+
+// Transport-owner helper: replaces `published` with `next` and advances the
+// version only when a field or the detail text actually changed.
+inline bool advanceMonitorTransportStatus(MonitorTransportStatus& published,
+                                          const MonitorTransportStatus& next,
+                                          bool detailChanged) {
+  if (!detailChanged && published.sameFields(next)) return false;
+  const uint32_t version = published.version + 1U;
+  published = next;
+  published.version = version;
+  return true;
+}
+
+// Producer-side nudge to the transport owner. Runs in a driver or daemon task,
+// so it must not block; a FreeRTOS task notification is the intended body.
+typedef void (*MonitorWakeCallback)(void* context);
+
 class MonitorTransport {
 public:
   virtual ~MonitorTransport() {}
@@ -47,12 +167,71 @@ public:
     if (value < 0) return false;
     event.type = MonitorRxEventType::BYTE;
     event.byte = static_cast<uint8_t>(value);
+    event.device = 0;
     event.epoch = 0;
     return true;
   }
 
   virtual uint32_t dataLossCount() const { return 0; }
   virtual uint32_t reconnectCount() const { return 0; }
+
+  // Before begin(): transports that publish bytes and lifecycle facts from
+  // their own tasks call `callback` after each one, so the owner can block
+  // instead of polling. Returns false when the transport has no such
+  // producer; its owner must keep polling.
+  virtual bool setWakeCallback(MonitorWakeCallback callback, void* context) {
+    (void)callback;
+    (void)context;
+    return false;
+  }
+
+  // Ingest owner, after a pass that framed bytes for `device`. Transports
+  // that choose their own line settings score them by it.
+  virtual void noteFraming(uint8_t device, const MonitorFramingReport& report) {
+    (void)device;
+    (void)report;
+  }
+
+  // micros() at which the transport last accepted received bytes, for
+  // latency tracing. Transports without a receive callback report none.
+  virtual bool lastRxAcceptedUs(uint32_t& acceptedUs) const {
+    (void)acceptedUs;
+    return false;
+  }
+
+  // Multi-device transports report how many monitor slots they serve and
+  // per-slot counters and receive times. Single-device transports are slot 0.
+  // Owner task only, like status().
+  virtual uint8_t deviceCount() const { return 1; }
+  virtual MonitorDeviceSummary deviceSummary(uint8_t device) const {
+    MonitorDeviceSummary result;
+    if (device != 0) return result;
+    result.state = state();
+    result.dataLossCount = dataLossCount();
+    result.reconnectCount = reconnectCount();
+    return result;
+  }
+  virtual bool deviceRxAcceptedUs(uint8_t device, uint32_t& acceptedUs) const {
+    return device == 0 && lastRxAcceptedUs(acceptedUs);
+  }
+
+  // Cheap per-tick status: no heap work. Transports whose detail() or
+  // deviceSummary() can change without a field change must call
+  // markStatusChanged() or override this.
+  virtual MonitorTransportStatus status() const {
+    MonitorTransportStatus result;
+    result.version = _statusVersion;
+    result.state = state();
+    result.dataLossCount = dataLossCount();
+    result.reconnectCount = reconnectCount();
+    return result;
+  }
+
+protected:
+  void markStatusChanged() { ++_statusVersion; }
+
+private:
+  uint32_t _statusVersion = 0;
 };
 
 #endif
@@ -0,0 +1,194 @@
+#ifndef UART_LINE_DETECTOR_H
+#define UART_LINE_DETECTOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// UART line settings for the fallback transport. A wrong baud rate or framing
+// used to surface only as a stream of malformed-frame diagnostics; instead the
+// transport walks a configured candidate list, scored by what the ingest
+// framer and parser make of the bytes, and persists the setting it locks on.
+struct UartLineSetting {
+  uint32_t baudRate = 9600;
+  uint8_t dataBits = 8;
+  // 'N', 'E' or 'O'.
+  char parity = 'N';
+  uint8_t stopBits = 1;
+
+  bool operator==(const UartLineSetting& other) const {
+    return baudRate == other.baudRate && dataBits == other.dataBits &&
+           parity == other.parity && stopBits == other.stopBits;
+  }
+  bool operator!=(const UartLineSetting& other) const {
+    return !(*this == other);
+  }
+};
+
+inline bool uartLineSettingValid(const UartLineSetting& setting) {
+  return setting.baudRate >= 300 && setting.baudRate <= 0xFFFFFFU &&
+         setting.dataBits >= 5 && setting.dataBits <= 8 &&
+         (setting.parity == 'N' || setting.parity == 'E' ||
+          setting.parity == 'O') &&
+         (setting.stopBits == 1 || setting.stopBits == 2);
+}
+
+// One NVS word: baud << 8 | (dataBits - 5) << 4 | parity << 2 | (stop - 1).
+// Zero is never a valid packing, so it doubles as "nothing persisted".
+inline uint32_t uartLinePack(const UartLineSetting& setting) {
+  if (!uartLineSettingValid(setting)) return 0;
+  const uint32_t parity = setting.parity == 'E' ? 1U
+                        : setting.parity == 'O' ? 2U : 0U;
+  return setting.baudRate << 8 |
+         static_cast<uint32_t>(setting.dataBits - 5) << 4 | parity << 2 |
+         static_cast<uint32_t>(setting.stopBits - 1);
+}
+
+inline bool uartLineUnpack(uint32_t packed, UartLineSetting& setting) {
+  UartLineSetting decoded;
+  decoded.baudRate = packed >> 8;
+  decoded.dataBits = static_cast<uint8_t>(5 + ((packed >> 4) & 0x3U));
+  const uint32_t parity = (packed >> 2) & 0x3U;
+  if (parity == 3 || (packed & 0xC2U) != 0) return false;
+  decoded.parity = parity == 1 ? 'E' : parity == 2 ? 'O' : 'N';
+  decoded.stopBits = static_cast<uint8_t>(1 + (packed & 0x1U));
+  if (!uartLineSettingValid(decoded)) return false;
+  setting = decoded;
+  return true;
+}
+
+// Evidence against the current setting before the next candidate is tried:
+// bytes the framer consumed without a valid frame, rejected frames, and UART
+// framing/parity errors. Searching gives up quickly; a locked setting
+// tolerates a noisy cable for longer before it is dropped.
+static constexpr uint32_t kUartLineSearchBytes = 256;
+static constexpr uint32_t kUartLineSearchRejects = 2;
+static constexpr uint32_t kUartLineSearchLineErrors = 4;
+static constexpr uint32_t kUartLineLockedBytes = 1024;
+static constexpr uint32_t kUartLineLockedRejects = 4;
+static constexpr uint32_t kUartLineLockedLineErrors = 8;
+
+struct UartLineTelemetry {
+  uint32_t switches = 0;
+  uint32_t locks = 0;
+  // Score of the current setting since it locked.
+  uint32_t lockedBytes = 0;
+  uint32_t lockedFrames = 0;
+
+  // Valid frames per KiB of framed bytes; 0 before any frame.
+  uint32_t framesPerKiB() const {
+    if (lockedBytes == 0) return 0;
+    return static_cast<uint32_t>(
+      static_cast<uint64_t>(lockedFrames) * 1024U / lockedBytes);
+  }
+};
+
+// Owner task only. Candidates are tried in order; a candidate locks as soon
+// as its valid frames at least match its rejected ones, so the frame that
+// proves a setting is itself delivered rather than spent on a probe.
+class UartLineDetector {
+public:
+  // `candidates` must outlive the detector. A valid `persistedPacked` starts
+  // locked on that setting, so a reboot does not hunt again.
+  void begin(const UartLineSetting* candidates, size_t count,
+             uint32_t persistedPacked) {
+    _candidates = candidates;
+    _count = count;
+    _index = 0;
+    _locked = false;
+    if (count > 0) _current = candidates[0];
+    UartLineSetting persisted;
+    if (uartLineUnpack(persistedPacked, persisted)) {
+      _current = persisted;
+      _locked = true;
+      _index = count;
+      for (size_t i = 0; i < count; ++i) {
+        if (candidates[i] == persisted) _index = i;
+      }
+    }
+    resetEvidence();
+  }
+
+  const UartLineSetting& current() const { return _current; }
+  bool locked() const { return _locked; }
+  const UartLineTelemetry& telemetry() const { return _telemetry; }
+
+  // One ingest pass worth of feedback. Returns true when current() changed
+  // and the UART must be reconfigured.
+  bool note(uint32_t bytes, uint32_t validFrames, uint32_t rejectedFrames,
+            uint32_t lineErrors) {
+    _trialValid = saturatingAdd(_trialValid, validFrames);
+    _trialRejected = saturatingAdd(_trialRejected, rejectedFrames);
+    if (_locked) {
+      _telemetry.lockedBytes = saturatingAdd(_telemetry.lockedBytes, bytes);
+      _telemetry.lockedFrames =
+        saturatingAdd(_telemetry.lockedFrames, validFrames);
+    }
+    if (validFrames > 0) {
+      if (!_locked && _trialValid >= _trialRejected) {
+        _locked = true;
+        _telemetry.locks = saturatingAdd(_telemetry.locks, 1);
+        _telemetry.lockedBytes = bytes;
+        _telemetry.lockedFrames = validFrames;
+      }
+      _bytesSinceValid = 0;
+      _rejectsSinceValid = 0;
+      _lineErrorsSinceValid = 0;
+      return false;
+    }
+
+    _bytesSinceValid = saturatingAdd(_bytesSinceValid, bytes);
+    _rejectsSinceValid = saturatingAdd(_rejectsSinceValid, rejectedFrames);
+    _lineErrorsSinceValid = saturatingAdd(_lineErrorsSinceValid, lineErrors);
+    const bool giveUp = _locked
+      ? _bytesSinceValid >= kUartLineLockedBytes ||
+        _rejectsSinceValid >= kUartLineLockedRejects ||
+        _lineErrorsSinceValid >= kUartLineLockedLineErrors
+      : _bytesSinceValid >= kUartLineSearchBytes ||
+        _rejectsSinceValid >= kUartLineSearchRejects ||
+        _lineErrorsSinceValid >= kUartLineSearchLineErrors;
+    if (!giveUp) return false;
+    return advance();
+  }
+
+private:
+  const UartLineSetting* _candidates = nullptr;
+  size_t _count = 0;
+  // == _count while on a persisted setting that is not in the list.
+  size_t _index = 0;
+  UartLineSetting _current;
+  bool _locked = false;
+  uint32_t _trialValid = 0;
+  uint32_t _trialRejected = 0;
+  uint32_t _bytesSinceValid = 0;
+  uint32_t _rejectsSinceValid = 0;
+  uint32_t _lineErrorsSinceValid = 0;
+  UartLineTelemetry _telemetry;
+
+  static uint32_t saturatingAdd(uint32_t value, uint32_t amount) {
+    return UINT32_MAX - value < amount ? UINT32_MAX : value + amount;
+  }
+
+  void resetEvidence() {
+    _trialValid = 0;
+    _trialRejected = 0;
+    _bytesSinceValid = 0;
+    _rejectsSinceValid = 0;
+    _lineErrorsSinceValid = 0;
+  }
+
+  bool advance() {
+    _locked = false;
+    resetEvidence();
+    if (_count == 0) return false;
+    _index = _index + 1 >= _count ? 0 : _index + 1;
+    const UartLineSetting next = _candidates[_index];
+    if (next == _current) return false;
+    _current = next;
+    _telemetry.switches = saturatingAdd(_telemetry.switches, 1);
+    _telemetry.lockedBytes = 0;
+    _telemetry.lockedFrames = 0;
+    return true;
+  }
+};
+
+#endif
@@ -2,36 +2,201 @@
 #define UART_TRANSPORT_H
 
 #include <Arduino.h>
+#include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <atomic>
 #include "MonitorTransport.h"
+#include "UartLineDetector.h"
+
+// UART fallback on the ESP-IDF driver. Its ISR moves FIFO bytes into the
+// driver ring buffer and posts uart_event_t; the owner drains that queue in
+// order and reads each UART_DATA run in one call. FIFO overruns and a full
+// ring buffer are not silent: the driver input is flushed, as IDF requires,
+// and an ordered DISCONTINUITY with a new epoch tells the framer to drop the
+// frame that straddled the gap.
+//
+// The line setting comes from UartLineDetector, fed by noteFraming(). A switch
+// is a few register writes (no driver reinstall), then a STREAM_RESET with a
+// new epoch so no byte read under the old setting reaches the framer.
+static constexpr int kUartDriverRxBufferBytes = 1024;
+static constexpr int kUartEventQueueDepth = 20;
+static constexpr size_t kUartRxChunkBytes = 128;
 
 class UartTransport : public MonitorTransport {
 private:
-  HardwareSerial* serial;
+  uart_port_t port;
   int rxPin;
   int txPin;
-  unsigned long baudRate;
+  UartLineDetector line;
+  // Packed setting once locked, 0 before; the main loop persists it.
+  std::atomic<uint32_t> lockedLine{0};
   MonitorTransportState currentState;
-  String currentDetail;
+  QueueHandle_t events = nullptr;
+  bool installed = false;
+
+  // One bulk read, handed out a byte at a time. Bytes staged here precede
+  // any later loss, so a pending marker waits until they drain.
+  uint8_t chunk[kUartRxChunkBytes] = {};
+  size_t chunkOffset = 0;
+  size_t chunkLength = 0;
+  // UART_DATA bytes announced but not yet read.
+  size_t announcedBytes = 0;
+  uint32_t epoch = 0;
+  bool markerPending = false;
+  MonitorRxEventType markerType = MonitorRxEventType::DISCONTINUITY;
+  // Framing/parity errors since the last noteFraming().
+  uint32_t lineErrors = 0;
+
+  uint32_t lossEpisodes = 0;
+  uint32_t fifoOverflows = 0;
+  uint32_t bufferFullEvents = 0;
+  // Bytes discarded by the recovery flush. Bytes the FIFO or ISR already
+  // lost are not countable, so this is a lower bound.
+  uint32_t droppedBytes = 0;
+  uint32_t lastAcceptedUs = 0;
+  bool acceptedEver = false;
+
+  static uint32_t saturatingAdd(uint32_t value, size_t amount) {
+    return UINT32_MAX - value < amount ? UINT32_MAX
+                                       : value + static_cast<uint32_t>(amount);
+  }
+
+  void recordLoss(uart_event_type_t type) {
+    size_t buffered = 0;
+    uart_get_buffered_data_len(port, &buffered);
+    uart_flush_input(port);
+    xQueueReset(events);
+    announcedBytes = 0;
+    droppedBytes = saturatingAdd(droppedBytes, buffered);
+    uint32_t& counter =
+      type == UART_FIFO_OVF ? fifoOverflows : bufferFullEvents;
+    if (counter != UINT32_MAX) counter++;
+    // Back-to-back losses before the owner sees the marker are one gap.
+    if (!markerPending) {
+      if (lossEpisodes != UINT32_MAX) lossEpisodes++;
+      epoch++;
+      markerPending = true;
+      markerType = MonitorRxEventType::DISCONTINUITY;
+    }
+    markStatusChanged();
+  }
+
+  static uart_word_length_t wordLength(uint8_t dataBits) {
+    return static_cast<uart_word_length_t>(UART_DATA_5_BITS + (dataBits - 5));
+  }
+
+  static uart_parity_t parityMode(char parity) {
+    return parity == 'E' ? UART_PARITY_EVEN
+         : parity == 'O' ? UART_PARITY_ODD : UART_PARITY_DISABLE;
+  }
+
+  static uart_stop_bits_t stopBitsMode(uint8_t stopBits) {
+    return stopBits == 2 ? UART_STOP_BITS_2 : UART_STOP_BITS_1;
+  }
+
+  // Bytes already read or buffered belong to the old setting: drop them and
+  // restart the framer, without counting a data loss.
+  void applyLine() {
+    const UartLineSetting& setting = line.current();
+    uart_set_baudrate(port, setting.baudRate);
+    uart_set_word_length(port, wordLength(setting.dataBits));
+    uart_set_parity(port, parityMode(setting.parity));
+    uart_set_stop_bits(port, stopBitsMode(setting.stopBits));
+    uart_flush_input(port);
+    xQueueReset(events);
+    announcedBytes = 0;
+    chunkOffset = 0;
+    chunkLength = 0;
+    lineErrors = 0;
+    epoch++;
+    markerPending = true;
+    markerType = MonitorRxEventType::STREAM_RESET;
+    markStatusChanged();
+  }
+
+  // Stages the next bulk read or loss marker; false when the driver is idle.
+  bool fill() {
+    while (installed) {
+      if (announcedBytes > 0) {
+        const size_t wanted = announcedBytes < kUartRxChunkBytes
+          ? announcedBytes : kUartRxChunkBytes;
+        const int count = uart_read_bytes(port, chunk, wanted, 0);
+        if (count <= 0) {
+          announcedBytes = 0;
+          continue;
+        }
+        announcedBytes -= static_cast<size_t>(count);
+        chunkOffset = 0;
+        chunkLength = static_cast<size_t>(count);
+        lastAcceptedUs = static_cast<uint32_t>(micros());
+        acceptedEver = true;
+        return true;
+      }
+      uart_event_t event;
+      if (xQueueReceive(events, &event, 0) != pdTRUE) return false;
+      switch (event.type) {
+        case UART_DATA:
+          announcedBytes += event.size;
+          break;
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+          recordLoss(event.type);
+          return true;
+        case UART_FRAME_ERR:
+        case UART_PARITY_ERR:
+          // Evidence for the line detector; the framer rejects the bytes.
+          if (lineErrors != UINT32_MAX) lineErrors++;
+          break;
+        default:
+          break;
+      }
+    }
+    return false;
+  }
 
 public:
-  UartTransport(HardwareSerial* serial, int rxPin, int txPin, unsigned long baudRate)
-    : serial(serial), rxPin(rxPin), txPin(txPin), baudRate(baudRate), currentState(TRANSPORT_STATE_STARTING) {}
+  // `candidates` must outlive the transport. `persistedLine` is a packed
+  // setting from a previous lock, or 0 to start at the first candidate.
+  UartTransport(uart_port_t port, int rxPin, int txPin,
+                const UartLineSetting* candidates, size_t candidateCount,
+                uint32_t persistedLine)
+    : port(port), rxPin(rxPin), txPin(txPin), currentState(TRANSPORT_STATE_STARTING) {
+    line.begin(candidates, candidateCount, persistedLine);
+    if (line.locked()) lockedLine.store(uartLinePack(line.current()));
+  }
+
+  ~UartTransport() override {
+    if (installed) uart_driver_delete(port);
+  }
 
   bool begin() override {
-    serial->begin(baudRate, SERIAL_8N1, rxPin, txPin);
-    currentState = TRANSPORT_STATE_READY;
-    currentDetail = "UART fallback active (RX:";
-    currentDetail += rxPin;
-    currentDetail += ", TX:";
-    currentDetail += txPin;
-    currentDetail += ", ";
-    currentDetail += baudRate;
-    currentDetail += "bps)";
-    return true;
+    const UartLineSetting& setting = line.current();
+    uart_config_t config = {};
+    config.baud_rate = static_cast<int>(setting.baudRate);
+    config.data_bits = wordLength(setting.dataBits);
+    config.parity = parityMode(setting.parity);
+    config.stop_bits = stopBitsMode(setting.stopBits);
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_DEFAULT;
+    installed = uart_driver_install(port, kUartDriverRxBufferBytes, 0,
+                                    kUartEventQueueDepth, &events, 0) == ESP_OK;
+    if (installed &&
+        (uart_param_config(port, &config) != ESP_OK ||
+         uart_set_pin(port, txPin, rxPin, UART_PIN_NO_CHANGE,
+                      UART_PIN_NO_CHANGE) != ESP_OK)) {
+      uart_driver_delete(port);
+      installed = false;
+    }
+    currentState = installed ? TRANSPORT_STATE_READY : TRANSPORT_STATE_ERROR;
+    markStatusChanged();
+    return installed;
   }
 
   void poll() override {
-    if (serial->available() > 0) {
+    size_t buffered = 0;
+    if (installed) uart_get_buffered_data_len(port, &buffered);
+    if (buffered > 0 || chunkOffset < chunkLength) {
       currentState = TRANSPORT_STATE_RECEIVING;
       return;
     }
@@ -41,15 +206,37 @@ public:
   }
 
   int available() override {
-    return serial->available();
+    size_t buffered = 0;
+    if (installed) uart_get_buffered_data_len(port, &buffered);
+    return static_cast<int>(buffered + (chunkLength - chunkOffset));
   }
 
   int read() override {
-    int value = serial->read();
-    if (value >= 0) {
-      currentState = TRANSPORT_STATE_RECEIVING;
+    MonitorRxEvent event;
+    if (!nextRxEvent(event) || event.type != MonitorRxEventType::BYTE) {
+      return -1;
     }
-    return value;
+    return event.byte;
+  }
+
+  bool nextRxEvent(MonitorRxEvent& event) override {
+    if (chunkOffset >= chunkLength) {
+      chunkOffset = 0;
+      chunkLength = 0;
+      if (!markerPending && !fill()) return false;
+    }
+    event.device = 0;
+    event.epoch = epoch;
+    if (chunkOffset >= chunkLength) {
+      markerPending = false;
+      event.type = markerType;
+      event.byte = 0;
+      return true;
+    }
+    event.type = MonitorRxEventType::BYTE;
+    event.byte = chunk[chunkOffset++];
+    currentState = TRANSPORT_STATE_RECEIVING;
+    return true;
   }
 
   const char* name() const override {
@@ -61,7 +248,91 @@ public:
   }
 
   String detail() const override {
-    return currentDetail;
+    if (!installed) {
+      String failed = "UART driver install failed (UART";
+      failed += static_cast<int>(port);
+      failed += ")";
+      return failed;
+    }
+    const UartLineSetting& setting = line.current();
+    String text = "UART fallback active (RX:";
+    text += rxPin;
+    text += ", TX:";
+    text += txPin;
+    text += ", ";
+    text += static_cast<unsigned long>(setting.baudRate);
+    text += "bps ";
+    text += static_cast<int>(setting.dataBits);
+    text += setting.parity;
+    text += static_cast<int>(setting.stopBits);
+    text += line.locked() ? ", locked" : ", searching";
+    text += ")";
+    const UartLineTelemetry& telemetry = line.telemetry();
+    if (telemetry.switches > 0) {
+      text += " line_switches=";
+      text += telemetry.switches;
+    }
+    if (line.locked() && telemetry.lockedFrames > 0) {
+      text += " frames_per_kib=";
+      text += telemetry.framesPerKiB();
+    }
+    if (lossEpisodes > 0) {
+      text += " fifo_overflows=";
+      text += fifoOverflows;
+      text += " buffer_full=";
+      text += bufferFullEvents;
+      text += " dropped_bytes=";
+      text += droppedBytes;
+    }
+    return text;
+  }
+
+  uint32_t dataLossCount() const override { return lossEpisodes; }
+
+  // Ingest owner, after each pass: scores the current line setting and
+  // switches to the next candidate when the evidence says it is wrong.
+  void noteFraming(uint8_t device,
+                   const MonitorFramingReport& report) override {
+    if (device != 0 || !installed) return;
+    const bool wasLocked = line.locked();
+    const bool switched = line.note(report.bytes, report.validFrames,
+                                    report.rejectedFrames, lineErrors);
+    lineErrors = 0;
+    if (switched) applyLine();
+    if (line.locked()) {
+      lockedLine.store(uartLinePack(line.current()), std::memory_order_release);
+    }
+    // The detail text shows the lock and the score.
+    if (switched || wasLocked != line.locked() || report.validFrames > 0) {
+      markStatusChanged();
+    }
+  }
+
+  // Any task: the setting to persist, once one has locked.
+  bool lockedLineSetting(uint32_t& packed) const {
+    packed = lockedLine.load(std::memory_order_acquire);
+    return packed != 0;
+  }
+
+  const UartLineDetector& lineDetector() const { return line; }
+
+  MonitorTransportStatus status() const override {
+    MonitorTransportStatus result = MonitorTransport::status();
+    result.droppedBytes = droppedBytes;
+    result.overflowEpisodes = lossEpisodes;
+    return result;
+  }
+
+  MonitorDeviceSummary deviceSummary(uint8_t device) const override {
+    MonitorDeviceSummary result = MonitorTransport::deviceSummary(device);
+    if (device == 0) result.droppedBytes = droppedBytes;
+    return result;
+  }
+
+  bool lastRxAcceptedUs(uint32_t& acceptedUs) const override {
+    if (!acceptedEver) return false;
+    acceptedUs = lastAcceptedUs;
+    return true;
   }
 };
 
@@ -4,6 +4,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
+
 #include "UsbCdcState.h"
 
 template <typename Mutex>
@@ -44,6 +46,13 @@ struct UsbCdcDiagnosticsSnapshot {
 // One synchronized boundary shared by target production code and host/TSan
 // tests. Mutex is portMUX-backed on ESP32 and std::mutex on the host; lock
 // scope, channel ordering, producer gate, and context retirement are identical.
+//
+// The mutex covers lifecycle transitions only. The per-transfer data path and
+// the per-poll claim are lock-free: every transition that can change byte
+// admission republishes a per-slot admitted session, and an admitted data
+// callback registers in a per-slot counter before re-reading it. Both sides
+// use seq_cst, so a revocation followed by callbacksQuiescent() either sees
+// the in-flight commit or the callback sees the revocation.
 template <typename Mutex, size_t OrderedCapacity, size_t ContextCapacity>
 class UsbCdcSynchronizedState {
   static_assert(ContextCapacity > 0, "CDC context capacity must be nonzero");
@@ -103,7 +112,8 @@ public:
     ByteCommitLease& operator=(const ByteCommitLease&) = delete;
 
     ByteCommitLease(ByteCommitLease&& other) noexcept
-      : _owner(other._owner), _slot(other._slot), _session(other._session) {
+      : _owner(other._owner), _slot(other._slot), _session(other._session),
+        _lockFree(other._lockFree) {
       other._owner = nullptr;
     }
 
@@ -113,6 +123,7 @@ public:
       _owner = other._owner;
       _slot = other._slot;
       _session = other._session;
+      _lockFree = other._lockFree;
       other._owner = nullptr;
       return *this;
     }
@@ -123,18 +134,23 @@ public:
     friend class UsbCdcSynchronizedState;
 
     ByteCommitLease(UsbCdcSynchronizedState* owner, size_t slot,
-                    uint32_t session)
-      : _owner(owner), _slot(slot), _session(session) {}
+                    uint32_t session, bool lockFree = false)
+      : _owner(owner), _slot(slot), _session(session), _lockFree(lockFree) {}
 
     void release() {
       if (_owner == nullptr) return;
-      _owner->releaseByteCommit(_slot, _session);
+      if (_lockFree) {
+        _owner->_admittedCommits[_slot].fetch_sub(1, std::memory_order_release);
+      } else {
+        _owner->releaseByteCommit(_slot, _session);
+      }
       _owner = nullptr;
     }
 
     UsbCdcSynchronizedState* _owner = nullptr;
     size_t _slot = 0;
     uint32_t _session = 0;
+    bool _lockFree = false;
   };
 
   void startSession(uint32_t session) {
@@ -145,6 +161,7 @@ public:
     _terminalLossActive = false;
     _overflowLossActive = false;
     if (!_ordered.fallbackPending()) _quarantined = false;
+    publishAdmissionUnlocked();
   }
 
   void recordRejectedDrop(uint32_t droppedBytes) {
@@ -204,7 +221,9 @@ public:
     UsbCdcScopedLock<Mutex> lock(_mutex);
     bool enable = startResult == UsbCdcOrderedPublishResult::QUEUED &&
                   !_quarantined;
-    return _gate.commitConfiguration(token, enable);
+    bool committed = _gate.commitConfiguration(token, enable);
+    publishAdmissionUnlocked();
+    return committed;
   }
 
   int acquireContext(uint32_t session) {
@@ -219,6 +238,7 @@ public:
         _contexts[index].callbacks = 0;
         _contexts[index].byteCommits = 0;
         _nextContext = (index + 1) % ContextCapacity;
+        publishAdmissionUnlocked();
         return static_cast<int>(index);
       }
     }
@@ -227,12 +247,11 @@ public:
 
   bool abandonContext(size_t slot, uint32_t session) {
     UsbCdcScopedLock<Mutex> lock(_mutex);
-    if (!matchesUnlocked(slot, session) ||
-        _contexts[slot].callbacks != 0 ||
-        _contexts[slot].byteCommits != 0) {
+    if (!matchesUnlocked(slot, session) || !idleUnlocked(slot)) {
       return false;
     }
     _contexts[slot] = ContextState{};
+    publishAdmissionUnlocked();
     return true;
   }
 
@@ -256,6 +275,19 @@ public:
     return CallbackLease(this, slot, session);
   }
 
+  // Steady-state data path: no lock. Fails whenever admission needs the full
+  // check below (quarantine, terminal, retiring or stale session), so callers
+  // fall back to acquireCallback() + acquireByteCommitOrRecordDrop().
+  ByteCommitLease acquireAdmittedByteCommit(size_t slot, uint32_t session) {
+    if (slot >= ContextCapacity || session == 0) return ByteCommitLease{};
+    _admittedCommits[slot].fetch_add(1, std::memory_order_seq_cst);
+    if (_admittedSession[slot].load(std::memory_order_seq_cst) != session) {
+      _admittedCommits[slot].fetch_sub(1, std::memory_order_release);
+      return ByteCommitLease{};
+    }
+    return ByteCommitLease(this, slot, session, true);
+  }
+
   ByteCommitLease acquireByteCommitOrRecordDrop(
       size_t slot, uint32_t session, uint32_t epoch,
       uint32_t rejectedBytes, UsbCdcByteAdmission& admission) {
@@ -285,9 +317,7 @@ public:
 
   bool callbacksQuiescent(size_t slot, uint32_t session) {
     UsbCdcScopedLock<Mutex> lock(_mutex);
-    return !matchesUnlocked(slot, session) ||
-           (_contexts[slot].callbacks == 0 &&
-            _contexts[slot].byteCommits == 0);
+    return !matchesUnlocked(slot, session) || idleUnlocked(slot);
   }
 
   bool callbackEnabled(size_t slot, uint32_t session) {
@@ -316,6 +346,7 @@ public:
     }
     _quarantined = true;
     _gate.noteTerminal(session);
+    publishAdmissionUnlocked();
     return first ? UsbCdcTerminalUpdate::FIRST
                  : UsbCdcTerminalUpdate::UPGRADED;
   }
@@ -343,17 +374,20 @@ public:
         _terminalFact = UsbCdcTerminalFact::ERROR;
       }
     }
+    publishAdmissionUnlocked();
   }
 
   void quarantineProducer(uint32_t session) {
     UsbCdcScopedLock<Mutex> lock(_mutex);
     _quarantined = true;
     if (session != 0) _gate.stopProducer(session);
+    publishAdmissionUnlocked();
   }
 
   void stopProducer(uint32_t session) {
     UsbCdcScopedLock<Mutex> lock(_mutex);
     _gate.stopProducer(session);
+    publishAdmissionUnlocked();
   }
 
   UsbCdcOrderedPublishResult publish(const UsbCdcOrderedEvent& event,
@@ -364,6 +398,7 @@ public:
     if (result != UsbCdcOrderedPublishResult::QUEUED) {
       _quarantined = true;
       _gate.stopProducer(event.session);
+      publishAdmissionUnlocked();
     }
     return result;
   }
@@ -373,6 +408,7 @@ public:
     UsbCdcScopedLock<Mutex> lock(_mutex);
     _quarantined = true;
     _gate.stopProducer(event.session);
+    publishAdmissionUnlocked();
     return _ordered.publish(event, true, true);
   }
 
@@ -387,8 +423,12 @@ public:
                                  UsbCdcOrderedDelivery& delivery,
                                  bool connected,
                                  BeforeResume beforeResume) {
+    UsbCdcOrderedClaimResult result;
+    delivery.producerResumed = false;
+    if (_ordered.claimUnlocked(cursor, delivery, result)) return result;
+
     UsbCdcScopedLock<Mutex> lock(_mutex);
-    UsbCdcOrderedClaimResult result = _ordered.claim(cursor, delivery);
+    result = _ordered.claim(cursor, delivery);
     delivery.producerResumed = false;
     if (result == UsbCdcOrderedClaimResult::CLAIMED &&
         !_ordered.fallbackPending() &&
@@ -408,13 +448,12 @@ public:
       _quarantined = false;
       _gate.stopProducer(_gate.session());
     }
+    publishAdmissionUnlocked();
     return result;
   }
 
-  size_t pendingCount() {
-    UsbCdcScopedLock<Mutex> lock(_mutex);
-    return _ordered.pendingCount();
-  }
+  // Consumer side; lock-free.
+  size_t pendingCount() const { return _ordered.pendingCount(); }
 
   bool fallbackPending() {
     UsbCdcScopedLock<Mutex> lock(_mutex);
@@ -431,6 +470,7 @@ public:
     _ordered.clear();
     _quarantined = false;
     _overflowLossActive = false;
+    publishAdmissionUnlocked();
   }
 
   bool retireContext(size_t slot, uint32_t session) {
@@ -438,6 +478,7 @@ public:
     if (!matchesUnlocked(slot, session)) return false;
     _contexts[slot].retiring = true;
     _gate.stopProducer(session);
+    publishAdmissionUnlocked();
     return true;
   }
 
@@ -448,11 +489,9 @@ public:
       return UsbCdcCloseCompletion::STALE_CONTEXT;
     }
     if (!driverSucceeded) return UsbCdcCloseCompletion::DRIVER_FAILED;
-    if (_contexts[slot].callbacks != 0 ||
-        _contexts[slot].byteCommits != 0) {
-      return UsbCdcCloseCompletion::CALLBACKS_ACTIVE;
-    }
+    if (!idleUnlocked(slot)) return UsbCdcCloseCompletion::CALLBACKS_ACTIVE;
     _contexts[slot] = ContextState{};
+    publishAdmissionUnlocked();
     return UsbCdcCloseCompletion::RELEASED;
   }
 
@@ -490,6 +529,10 @@ private:
   uint32_t _overflowEpisodes = 0;
   bool _terminalLossActive = false;
   bool _overflowLossActive = false;
+  // Lock-free admission: session admitted per slot (0 = take the locked
+  // path) and commits currently holding that admission.
+  std::atomic<uint32_t> _admittedSession[ContextCapacity] = {};
+  std::atomic<uint32_t> _admittedCommits[ContextCapacity] = {};
 
   static uint32_t saturatingAdd(uint32_t left, uint32_t right) {
     return UINT32_MAX - left < right ? UINT32_MAX : left + right;
@@ -504,6 +547,26 @@ private:
            _contexts[slot].active && _contexts[slot].session == session;
   }
 
+  bool idleUnlocked(size_t slot) const {
+    return _contexts[slot].callbacks == 0 &&
+           _contexts[slot].byteCommits == 0 &&
+           _admittedCommits[slot].load(std::memory_order_seq_cst) == 0;
+  }
+
+  // Mirrors acquireCallback() + acquireByteCommitOrRecordDrop() admission.
+  // Called after every lifecycle change under the lock, before any later
+  // quiescence check reads _admittedCommits.
+  void publishAdmissionUnlocked() {
+    for (size_t slot = 0; slot < ContextCapacity; ++slot) {
+      const ContextState& context = _contexts[slot];
+      const bool admitted = context.active && !context.retiring &&
+                            !_quarantined &&
+                            _gate.callbackEnabled(context.session);
+      _admittedSession[slot].store(admitted ? context.session : 0,
+                                   std::memory_order_seq_cst);
+    }
+  }
+
   void releaseCallback(size_t slot, uint32_t session) {
     UsbCdcScopedLock<Mutex> lock(_mutex);
     if (matchesUnlocked(slot, session) && _contexts[slot].callbacks > 0) {
@@ -0,0 +1,93 @@
+#ifndef USB_CDC_RECONNECT_H
+#define USB_CDC_RECONNECT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Reconnect fast path and time-to-READY telemetry. Cuffs power-cycle between
+// patients, so most attaches are the same monitor coming back: the port that
+// last brought it to READY opens it again by exact VID/PID on the interface
+// that worked, instead of probing every interface of any device. Line coding
+// is not cached: every open applies the fixed HBP-9030 setting.
+struct UsbCdcDeviceProfile {
+  bool valid = false;
+  uint16_t vid = 0;
+  uint16_t pid = 0;
+  uint8_t interfaceIndex = 0;
+};
+
+// Attach-to-READY buckets, upper bounds in milliseconds; the last bucket is
+// everything slower.
+static constexpr uint32_t kUsbCdcReadyBucketLimitsMs[] = {
+  10, 25, 50, 100, 250, 1000,
+};
+static constexpr size_t kUsbCdcReadyBucketCount =
+  sizeof(kUsbCdcReadyBucketLimitsMs) / sizeof(kUsbCdcReadyBucketLimitsMs[0]) +
+  1;
+
+inline size_t usbCdcReadyBucket(uint32_t elapsedMs) {
+  for (size_t i = 0; i + 1 < kUsbCdcReadyBucketCount; ++i) {
+    if (elapsedMs <= kUsbCdcReadyBucketLimitsMs[i]) return i;
+  }
+  return kUsbCdcReadyBucketCount - 1;
+}
+
+struct UsbCdcReconnectTelemetry {
+  uint32_t readyByBucket[kUsbCdcReadyBucketCount] = {};
+  uint32_t lastReadyMs = 0;
+  uint32_t maxReadyMs = 0;
+  // Opens that used the cached profile, and ones that fell back to probing.
+  uint32_t fastPathOpens = 0;
+  uint32_t probedOpens = 0;
+
+  uint32_t samples() const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < kUsbCdcReadyBucketCount; ++i) {
+      total = UINT32_MAX - total < readyByBucket[i]
+        ? UINT32_MAX : total + readyByBucket[i];
+    }
+    return total;
+  }
+};
+
+// Owner task only. A reconnect is timed from the driver's attach stamp to
+// CONFIG_SUCCEEDED, and only for a port that has been READY before: the
+// first connection after boot is enumeration, not a reconnect.
+class UsbCdcReconnectTracker {
+public:
+  void noteAttached(uint32_t attachedMs, bool connected) {
+    if (!_profile.valid || connected || _timing) return;
+    _timing = true;
+    _attachedMs = attachedMs;
+  }
+
+  void noteOpened(bool fastPath) {
+    uint32_t& counter = fastPath ? _telemetry.fastPathOpens
+                                 : _telemetry.probedOpens;
+    if (counter != UINT32_MAX) counter++;
+  }
+
+  void noteReady(const UsbCdcDeviceProfile& profile, uint32_t nowMs) {
+    if (_timing) {
+      const uint32_t elapsed = nowMs - _attachedMs;
+      uint32_t& bucket = _telemetry.readyByBucket[usbCdcReadyBucket(elapsed)];
+      if (bucket != UINT32_MAX) bucket++;
+      _telemetry.lastReadyMs = elapsed;
+      if (elapsed > _telemetry.maxReadyMs) _telemetry.maxReadyMs = elapsed;
+      _timing = false;
+    }
+    _profile = profile;
+    _profile.valid = true;
+  }
+
+  const UsbCdcDeviceProfile& profile() const { return _profile; }
+  const UsbCdcReconnectTelemetry& telemetry() const { return _telemetry; }
+
+private:
+  UsbCdcDeviceProfile _profile;
+  UsbCdcReconnectTelemetry _telemetry;
+  uint32_t _attachedMs = 0;
+  bool _timing = false;
+};
+
+#endif
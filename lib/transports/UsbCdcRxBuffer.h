@@ -0,0 +1,164 @@
+#ifndef USB_CDC_RX_BUFFER_H
+#define USB_CDC_RX_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+// USB CDC RX stream-buffer sizing and occupancy telemetry. The buffer size is
+// chosen at begin() from a persisted recommendation, so field overflow data
+// (not guesswork) decides how much RAM the next boot reserves. PSRAM allows a
+// larger ceiling because the stream buffer is only touched from task context.
+static constexpr size_t kUsbCdcRxMinBytes = 1024;
+static constexpr size_t kUsbCdcRxMaxInternalBytes = 4096;
+static constexpr size_t kUsbCdcRxMaxPsramBytes = 32768;
+
+enum class UsbCdcRxLevel : uint8_t {
+  BELOW_QUARTER = 0,
+  BELOW_HALF,
+  BELOW_THREE_QUARTERS,
+  HIGH_WATER,
+  COUNT,
+};
+
+static constexpr size_t kUsbCdcRxLevelCount =
+  static_cast<size_t>(UsbCdcRxLevel::COUNT);
+
+inline UsbCdcRxLevel usbCdcRxLevel(uint32_t occupancy, uint32_t capacity) {
+  if (capacity == 0) return UsbCdcRxLevel::HIGH_WATER;
+  const uint64_t scaled = static_cast<uint64_t>(occupancy) * 4U;
+  if (scaled < capacity) return UsbCdcRxLevel::BELOW_QUARTER;
+  if (scaled < static_cast<uint64_t>(capacity) * 2U) {
+    return UsbCdcRxLevel::BELOW_HALF;
+  }
+  if (scaled < static_cast<uint64_t>(capacity) * 3U) {
+    return UsbCdcRxLevel::BELOW_THREE_QUARTERS;
+  }
+  return UsbCdcRxLevel::HIGH_WATER;
+}
+
+inline const char* usbCdcRxLevelCode(UsbCdcRxLevel level) {
+  switch (level) {
+    case UsbCdcRxLevel::BELOW_QUARTER:        return "lt25";
+    case UsbCdcRxLevel::BELOW_HALF:           return "lt50";
+    case UsbCdcRxLevel::BELOW_THREE_QUARTERS: return "lt75";
+    case UsbCdcRxLevel::HIGH_WATER:           return "ge75";
+    default:                                  return "unknown";
+  }
+}
+
+// Clamp a requested size to what the chosen memory can hold.
+inline size_t usbCdcRxClampCapacity(size_t requested, bool psram) {
+  const size_t ceiling = psram ? kUsbCdcRxMaxPsramBytes
+                               : kUsbCdcRxMaxInternalBytes;
+  if (requested < kUsbCdcRxMinBytes) return kUsbCdcRxMinBytes;
+  return requested > ceiling ? ceiling : requested;
+}
+
+struct UsbCdcRxTelemetry {
+  uint32_t capacityBytes = 0;
+  bool psram = false;
+  uint32_t highWatermarkBytes = 0;
+  uint32_t timeAtHighWaterMs = 0;
+  // Overflow episodes keyed by occupancy just before the overflowing
+  // transfer: a low level means a burst larger than the buffer, a high level
+  // means the consumer fell behind.
+  uint32_t overflowByLevel[kUsbCdcRxLevelCount] = {};
+
+  uint32_t overflowEpisodes() const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < kUsbCdcRxLevelCount; ++i) {
+      total = UINT32_MAX - total < overflowByLevel[i]
+        ? UINT32_MAX : total + overflowByLevel[i];
+    }
+    return total;
+  }
+};
+
+// Next boot's buffer size. Grows (doubling) after any overflow or once the
+// high watermark reaches the top quarter; never shrinks on its own, since a
+// quiet week says little about the next burst.
+inline size_t usbCdcRxNextCapacity(const UsbCdcRxTelemetry& telemetry,
+                                   size_t maxBytes) {
+  const size_t current = telemetry.capacityBytes < kUsbCdcRxMinBytes
+    ? kUsbCdcRxMinBytes : telemetry.capacityBytes;
+  const bool pressured =
+    telemetry.overflowEpisodes() > 0 ||
+    usbCdcRxLevel(telemetry.highWatermarkBytes, telemetry.capacityBytes) ==
+      UsbCdcRxLevel::HIGH_WATER;
+  if (!pressured || current >= maxBytes) return current;
+  return current > maxBytes / 2 ? maxBytes : current * 2;
+}
+
+// Producer methods run in the CDC data callback (one task); sampleOwner()
+// runs in the transport owner task; snapshot() may run anywhere. Counters are
+// relaxed atomics: each is independently meaningful and only ever grows.
+class UsbCdcRxOccupancyMonitor {
+public:
+  void configure(uint32_t capacityBytes, bool psram) {
+    _capacity = capacityBytes;
+    _psram = psram;
+  }
+
+  // Producer: occupancy right after a successful stream send.
+  void noteAccepted(uint32_t occupancy) {
+    if (occupancy > _highWatermark.load(std::memory_order_relaxed)) {
+      _highWatermark.store(occupancy, std::memory_order_relaxed);
+    }
+  }
+
+  // Producer: a transfer did not fit; `occupancyBefore` is the level it found.
+  void noteOverflow(uint32_t occupancyBefore) {
+    _highWatermark.store(_capacity, std::memory_order_relaxed);
+    std::atomic<uint32_t>& counter = _overflowByLevel[
+      static_cast<size_t>(usbCdcRxLevel(occupancyBefore, _capacity))];
+    const uint32_t current = counter.load(std::memory_order_relaxed);
+    if (current != UINT32_MAX) {
+      counter.store(current + 1U, std::memory_order_relaxed);
+    }
+  }
+
+  // Owner: attribute the interval since the previous sample to the level
+  // seen then. Resolution is the owner's wake interval: a transfer or two
+  // while bytes flow, the idle wait once the bus is quiet.
+  void sampleOwner(uint32_t occupancy, uint32_t nowMs) {
+    if (_sampled && _lastHigh) {
+      const uint32_t elapsed = nowMs - _lastSampleMs;
+      const uint32_t total = _timeAtHighWaterMs.load(std::memory_order_relaxed);
+      _timeAtHighWaterMs.store(UINT32_MAX - total < elapsed
+                                 ? UINT32_MAX : total + elapsed,
+                               std::memory_order_relaxed);
+    }
+    _sampled = true;
+    _lastSampleMs = nowMs;
+    _lastHigh = usbCdcRxLevel(occupancy, _capacity) ==
+                UsbCdcRxLevel::HIGH_WATER;
+  }
+
+  UsbCdcRxTelemetry snapshot() const {
+    UsbCdcRxTelemetry result;
+    result.capacityBytes = _capacity;
+    result.psram = _psram;
+    result.highWatermarkBytes = _highWatermark.load(std::memory_order_relaxed);
+    result.timeAtHighWaterMs =
+      _timeAtHighWaterMs.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kUsbCdcRxLevelCount; ++i) {
+      result.overflowByLevel[i] =
+        _overflowByLevel[i].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+private:
+  uint32_t _capacity = 0;
+  bool _psram = false;
+  std::atomic<uint32_t> _highWatermark{0};
+  std::atomic<uint32_t> _timeAtHighWaterMs{0};
+  std::atomic<uint32_t> _overflowByLevel[kUsbCdcRxLevelCount] = {};
+  uint32_t _lastSampleMs = 0;
+  bool _sampled = false;
+  bool _lastHigh = false;
+};
+
+#endif
@@ -4,6 +4,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
+
 enum class UsbCdcPhase : uint8_t {
   STARTING = 0,
   INSTALLING,
@@ -154,6 +156,7 @@ public:
   }
 
   void noteByteDelivered() { _deliveredByteSequence++; }
+  void noteBytesDelivered(uint32_t count) { _deliveredByteSequence += count; }
 
   void applyControl(const UsbCdcOrderedEvent& event) {
     if (!controlDue(event)) return;
@@ -199,32 +202,54 @@ struct UsbCdcOrderedDelivery {
   bool fromFallback = false;
   bool quarantineBarrier = false;
   bool producerResumed = false;
+  // Set on BLOCKED: bytes the cursor may still deliver before the head control.
+  uint32_t bytesBeforeControl = UINT32_MAX;
 };
 
-// Fixed-capacity ordered control channel. The caller supplies synchronization:
-// production wraps every method with one portMUX, while host stress uses one
-// std::mutex. Once the ring fills, every later control merges into the single
-// fallback so no newer queue item can overtake it.
+// Bytes the consumer may move in one bulk receive without crossing the next
+// ordered control. `acceptedSnapshot` must be loaded before the claim that
+// filled `delivery`: a control published after that load has a boundary at
+// or beyond the snapshot, so a chunk can never straddle a loss marker.
+inline size_t usbCdcBulkReceiveLimit(const UsbCdcOrderedCursor& cursor,
+                                     uint32_t acceptedSnapshot,
+                                     const UsbCdcOrderedDelivery& delivery,
+                                     size_t chunkCapacity) {
+  uint32_t limit = acceptedSnapshot - cursor.deliveredByteSequence();
+  if (limit > UINT32_MAX / 2U) return 0;  // Snapshot predates a session reset.
+  if (delivery.bytesBeforeControl < limit) limit = delivery.bytesBeforeControl;
+  return limit < chunkCapacity ? static_cast<size_t>(limit) : chunkCapacity;
+}
+
+// Fixed-capacity ordered control channel, single consumer. Producers are
+// serialized by the caller (one portMUX in production, one std::mutex in host
+// stress) because publishing a control is a rare lifecycle transition. The
+// ring indices are acquire/release atomics, so the consumer can run
+// claimUnlocked() without that lock; only fallback, stale and
+// quarantine-barrier claims still need claim() under the caller's lock. Once
+// the ring fills, every later control merges into the single fallback so no
+// newer queue item can overtake it.
 template <size_t Capacity>
 class UsbCdcOrderedChannel {
   static_assert(Capacity > 0, "ordered channel capacity must be nonzero");
 
 public:
+  // Producer side, caller-serialized.
   UsbCdcOrderedPublishResult publish(const UsbCdcOrderedEvent& event,
                                      bool resumeProducer,
                                      bool quarantineBarrier = false) {
-    if (_fallbackPending) {
+    if (_fallbackPending.load(std::memory_order_relaxed)) {
       mergeFallback(event, resumeProducer, quarantineBarrier);
       return UsbCdcOrderedPublishResult::FALLBACK_MERGED;
     }
-    if (_count < Capacity) {
-      _items[_tail].event = event;
-      _items[_tail].resumeProducer = resumeProducer;
-      _items[_tail].fromFallback = false;
-      _items[_tail].quarantineBarrier = quarantineBarrier;
-      _items[_tail].producerResumed = false;
-      _tail = (_tail + 1) % Capacity;
-      _count++;
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (distance(_head.load(std::memory_order_acquire), tail) < Capacity) {
+      UsbCdcOrderedDelivery& item = _items[tail % Capacity];
+      item.event = event;
+      item.resumeProducer = resumeProducer;
+      item.fromFallback = false;
+      item.quarantineBarrier = quarantineBarrier;
+      item.producerResumed = false;
+      _tail.store(advance(tail), std::memory_order_release);
       return UsbCdcOrderedPublishResult::QUEUED;
     }
     _fallback.event = event;
@@ -232,31 +257,73 @@ public:
     _fallback.fromFallback = true;
     _fallback.quarantineBarrier = quarantineBarrier;
     _fallback.producerResumed = false;
-    _fallbackPending = true;
+    _fallbackPending.store(true, std::memory_order_release);
     return UsbCdcOrderedPublishResult::FALLBACK_CREATED;
   }
 
+  // Consumer side without the producer lock. Returns false when the head needs
+  // claim() under the lock: a fallback, a stale item, or a due quarantine
+  // barrier whose claim also changes producer state. A control published
+  // after the consumer sampled its accepted-byte snapshot has a boundary at or
+  // beyond that snapshot, so missing it here is the same benign race the
+  // locked claim already had.
+  bool claimUnlocked(const UsbCdcOrderedCursor& cursor,
+                     UsbCdcOrderedDelivery& delivery,
+                     UsbCdcOrderedClaimResult& result) {
+    delivery.bytesBeforeControl = UINT32_MAX;
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire)) {
+      if (_fallbackPending.load(std::memory_order_acquire)) return false;
+      result = UsbCdcOrderedClaimResult::NONE;
+      return true;
+    }
+    const UsbCdcOrderedDelivery& item = _items[head % Capacity];
+    if (cursor.controlStale(item.event)) return false;
+    if (!cursor.controlDue(item.event)) {
+      delivery.bytesBeforeControl =
+        item.event.byteBoundary - cursor.deliveredByteSequence();
+      result = UsbCdcOrderedClaimResult::BLOCKED;
+      return true;
+    }
+    if (item.quarantineBarrier) return false;
+    delivery = item;
+    delivery.bytesBeforeControl = UINT32_MAX;
+    _head.store(advance(head), std::memory_order_release);
+    result = UsbCdcOrderedClaimResult::CLAIMED;
+    return true;
+  }
+
+  // Consumer side under the producer lock; handles every head kind.
   UsbCdcOrderedClaimResult claim(const UsbCdcOrderedCursor& cursor,
                                  UsbCdcOrderedDelivery& delivery) {
-    if (_count > 0) {
-      const UsbCdcOrderedDelivery& head = _items[_head];
-      if (cursor.controlStale(head.event)) {
+    delivery.bytesBeforeControl = UINT32_MAX;
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (head != _tail.load(std::memory_order_acquire)) {
+      const UsbCdcOrderedDelivery& item = _items[head % Capacity];
+      if (cursor.controlStale(item.event)) {
         popQueue();
         return UsbCdcOrderedClaimResult::STALE_QUEUE_DISCARDED;
       }
-      if (!cursor.controlDue(head.event)) {
+      if (!cursor.controlDue(item.event)) {
+        delivery.bytesBeforeControl =
+          item.event.byteBoundary - cursor.deliveredByteSequence();
         return UsbCdcOrderedClaimResult::BLOCKED;
       }
-      delivery = head;
+      delivery = item;
+      delivery.bytesBeforeControl = UINT32_MAX;
       popQueue();
       return UsbCdcOrderedClaimResult::CLAIMED;
     }
-    if (!_fallbackPending) return UsbCdcOrderedClaimResult::NONE;
+    if (!_fallbackPending.load(std::memory_order_acquire)) {
+      return UsbCdcOrderedClaimResult::NONE;
+    }
     if (cursor.controlStale(_fallback.event)) {
       clearFallback();
       return UsbCdcOrderedClaimResult::STALE_FALLBACK_DISCARDED;
     }
     if (!cursor.controlDue(_fallback.event)) {
+      delivery.bytesBeforeControl =
+        _fallback.event.byteBoundary - cursor.deliveredByteSequence();
       return UsbCdcOrderedClaimResult::BLOCKED;
     }
     delivery = _fallback;
@@ -264,21 +331,35 @@ public:
     return UsbCdcOrderedClaimResult::CLAIMED;
   }
 
-  size_t pendingCount() const { return _count + (_fallbackPending ? 1 : 0); }
-  bool fallbackPending() const { return _fallbackPending; }
+  // Exact for the consumer and under the producer lock; a lower bound for
+  // any other observer.
+  size_t pendingCount() const {
+    const size_t head = _head.load(std::memory_order_acquire);
+    const size_t queued = distance(head, _tail.load(std::memory_order_acquire));
+    return queued +
+           (_fallbackPending.load(std::memory_order_acquire) ? 1 : 0);
+  }
 
+  bool fallbackPending() const {
+    return _fallbackPending.load(std::memory_order_acquire);
+  }
+
+  // Producer lock held.
   bool hasPendingQuarantineBarrier() const {
-    if (_fallbackPending && _fallback.quarantineBarrier) return true;
-    for (size_t offset = 0; offset < _count; ++offset) {
-      size_t index = (_head + offset) % Capacity;
-      if (_items[index].quarantineBarrier) return true;
+    if (fallbackPending() && _fallback.quarantineBarrier) return true;
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    for (size_t index = _head.load(std::memory_order_acquire); index != tail;
+         index = advance(index)) {
+      if (_items[index % Capacity].quarantineBarrier) return true;
     }
     return false;
   }
 
+  // Producer lock held. Only quarantine barriers are amended in place, and the
+  // consumer never copies a barrier outside that lock.
   bool appendDroppedBytesToResume(uint32_t session, uint32_t epoch,
                                   uint32_t droppedBytes) {
-    if (_fallbackPending && _fallback.quarantineBarrier &&
+    if (fallbackPending() && _fallback.quarantineBarrier &&
         _fallback.event.type == UsbCdcOrderedType::DISCONTINUITY &&
         _fallback.event.session == session &&
         _fallback.event.epoch == epoch) {
@@ -286,9 +367,11 @@ public:
         _fallback.event.droppedBytes, droppedBytes);
       return true;
     }
-    for (size_t offset = 0; offset < _count; ++offset) {
-      size_t index = (_tail + Capacity - 1 - offset) % Capacity;
-      UsbCdcOrderedDelivery& delivery = _items[index];
+    const size_t head = _head.load(std::memory_order_acquire);
+    size_t index = _tail.load(std::memory_order_relaxed);
+    while (index != head) {
+      index = retreat(index);
+      UsbCdcOrderedDelivery& delivery = _items[index % Capacity];
       if (delivery.quarantineBarrier &&
           delivery.event.type == UsbCdcOrderedType::DISCONTINUITY &&
           delivery.event.session == session &&
@@ -301,36 +384,48 @@ public:
     return false;
   }
 
+  // Producer lock held and the consumer idle (same task or quiesced).
   void clear() {
     for (size_t i = 0; i < Capacity; ++i) _items[i] = UsbCdcOrderedDelivery{};
-    _head = 0;
-    _tail = 0;
-    _count = 0;
+    _head.store(0, std::memory_order_release);
+    _tail.store(0, std::memory_order_release);
     clearFallback();
   }
 
 private:
+  // Indices run over [0, 2 * Capacity) so a full ring differs from an empty
+  // one without a shared count.
+  static constexpr size_t kIndexSpan = Capacity * 2;
+
   UsbCdcOrderedDelivery _items[Capacity] = {};
-  size_t _head = 0;
-  size_t _tail = 0;
-  size_t _count = 0;
+  std::atomic<size_t> _head{0};  // Written by the consumer only.
+  std::atomic<size_t> _tail{0};  // Written by the serialized producers only.
   UsbCdcOrderedDelivery _fallback;
-  bool _fallbackPending = false;
+  std::atomic<bool> _fallbackPending{false};
+
+  static size_t advance(size_t index) { return (index + 1) % kIndexSpan; }
+  static size_t retreat(size_t index) {
+    return (index + kIndexSpan - 1) % kIndexSpan;
+  }
+  static size_t distance(size_t head, size_t tail) {
+    return (tail + kIndexSpan - head) % kIndexSpan;
+  }
 
   static uint32_t saturatingAdd(uint32_t left, uint32_t right) {
     if (UINT32_MAX - left < right) return UINT32_MAX;
     return left + right;
   }
 
+  // Slots are not scrubbed on pop: a producer scanning for a resume barrier
+  // may still read a slot the consumer has just released.
   void popQueue() {
-    _items[_head] = UsbCdcOrderedDelivery{};
-    _head = (_head + 1) % Capacity;
-    _count--;
+    _head.store(advance(_head.load(std::memory_order_relaxed)),
+                std::memory_order_release);
   }
 
   void clearFallback() {
     _fallback = UsbCdcOrderedDelivery{};
-    _fallbackPending = false;
+    _fallbackPending.store(false, std::memory_order_release);
   }
 
   void mergeFallback(const UsbCdcOrderedEvent& event, bool resumeProducer,
@@ -507,6 +602,13 @@ inline bool usbCdcMayEnqueueCriticalControl(size_t queueSpaces) {
   return queueSpaces > 0;
 }
 
+// A port that has been READY treats a fresh attach as its monitor coming
+// back. Its first open retries come quickly, since a cuff that has just
+// powered up may need a moment before its interface opens. The normal
+// back-off resumes after that.
+static constexpr uint8_t USB_CDC_FAST_OPEN_RETRIES = 3;
+static constexpr uint64_t USB_CDC_FAST_OPEN_RETRY_MS = 50;
+
 class UsbCdcLifecycle {
 public:
   void apply(const UsbCdcControlEvent& event, uint64_t nowMs) {
@@ -543,6 +645,7 @@ public:
         _deviceAttached = true;
         if (_hostReady && _driverReady && !_connected && !_handleOwned) {
           _phase = UsbCdcPhase::WAITING_DEVICE;
+          if (_everConnected) _fastOpenRetries = USB_CDC_FAST_OPEN_RETRIES;
         }
         break;
 
@@ -587,6 +690,7 @@ public:
           _phase = UsbCdcPhase::READY;
           _retryTarget = UsbCdcRetryTarget::NONE;
           _openRetryAttempt = 0;
+          _fastOpenRetries = 0;
           _lastError = 0;
           _overflowActive = false;
           _terminalHandled = false;
@@ -744,6 +848,7 @@ private:
   bool _terminalHandled = false;
   uint8_t _installRetryAttempt = 0;
   uint8_t _openRetryAttempt = 0;
+  uint8_t _fastOpenRetries = 0;
   uint64_t _retryAtMs = 0;
   int32_t _lastError = 0;
   uint32_t _rxEpoch = 0;
@@ -775,8 +880,13 @@ private:
   }
 
   void scheduleOpenRetry(int32_t error, uint64_t nowMs) {
-    if (_openRetryAttempt < UINT8_MAX) _openRetryAttempt++;
-    _retryAtMs = nowMs + retryDelayMs(_openRetryAttempt);
+    if (_fastOpenRetries > 0) {
+      _fastOpenRetries--;
+      _retryAtMs = nowMs + USB_CDC_FAST_OPEN_RETRY_MS;
+    } else {
+      if (_openRetryAttempt < UINT8_MAX) _openRetryAttempt++;
+      _retryAtMs = nowMs + retryDelayMs(_openRetryAttempt);
+    }
     _retryTarget = UsbCdcRetryTarget::OPEN;
     _lastError = error;
     _phase = UsbCdcPhase::RETRY_WAIT;
@@ -3,10 +3,17 @@
 
 #include <Arduino.h>
 #include "MonitorTransport.h"
+#include "UsbCdcReconnect.h"
+#include "UsbCdcRxBuffer.h"
 
 class UsbCdcTransport : public MonitorTransport {
 public:
-  UsbCdcTransport();
+  // rxBufferBytes is clamped to kUsbCdcRxMinBytes..the PSRAM or internal
+  // ceiling; begin() allocates it from PSRAM when the board has it.
+  // deviceCount (1..kMaxMonitorDevices) monitors may share one hub; each
+  // gets its own RX buffer of that size and is opened independently.
+  explicit UsbCdcTransport(size_t rxBufferBytes = kUsbCdcRxMinBytes,
+                           uint8_t deviceCount = 1);
   ~UsbCdcTransport() override;
 
   bool begin() override;
@@ -14,13 +21,23 @@ public:
   int available() override;
   int read() override;
   bool nextRxEvent(MonitorRxEvent& event) override;
+  bool setWakeCallback(MonitorWakeCallback callback, void* context) override;
   const char* name() const override;
   MonitorTransportState state() const override;
   String detail() const override;
+  MonitorTransportStatus status() const override;
   uint32_t dataLossCount() const override;
   uint32_t reconnectCount() const override;
+  bool lastRxAcceptedUs(uint32_t& acceptedUs) const override;
+  uint8_t deviceCount() const override;
+  MonitorDeviceSummary deviceSummary(uint8_t device) const override;
+  bool deviceRxAcceptedUs(uint8_t device, uint32_t& acceptedUs) const override;
   uint32_t droppedByteCount() const;
   uint32_t overflowEpisodeCount() const;
+  // Any task: RX buffer size, occupancy high watermark and overflow levels.
+  UsbCdcRxTelemetry rxTelemetry(uint8_t device = 0) const;
+  // Owner task only: attach-to-READY histogram and fast-path opens.
+  UsbCdcReconnectTelemetry reconnectTelemetry(uint8_t device = 0) const;
 
   // Exposed so the OTG callbacks implemented in sketch/src can access state
   // without pulling ESP-IDF USB types into this header.
@@ -4,56 +4,63 @@ cd "$(dirname "$0")/.."
 
 header=lib/BoundedWebServer.h
 source=src/BoundedWebServer.cpp
+table=lib/BoundedConnectionTable.h
 
 test -f "$header"
 test -f "$source"
+test -f "$table"
 
 grep -Fq 'class BoundedWebServer' "$header"
 grep -Fq 'void handleClient() override' "$header"
 grep -Fq 'size_t _currentClientWrite(' "$header"
-grep -Fq 'BoundedHttpTransaction _transaction' "$header"
-grep -Fq 'BoundedIngressBuffer _ingress' "$header"
 grep -Fq 'BoundedSocketRuntime _socketRuntime' "$header"
+grep -Fq 'BoundedConnectionTable<kBoundedWebSlots> _connections' "$header"
+grep -Fq 'BoundedHttpTransaction transaction;' "$table"
+grep -Fq 'BoundedIngressBuffer ingress;' "$table"
+grep -Fq 'BoundedSocketRuntime _socketRuntime;' "$table"
+grep -Fq 'kBoundedWebSlots = ' "$table"
 
 grep -Fq '_server.accept()' "$source"
+grep -Fq '_connections.acquire()' "$source"
+grep -Fq '_connections.forEachActive(' "$source"
 grep -Fq 'MSG_DONTWAIT' "$source"
 grep -Fq '::send(' "$source"
 grep -Fq '::recv(' "$source"
 grep -Fq '::shutdown(' "$source"
 grep -Fq 'BoundedIngressBuffer::kCapacity' lib/BoundedSocketRuntime.h
-grep -Fq '_transaction.consume(' "$source"
+grep -Fq 'transaction.consume(' "$source"
 grep -Fq '_gate->evaluate(' "$source"
-grep -Fq '_transaction.request(), _runtimeSnapshot.security' "$source"
-grep -Fq 'pumpResponse(_socketRuntime.nowMs())' "$source"
-grep -Fq '_socketRuntime.beginDrain()' "$source"
-grep -Fq '_socketRuntime.pollDrain(' "$source"
+grep -Fq 'transaction.request(), _runtimeSnapshot.security' "$source"
+grep -Fq 'connection.pumpResponse(_socketRuntime.nowMs())' "$source"
+grep -Fq 'socketRuntime.beginDrain()' "$source"
+grep -Fq 'socketRuntime.pollDrain(' "$source"
 grep -Fq 'catch (const std::bad_alloc&)' "$source"
-grep -Fq '_transaction.rejectCapture(' "$source"
+grep -Fq 'transaction.rejectCapture(' "$source"
 grep -Fq 'mandatoryResponseHeadersAreExact()' "$source"
-grep -Fq '_transaction.capturedResponseIsValidHttp1()' "$source"
+grep -Fq 'transaction.capturedResponseIsValidHttp1()' "$source"
 grep -Fq 'BoundedStreamConsumer _streamConsumer' "$header"
 grep -Fq 'configureStreamConsumer(' "$header"
 grep -Fq '_streamConsumer.start(' "$source"
 grep -Fq '_streamConsumer.write(' "$source"
 grep -Fq '_streamConsumer.finish()' "$source"
 grep -Fq '_streamConsumer.cancel()' "$source"
-grep -Fq '_transaction.rejectBody(503' "$source"
+grep -Fq 'transaction.rejectBody(503' "$source"
 
 gate_line=$(grep -nF '_gate->evaluate(' "$source" | head -1 | cut -d: -f1)
 stream_begin_line=$(grep -nF '_streamConsumer.start(' "$source" | head -1 | cut -d: -f1)
-policy_line=$(grep -nF '_transaction.acceptPolicy(' "$source" | head -1 | cut -d: -f1)
+policy_line=$(grep -nF 'transaction.acceptPolicy(' "$source" | head -1 | cut -d: -f1)
 if [[ -z "$gate_line" || -z "$policy_line" || -z "$stream_begin_line" || \
       ! "$gate_line" -lt "$policy_line" || ! "$policy_line" -lt "$stream_begin_line" ]]; then
   echo "stream sink must begin only after gate and request policy acceptance" >&2
   exit 1
 fi
 
-if grep -Eq '_parseRequest|_currentClient\.(available|connected|read)|readString|readBytes|delay\(|yield\(' "$source"; then
+if grep -Eq '_parseRequest|(_currentClient|_clients\[[^]]*\])\.(available|connected|read)|readString|readBytes|delay\(|yield\(' "$source" "$table"; then
   echo "bounded web runtime uses a blocking/stock parser primitive" >&2
   exit 1
 fi
 
-if grep -Eq '_currentClient\.write' "$source"; then
+if grep -Eq '(_currentClient|_clients\[[^]]*\])\.write' "$source" "$table"; then
   echo "bounded web runtime bypasses or redefines the capture contract" >&2
   exit 1
 fi
@@ -1,6 +1,7 @@
 #!/usr/bin/env bash
 set -euo pipefail
 FILE="lib/WebHandler.h"
+STYLE="web/style.css"
 SKETCH="BP_checker.ino"
 for token in \
   "--bg" "--surface" "--primary" \
@@ -28,9 +29,19 @@ for token in \
   "loss.textContent=d.data_loss_count" "reconnect.textContent=d.reconnect_count" \
     "時間來源"
 do
-  grep -Fq -- "$token" "$FILE" || { echo "missing token: $token"; exit 1; }
+  grep -Fq -- "$token" "$FILE" "$STYLE" || { echo "missing token: $token"; exit 1; }
 done
 
+# Styles come only from the cached /static/ asset; pages must not inline <style>.
+grep -Fq "<link rel='stylesheet' href='\";" "$FILE" || {
+  echo "pages must link the cached static stylesheet"
+  exit 1
+}
+if grep -Fq "<style" "$FILE"; then
+  echo "inline <style> found; edit $STYLE and regenerate lib/StaticAssets.h"
+  exit 1
+fi
+
 for token in \
   'FirmwareUpdateRuntime* firmwareUpdateRuntime' \
   '/firmware_update' '/authorize_firmware' '/install_firmware' \
@@ -112,7 +123,7 @@ if [[ -z "$policy_snapshot_line" || -z "$policy_snapshot_value_line" || \
   exit 1
 fi
 
-latest_json_line=$(grep -nF "const d=await r.json();" "$FILE" \
+latest_json_line=$(grep -nF "const d=unchanged?bpLastData:await r.json();" "$FILE" \
   | head -1 | cut -d: -f1)
 policy_reload_line=$(grep -nF \
   "if(String(d.policy_version)!==bpPolicyVersion){location.reload();return;}" \
@@ -134,6 +145,39 @@ if [[ -z "$latest_json_line" || -z "$policy_reload_line" || \
   exit 1
 fi
 
+# Conditional polling: a 304 reuses the last body and keeps advancing the
+# receive age locally instead of resetting it to the cached value.
+for token in \
+  "headers:bpEtag?{'If-None-Match':bpEtag}:{}" \
+  "const unchanged=r.status===304&&bpLastData!==null;" \
+  "if(!unchanged){bpLastData=d;bpEtag=r.headers.get('ETag')||'';}" \
+  "if (answerNotModified(etag)) return;"
+do
+  grep -Fq -- "$token" "$FILE" || {
+    echo "missing conditional JSON polling contract: $token"
+    exit 1
+  }
+done
+
+# Live updates: the dashboard listens on /api/events and shares bpApply with
+# the conditional poll, which remains the fallback when the stream is refused.
+for token in \
+  'server->on("/api/events", HTTP_GET' \
+  "text/event-stream" \
+  "new EventSource('/api/events')" \
+  "if(!window.EventSource){bpRefresh();return;}" \
+  "bpEvents.addEventListener('heartbeat',()=>{bpLastSuccessfulResponseAt=Date.now();});" \
+  "if(bpEvents&&bpEvents.readyState===EventSource.CLOSED){bpEvents=null;bpRefresh();}" \
+  "bpApply(d,!unchanged);" \
+  "if(bpEvents){bpEvents.close();bpEvents=null;}" \
+  "bpListen();"
+do
+  grep -Fq -- "$token" "$FILE" || {
+    echo "missing live event stream contract: $token"
+    exit 1
+  }
+done
+
 for token in \
   "MonotonicMillis64 uptimeClock" \
   "uptimeClock.observe(static_cast<uint32_t>(millis()))" \
@@ -179,7 +223,7 @@ done
 for required_injection in \
   "classifyMeasurement(latest, activePolicy())" \
   "classifyMeasurement(record, activePolicy())" \
-  "input.staleAfterMs = activePolicy().staleAfterMs" \
+  "snapshot.freshnessInput(nowMs, activePolicy().staleAfterMs)" \
   "policy_name" "policy_version"
 do
   grep -Fq -- "$required_injection" "$FILE" || {
@@ -189,11 +233,11 @@ do
 done
 
 for token in \
-  'setUInt64Json(doc["revision"], recordManager->getRevision())' \
+  'json.uint64Field("revision", recordManager->getRevision())' \
   'setUInt64Json(doc["record_sequence"], latest.recordSequence)' \
   'setUInt64Json(doc["session_sequence"], latest.sessionSequence)' \
-  'setUInt64Json(recordObj["record_sequence"], record.recordSequence)' \
-  'setUInt64Json(recordObj["session_sequence"], record.sessionSequence)'
+  'json.uint64Field("record_sequence", record.recordSequence)' \
+  'json.uint64Field("session_sequence", record.sessionSequence)'
 do
   grep -Fq -- "$token" "$FILE" || {
     echo "opaque uint64 API field is not an exact decimal JSON string: $token"
@@ -206,7 +250,9 @@ for forbidden_numeric in \
   'doc["record_sequence"] = latest.recordSequence' \
   'doc["session_sequence"] = latest.sessionSequence' \
   'recordObj["record_sequence"] = record.recordSequence' \
-  'recordObj["session_sequence"] = record.sessionSequence'
+  'recordObj["session_sequence"] = record.sessionSequence' \
+  'json.field("record_sequence", record.recordSequence)' \
+  'json.field("session_sequence", record.sessionSequence)'
 do
   if grep -Fq -- "$forbidden_numeric" "$FILE"; then
     echo "opaque uint64 API field would lose precision in JSON: $forbidden_numeric"
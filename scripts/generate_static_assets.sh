@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+# Compiles web/style.css into lib/StaticAssets.h: gzip bytes kept in flash, a
+# content-hash ETag, and a versioned /static path that changes with the
+# content so browsers may cache it as immutable. Run after editing the CSS;
+# --check fails when the committed header no longer matches the source.
+set -euo pipefail
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+cd "$ROOT"
+
+SOURCE=web/style.css
+OUTPUT=lib/StaticAssets.h
+
+test -f "$SOURCE" || {
+  echo "static asset source is missing: $SOURCE" >&2
+  exit 1
+}
+
+source_sha=$(sha256sum "$SOURCE" | cut -d' ' -f1)
+version=${source_sha:0:16}
+
+if [[ "${1:-}" == "--check" ]]; then
+  grep -Fq "kStyleCssSourceSha256[] = \"$source_sha\";" "$OUTPUT" || {
+    echo "$OUTPUT is stale; run scripts/generate_static_assets.sh" >&2
+    exit 1
+  }
+  echo "static assets are current"
+  exit 0
+fi
+
+command -v gzip >/dev/null || {
+  echo "gzip is required" >&2
+  exit 1
+}
+
+tmp=$(mktemp)
+trap 'rm -f "$tmp"' EXIT
+{
+  cat <<EOF
+// Generated by scripts/generate_static_assets.sh from $SOURCE. Do not edit.
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace bp_web {
+
+inline constexpr char kStyleCssSourceSha256[] = "$source_sha";
+inline constexpr char kStyleCssPath[] = "/static/style-$version.css";
+inline constexpr char kStyleCssEtag[] = "\"$version\"";
+inline constexpr uint8_t kStyleCssGzip[] = {
+EOF
+  # -n keeps the name and timestamp out, so the bytes depend on content only.
+  gzip -9 -n -c "$SOURCE" | od -An -v -tx1 |
+    sed -E 's/ ([0-9a-f]{2})/0x\1, /g; s/, $/,/; s/^/  /'
+  cat <<EOF
+};
+inline constexpr size_t kStyleCssGzipLength = sizeof(kStyleCssGzip);
+
+}  // namespace bp_web
+
+#endif
+EOF
+} > "$tmp"
+mv "$tmp" "$OUTPUT"
+trap - EXIT
+echo "wrote $OUTPUT ($(gzip -9 -n -c "$SOURCE" | wc -c) bytes gzip, $(wc -c < "$SOURCE") source)"
@@ -6,29 +6,40 @@ cd "$ROOT"
 mkdir -p build/host_tests
 
 CXX=${CXX:-c++}
-SOURCE=test/host/stress_usb_cdc_concurrency.cpp
-BASE=( -std=c++17 -O1 -g -Wall -Wextra -Werror -pthread -iquote . -Itest/host )
-NORMAL=build/host_tests/stress_usb_cdc_concurrency
-"$CXX" "${BASE[@]}" -o "$NORMAL" "$SOURCE"
-"$NORMAL"
+# test/host/idf supplies the FreeRTOS/IDF/cdc_acm_host fakes that let the
+# real UsbCdcTransport.cpp build on the host.
+BASE=( -std=c++17 -O1 -g -Wall -Wextra -Werror -pthread -iquote . -Itest/host -Itest/host/idf )
+# USB CDC ownership races, the simulated transport and the DataProcessor
+# ingest-task split share the same normal + ThreadSanitizer gate. The state,
+# web keep-alive and HTML template benchmarks run here as short smoke passes;
+# run_usb_cdc_benchmark.sh, run_web_benchmark.sh and run_html_benchmark.sh
+# time them.
+SOURCES=( test/host/stress_usb_cdc_concurrency.cpp test/host/stress_usb_cdc_transport.cpp test/host/stress_ingest_pipeline.cpp test/host/bench_usb_cdc_state.cpp test/host/bench_web_keepalive.cpp test/host/bench_html_template.cpp )
 
-TSAN=build/host_tests/stress_usb_cdc_concurrency_tsan
-TSAN_LOG=build/host_tests/tsan.log
-if "$CXX" "${BASE[@]}" -fsanitize=thread -fno-omit-frame-pointer \
-    -o "$TSAN" "$SOURCE" >"$TSAN_LOG" 2>&1; then
-  if "$TSAN" >>"$TSAN_LOG" 2>&1; then
-    echo "ThreadSanitizer stress passed."
-  elif grep -Eqi 'ThreadSanitizer (is )?not supported|unsupported VMA range|ThreadSanitizer: unexpected memory mapping' "$TSAN_LOG"; then
-    echo "ThreadSanitizer runtime unavailable on this platform; normal stress passed."
-  else
-    cat "$TSAN_LOG" >&2
-    exit 1
-  fi
-else
-  if grep -Eqi 'unsupported option.*fsanitize=thread|unknown argument.*fsanitize=thread|unrecognized command-line option.*fsanitize=thread|cannot find.*(clang_rt\.tsan|libtsan)|library not found.*tsan' "$TSAN_LOG"; then
-    echo "ThreadSanitizer compiler support unavailable; normal stress passed."
+for SOURCE in "${SOURCES[@]}"; do
+  NAME=$(basename "$SOURCE" .cpp)
+  NORMAL=build/host_tests/$NAME
+  "$CXX" "${BASE[@]}" -o "$NORMAL" "$SOURCE"
+  "$NORMAL"
+
+  TSAN=build/host_tests/${NAME}_tsan
+  TSAN_LOG=build/host_tests/${NAME}_tsan.log
+  if "$CXX" "${BASE[@]}" -fsanitize=thread -fno-omit-frame-pointer \
+      -o "$TSAN" "$SOURCE" >"$TSAN_LOG" 2>&1; then
+    if "$TSAN" >>"$TSAN_LOG" 2>&1; then
+      echo "ThreadSanitizer stress passed: $NAME."
+    elif grep -Eqi 'ThreadSanitizer (is )?not supported|unsupported VMA range|ThreadSanitizer: unexpected memory mapping' "$TSAN_LOG"; then
+      echo "ThreadSanitizer runtime unavailable on this platform; normal stress passed."
+    else
+      cat "$TSAN_LOG" >&2
+      exit 1
+    fi
   else
-    cat "$TSAN_LOG" >&2
-    exit 1
+    if grep -Eqi 'unsupported option.*fsanitize=thread|unknown argument.*fsanitize=thread|unrecognized command-line option.*fsanitize=thread|cannot find.*(clang_rt\.tsan|libtsan)|library not found.*tsan' "$TSAN_LOG"; then
+      echo "ThreadSanitizer compiler support unavailable; normal stress passed."
+    else
+      cat "$TSAN_LOG" >&2
+      exit 1
+    fi
   fi
-fi
+done
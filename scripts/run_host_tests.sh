@@ -1,6 +1,6 @@
 #!/usr/bin/env bash
 # Host-side unit tests：用本機 clang++ 編譯 header-only lib 並執行測試。
-# test/host/Arduino.h、Preferences.h 提供最小 Arduino shim。
+# test/host/Arduino.h、Preferences.h 提供最小 Arduino shim；test/host/idf 提供 ESP-IDF driver fake。
 # 每個 test/host/test_*.cpp 是一個獨立測試 binary。
 set -euo pipefail
 cd "$(dirname "$0")/.."
@@ -13,7 +13,7 @@ for src in test/host/test_*.cpp; do
   name=$(basename "$src" .cpp)
   # Use -iquote for the repository root so the required VERSION file cannot
   # shadow the standard C++ <version> header on case-insensitive filesystems.
-  c++ -std=c++17 -Wall -Wextra -iquote . -Itest/host -o "$BUILD_DIR/$name" "$src"
+  c++ -std=c++17 -Wall -Wextra -iquote . -Itest/host -Itest/host/idf -o "$BUILD_DIR/$name" "$src"
   echo "== $name =="
   "$BUILD_DIR/$name" || status=1
 done
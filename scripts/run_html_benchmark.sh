@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# Time and heap allocations per /history page, built by String
+# concatenation versus the precompiled template cursor writing straight into
+# the response window (test/host/bench_html_template.cpp). Host timings
+# depend on the machine, so this prints rather than compares against a
+# baseline, and fails if the template path allocates or is not faster.
+#
+#   BENCH_PAGES  pages rendered per mode (20000)
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+cd "$ROOT"
+mkdir -p build/host_tests
+
+CXX=${CXX:-c++}
+BIN=build/host_tests/bench_html_template
+PAGES=${BENCH_PAGES:-20000}
+
+"$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -pthread -iquote . \
+  -Itest/host -Itest/host/idf -o "$BIN" test/host/bench_html_template.cpp
+
+RESULT=build/host_tests/bench_html_template.result
+"$BIN" --report --pages "$PAGES" >"$RESULT"
+awk '$1 == "bench" { value[$2] = $3; printf "%-36s %10.1f\n", $2, $3 }
+     END {
+       string_ns = value["html_page_ns/string"]
+       template_ns = value["html_page_ns/template"]
+       if (string_ns <= 0 || template_ns <= 0) {
+         print "html benchmark: missing results"
+         exit 1
+       }
+       printf "template speedup %.2fx\n", string_ns / template_ns
+       if (value["html_page_allocs/template"] != 0) exit 1
+       if (template_ns >= string_ns) exit 1
+     }' "$RESULT"
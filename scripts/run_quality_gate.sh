@@ -37,6 +37,7 @@ bash scripts/run_concurrency_stress.sh
 
 echo "== UI/static checks =="
 bash scripts/check_ui_markup.sh
+bash scripts/generate_static_assets.sh --check
 
 echo "== pinned firmware build =="
 rm -rf build/firmware
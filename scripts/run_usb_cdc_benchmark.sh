@@ -0,0 +1,96 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# ns/op benchmark for the UsbCdcSynchronizedState paths the CDC callback and
+# owner task take, compared against test/host/bench_usb_cdc_state.baseline.
+# Timing depends on the machine, so this is not part of run_quality_gate.sh;
+# refresh the baseline with --update-baseline on the host that compares.
+#
+#   BENCH_TOLERANCE_PCT  allowed slowdown before a result is flagged (25)
+#   BENCH_SLACK_NS       absolute slowdown always tolerated (5)
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+cd "$ROOT"
+mkdir -p build/host_tests
+
+UPDATE=0
+case "${1:-}" in
+  "") ;;
+  --update-baseline) UPDATE=1 ;;
+  *)
+    echo "usage: $0 [--update-baseline]" >&2
+    exit 2
+    ;;
+esac
+
+CXX=${CXX:-c++}
+BASELINE=test/host/bench_usb_cdc_state.baseline
+BIN=build/host_tests/bench_usb_cdc_state
+TOLERANCE_PCT=${BENCH_TOLERANCE_PCT:-25}
+SLACK_NS=${BENCH_SLACK_NS:-5}
+
+"$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -pthread -iquote . \
+  -Itest/host -Itest/host/idf -o "$BIN" test/host/bench_usb_cdc_state.cpp
+
+# Two processes, best per measurement: scheduler and placement noise on a
+# shared host shows up per process, not per repetition.
+RESULT=build/host_tests/bench_usb_cdc_state.result
+"$BIN" --report >"$RESULT.1"
+"$BIN" --report >"$RESULT.2"
+awk '$1 == "bench" {
+       if (!($2 in best) || $3 < best[$2]) best[$2] = $3
+       if (!($2 in order)) { order[$2] = ++n; names[n] = $2 }
+     }
+     END { for (i = 1; i <= n; i++) printf "%s %.1f\n", names[i], best[names[i]] }' \
+  "$RESULT.1" "$RESULT.2" >"$RESULT"
+
+if [[ "$UPDATE" == 1 ]]; then
+  {
+    echo "# ns/op from scripts/run_usb_cdc_benchmark.sh --update-baseline"
+    echo "# $(uname -sm), $("$CXX" --version | head -n 1)"
+    cat "$RESULT"
+  } >"$BASELINE"
+  echo "USB CDC benchmark baseline written to $BASELINE."
+  exit 0
+fi
+
+[[ -f "$BASELINE" ]] || {
+  echo "missing $BASELINE; run $0 --update-baseline" >&2
+  exit 1
+}
+
+awk -v tolerance="$TOLERANCE_PCT" -v slack="$SLACK_NS" '
+  FNR == NR {
+    if ($0 !~ /^#/ && NF == 2) baseline[$1] = $2
+    next
+  }
+  {
+    name = $1
+    current = $2
+    if (!(name in baseline)) {
+      printf "%-50s %8.1f ns  (new)\n", name, current
+      next
+    }
+    base = baseline[name]
+    seen[name] = 1
+    delta = base > 0 ? (current - base) * 100 / base : 0
+    flag = ""
+    if (current > base * (1 + tolerance / 100) && current - base > slack) {
+      flag = "  REGRESSION"
+      regressions++
+    }
+    printf "%-50s %8.1f ns  baseline %8.1f  %+6.1f%%%s\n", name, current, base, delta, flag
+  }
+  END {
+    for (name in baseline) {
+      if (!(name in seen)) {
+        printf "%-50s missing from this run\n", name
+        regressions++
+      }
+    }
+    if (regressions > 0) {
+      printf "USB CDC benchmark: %d regression(s) beyond %s%% and %s ns.\n", regressions, tolerance, slack
+      exit 1
+    }
+    print "USB CDC benchmark within baseline."
+  }' "$BASELINE" "$RESULT"
@@ -0,0 +1,35 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# Requests per second from one polling client over loopback TCP, closing
+# after every response versus HTTP/1.1 keep-alive, through the real
+# connection table and transaction (test/host/bench_web_keepalive.cpp).
+# Loopback numbers depend on the host, so this prints rather than compares
+# against a baseline, and fails only if keep-alive is not the faster mode.
+#
+#   BENCH_REQUESTS  requests per mode (20000)
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+cd "$ROOT"
+mkdir -p build/host_tests
+
+CXX=${CXX:-c++}
+BIN=build/host_tests/bench_web_keepalive
+REQUESTS=${BENCH_REQUESTS:-20000}
+
+"$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -pthread -iquote . \
+  -Itest/host -Itest/host/idf -o "$BIN" test/host/bench_web_keepalive.cpp
+
+RESULT=build/host_tests/bench_web_keepalive.result
+"$BIN" --report --requests "$REQUESTS" >"$RESULT"
+awk '$1 == "bench" { rate[$2] = $3; printf "%-40s %10.0f req/s\n", $2, $3 }
+     END {
+       close_rate = rate["web_requests_per_s/close"]
+       keep_rate = rate["web_requests_per_s/keep_alive"]
+       if (close_rate <= 0 || keep_rate <= 0) {
+         print "web benchmark: missing results"
+         exit 1
+       }
+       printf "keep-alive speedup %.2fx\n", keep_rate / close_rate
+       if (keep_rate <= close_rate) exit 1
+     }' "$RESULT"
@@ -58,7 +58,9 @@ BoundedSocketOps defaultSocketOps() {
 }  // namespace
 
 BoundedWebServer::BoundedWebServer(int port)
-  : WebServer(port), _socketRuntime(defaultSocketOps()) {}
+  : WebServer(port),
+    _socketRuntime(defaultSocketOps()),
+    _connections(defaultSocketOps()) {}
 
 void BoundedWebServer::secureZero(void* target, size_t length) {
   volatile uint8_t* bytes = static_cast<volatile uint8_t*>(target);
@@ -112,7 +114,8 @@ void BoundedWebServer::configureAccess(
 
 bool BoundedWebServer::configureStreamConsumer(
     const bp_http::StreamConsumerCallbacks& callbacks) {
-  if (_clientActive || _streamConsumer.active() || callbacks.begin == nullptr ||
+  if (hasActiveClient() || _streamConsumer.active() ||
+      callbacks.begin == nullptr ||
       callbacks.write == nullptr || callbacks.finish == nullptr ||
       callbacks.abort == nullptr) {
     return false;
@@ -121,117 +124,124 @@ bool BoundedWebServer::configureStreamConsumer(
   return true;
 }
 
-void BoundedWebServer::acceptClient(uint32_t nowMs) {
-  _currentClient = _server.accept();
-  if (!_currentClient) return;
-
-  _clientActive = true;
-  _currentStatus = HC_WAIT_READ;
-  _acceptedLocalAddress = static_cast<uint32_t>(_currentClient.localIP());
-  _remoteAddress = static_cast<uint32_t>(_currentClient.remoteIP());
-  _currentClient.setNoDelay(true);
-  _transaction.begin(nowMs);
-  _streamConsumer.reset();
-  _ingress.clear();
-  _formValidator.clear();
-  _currentRole = AccessRole::NONE;
-  _currentRequestInterface = RequestInterface::UNKNOWN;
-  _currentRoute = nullptr;
-  _deferredAction = nullptr;
-  _deferredContext = nullptr;
-  _deferredFallbackPending = false;
+void BoundedWebServer::acceptClients(uint32_t nowMs) {
+  // Admission control: only a free slot accepts. A full table leaves the
+  // client in the listen backlog, so web RAM stays the fixed slot table.
+  while (BoundedConnection* connection = _connections.acquire()) {
+    NetworkClient& client = _clients[_connections.indexOf(*connection)];
+    client = _server.accept();
+    if (!client) {
+      client = NetworkClient();
+      return;
+    }
+    client.setNoDelay(true);
+    connection->open(client.fd(), static_cast<uint32_t>(client.localIP()),
+                     static_cast<uint32_t>(client.remoteIP()), nowMs);
+    _currentStatus = HC_WAIT_READ;
+  }
 }
 
-void BoundedWebServer::processIngress(uint32_t nowMs) {
-  const bp_http::TransactionState state = _transaction.state();
-  if (state != bp_http::TransactionState::READING_HEADERS &&
+void BoundedWebServer::processIngress(BoundedConnection& connection,
+                                      uint32_t nowMs) {
+  bp_http::BoundedHttpTransaction& transaction = connection.transaction;
+  BoundedIngressBuffer& ingress = connection.ingress;
+  const bp_http::TransactionState state = transaction.state();
+  if (state != bp_http::TransactionState::AWAITING_REQUEST &&
+      state != bp_http::TransactionState::READING_HEADERS &&
       state != bp_http::TransactionState::READING_BODY) {
     return;
   }
 
-  if (_transaction.pendingStreamChunk().length != 0) {
-    (void)processStreamChunk(nowMs);
+  if (transaction.pendingStreamChunk().length != 0) {
+    (void)processStreamChunk(connection, nowMs);
     return;
   }
 
-  if (_ingress.length() == 0) {
-    const int socket = _currentClient.fd();
-    if (socket < 0) {
-      _streamConsumer.cancel();
-      _transaction.abort();
+  if (ingress.length() == 0) {
+    if (connection.socket() < 0) {
+      releaseStreamConsumer(connection);
+      transaction.abort();
       return;
     }
-    const IngressIoResult received = _socketRuntime.receiveInto(
-      socket, _ingress);
+    const IngressIoResult received = connection.receive();
     if (received == IngressIoResult::WOULD_BLOCK) {
       return;
     }
     if (received != IngressIoResult::PROGRESS) {
-      _streamConsumer.cancel();
-      _transaction.abort();
+      releaseStreamConsumer(connection);
+      transaction.abort();
       return;
     }
   }
 
-  const bp_http::TransactionConsume consumed = _transaction.consume(
-    _ingress.data(), _ingress.length(), nowMs);
+  const bp_http::TransactionConsume consumed = transaction.consume(
+    ingress.data(), ingress.length(), nowMs);
   if (consumed.consumed != 0) {
-    if (!_ingress.consume(consumed.consumed)) _transaction.abort();
-  } else if (_transaction.state() ==
+    if (!ingress.consume(consumed.consumed)) transaction.abort();
+  } else if (transaction.state() ==
                bp_http::TransactionState::READING_HEADERS ||
-             _transaction.state() ==
+             transaction.state() ==
                bp_http::TransactionState::READING_BODY) {
-    _ingress.clear();
-    _transaction.abort();
+    ingress.clear();
+    transaction.abort();
   }
 
-  if (_transaction.pendingStreamChunk().length != 0) {
-    (void)processStreamChunk(nowMs);
-  } else if (_streamConsumer.active() &&
-             _transaction.state() !=
+  if (transaction.pendingStreamChunk().length != 0) {
+    (void)processStreamChunk(connection, nowMs);
+  } else if (_streamOwner == &connection && _streamConsumer.active() &&
+             transaction.state() !=
                bp_http::TransactionState::READING_BODY) {
-    _streamConsumer.cancel();
+    releaseStreamConsumer(connection);
   }
 
-  if (_transaction.state() == bp_http::TransactionState::SENDING_RESPONSE ||
-      _transaction.state() == bp_http::TransactionState::ABORTED) {
-    _ingress.clear();
+  if (transaction.state() == bp_http::TransactionState::SENDING_RESPONSE ||
+      transaction.state() == bp_http::TransactionState::ABORTED) {
+    ingress.clear();
   }
 }
 
-bool BoundedWebServer::processStreamChunk(uint32_t nowMs) {
-  const bp_http::RequestBodyChunk chunk = _transaction.pendingStreamChunk();
-  if (chunk.data == nullptr || chunk.length == 0 || !_streamConsumer.active()) {
-    if (_streamConsumer.active()) _streamConsumer.cancel();
-    if (_transaction.state() == bp_http::TransactionState::READING_BODY) {
-      (void)_transaction.rejectBody(503, nowMs);
+bool BoundedWebServer::processStreamChunk(BoundedConnection& connection,
+                                          uint32_t nowMs) {
+  bp_http::BoundedHttpTransaction& transaction = connection.transaction;
+  const bp_http::RequestBodyChunk chunk = transaction.pendingStreamChunk();
+  if (chunk.data == nullptr || chunk.length == 0 ||
+      _streamOwner != &connection || !_streamConsumer.active()) {
+    releaseStreamConsumer(connection);
+    if (transaction.state() == bp_http::TransactionState::READING_BODY) {
+      (void)transaction.rejectBody(503, nowMs);
     }
-    _ingress.clear();
+    connection.ingress.clear();
     return false;
   }
   if (_streamConsumer.write(chunk.data, chunk.length) !=
       bp_http::StreamConsumerResult::OK) {
-    (void)_transaction.rejectBody(503, nowMs);
-    _ingress.clear();
+    (void)transaction.rejectBody(503, nowMs);
+    connection.ingress.clear();
     return false;
   }
-  if (!_transaction.drainStreamChunk(nowMs)) {
-    _streamConsumer.cancel();
-    if (_transaction.state() == bp_http::TransactionState::READING_BODY) {
-      (void)_transaction.rejectBody(503, nowMs);
+  if (!transaction.drainStreamChunk(nowMs)) {
+    releaseStreamConsumer(connection);
+    if (transaction.state() == bp_http::TransactionState::READING_BODY) {
+      (void)transaction.rejectBody(503, nowMs);
     }
-    _ingress.clear();
+    connection.ingress.clear();
     return false;
   }
-  if (_transaction.state() == bp_http::TransactionState::DISPATCH_READY &&
+  if (transaction.state() == bp_http::TransactionState::DISPATCH_READY &&
       _streamConsumer.finish() != bp_http::StreamConsumerResult::OK) {
-    (void)_transaction.rejectDispatch(503, nowMs);
-    _ingress.clear();
+    (void)transaction.rejectDispatch(503, nowMs);
+    connection.ingress.clear();
     return false;
   }
   return true;
 }
 
+void BoundedWebServer::releaseStreamConsumer(BoundedConnection& connection) {
+  if (_streamOwner != &connection) return;
+  _streamConsumer.cancel();
+  _streamOwner = nullptr;
+}
+
 bool BoundedWebServer::snapshotIsWellFormed() const {
   if (!hasTerminator(_runtimeSnapshot.apHost,
                      sizeof(_runtimeSnapshot.apHost)) ||
@@ -252,31 +262,48 @@ bool BoundedWebServer::snapshotIsWellFormed() const {
   return true;
 }
 
+bp_http::BoundedHttpTransaction*
+BoundedWebServer::dispatchTransaction() const {
+  return _dispatching == nullptr ? nullptr : &_dispatching->transaction;
+}
+
+bool BoundedWebServer::currentRouteIsCacheable() const {
+  const RoutePolicy* route = currentRoute();
+  return route != nullptr && !route->noStore && isStaticAssetRoute(*route);
+}
+
 bool BoundedWebServer::mandatoryResponseHeadersAreExact() const {
   struct RequiredHeader {
     const char* name;
     const char* value;
   };
-  static constexpr RequiredHeader kRequired[] = {
-    {"Cache-Control", "no-store, max-age=0"},
-    {"Pragma", "no-cache"},
+  const bool cacheable = currentRouteIsCacheable();
+  const RequiredHeader required[] = {
+    {"Cache-Control", cacheable
+       ? bp_http::BoundedHttpResponse::kImmutableCacheControl
+       : bp_http::BoundedHttpResponse::kNoStoreCacheControl},
     {"X-Content-Type-Options", "nosniff"},
+    // A cacheable response must not carry Pragma at all.
+    {"Pragma", cacheable ? nullptr : "no-cache"},
   };
-  for (const RequiredHeader& required : kRequired) {
+  for (const RequiredHeader& header : required) {
     size_t matches = 0;
-    for (RequestArgument* header = _responseHeaders;
-         header != nullptr; header = header->next) {
-      if (!header->key.equalsIgnoreCase(required.name)) continue;
+    for (RequestArgument* sent = _responseHeaders;
+         sent != nullptr; sent = sent->next) {
+      if (!sent->key.equalsIgnoreCase(header.name)) continue;
       ++matches;
-      if (header->value != required.value) return false;
+      if (header.value == nullptr || sent->value != header.value) {
+        return false;
+      }
     }
-    if (matches != 1) return false;
+    if (matches != (header.value == nullptr ? 0U : 1U)) return false;
   }
   return true;
 }
 
-void BoundedWebServer::processPolicy() {
-  if (_transaction.state() != bp_http::TransactionState::WAIT_POLICY) return;
+void BoundedWebServer::processPolicy(BoundedConnection& connection) {
+  bp_http::BoundedHttpTransaction& transaction = connection.transaction;
+  if (transaction.state() != bp_http::TransactionState::WAIT_POLICY) return;
   secureZero(&_runtimeSnapshot, sizeof(_runtimeSnapshot));
   GateResult decision{};
   bool evaluated = false;
@@ -285,7 +312,7 @@ void BoundedWebServer::processPolicy() {
         _snapshotProvider(_snapshotContext, _runtimeSnapshot) &&
         snapshotIsWellFormed()) {
       InterfaceSnapshot network{};
-      network.acceptedLocalAddress = _acceptedLocalAddress;
+      network.acceptedLocalAddress = connection.acceptedLocalAddress;
       network.apAddress = _runtimeSnapshot.apAddress;
       network.staAddress = _runtimeSnapshot.staAddress;
       network.apActive = _runtimeSnapshot.apActive;
@@ -296,8 +323,8 @@ void BoundedWebServer::processPolicy() {
       network.mdnsHost = _runtimeSnapshot.mdnsHost;
 
       decision = _gate->evaluate(
-        _transaction.request(), _runtimeSnapshot.security, network,
-        _remoteAddress, _socketRuntime.nowMs());
+        transaction.request(), _runtimeSnapshot.security, network,
+        connection.remoteAddress, _socketRuntime.nowMs());
       evaluated = true;
     }
   } catch (...) {
@@ -307,8 +334,8 @@ void BoundedWebServer::processPolicy() {
 
   if (!evaluated) {
     secureZero(&_runtimeSnapshot, sizeof(_runtimeSnapshot));
-    (void)_transaction.rejectPolicy(503, _socketRuntime.nowMs());
-    _ingress.clear();
+    (void)transaction.rejectPolicy(503, _socketRuntime.nowMs());
+    connection.ingress.clear();
     return;
   }
   const uint32_t policyCompletedAt = _socketRuntime.nowMs();
@@ -317,44 +344,43 @@ void BoundedWebServer::processPolicy() {
     if (decision.status == 405) {
       bool known = false;
       const bp_http::AllowedMethods allowed = allowedMethodsForPath(
-        _transaction.request().view().path, known);
+        transaction.request().view().path, known);
       if (known) {
-        (void)_transaction.rejectPolicy(405, policyCompletedAt, allowed);
+        (void)transaction.rejectPolicy(405, policyCompletedAt, allowed);
       } else {
-        (void)_transaction.rejectPolicy(500, policyCompletedAt);
+        (void)transaction.rejectPolicy(500, policyCompletedAt);
       }
     } else {
-      (void)_transaction.rejectPolicy(decision.status, policyCompletedAt);
+      (void)transaction.rejectPolicy(decision.status, policyCompletedAt);
     }
-    _ingress.clear();
+    connection.ingress.clear();
     return;
   }
 
-  _currentRole = decision.role;
-  _currentRequestInterface = decision.requestInterface;
-  _currentRoute = decision.route;
-  const bool accepted = _transaction.acceptPolicy(
+  connection.role = decision.role;
+  connection.requestInterface = decision.requestInterface;
+  connection.route = decision.route;
+  const bool accepted = transaction.acceptPolicy(
     decision.bodyMode, decision.bodyCap, policyCompletedAt);
+  // One upload at a time: another slot holding the sink gets 503.
   if (accepted && decision.bodyMode == bp_http::BodyMode::STREAM &&
-      _streamConsumer.start(_transaction.request().view().contentLength,
-                            _streamCallbacks) !=
-        bp_http::StreamConsumerResult::OK) {
-    (void)_transaction.rejectBody(503, policyCompletedAt);
-    _currentRole = AccessRole::NONE;
-    _currentRequestInterface = RequestInterface::UNKNOWN;
-    _currentRoute = nullptr;
-    _ingress.clear();
+      (_streamOwner != nullptr ||
+       _streamConsumer.start(transaction.request().view().contentLength,
+                             _streamCallbacks) !=
+         bp_http::StreamConsumerResult::OK)) {
+    (void)transaction.rejectBody(503, policyCompletedAt);
+    connection.clearGrant();
+    connection.ingress.clear();
     return;
   }
-  if (!accepted ||
-      _transaction.state() == bp_http::TransactionState::DISPATCH_READY) {
-    _ingress.clear();
+  if (accepted && decision.bodyMode == bp_http::BodyMode::STREAM) {
+    _streamOwner = &connection;
   }
-  if (!accepted) {
-    _currentRole = AccessRole::NONE;
-    _currentRequestInterface = RequestInterface::UNKNOWN;
-    _currentRoute = nullptr;
+  if (!accepted ||
+      transaction.state() == bp_http::TransactionState::DISPATCH_READY) {
+    connection.ingress.clear();
   }
+  if (!accepted) connection.clearGrant();
 }
 
 void BoundedWebServer::setCollectedHeader(const char* name,
@@ -382,7 +408,7 @@ void BoundedWebServer::selectCurrentHandler() {
 
 bool BoundedWebServer::materializeBaseRequest() {
   wipeBaseRequestState();
-  const bp_http::RequestView& view = _transaction.request().view();
+  const bp_http::RequestView& view = _dispatching->transaction.request().view();
 
   const size_t pathLength = boundedLength(view.path, sizeof(view.path));
   const size_t hostLength = boundedLength(view.host, sizeof(view.host));
@@ -474,41 +500,52 @@ void BoundedWebServer::wipeBaseRequestState() {
   _currentRaw.reset();
 }
 
-void BoundedWebServer::dispatchReadyRequest() {
-  if (_transaction.state() != bp_http::TransactionState::DISPATCH_READY) {
+void BoundedWebServer::dispatchReadyRequest(BoundedConnection& connection) {
+  bp_http::BoundedHttpTransaction& transaction = connection.transaction;
+  if (transaction.state() != bp_http::TransactionState::DISPATCH_READY) {
     return;
   }
-  if (_currentRoute != nullptr &&
-      _currentRoute->bodyKind == RouteBodyKind::STREAM &&
-      _streamConsumer.state() != bp_http::StreamConsumerState::COMPLETE) {
-    (void)_transaction.rejectDispatch(503, _socketRuntime.nowMs());
+  if (connection.route != nullptr &&
+      connection.route->bodyKind == RouteBodyKind::STREAM &&
+      (_streamOwner != &connection ||
+       _streamConsumer.state() != bp_http::StreamConsumerState::COMPLETE)) {
+    (void)transaction.rejectDispatch(503, _socketRuntime.nowMs());
     return;
   }
+  _dispatching = &connection;
   int dispatchFailureStatus = 0;
   bool captureStarted = false;
   try {
-    const bp_http::RequestView& view = _transaction.request().view();
+    const bp_http::RequestView& view = transaction.request().view();
     const size_t queryLength = boundedLength(view.query, sizeof(view.query));
     if (queryLength >= sizeof(view.query) ||
         !_formValidator.validate(view.query, queryLength,
-                                 _transaction.request().body(),
-                                 _transaction.request().bodyLength())) {
+                                 transaction.request().body(),
+                                 transaction.request().bodyLength())) {
       dispatchFailureStatus = 400;
     } else if (!materializeBaseRequest()) {
       dispatchFailureStatus = 503;
     } else {
       const uint32_t dispatchStartedAt = _socketRuntime.nowMs();
-      captureStarted = _transaction.beginDispatch(dispatchStartedAt);
+      captureStarted = transaction.beginDispatch(dispatchStartedAt);
       if (captureStarted) {
         wipeResponseHeaders();
         _contentLength = CONTENT_LENGTH_NOT_SET;
         _responseCode = 0;
         _chunked = false;
-        sendHeader("Cache-Control", "no-store, max-age=0");
-        sendHeader("Pragma", "no-cache");
+        if (currentRouteIsCacheable()) {
+          sendHeader("Cache-Control",
+                     bp_http::BoundedHttpResponse::kImmutableCacheControl);
+        } else {
+          sendHeader("Cache-Control",
+                     bp_http::BoundedHttpResponse::kNoStoreCacheControl);
+          sendHeader("Pragma", "no-cache");
+        }
         sendHeader("X-Content-Type-Options", "nosniff");
 
-        if (!mandatoryResponseHeadersAreExact()) {
+        if (currentRouteIsCacheable() && !transaction.allowCaching()) {
+          dispatchFailureStatus = 503;
+        } else if (!mandatoryResponseHeadersAreExact()) {
           dispatchFailureStatus = 503;
         } else if (_chain != nullptr) {
           (void)_chain->runChain(*this,
@@ -518,10 +555,10 @@ void BoundedWebServer::dispatchReadyRequest() {
         }
         if (dispatchFailureStatus == 0 &&
             (!mandatoryResponseHeadersAreExact() ||
-             !_transaction.capturedResponseIsValidHttp1())) {
+             !transaction.capturedResponseIsValidHttp1())) {
           dispatchFailureStatus = 503;
         }
-      } else if (_transaction.state() ==
+      } else if (transaction.state() ==
                    bp_http::TransactionState::DISPATCH_READY) {
         dispatchFailureStatus = 503;
       }
@@ -536,172 +573,184 @@ void BoundedWebServer::dispatchReadyRequest() {
   wipeBaseRequestState();
   wipeResponseHeaders();
   _formValidator.clear();
-  _ingress.clear();
+  // Pipelined bytes are not kept across a response, and a deferred action
+  // runs only once the socket is gone: either way this response closes.
+  if (connection.ingress.length() != 0 ||
+      connection.deferredAction != nullptr) {
+    transaction.closeAfterResponse();
+  }
+  connection.ingress.clear();
   if (dispatchFailureStatus == 0 && captureStarted) {
-    (void)_transaction.finishDispatch(finishedAt);
-  } else if (_transaction.state() ==
+    (void)transaction.finishDispatch(finishedAt);
+  } else if (transaction.state() ==
                bp_http::TransactionState::CAPTURING_RESPONSE) {
-    (void)_transaction.rejectCapture(dispatchFailureStatus, finishedAt);
-  } else if (_transaction.state() ==
+    (void)transaction.rejectCapture(dispatchFailureStatus, finishedAt);
+  } else if (transaction.state() ==
                bp_http::TransactionState::DISPATCH_READY) {
-    (void)_transaction.rejectDispatch(dispatchFailureStatus, finishedAt);
+    (void)transaction.rejectDispatch(dispatchFailureStatus, finishedAt);
   }
-  _currentRole = AccessRole::NONE;
-  _currentRequestInterface = RequestInterface::UNKNOWN;
-  _currentRoute = nullptr;
+  _dispatching = nullptr;
+  connection.clearGrant();
 }
 
-void BoundedWebServer::pumpResponse(uint32_t nowMs) {
-  if (_transaction.state() != bp_http::TransactionState::SENDING_RESPONSE) {
-    return;
-  }
-  if (!_transaction.poll(nowMs)) return;
-  const bp_http::ResponseChunk chunk = _transaction.nextOutput();
-  if (chunk.data == nullptr || chunk.length == 0) {
-    _transaction.abort();
-    return;
+void BoundedWebServer::finishConnection(BoundedConnection& connection,
+                                        bool runDeferredAction) {
+  BoundedWebDeferredAction action = runDeferredAction
+    ? connection.deferredAction : nullptr;
+  void* actionContext = runDeferredAction ? connection.deferredContext
+                                          : nullptr;
+  if (_streamOwner == &connection) {
+    _streamConsumer.reset();
+    _streamOwner = nullptr;
   }
+  connection.close();
 
-  const int socket = _currentClient.fd();
-  if (socket < 0) {
-    _transaction.abort();
-    return;
-  }
-  const SocketWriteResult sent = _socketRuntime.sendSome(
-    socket, chunk.data, chunk.length);
-  if (sent.status == SocketWriteStatus::WOULD_BLOCK) {
-    return;
-  }
-  if (sent.status != SocketWriteStatus::PROGRESS ||
-      !_transaction.acknowledgeOutput(sent.length)) {
-    _transaction.abort();
-  }
-}
-
-void BoundedWebServer::finishActiveClient(bool runDeferredAction) {
-  BoundedWebDeferredAction action = runDeferredAction
-    ? _deferredAction : nullptr;
-  void* actionContext = runDeferredAction ? _deferredContext : nullptr;
-  _deferredAction = nullptr;
-  _deferredContext = nullptr;
-  _deferredFallbackPending = false;
-
-  _streamConsumer.reset();
-  if (!_transaction.terminal()) _transaction.abort();
-  _socketRuntime.cancelDrain();
-  _ingress.clear();
-  _formValidator.clear();
-  secureZero(&_runtimeSnapshot, sizeof(_runtimeSnapshot));
-  wipeBaseRequestState();
-  wipeResponseHeaders();
-  _currentClient.stop();
-  _currentClient = NetworkClient();
-  _currentStatus = HC_NONE;
-  _clientActive = false;
-  _acceptedLocalAddress = 0;
-  _remoteAddress = 0;
-  _currentRole = AccessRole::NONE;
-  _currentRequestInterface = RequestInterface::UNKNOWN;
-  _currentRoute = nullptr;
+  NetworkClient& client = _clients[_connections.indexOf(connection)];
+  client.stop();
+  client = NetworkClient();
+  if (!hasActiveClient()) _currentStatus = HC_NONE;
 
   if (action != nullptr) action(actionContext);
 }
 
-void BoundedWebServer::handleClient() {
-  const uint32_t nowMs = _socketRuntime.nowMs();
-  if (!_clientActive) {
-    try {
-      acceptClient(nowMs);
-    } catch (...) {
-      _streamConsumer.reset();
-      _transaction.abort();
-      _socketRuntime.cancelDrain();
-      _ingress.clear();
-      _formValidator.clear();
-      secureZero(&_runtimeSnapshot, sizeof(_runtimeSnapshot));
-      wipeBaseRequestState();
-      wipeResponseHeaders();
-      _currentClient.stop();
-      _currentClient = NetworkClient();
-      _currentStatus = HC_NONE;
-      _clientActive = false;
-      _acceptedLocalAddress = 0;
-      _remoteAddress = 0;
-      _currentRole = AccessRole::NONE;
-      _currentRequestInterface = RequestInterface::UNKNOWN;
-      _currentRoute = nullptr;
-      _deferredAction = nullptr;
-      _deferredContext = nullptr;
-      _deferredFallbackPending = false;
-      return;
-    }
-    if (!_clientActive) return;
+void BoundedWebServer::serviceConnection(BoundedConnection& connection) {
+  if (connection.deferredFallbackPending) {
+    connection.deferredFallbackPending = false;
+    finishConnection(connection, true);
+    return;
   }
 
-  if (_deferredFallbackPending) {
-    _deferredFallbackPending = false;
-    finishActiveClient(true);
+  BoundedSocketRuntime& socketRuntime = connection.socketRuntime();
+  if (socketRuntime.drainActive()) {
+    const DrainIoResult drain = socketRuntime.pollDrain(connection.socket());
+    if (drain != DrainIoResult::WAITING) finishConnection(connection, true);
     return;
   }
 
-  if (_socketRuntime.drainActive()) {
-    const DrainIoResult drain = _socketRuntime.pollDrain(
-      _currentClient.fd());
-    if (drain != DrainIoResult::WAITING) finishActiveClient(true);
+  bp_http::BoundedHttpTransaction& transaction = connection.transaction;
+  // An idle keep-alive connection gives its slot up to a queued client.
+  if (transaction.state() == bp_http::TransactionState::AWAITING_REQUEST &&
+      clientWaiting()) {
+    finishConnection(connection, true);
     return;
   }
-
-  (void)_transaction.poll(nowMs);
-  if (_streamConsumer.active() &&
-      _transaction.state() != bp_http::TransactionState::READING_BODY) {
-    _streamConsumer.cancel();
+  const uint32_t nowMs = _socketRuntime.nowMs();
+  (void)transaction.poll(nowMs);
+  if (_streamOwner == &connection && _streamConsumer.active() &&
+      transaction.state() != bp_http::TransactionState::READING_BODY) {
+    releaseStreamConsumer(connection);
+  }
+  processIngress(connection, nowMs);
+  processPolicy(connection);
+  dispatchReadyRequest(connection);
+  connection.pumpResponse(_socketRuntime.nowMs());
+
+  if (transaction.state() == bp_http::TransactionState::COMPLETE &&
+      connection.deferredAction != nullptr) {
+    if (!socketRuntime.beginDrain()) {
+      connection.deferredFallbackPending = true;
+    }
+    return;
   }
-  processIngress(nowMs);
-  processPolicy();
-  dispatchReadyRequest();
-  pumpResponse(_socketRuntime.nowMs());
+  if (transaction.awaitNextRequest(_socketRuntime.nowMs())) return;
+  if (transaction.terminal()) finishConnection(connection, true);
+}
 
-  if (_transaction.state() == bp_http::TransactionState::COMPLETE &&
-      _deferredAction != nullptr) {
-    if (!_socketRuntime.beginDrain()) _deferredFallbackPending = true;
-    return;
+void BoundedWebServer::handleClient() {
+  try {
+    acceptClients(_socketRuntime.nowMs());
+  } catch (...) {
+    // A throwing accept leaves no half-open slot behind.
+    for (size_t i = 0; i < kBoundedWebSlots; ++i) {
+      BoundedConnection& connection = _connections.slot(i);
+      if (!connection.active() && _clients[i]) {
+        _clients[i].stop();
+        _clients[i] = NetworkClient();
+      }
+    }
   }
-  if (_transaction.terminal()) finishActiveClient(true);
+  // Round robin: each active slot gets one read, one policy step, at most
+  // one dispatch and one send budget per pass.
+  _connections.forEachActive(
+    [this](BoundedConnection& connection) { serviceConnection(connection); });
 }
 
 void BoundedWebServer::close() {
-  if (_clientActive) finishActiveClient(true);
+  for (size_t i = 0; i < kBoundedWebSlots; ++i) {
+    BoundedConnection& connection = _connections.slot(i);
+    if (connection.active()) finishConnection(connection, true);
+  }
   WebServer::close();
 }
 
 bool BoundedWebServer::deferAfterResponse(
     BoundedWebDeferredAction action, void* context) {
-  if (!_clientActive || action == nullptr || _deferredAction != nullptr ||
-      _transaction.state() !=
+  if (_dispatching == nullptr || action == nullptr ||
+      _dispatching->deferredAction != nullptr ||
+      _dispatching->transaction.state() !=
         bp_http::TransactionState::CAPTURING_RESPONSE) {
     return false;
   }
-  _deferredAction = action;
-  _deferredContext = context;
+  _dispatching->deferredAction = action;
+  _dispatching->deferredContext = context;
   return true;
 }
 
+bool BoundedWebServer::sendStream(int code, const char* contentType,
+                                  bp_http::ResponseGenerator generator,
+                                  void* context) {
+  bp_http::BoundedHttpTransaction* transaction = dispatchTransaction();
+  if (generator == nullptr || transaction == nullptr ||
+      transaction->state() !=
+        bp_http::TransactionState::CAPTURING_RESPONSE) {
+    return false;
+  }
+  String head;
+  _contentLength = CONTENT_LENGTH_UNKNOWN;
+  _prepareHeader(head, code, contentType, 0);
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+  _chunked = false;
+  const bool captured = transaction->capture(
+    reinterpret_cast<const uint8_t*>(head.c_str()), head.length()) ==
+      head.length() && transaction->captureStream(generator, context);
+  secureWipeString(head);
+  return captured;
+}
+
+bool BoundedWebServer::clientWaiting() {
+  return _connections.full() && _server.hasClient();
+}
+
+bool BoundedWebServer::requestMatchesEtag(const char* etag) const {
+  const bp_http::BoundedHttpTransaction* transaction = dispatchTransaction();
+  if (transaction == nullptr || transaction->state() !=
+        bp_http::TransactionState::CAPTURING_RESPONSE) {
+    return false;
+  }
+  const bp_http::RequestView& view = transaction->request().view();
+  return bp_http::etagListMatches(view.ifNoneMatch, etag);
+}
+
 bool BoundedWebServer::recordClaimResult(bool tokenAccepted,
                                          uint32_t nowMs) {
-  if (_gate == nullptr || _currentRoute == nullptr ||
-      !isClaimRoute(*_currentRoute) || !_currentRoute->mutation ||
-      _transaction.state() !=
+  const RoutePolicy* route = currentRoute();
+  if (_gate == nullptr || route == nullptr || !isClaimRoute(*route) ||
+      !route->mutation ||
+      _dispatching->transaction.state() !=
         bp_http::TransactionState::CAPTURING_RESPONSE) {
     return false;
   }
-  return _gate->recordClaimResult(_remoteAddress, tokenAccepted, nowMs);
+  return _gate->recordClaimResult(_dispatching->remoteAddress, tokenAccepted,
+                                  nowMs);
 }
 
 size_t BoundedWebServer::_currentClientWrite(const char* bytes,
                                              size_t length) {
-  const size_t captured = _transaction.capture(
+  bp_http::BoundedHttpTransaction* transaction = dispatchTransaction();
+  if (transaction == nullptr) return 0;
+  const size_t captured = transaction->capture(
     reinterpret_cast<const uint8_t*>(bytes), length);
-  return captured == length || _transaction.state() ==
+  return captured == length || transaction->state() ==
            bp_http::TransactionState::CAPTURING_RESPONSE
     ? length : 0;
 }
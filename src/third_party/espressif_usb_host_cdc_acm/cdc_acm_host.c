@@ -1043,10 +1043,14 @@ static void cdc_acm_device_remove(cdc_dev_t *cdc_dev)
  * 1. USB device with matching VID/PID is already opened by this driver: allocate new CDC device on top of the already opened USB device.
  * 2. USB device with matching VID/PID is NOT opened by this driver yet: poll USB connected devices until it is found.
  *
+ * With skip_opened set, path 1 is not taken and devices already held by this driver are skipped in path 2,
+ * so each call claims a different physical device.
+ *
  * @note This function will block for timeout_ms, if the device is not enumerated at the moment of calling this function.
  * @param[in] vid Vendor ID
  * @param[in] pid Product ID
  * @param[in] timeout_ms Connection timeout [ms]
+ * @param[in] skip_opened Only open devices that no CDC handle holds yet
  * @param[out] dev CDC-ACM device
  * @return esp_err_t
  */
@@ -1060,7 +1064,22 @@ static bool cdc_acm_snapshot_open_candidate(
     return available;
 }
 
-static esp_err_t cdc_acm_find_and_open_usb_device(uint16_t vid, uint16_t pid, int timeout_ms, cdc_dev_t **dev)
+static bool cdc_acm_device_already_opened(usb_device_handle_t dev_hdl)
+{
+    bool opened = false;
+    cdc_dev_t *cdc_dev;
+    CDC_ACM_ENTER_CRITICAL();
+    SLIST_FOREACH(cdc_dev, &p_cdc_acm_obj->cdc_devices_list, list_entry) {
+        if (cdc_dev->dev_hdl == dev_hdl) {
+            opened = true;
+            break;
+        }
+    }
+    CDC_ACM_EXIT_CRITICAL();
+    return opened;
+}
+
+static esp_err_t cdc_acm_find_and_open_usb_device(uint16_t vid, uint16_t pid, int timeout_ms, bool skip_opened, cdc_dev_t **dev)
 {
     assert(p_cdc_acm_obj);
     assert(dev);
@@ -1074,6 +1093,9 @@ static esp_err_t cdc_acm_find_and_open_usb_device(uint16_t vid, uint16_t pid, in
     ESP_LOGD(TAG, "Checking list of opened USB devices");
     cdc_dev_t *cdc_dev;
     SLIST_FOREACH(cdc_dev, &p_cdc_acm_obj->cdc_devices_list, list_entry) {
+        if (skip_opened) {
+            break;
+        }
         usb_device_handle_t candidate_handle = NULL;
         if (!cdc_acm_snapshot_open_candidate(cdc_dev, &candidate_handle)) {
             continue;
@@ -1121,6 +1143,11 @@ static esp_err_t cdc_acm_find_and_open_usb_device(uint16_t vid, uint16_t pid, in
                         p_cdc_acm_obj->cdc_acm_client_hdl, current_device);
                     continue;
                 }
+                if (skip_opened && cdc_acm_device_already_opened(current_device)) {
+                    usb_host_device_close(
+                        p_cdc_acm_obj->cdc_acm_client_hdl, current_device);
+                    continue;
+                }
                 if ((device_desc->bDeviceClass != USB_CLASS_HUB) &&
                         (vid == device_desc->idVendor || vid == CDC_HOST_ANY_VID) &&
                         (pid == device_desc->idProduct || pid == CDC_HOST_ANY_PID)) {
@@ -1483,7 +1510,8 @@ esp_err_t cdc_acm_host_open(uint16_t vid, uint16_t pid, uint8_t interface_idx, c
     }
     // Find underlying USB device
     cdc_dev_t *cdc_dev;
-    ret =  cdc_acm_find_and_open_usb_device(vid, pid, dev_config->connection_timeout_ms, &cdc_dev);
+    ret =  cdc_acm_find_and_open_usb_device(vid, pid, dev_config->connection_timeout_ms,
+                                            dev_config->skip_opened_devices, &cdc_dev);
     if (ESP_OK != ret) {
         goto exit;
     }
@@ -2261,6 +2289,27 @@ esp_err_t cdc_acm_host_protocols_get(cdc_acm_dev_hdl_t cdc_hdl, cdc_comm_protoco
     return ret;
 }
 
+esp_err_t cdc_acm_host_device_ids_get(cdc_acm_dev_hdl_t cdc_hdl, uint16_t *vid, uint16_t *pid)
+{
+    CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
+    cdc_dev_t *cdc_dev = NULL;
+    esp_err_t ret = cdc_acm_acquire_device_operation(cdc_hdl, &cdc_dev);
+    if (ret != ESP_OK) return ret;
+
+    const usb_device_desc_t *device_desc = NULL;
+    ret = usb_host_get_device_descriptor(cdc_dev->dev_hdl, &device_desc);
+    if (ret == ESP_OK) {
+        if (vid != NULL) {
+            *vid = device_desc->idVendor;
+        }
+        if (pid != NULL) {
+            *pid = device_desc->idProduct;
+        }
+    }
+    cdc_acm_release_device_operation(cdc_dev);
+    return ret;
+}
+
 esp_err_t cdc_acm_host_cdc_desc_get(cdc_acm_dev_hdl_t cdc_hdl, cdc_desc_subtype_t desc_type, const usb_standard_desc_t **desc_out)
 {
     CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
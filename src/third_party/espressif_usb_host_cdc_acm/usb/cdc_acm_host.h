@@ -160,6 +160,18 @@ void cdc_acm_host_desc_print(cdc_acm_dev_hdl_t cdc_hdl);
  */
 esp_err_t cdc_acm_host_protocols_get(cdc_acm_dev_hdl_t cdc_hdl, cdc_comm_protocol_t *comm, cdc_data_protocol_t *data);
 
+/**
+ * @brief Get Vendor and Product ID of the opened device
+ *
+ * @param cdc_hdl  CDC handle obtained from cdc_acm_host_open()
+ * @param[out] vid Device's Vendor ID
+ * @param[out] pid Device's Product ID
+ * @return
+ *   - ESP_OK: Success
+ *   - ESP_ERR_INVALID_ARG: Invalid device
+ */
+esp_err_t cdc_acm_host_device_ids_get(cdc_acm_dev_hdl_t cdc_hdl, uint16_t *vid, uint16_t *pid);
+
 /**
  * @brief Get CDC functional descriptor
  *
@@ -79,4 +79,5 @@ typedef struct {
     cdc_acm_host_dev_callback_t event_cb; /**< Device's event callback function. Can be NULL */
     cdc_acm_data_callback_t data_cb;      /**< Device's data RX callback function. Can be NULL for write-only devices */
     void *user_arg;                       /**< User's argument that will be passed to the callbacks */
+    bool skip_opened_devices;             /**< Only consider USB devices this driver has not opened yet, so several handles map to distinct devices behind a hub */
 } cdc_acm_host_device_config_t;
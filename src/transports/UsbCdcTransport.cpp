@@ -1,5 +1,7 @@
 #include "../../lib/transports/UsbCdcTransport.h"
 #include "../../lib/transports/UsbCdcConcurrency.h"
+#include "../../lib/transports/UsbCdcReconnect.h"
+#include "../../lib/transports/UsbCdcRxBuffer.h"
 #include "../../lib/transports/UsbCdcState.h"
 
 #include <atomic>
@@ -11,6 +13,7 @@
 #include <freertos/semphr.h>
 #include <freertos/stream_buffer.h>
 #include <freertos/task.h>
+#include <esp_heap_caps.h>
 #include <soc/soc_caps.h>
 
 #if SOC_USB_OTG_SUPPORTED
@@ -21,8 +24,8 @@
 #endif
 
 namespace {
-constexpr size_t kRxUsableBytes = 1024;
-constexpr size_t kRxStorageBytes = kRxUsableBytes + 1;
+// One full-speed bulk packet; the consumer moves at most this much per claim.
+constexpr size_t kRxChunkBytes = 64;
 constexpr UBaseType_t kLifecycleQueueDepth = 16;
 constexpr size_t kOrderedChannelDepth = 12;
 constexpr size_t kCallbackContextCount = 2;
@@ -61,21 +64,37 @@ private:
   portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
 };
 
-struct UsbCdcTransport::Impl {
+struct UsbCdcPort {
   struct CallbackContext {
-    Impl* owner = nullptr;
+    UsbCdcPort* owner = nullptr;
     size_t slot = 0;
     uint32_t session = 0;
   };
 
+  UsbCdcTransport::Impl* host = nullptr;
+  uint8_t index = 0;
   UsbCdcLifecycle lifecycle;
   UsbCdcOrderedCursor cursor;
   MonitorTransportState currentState = TRANSPORT_STATE_STARTING;
   String currentDetail = "USB CDC host not initialized";
 
+  // Stream-buffer storage is sized at begin(): PSRAM when present, else
+  // internal RAM, from the requested (persisted) capacity.
   StaticStreamBuffer_t rxStreamState = {};
-  alignas(4) uint8_t rxStreamStorage[kRxStorageBytes] = {};
+  uint8_t* rxStreamStorage = nullptr;
+  size_t rxStorageBytes = 0;
   StreamBufferHandle_t rxStream = nullptr;
+  UsbCdcRxOccupancyMonitor rxOccupancy;
+  UsbCdcRxTelemetry reportedRxTelemetry;
+  // Owner task only: cached profile of the last READY device and the
+  // attach-to-READY histogram.
+  UsbCdcReconnectTracker reconnect;
+
+  // Consumer-owned bulk receive buffer. Filled only up to the next ordered
+  // control boundary, so bytes here never straddle a loss marker.
+  alignas(4) uint8_t rxChunk[kRxChunkBytes] = {};
+  size_t rxChunkOffset = 0;
+  size_t rxChunkLength = 0;
 
   StaticQueue_t lifecycleQueueState = {};
   alignas(4) uint8_t lifecycleQueueStorage[
@@ -88,32 +107,28 @@ struct UsbCdcTransport::Impl {
   int activeCallbackSlot = -1;
 
   std::atomic<uint32_t> acceptedByteSequence{0};
+  // Cursor position published after each stream receive, so the callback can
+  // compute occupancy as accepted - drained without touching the stream lock.
+  std::atomic<uint32_t> drainedByteSequence{0};
+  std::atomic<uint32_t> lastRxAcceptedUs{0};
+  std::atomic<bool> rxAcceptedEver{false};
   std::atomic<uint32_t> lifecycleQueueFailures{0};
   std::atomic<bool> overflowMarkerPublished{false};
-  std::atomic<bool> shutdownRequested{false};
-  std::atomic<bool> teardownSafe{true};
-  std::atomic<UsbCdcDaemonPhase> daemonPhase{UsbCdcDaemonPhase::STOPPED};
 
-  StaticSemaphore_t daemonExitState = {};
-  SemaphoreHandle_t daemonExit = nullptr;
-  bool beginCalled = false;
-  bool daemonTaskStarted = false;
   uint32_t activeSession = 0;
-  uint32_t lastMillis32 = 0;
-  uint64_t millisHigh = 0;
-  bool millisInitialized = false;
   bool terminalBoundaryPending = false;
   UsbCdcTerminalBoundaryTracker terminalBoundary;
   UsbCdcControlEvent pendingTerminalEvent;
   UsbCdcOrderedType pendingTerminalType = UsbCdcOrderedType::STREAM_RESET;
   UsbCdcDiagnosticsSnapshot currentDiagnostics;
   uint32_t currentReconnectCount = 0;
+  bool detailChanged = true;
 
 #if SOC_USB_OTG_SUPPORTED
   cdc_acm_dev_hdl_t cdcHandle = nullptr;
 #endif
 
-  Impl() {
+  UsbCdcPort() {
     for (size_t i = 0; i < kCallbackContextCount; ++i) {
       callbackContexts[i].owner = this;
       callbackContexts[i].slot = i;
@@ -121,6 +136,82 @@ struct UsbCdcTransport::Impl {
     cursor.beginSession(0, 0, 0);
   }
 
+  // Owner task only. Marks the text dirty so status() advances its version.
+  void setDetail(const char* text) {
+    currentDetail = text;
+    detailChanged = true;
+  }
+
+  void setDetail(const char* text, int32_t code) {
+    currentDetail = text;
+    currentDetail += code;
+    detailChanged = true;
+  }
+
+  void discardRxChunk() {
+    memset(rxChunk, 0, sizeof(rxChunk));
+    rxChunkOffset = 0;
+    rxChunkLength = 0;
+  }
+
+  size_t rxChunkRemaining() const { return rxChunkLength - rxChunkOffset; }
+
+  size_t bufferedBytes() const {
+    return rxStream == nullptr
+      ? 0 : rxChunkRemaining() + xStreamBufferBytesAvailable(rxStream);
+  }
+
+  MonitorDeviceSummary summary() const {
+    MonitorDeviceSummary result;
+    result.state = currentState;
+    result.dataLossCount = currentDiagnostics.lossEpisodes;
+    result.reconnectCount = currentReconnectCount;
+    result.droppedBytes = currentDiagnostics.droppedBytes;
+    return result;
+  }
+};
+
+struct UsbCdcTransport::Impl {
+  Impl() {
+    for (uint8_t i = 0; i < kMaxMonitorDevices; ++i) {
+      ports[i].host = this;
+      ports[i].index = i;
+    }
+  }
+
+  // One port per monitor behind the root port or a hub. Ports share the host
+  // library, CDC driver and daemon; everything session-scoped is per port.
+  UsbCdcPort ports[kMaxMonitorDevices];
+  uint8_t portCount = 1;
+  // Consumer round-robin: the next port to drain once the current chunk ends.
+  uint8_t nextRxPort = 0;
+  size_t requestedRxBytes = kUsbCdcRxMinBytes;
+
+  std::atomic<bool> shutdownRequested{false};
+  std::atomic<bool> teardownSafe{true};
+  std::atomic<UsbCdcDaemonPhase> daemonPhase{UsbCdcDaemonPhase::STOPPED};
+
+  StaticSemaphore_t daemonExitState = {};
+  SemaphoreHandle_t daemonExit = nullptr;
+  // Given by the destructor so a retry back-off ends at shutdown, not at the
+  // next slice boundary.
+  StaticSemaphore_t daemonWakeState = {};
+  SemaphoreHandle_t daemonWake = nullptr;
+  // Set before begin() and never changed, so producer tasks read it without
+  // synchronization.
+  MonitorWakeCallback wakeCallback = nullptr;
+  void* wakeContext = nullptr;
+  bool beginCalled = false;
+  bool daemonTaskStarted = false;
+  uint32_t lastMillis32 = 0;
+  uint64_t millisHigh = 0;
+  bool millisInitialized = false;
+  MonitorTransportStatus publishedStatus;
+  MonitorDeviceSummary publishedDevices[kMaxMonitorDevices];
+
+  // Owner task only: host-level failures before any port runs.
+  void setAllPorts(MonitorTransportState state, const char* text);
+
   uint64_t monotonicMillis() {
     uint32_t now = millis();
     if (!millisInitialized) {
@@ -134,17 +225,30 @@ struct UsbCdcTransport::Impl {
   }
 };
 
+void UsbCdcTransport::Impl::setAllPorts(MonitorTransportState state,
+                                        const char* text) {
+  for (uint8_t i = 0; i < portCount; ++i) {
+    ports[i].currentState = state;
+    ports[i].setDetail(text);
+  }
+}
+
 #if SOC_USB_OTG_SUPPORTED
 static std::atomic<UsbCdcTransport::Impl*> gUsbCdcImpl{nullptr};
 
+// Producer side, after the byte or event it announces is visible.
+static void wakeOwner(UsbCdcTransport::Impl* impl) {
+  if (impl->wakeCallback != nullptr) impl->wakeCallback(impl->wakeContext);
+}
+
 // CALLBACK_POD_BEGIN lifecycle queue producer
-static bool enqueueLifecycle(UsbCdcTransport::Impl* impl,
+static bool enqueueLifecycle(UsbCdcPort* port,
                              UsbCdcControlType type, int32_t code = 0,
                              uint32_t count = 0, uint32_t session = 0,
                              bool critical = true) {
-  if (impl == nullptr || impl->lifecycleQueue == nullptr) return false;
+  if (port == nullptr || port->lifecycleQueue == nullptr) return false;
   if (!critical && !usbCdcMayEnqueueNormalControl(
-        uxQueueSpacesAvailable(impl->lifecycleQueue))) {
+        uxQueueSpacesAvailable(port->lifecycleQueue))) {
     return false;
   }
   UsbCdcControlEvent event;
@@ -152,10 +256,14 @@ static bool enqueueLifecycle(UsbCdcTransport::Impl* impl,
   event.code = code;
   event.count = count;
   event.session = session;
-  if (xQueueSendToBack(impl->lifecycleQueue, &event, 0) == pdPASS) return true;
+  if (xQueueSendToBack(port->lifecycleQueue, &event, 0) == pdPASS) {
+    wakeOwner(port->host);
+    return true;
+  }
   if (critical) {
-    atomicSaturatingIncrement(impl->lifecycleQueueFailures);
-    impl->shared.quarantineTerminal(session);
+    atomicSaturatingIncrement(port->lifecycleQueueFailures);
+    port->shared.quarantineTerminal(session);
+    wakeOwner(port->host);
   }
   return false;
 }
@@ -163,7 +271,7 @@ static bool enqueueLifecycle(UsbCdcTransport::Impl* impl,
 
 // CALLBACK_POD_BEGIN ordered loss producer
 static UsbCdcOrderedPublishResult enqueueOrdered(
-    UsbCdcTransport::Impl* impl, UsbCdcOrderedType type, uint32_t session,
+    UsbCdcPort* port, UsbCdcOrderedType type, uint32_t session,
     uint32_t epoch, uint32_t droppedBytes, bool resumeProducer = false,
     bool quarantineBarrier = false) {
   UsbCdcOrderedEvent event;
@@ -171,55 +279,82 @@ static UsbCdcOrderedPublishResult enqueueOrdered(
   event.session = session;
   event.epoch = epoch;
   event.byteBoundary =
-    impl->acceptedByteSequence.load(std::memory_order_acquire);
+    port->acceptedByteSequence.load(std::memory_order_acquire);
   event.droppedBytes = droppedBytes;
   if (quarantineBarrier) {
-    return impl->shared.publishQuarantineBarrier(event);
+    return port->shared.publishQuarantineBarrier(event);
   }
-  return impl->shared.publish(event, resumeProducer);
+  return port->shared.publish(event, resumeProducer);
 }
 // CALLBACK_POD_END ordered loss producer
 
-static uint32_t beginTerminalLoss(UsbCdcTransport::Impl* impl) {
-  return impl->shared.beginTerminalLoss();
+static uint32_t beginTerminalLoss(UsbCdcPort* port) {
+  return port->shared.beginTerminalLoss();
 }
 
 // CALLBACK_POD_BEGIN CDC data callback
+// Caller holds a byte-commit lease, so a terminal boundary cannot be stamped
+// until these bytes are counted in acceptedByteSequence.
+static void commitReceivedBytes(UsbCdcPort* port, uint32_t session,
+                                const uint8_t* data, size_t dataLen) {
+  const uint32_t occupancyBefore =
+    port->acceptedByteSequence.load(std::memory_order_relaxed) -
+    port->drainedByteSequence.load(std::memory_order_acquire);
+  size_t sent = xStreamBufferSend(port->rxStream, data, dataLen, 0);
+  port->acceptedByteSequence.fetch_add(static_cast<uint32_t>(sent),
+                                       std::memory_order_release);
+  if (sent > 0) {
+    port->lastRxAcceptedUs.store(static_cast<uint32_t>(micros()),
+                                 std::memory_order_relaxed);
+    port->rxAcceptedEver.store(true, std::memory_order_release);
+    port->rxOccupancy.noteAccepted(occupancyBefore +
+                                   static_cast<uint32_t>(sent));
+  }
+  if (sent < dataLen) {
+    port->rxOccupancy.noteOverflow(occupancyBefore);
+    size_t lostSize = dataLen - sent;
+    uint32_t lost = lostSize > UINT32_MAX ? UINT32_MAX
+                                          : static_cast<uint32_t>(lostSize);
+    uint32_t epoch = port->shared.beginOverflowLoss(lost);
+    port->overflowMarkerPublished.store(true, std::memory_order_release);
+    enqueueOrdered(port, UsbCdcOrderedType::DISCONTINUITY,
+                   session, epoch, lost, true, true);
+  }
+  wakeOwner(port->host);
+}
+
 static bool cdcDataCallback(const uint8_t* data, size_t dataLen, void* userArg) {
-  auto* context = static_cast<UsbCdcTransport::Impl::CallbackContext*>(userArg);
+  auto* context = static_cast<UsbCdcPort::CallbackContext*>(userArg);
   if (context == nullptr || context->owner == nullptr || data == nullptr ||
       dataLen == 0) {
     return true;
   }
-  auto* impl = context->owner;
+  auto* port = context->owner;
+  // Steady state: one lock-free admission per transfer. Anything unusual
+  // (quarantine, terminal, retiring context) takes the synchronized path.
+  auto admitted = port->shared.acquireAdmittedByteCommit(context->slot,
+                                                         context->session);
+  if (admitted) {
+    commitReceivedBytes(port, context->session, data, dataLen);
+    return true;
+  }
+
   uint32_t rejectedBytes = dataLen > UINT32_MAX
     ? UINT32_MAX : static_cast<uint32_t>(dataLen);
-  auto lease = impl->shared.acquireCallback(context->slot, context->session);
+  auto lease = port->shared.acquireCallback(context->slot, context->session);
   if (!lease) {
-    impl->shared.recordRejectedDrop(rejectedBytes);
+    port->shared.recordRejectedDrop(rejectedBytes);
     return true;
   }
-  uint32_t epoch = impl->shared.producerEpoch();
+  uint32_t epoch = port->shared.producerEpoch();
   UsbCdcByteAdmission admission = UsbCdcByteAdmission::REJECTED_INACTIVE;
-  auto byteCommit = impl->shared.acquireByteCommitOrRecordDrop(
+  auto byteCommit = port->shared.acquireByteCommitOrRecordDrop(
     context->slot, context->session, epoch, rejectedBytes, admission);
   if (!byteCommit) {
-    impl->shared.recordRejectedDrop(rejectedBytes);
+    port->shared.recordRejectedDrop(rejectedBytes);
     return true;
   }
-
-  size_t sent = xStreamBufferSend(impl->rxStream, data, dataLen, 0);
-  impl->acceptedByteSequence.fetch_add(static_cast<uint32_t>(sent),
-                                       std::memory_order_release);
-  if (sent < dataLen) {
-    size_t lostSize = dataLen - sent;
-    uint32_t lost = lostSize > UINT32_MAX ? UINT32_MAX
-                                          : static_cast<uint32_t>(lostSize);
-    epoch = impl->shared.beginOverflowLoss(lost);
-    impl->overflowMarkerPublished.store(true, std::memory_order_release);
-    enqueueOrdered(impl, UsbCdcOrderedType::DISCONTINUITY,
-                   context->session, epoch, lost, true, true);
-  }
+  commitReceivedBytes(port, context->session, data, dataLen);
   return true;  // false makes the vendored driver append into its USB buffer.
 }
 // CALLBACK_POD_END CDC data callback
@@ -227,47 +362,47 @@ static bool cdcDataCallback(const uint8_t* data, size_t dataLen, void* userArg)
 // CALLBACK_POD_BEGIN CDC lifecycle callback
 static void cdcEventCallback(const cdc_acm_host_dev_event_data_t* event,
                              void* userArg) {
-  auto* context = static_cast<UsbCdcTransport::Impl::CallbackContext*>(userArg);
+  auto* context = static_cast<UsbCdcPort::CallbackContext*>(userArg);
   if (context == nullptr || context->owner == nullptr || event == nullptr) return;
-  auto* impl = context->owner;
+  auto* port = context->owner;
   bool terminalEvent = event->type == CDC_ACM_HOST_ERROR ||
                        event->type == CDC_ACM_HOST_DEVICE_DISCONNECTED;
   auto lease = terminalEvent
-    ? impl->shared.acquireTerminalCallback(context->slot, context->session)
-    : impl->shared.acquireCallback(context->slot, context->session);
+    ? port->shared.acquireTerminalCallback(context->slot, context->session)
+    : port->shared.acquireCallback(context->slot, context->session);
   if (!lease) return;
   switch (event->type) {
     case CDC_ACM_HOST_ERROR: {
-      if (impl->shared.noteTerminalFact(
+      if (port->shared.noteTerminalFact(
             context->session, UsbCdcTerminalFact::ERROR) ==
           UsbCdcTerminalUpdate::IGNORED) break;
-      if (enqueueLifecycle(impl, UsbCdcControlType::TRANSFER_ERROR,
+      if (enqueueLifecycle(port, UsbCdcControlType::TRANSFER_ERROR,
                            event->data.error, 0, context->session, true)) {
-        impl->shared.acknowledgeTerminalFact(
+        port->shared.acknowledgeTerminalFact(
           context->session, UsbCdcTerminalFact::ERROR);
       }
       break;
     }
     case CDC_ACM_HOST_DEVICE_DISCONNECTED: {
-      if (impl->shared.noteTerminalFact(
+      if (port->shared.noteTerminalFact(
             context->session, UsbCdcTerminalFact::DISCONNECTED) ==
           UsbCdcTerminalUpdate::IGNORED) break;
-      if (enqueueLifecycle(impl, UsbCdcControlType::DEVICE_DISCONNECTED, 0, 0,
+      if (enqueueLifecycle(port, UsbCdcControlType::DEVICE_DISCONNECTED, 0, 0,
                            context->session, true)) {
-        impl->shared.acknowledgeTerminalFact(
+        port->shared.acknowledgeTerminalFact(
           context->session, UsbCdcTerminalFact::DISCONNECTED);
       }
       break;
     }
     case CDC_ACM_HOST_SERIAL_STATE:
     case CDC_ACM_HOST_NETWORK_CONNECTION:
-      enqueueLifecycle(impl, UsbCdcControlType::RX_ACTIVITY, 0, 0,
+      enqueueLifecycle(port, UsbCdcControlType::RX_ACTIVITY, 0, 0,
                        context->session, false);
       break;
 #ifdef CDC_HOST_SUSPEND_RESUME_API_SUPPORTED
     case CDC_ACM_HOST_DEVICE_SUSPENDED:
     case CDC_ACM_HOST_DEVICE_RESUMED:
-      enqueueLifecycle(impl, UsbCdcControlType::RX_ACTIVITY, 0, 0,
+      enqueueLifecycle(port, UsbCdcControlType::RX_ACTIVITY, 0, 0,
                        context->session, false);
       break;
 #endif
@@ -277,18 +412,23 @@ static void cdcEventCallback(const cdc_acm_host_dev_event_data_t* event,
 }
 // CALLBACK_POD_END CDC lifecycle callback
 
+// Daemon task: host-library and driver facts apply to every port.
+static void enqueueHostLifecycle(UsbCdcTransport::Impl* impl,
+                                 UsbCdcControlType type, int32_t code = 0) {
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    enqueueLifecycle(&impl->ports[index], type, code, 0, 0, true);
+  }
+}
+
 static uint32_t daemonRetryDelay(uint8_t attempt) {
   uint8_t shift = attempt > 5 ? 4 : static_cast<uint8_t>(attempt - 1);
   return static_cast<uint32_t>(1000U << shift);
 }
 
+// Sleeps through one retry back-off; the destructor's daemonWake cuts it short.
 static bool daemonWait(UsbCdcTransport::Impl* impl, uint32_t delayMs) {
-  uint32_t remaining = delayMs;
-  while (remaining > 0 &&
-         !impl->shutdownRequested.load(std::memory_order_acquire)) {
-    uint32_t slice = remaining > 100 ? 100 : remaining;
-    vTaskDelay(pdMS_TO_TICKS(slice));
-    remaining -= slice;
+  if (!impl->shutdownRequested.load(std::memory_order_acquire)) {
+    (void)xSemaphoreTake(impl->daemonWake, pdMS_TO_TICKS(delayMs));
   }
   return !impl->shutdownRequested.load(std::memory_order_acquire);
 }
@@ -361,12 +501,12 @@ static void usbHostDaemonTask(void* arg) {
 
     esp_err_t result = usb_host_install(&hostConfig);
     if (result != ESP_OK) {
-      enqueueLifecycle(impl, UsbCdcControlType::HOST_INSTALL_FAILED, result);
+      enqueueHostLifecycle(impl, UsbCdcControlType::HOST_INSTALL_FAILED, result);
       if (retryAttempt < UINT8_MAX) retryAttempt++;
       if (!daemonWait(impl, daemonRetryDelay(retryAttempt))) break;
       continue;
     }
-    enqueueLifecycle(impl, UsbCdcControlType::HOST_INSTALL_OK);
+    enqueueHostLifecycle(impl, UsbCdcControlType::HOST_INSTALL_OK);
 
     const cdc_acm_host_driver_config_t driverConfig = {
       .driver_task_stack_size = 4096,
@@ -376,9 +516,16 @@ static void usbHostDaemonTask(void* arg) {
         // CALLBACK_POD_BEGIN new-device callback
         UsbCdcTransport::Impl* active =
           gUsbCdcImpl.load(std::memory_order_acquire);
+        // Which port the device belongs to is decided by the next open, so
+        // every idle port gets a chance to claim it. `count` carries the
+        // attach time for the reconnect histogram.
         if (active != nullptr) {
-          enqueueLifecycle(active, UsbCdcControlType::DEVICE_ATTACHED,
-                           0, 0, 0, true);
+          const uint32_t attachedMs = static_cast<uint32_t>(millis());
+          for (uint8_t index = 0; index < active->portCount; ++index) {
+            enqueueLifecycle(&active->ports[index],
+                             UsbCdcControlType::DEVICE_ATTACHED, 0,
+                             attachedMs, 0, true);
+          }
         }
         // CALLBACK_POD_END new-device callback
       },
@@ -386,7 +533,7 @@ static void usbHostDaemonTask(void* arg) {
 
     result = cdc_acm_host_install(&driverConfig);
     if (result != ESP_OK) {
-      enqueueLifecycle(impl, UsbCdcControlType::DRIVER_INSTALL_FAILED, result);
+      enqueueHostLifecycle(impl, UsbCdcControlType::DRIVER_INSTALL_FAILED, result);
       if (!teardownUsbHost(false)) {
         impl->teardownSafe.store(false, std::memory_order_release);
         break;
@@ -397,13 +544,16 @@ static void usbHostDaemonTask(void* arg) {
     }
 
     retryAttempt = 0;
-    enqueueLifecycle(impl, UsbCdcControlType::DRIVER_INSTALL_OK);
+    enqueueHostLifecycle(impl, UsbCdcControlType::DRIVER_INSTALL_OK);
+    // Blocks until the host library has work: an idle bus costs no wakeups.
+    // The destructor's usb_host_lib_unblock() is latched, so a shutdown that
+    // lands between the check and the call still returns promptly.
     while (!impl->shutdownRequested.load(std::memory_order_acquire)) {
       uint32_t eventFlags = 0;
-      result = usb_host_lib_handle_events(pdMS_TO_TICKS(100), &eventFlags);
+      result = usb_host_lib_handle_events(portMAX_DELAY, &eventFlags);
       if (result != ESP_OK && result != ESP_ERR_TIMEOUT) {
-        enqueueLifecycle(impl, UsbCdcControlType::CONTROL_QUEUE_OVERFLOW,
-                         result, 0, 0, true);
+        enqueueHostLifecycle(impl, UsbCdcControlType::CONTROL_QUEUE_OVERFLOW,
+                             result);
       }
     }
 
@@ -422,50 +572,68 @@ static void usbHostDaemonTask(void* arg) {
 }
 #endif  // SOC_USB_OTG_SUPPORTED
 
-UsbCdcTransport::UsbCdcTransport() : impl(new Impl()) {}
+UsbCdcTransport::UsbCdcTransport(size_t rxBufferBytes, uint8_t deviceCount)
+    : impl(new Impl()) {
+  impl->requestedRxBytes = rxBufferBytes;
+  impl->portCount = deviceCount == 0 ? 1
+    : deviceCount > kMaxMonitorDevices ? kMaxMonitorDevices : deviceCount;
+}
 
-UsbCdcTransport::~UsbCdcTransport() {
-  if (impl == nullptr) return;
 #if SOC_USB_OTG_SUPPORTED
-  impl->shared.quarantineProducer(impl->activeSession);
-  Impl* expected = impl;
-  gUsbCdcImpl.compare_exchange_strong(expected, nullptr,
-                                       std::memory_order_acq_rel);
+// Destructor only. Returns false when the handle could not be released, in
+// which case the driver may still call into this port.
+static bool closePortForDestruction(UsbCdcPort* port) {
   size_t closeAttempts = 0;
-  while (impl->cdcHandle != nullptr &&
+  while (port->cdcHandle != nullptr &&
          closeAttempts < kDestructorCloseAttempts) {
     closeAttempts++;
-    size_t slot = impl->activeCallbackSlot < 0
+    size_t slot = port->activeCallbackSlot < 0
       ? kCallbackContextCount
-      : static_cast<size_t>(impl->activeCallbackSlot);
+      : static_cast<size_t>(port->activeCallbackSlot);
     if (slot < kCallbackContextCount) {
-      impl->shared.retireContext(slot, impl->activeSession);
+      port->shared.retireContext(slot, port->activeSession);
     }
-    esp_err_t result = cdc_acm_host_close(impl->cdcHandle);
+    esp_err_t result = cdc_acm_host_close(port->cdcHandle);
     if (result == ESP_OK) {
-      impl->cdcHandle = nullptr;
+      port->cdcHandle = nullptr;
       if (slot < kCallbackContextCount) {
-        UsbCdcCloseCompletion completion = impl->shared.finishClose(
-          slot, impl->activeSession, true);
+        UsbCdcCloseCompletion completion = port->shared.finishClose(
+          slot, port->activeSession, true);
         while (completion == UsbCdcCloseCompletion::CALLBACKS_ACTIVE) {
           vTaskDelay(pdMS_TO_TICKS(1));
-          completion = impl->shared.finishClose(
-            slot, impl->activeSession, true);
+          completion = port->shared.finishClose(
+            slot, port->activeSession, true);
         }
         if (completion == UsbCdcCloseCompletion::RELEASED) {
-          impl->callbackContexts[slot].session = 0;
-          impl->activeCallbackSlot = -1;
+          port->callbackContexts[slot].session = 0;
+          port->activeCallbackSlot = -1;
         }
       }
     } else {
       if (slot < kCallbackContextCount) {
-        impl->shared.finishClose(slot, impl->activeSession, false);
+        port->shared.finishClose(slot, port->activeSession, false);
       }
       vTaskDelay(pdMS_TO_TICKS(10));
     }
   }
-  if (impl->cdcHandle != nullptr) {
-    impl->teardownSafe.store(false, std::memory_order_release);
+  return port->cdcHandle == nullptr;
+}
+#endif
+
+UsbCdcTransport::~UsbCdcTransport() {
+  if (impl == nullptr) return;
+#if SOC_USB_OTG_SUPPORTED
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    UsbCdcPort* port = &impl->ports[index];
+    port->shared.quarantineProducer(port->activeSession);
+  }
+  Impl* expected = impl;
+  gUsbCdcImpl.compare_exchange_strong(expected, nullptr,
+                                       std::memory_order_acq_rel);
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    if (!closePortForDestruction(&impl->ports[index])) {
+      impl->teardownSafe.store(false, std::memory_order_release);
+    }
   }
   impl->shutdownRequested.store(true, std::memory_order_release);
   UsbCdcDaemonPhase phase = impl->daemonPhase.load(std::memory_order_acquire);
@@ -473,6 +641,7 @@ UsbCdcTransport::~UsbCdcTransport() {
     impl->daemonPhase.store(UsbCdcDaemonPhase::STOPPING,
                             std::memory_order_release);
     usb_host_lib_unblock();
+    xSemaphoreGive(impl->daemonWake);
   }
   if (impl->daemonTaskStarted && impl->daemonExit != nullptr) {
     xSemaphoreTake(impl->daemonExit, portMAX_DELAY);
@@ -488,43 +657,92 @@ UsbCdcTransport::~UsbCdcTransport() {
     return;
   }
 #endif
-  memset(impl->rxStreamStorage, 0, sizeof(impl->rxStreamStorage));
-  impl->shared.clearOrdered();
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    UsbCdcPort* port = &impl->ports[index];
+    if (port->rxStreamStorage != nullptr) {
+      memset(port->rxStreamStorage, 0, port->rxStorageBytes);
+      heap_caps_free(port->rxStreamStorage);
+      port->rxStreamStorage = nullptr;
+    }
+    port->discardRxChunk();
+    port->shared.clearOrdered();
+  }
   delete impl;
   impl = nullptr;
 }
 
+// Owner task, begin() only. A static stream buffer needs one spare storage
+// byte beyond its usable capacity. PSRAM gets the larger ceiling; if the
+// requested size cannot be placed anywhere, fall back to the minimum.
+static void allocateRxStorage(UsbCdcPort* port, size_t requestedBytes) {
+  const size_t psramBytes = usbCdcRxClampCapacity(requestedBytes, true);
+  const size_t internalBytes = usbCdcRxClampCapacity(requestedBytes, false);
+  const struct {
+    size_t usable;
+    uint32_t caps;
+    bool psram;
+  } attempts[] = {
+    {psramBytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, true},
+    {internalBytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, false},
+    {kUsbCdcRxMinBytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, false},
+  };
+  for (const auto& attempt : attempts) {
+    void* storage = heap_caps_calloc(1, attempt.usable + 1, attempt.caps);
+    if (storage == nullptr) continue;
+    port->rxStreamStorage = static_cast<uint8_t*>(storage);
+    port->rxStorageBytes = attempt.usable + 1;
+    port->rxOccupancy.configure(static_cast<uint32_t>(attempt.usable),
+                                attempt.psram);
+    port->reportedRxTelemetry = port->rxOccupancy.snapshot();
+    return;
+  }
+}
+
+static bool allocatePortQueues(UsbCdcPort* port, size_t requestedRxBytes) {
+  allocateRxStorage(port, requestedRxBytes);
+  if (port->rxStreamStorage != nullptr) {
+    port->rxStream = xStreamBufferCreateStatic(
+      port->rxStorageBytes, 1, port->rxStreamStorage, &port->rxStreamState);
+  }
+  port->lifecycleQueue = xQueueCreateStatic(
+    kLifecycleQueueDepth, sizeof(UsbCdcControlEvent),
+    port->lifecycleQueueStorage, &port->lifecycleQueueState);
+  return port->rxStream != nullptr && port->lifecycleQueue != nullptr;
+}
+
 bool UsbCdcTransport::begin() {
   if (impl == nullptr || impl->beginCalled) return false;
   impl->beginCalled = true;
-  impl->rxStream = xStreamBufferCreateStatic(
-    sizeof(impl->rxStreamStorage), 1, impl->rxStreamStorage,
-    &impl->rxStreamState);
-  impl->lifecycleQueue = xQueueCreateStatic(
-    kLifecycleQueueDepth, sizeof(UsbCdcControlEvent),
-    impl->lifecycleQueueStorage, &impl->lifecycleQueueState);
+  bool allocated = true;
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    allocated = allocatePortQueues(&impl->ports[index],
+                                   impl->requestedRxBytes) && allocated;
+  }
   impl->daemonExit = xSemaphoreCreateBinaryStatic(&impl->daemonExitState);
-  if (impl->rxStream == nullptr || impl->lifecycleQueue == nullptr ||
-      impl->daemonExit == nullptr) {
-    impl->currentState = TRANSPORT_STATE_ERROR;
-    impl->currentDetail = "USB queue allocation failed";
+  impl->daemonWake = xSemaphoreCreateBinaryStatic(&impl->daemonWakeState);
+  if (!allocated || impl->daemonExit == nullptr ||
+      impl->daemonWake == nullptr) {
+    impl->setAllPorts(TRANSPORT_STATE_ERROR, "USB queue allocation failed");
     return false;
   }
 
   UsbCdcControlEvent beginEvent;
   beginEvent.type = UsbCdcControlType::BEGIN;
-  impl->lifecycle.apply(beginEvent, impl->monotonicMillis());
+  const uint64_t nowMs = impl->monotonicMillis();
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    impl->ports[index].lifecycle.apply(beginEvent, nowMs);
+  }
 
 #if !SOC_USB_OTG_SUPPORTED
-  impl->currentState = TRANSPORT_STATE_UNSUPPORTED;
-  impl->currentDetail = "SOC_USB_OTG_SUPPORTED is not available on this target";
+  impl->setAllPorts(TRANSPORT_STATE_UNSUPPORTED,
+                    "SOC_USB_OTG_SUPPORTED is not available on this target");
   return false;
 #else
   Impl* expected = nullptr;
   if (!gUsbCdcImpl.compare_exchange_strong(expected, impl,
                                             std::memory_order_acq_rel)) {
-    impl->currentState = TRANSPORT_STATE_ERROR;
-    impl->currentDetail = "Another USB CDC transport is already active";
+    impl->setAllPorts(TRANSPORT_STATE_ERROR,
+                      "Another USB CDC transport is already active");
     return false;
   }
   impl->daemonPhase.store(UsbCdcDaemonPhase::STARTING,
@@ -534,16 +752,15 @@ bool UsbCdcTransport::begin() {
   if (created != pdPASS) {
     impl->daemonPhase.store(UsbCdcDaemonPhase::STOPPED,
                             std::memory_order_release);
-    impl->currentState = TRANSPORT_STATE_ERROR;
-    impl->currentDetail = "Failed to create USB host daemon task";
+    impl->setAllPorts(TRANSPORT_STATE_ERROR,
+                      "Failed to create USB host daemon task");
     expected = impl;
     gUsbCdcImpl.compare_exchange_strong(expected, nullptr,
                                          std::memory_order_acq_rel);
     return false;
   }
   impl->daemonTaskStarted = true;
-  impl->currentState = TRANSPORT_STATE_STARTING;
-  impl->currentDetail = "Starting USB host stack";
+  impl->setAllPorts(TRANSPORT_STATE_STARTING, "Starting USB host stack");
   return true;
 #endif
 }
@@ -563,45 +780,44 @@ static bool sessionScoped(UsbCdcControlType type) {
   }
 }
 
-static void applyLifecycleEvent(UsbCdcTransport::Impl* impl,
+static void applyLifecycleEvent(UsbCdcPort* port,
                                 const UsbCdcControlEvent& event,
                                 uint64_t nowMs) {
-  if (sessionScoped(event.type) && event.session != impl->activeSession) return;
-  impl->lifecycle.apply(event, nowMs);
+  if (sessionScoped(event.type) && event.session != port->activeSession) return;
+  port->lifecycle.apply(event, nowMs);
   switch (event.type) {
     case UsbCdcControlType::HOST_INSTALL_OK:
-      impl->currentDetail = "USB host installed";
+      port->setDetail("USB host installed");
       break;
     case UsbCdcControlType::HOST_INSTALL_FAILED:
-      impl->currentDetail = "usb_host_install failed; retry scheduled: ";
-      impl->currentDetail += event.code;
+      port->setDetail("usb_host_install failed; retry scheduled: ", event.code);
       break;
     case UsbCdcControlType::DRIVER_INSTALL_OK:
-      impl->currentDetail = "USB host ready. Waiting for CDC device.";
+      port->setDetail("USB host ready. Waiting for CDC device.");
       break;
     case UsbCdcControlType::DRIVER_INSTALL_FAILED:
-      impl->currentDetail = "cdc_acm_host_install failed; retry scheduled: ";
-      impl->currentDetail += event.code;
+      port->setDetail("cdc_acm_host_install failed; retry scheduled: ",
+                      event.code);
       break;
     case UsbCdcControlType::DEVICE_ATTACHED:
-      impl->currentDetail = "USB device detected. Probing CDC interface.";
+      port->reconnect.noteAttached(event.count, port->lifecycle.connected());
+      port->setDetail("USB device detected. Probing CDC interface.");
       break;
     case UsbCdcControlType::TRANSFER_ERROR:
-      impl->currentDetail = "CDC transfer error; reconnect scheduled: ";
-      impl->currentDetail += event.code;
+      port->setDetail("CDC transfer error; reconnect scheduled: ", event.code);
       break;
     case UsbCdcControlType::DEVICE_DISCONNECTED:
-      impl->currentDetail = "CDC device disconnected";
+      port->setDetail("CDC device disconnected");
       break;
     case UsbCdcControlType::HANDLE_CLOSE_FAILED:
-      impl->currentDetail = "cdc_acm_host_close failed; ownership retained: ";
-      impl->currentDetail += event.code;
+      port->setDetail("cdc_acm_host_close failed; ownership retained: ",
+                      event.code);
       break;
     case UsbCdcControlType::RX_OVERFLOW:
-      impl->currentDetail = "CDC RX overflow; frame boundary recovery active";
+      port->setDetail("CDC RX overflow; frame boundary recovery active");
       break;
     case UsbCdcControlType::CONTROL_QUEUE_OVERFLOW:
-      impl->currentDetail = "CDC control queue overflow; fail-closed recovery";
+      port->setDetail("CDC control queue overflow; fail-closed recovery");
       break;
     default:
       break;
@@ -624,148 +840,151 @@ static bool terminalOrderedType(UsbCdcControlType type,
   }
 }
 
-static bool quiesceTerminalCallbacks(UsbCdcTransport::Impl* impl,
+static bool quiesceTerminalCallbacks(UsbCdcPort* port,
                                      uint32_t session) {
-  if (impl->activeCallbackSlot < 0) return true;
-  size_t slot = static_cast<size_t>(impl->activeCallbackSlot);
-  if (!impl->shared.contextMatches(slot, session)) return true;
-  impl->shared.retireContext(slot, session);
+  if (port->activeCallbackSlot < 0) return true;
+  size_t slot = static_cast<size_t>(port->activeCallbackSlot);
+  if (!port->shared.contextMatches(slot, session)) return true;
+  port->shared.retireContext(slot, session);
   for (size_t attempt = 0; attempt < kCallbackQuiesceAttempts; ++attempt) {
-    if (impl->shared.callbacksQuiescent(slot, session)) return true;
+    if (port->shared.callbacksQuiescent(slot, session)) return true;
     taskYIELD();
   }
-  return impl->shared.callbacksQuiescent(slot, session);
+  return port->shared.callbacksQuiescent(slot, session);
 }
 
-static bool publishTerminalBoundary(UsbCdcTransport::Impl* impl,
+static bool publishTerminalBoundary(UsbCdcPort* port,
                                     uint32_t session,
                                     UsbCdcOrderedType orderedType) {
-  impl->shared.quarantineTerminal(session);
-  if (!impl->terminalBoundary.needsPublish(orderedType)) return true;
-  if (!quiesceTerminalCallbacks(impl, session)) return false;
-  uint32_t epoch = beginTerminalLoss(impl);
-  enqueueOrdered(impl, orderedType, session, epoch, 0, false);
-  impl->terminalBoundary.notePublished(orderedType);
+  port->shared.quarantineTerminal(session);
+  if (!port->terminalBoundary.needsPublish(orderedType)) return true;
+  if (!quiesceTerminalCallbacks(port, session)) return false;
+  uint32_t epoch = beginTerminalLoss(port);
+  enqueueOrdered(port, orderedType, session, epoch, 0, false);
+  port->terminalBoundary.notePublished(orderedType);
   return true;
 }
 
-static bool applyTerminalEventOrDefer(UsbCdcTransport::Impl* impl,
+static bool applyTerminalEventOrDefer(UsbCdcPort* port,
                                       const UsbCdcControlEvent& event,
                                       uint64_t nowMs) {
   UsbCdcControlEvent normalized = event;
   normalized.session = usbCdcEffectiveControlSession(
-    normalized.type, normalized.session, impl->activeSession);
+    normalized.type, normalized.session, port->activeSession);
   if (sessionScoped(normalized.type) &&
-      normalized.session != impl->activeSession) {
+      normalized.session != port->activeSession) {
     return true;
   }
   UsbCdcOrderedType orderedType;
   if (!terminalOrderedType(normalized.type, orderedType)) {
-    applyLifecycleEvent(impl, normalized, nowMs);
+    applyLifecycleEvent(port, normalized, nowMs);
     return true;
   }
-  if (!publishTerminalBoundary(impl, normalized.session, orderedType)) {
-    impl->pendingTerminalEvent = normalized;
-    impl->pendingTerminalType = orderedType;
-    impl->terminalBoundaryPending = true;
+  if (!publishTerminalBoundary(port, normalized.session, orderedType)) {
+    port->pendingTerminalEvent = normalized;
+    port->pendingTerminalType = orderedType;
+    port->terminalBoundaryPending = true;
     return false;
   }
-  applyLifecycleEvent(impl, normalized, nowMs);
+  applyLifecycleEvent(port, normalized, nowMs);
   return true;
 }
 
-static bool replayPendingTerminalFact(UsbCdcTransport::Impl* impl,
+static bool replayPendingTerminalFact(UsbCdcPort* port,
                                       uint64_t nowMs) {
   UsbCdcTerminalFact fact =
-    impl->shared.pendingTerminalFact(impl->activeSession);
+    port->shared.pendingTerminalFact(port->activeSession);
   if (fact == UsbCdcTerminalFact::NONE) return true;
 
   UsbCdcControlEvent replay;
-  replay.session = impl->activeSession;
+  replay.session = port->activeSession;
   if (fact == UsbCdcTerminalFact::DISCONNECTED) {
     replay.type = UsbCdcControlType::DEVICE_DISCONNECTED;
   } else {
     replay.type = UsbCdcControlType::TRANSFER_ERROR;
     replay.code = ESP_FAIL;
   }
-  if (!applyTerminalEventOrDefer(impl, replay, nowMs)) return false;
-  impl->shared.acknowledgeTerminalFact(impl->activeSession, fact);
+  if (!applyTerminalEventOrDefer(port, replay, nowMs)) return false;
+  port->shared.acknowledgeTerminalFact(port->activeSession, fact);
   return true;
 }
 
-static void drainLifecycleQueue(UsbCdcTransport::Impl* impl, uint64_t nowMs) {
-  if (impl->terminalBoundaryPending) {
-    if (!publishTerminalBoundary(impl, impl->pendingTerminalEvent.session,
-                                 impl->pendingTerminalType)) {
+static void drainLifecycleQueue(UsbCdcPort* port, uint64_t nowMs) {
+  if (port->terminalBoundaryPending) {
+    if (!publishTerminalBoundary(port, port->pendingTerminalEvent.session,
+                                 port->pendingTerminalType)) {
       return;
     }
-    UsbCdcControlEvent pending = impl->pendingTerminalEvent;
-    impl->terminalBoundaryPending = false;
-    applyLifecycleEvent(impl, pending, nowMs);
+    UsbCdcControlEvent pending = port->pendingTerminalEvent;
+    port->terminalBoundaryPending = false;
+    applyLifecycleEvent(port, pending, nowMs);
   }
 
   UsbCdcControlEvent event;
-  while (xQueueReceive(impl->lifecycleQueue, &event, 0) == pdPASS) {
-    if (!applyTerminalEventOrDefer(impl, event, nowMs)) return;
+  while (xQueueReceive(port->lifecycleQueue, &event, 0) == pdPASS) {
+    if (!applyTerminalEventOrDefer(port, event, nowMs)) return;
   }
-  uint32_t failures = impl->lifecycleQueueFailures.exchange(
+  uint32_t failures = port->lifecycleQueueFailures.exchange(
     0, std::memory_order_acq_rel);
   if (failures > 0) {
     UsbCdcControlEvent failure;
     failure.type = UsbCdcControlType::CONTROL_QUEUE_OVERFLOW;
     failure.code = static_cast<int32_t>(failures);
-    failure.session = impl->activeSession;
-    impl->shared.quarantineTerminal(impl->activeSession);
-    if (!applyTerminalEventOrDefer(impl, failure, nowMs)) return;
+    failure.session = port->activeSession;
+    port->shared.quarantineTerminal(port->activeSession);
+    if (!applyTerminalEventOrDefer(port, failure, nowMs)) return;
   }
-  (void)replayPendingTerminalFact(impl, nowMs);
+  (void)replayPendingTerminalFact(port, nowMs);
 }
 
-static void retireFailedOpenCallbackContext(UsbCdcTransport::Impl* impl) {
-  if (impl->activeCallbackSlot < 0) return;
-  size_t slot = static_cast<size_t>(impl->activeCallbackSlot);
-  uint32_t session = impl->callbackContexts[slot].session;
+static void retireFailedOpenCallbackContext(UsbCdcPort* port) {
+  if (port->activeCallbackSlot < 0) return;
+  size_t slot = static_cast<size_t>(port->activeCallbackSlot);
+  uint32_t session = port->callbackContexts[slot].session;
   if (session != 0) {
-    impl->shared.retireContext(slot, session);
+    port->shared.retireContext(slot, session);
   }
   // Open failure guarantees the driver has disabled future callback
   // snapshots. Detach this slot from new opens, but keep its immutable
   // session until every already-snapshotted callback lease drains.
-  impl->activeCallbackSlot = -1;
+  port->activeCallbackSlot = -1;
 }
 
 static void reapRetiredCallbackContexts(UsbCdcTransport::Impl* impl) {
-  for (size_t slot = 0; slot < kCallbackContextCount; ++slot) {
-    if (impl->activeCallbackSlot == static_cast<int>(slot)) continue;
-    uint32_t session = impl->callbackContexts[slot].session;
-    if (session != 0 && impl->shared.abandonContext(slot, session)) {
-      impl->callbackContexts[slot].session = 0;
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    UsbCdcPort* port = &impl->ports[index];
+    for (size_t slot = 0; slot < kCallbackContextCount; ++slot) {
+      if (port->activeCallbackSlot == static_cast<int>(slot)) continue;
+      uint32_t session = port->callbackContexts[slot].session;
+      if (session != 0 && port->shared.abandonContext(slot, session)) {
+        port->callbackContexts[slot].session = 0;
+      }
     }
   }
 }
 
-static bool closeOwnedHandle(UsbCdcTransport::Impl* impl, uint64_t nowMs) {
-  if (!impl->lifecycle.takeCloseRequest()) return false;
-  cdc_acm_dev_hdl_t handle = impl->cdcHandle;
-  size_t slot = impl->activeCallbackSlot < 0
+static bool closeOwnedHandle(UsbCdcPort* port, uint64_t nowMs) {
+  if (!port->lifecycle.takeCloseRequest()) return false;
+  cdc_acm_dev_hdl_t handle = port->cdcHandle;
+  size_t slot = port->activeCallbackSlot < 0
     ? kCallbackContextCount
-    : static_cast<size_t>(impl->activeCallbackSlot);
+    : static_cast<size_t>(port->activeCallbackSlot);
   if (slot < kCallbackContextCount) {
-    impl->shared.retireContext(slot, impl->activeSession);
+    port->shared.retireContext(slot, port->activeSession);
   }
   esp_err_t result = handle == nullptr ? ESP_ERR_INVALID_STATE
                                         : cdc_acm_host_close(handle);
   UsbCdcControlEvent outcome;
-  outcome.session = impl->activeSession;
+  outcome.session = port->activeSession;
   if (result == ESP_OK) {
-    impl->cdcHandle = nullptr;
+    port->cdcHandle = nullptr;
     UsbCdcCloseCompletion completion = slot < kCallbackContextCount
-      ? impl->shared.finishClose(slot, impl->activeSession, true)
+      ? port->shared.finishClose(slot, port->activeSession, true)
       : UsbCdcCloseCompletion::RELEASED;
     if (completion == UsbCdcCloseCompletion::RELEASED) {
       if (slot < kCallbackContextCount) {
-        impl->callbackContexts[slot].session = 0;
-        impl->activeCallbackSlot = -1;
+        port->callbackContexts[slot].session = 0;
+        port->activeCallbackSlot = -1;
       }
       outcome.type = UsbCdcControlType::HANDLE_CLOSED;
     } else {
@@ -775,81 +994,83 @@ static bool closeOwnedHandle(UsbCdcTransport::Impl* impl, uint64_t nowMs) {
     }
   } else {
     if (slot < kCallbackContextCount) {
-      impl->shared.finishClose(slot, impl->activeSession, false);
+      port->shared.finishClose(slot, port->activeSession, false);
     }
     outcome.type = UsbCdcControlType::HANDLE_CLOSE_FAILED;
     outcome.code = result;
   }
-  applyLifecycleEvent(impl, outcome, nowMs);
+  applyLifecycleEvent(port, outcome, nowMs);
   return result == ESP_OK;
 }
 
-static bool configurationMayContinue(UsbCdcTransport::Impl* impl,
+static bool configurationMayContinue(UsbCdcPort* port,
                                      cdc_acm_dev_hdl_t candidate,
                                      const UsbCdcConfigToken& token) {
-  if (impl->activeCallbackSlot < 0) return false;
-  size_t slot = static_cast<size_t>(impl->activeCallbackSlot);
-  bool handleMatches = candidate != nullptr && impl->cdcHandle == candidate;
-  bool contextValid = impl->shared.configurationContextValid(
-    slot, impl->activeSession);
-  bool tokenValid = impl->shared.configurationTokenValid(token);
+  if (port->activeCallbackSlot < 0) return false;
+  size_t slot = static_cast<size_t>(port->activeCallbackSlot);
+  bool handleMatches = candidate != nullptr && port->cdcHandle == candidate;
+  bool contextValid = port->shared.configurationContextValid(
+    slot, port->activeSession);
+  bool tokenValid = port->shared.configurationTokenValid(token);
   return usbCdcConfigurationMayContinue(
-    impl->lifecycle.phase(), impl->lifecycle.closePending(),
+    port->lifecycle.phase(), port->lifecycle.closePending(),
     handleMatches, contextValid, tokenValid);
 }
 
-static void failConfiguration(UsbCdcTransport::Impl* impl, uint64_t nowMs,
+static void failConfiguration(UsbCdcPort* port, uint64_t nowMs,
                               esp_err_t error) {
   UsbCdcControlEvent failed;
   failed.type = UsbCdcControlType::CONFIG_FAILED;
   failed.code = error;
-  failed.session = impl->activeSession;
-  impl->currentDetail = "CDC configuration failed; retry scheduled";
-  if (applyTerminalEventOrDefer(impl, failed, nowMs)) {
-    closeOwnedHandle(impl, nowMs);
+  failed.session = port->activeSession;
+  port->setDetail("CDC configuration failed; retry scheduled");
+  if (applyTerminalEventOrDefer(port, failed, nowMs)) {
+    closeOwnedHandle(port, nowMs);
   }
 }
 
-static void attemptOpenAndConfigure(UsbCdcTransport* self, uint64_t nowMs) {
-  auto* impl = self->impl;
+static void attemptOpenAndConfigure(UsbCdcPort* port, uint64_t nowMs) {
+  UsbCdcTransport::Impl* impl = port->host;
   reapRetiredCallbackContexts(impl);
-  if (!impl->lifecycle.shouldAttemptOpen(nowMs)) return;
+  if (!port->lifecycle.shouldAttemptOpen(nowMs)) return;
 
-  bool sessionWrapped = impl->activeSession == UINT32_MAX;
-  impl->activeSession = usbCdcNextSession(impl->activeSession);
+  bool sessionWrapped = port->activeSession == UINT32_MAX;
+  port->activeSession = usbCdcNextSession(port->activeSession);
   if (sessionWrapped) {
-    xStreamBufferReset(impl->rxStream);
-    impl->shared.clearOrdered();
-    impl->acceptedByteSequence.store(0, std::memory_order_release);
-    impl->cursor.beginSession(0, 0,
-      impl->shared.producerEpoch());
-  }
-  impl->shared.startSession(impl->activeSession);
-  UsbCdcConfigToken configToken = impl->shared.configurationToken();
-  impl->terminalBoundaryPending = false;
-  impl->terminalBoundary.reset();
-  impl->overflowMarkerPublished.store(false, std::memory_order_release);
+    xStreamBufferReset(port->rxStream);
+    port->discardRxChunk();
+    port->shared.clearOrdered();
+    port->acceptedByteSequence.store(0, std::memory_order_release);
+    port->drainedByteSequence.store(0, std::memory_order_release);
+    port->cursor.beginSession(0, 0,
+      port->shared.producerEpoch());
+  }
+  port->shared.startSession(port->activeSession);
+  UsbCdcConfigToken configToken = port->shared.configurationToken();
+  port->terminalBoundaryPending = false;
+  port->terminalBoundary.reset();
+  port->overflowMarkerPublished.store(false, std::memory_order_release);
 
   UsbCdcControlEvent started;
   started.type = UsbCdcControlType::OPEN_STARTED;
-  started.session = impl->activeSession;
-  impl->lifecycle.apply(started, nowMs);
-  impl->currentDetail = "Probing CDC device";
+  started.session = port->activeSession;
+  port->lifecycle.apply(started, nowMs);
+  port->setDetail("Probing CDC device");
 
-  int callbackSlot = impl->shared.acquireContext(impl->activeSession);
+  int callbackSlot = port->shared.acquireContext(port->activeSession);
   if (callbackSlot < 0) {
     UsbCdcControlEvent failed;
     failed.type = UsbCdcControlType::OPEN_FAILED;
     failed.code = ESP_ERR_NO_MEM;
-    failed.session = impl->activeSession;
-    impl->lifecycle.apply(failed, nowMs);
-    impl->currentDetail = "No quiescent CDC callback context available";
+    failed.session = port->activeSession;
+    port->lifecycle.apply(failed, nowMs);
+    port->setDetail("No quiescent CDC callback context available");
     return;
   }
-  impl->activeCallbackSlot = callbackSlot;
-  UsbCdcTransport::Impl::CallbackContext* callbackContext =
-    &impl->callbackContexts[static_cast<size_t>(callbackSlot)];
-  callbackContext->session = impl->activeSession;
+  port->activeCallbackSlot = callbackSlot;
+  UsbCdcPort::CallbackContext* callbackContext =
+    &port->callbackContexts[static_cast<size_t>(callbackSlot)];
+  callbackContext->session = port->activeSession;
 
   cdc_acm_host_device_config_t config = {
     .connection_timeout_ms = kOpenTimeoutMs,
@@ -858,39 +1079,60 @@ static void attemptOpenAndConfigure(UsbCdcTransport* self, uint64_t nowMs) {
     .event_cb = cdcEventCallback,
     .data_cb = cdcDataCallback,
     .user_arg = callbackContext,
+    // Behind a hub every port must claim a different physical device.
+    .skip_opened_devices = impl->portCount > 1,
   };
 
   cdc_acm_dev_hdl_t candidate = nullptr;
   esp_err_t openResult = ESP_ERR_NOT_FOUND;
-  uint8_t openedInterface = 0;
-  for (uint8_t interfaceIndex = 0; interfaceIndex < 3; ++interfaceIndex) {
+  UsbCdcDeviceProfile profile = port->reconnect.profile();
+  // Fast path: the device this port last brought to READY, by exact VID/PID
+  // on the interface that worked. Anything else falls back to the probe.
+  bool fastPath = false;
+  if (profile.valid) {
+    openResult = cdc_acm_host_open(profile.vid, profile.pid,
+                                   profile.interfaceIndex, &config,
+                                   &candidate);
+    fastPath = openResult == ESP_OK && candidate != nullptr;
+  }
+  for (uint8_t interfaceIndex = 0; !fastPath && interfaceIndex < 3;
+       ++interfaceIndex) {
     openResult = cdc_acm_host_open(CDC_HOST_ANY_VID, CDC_HOST_ANY_PID,
                                    interfaceIndex, &config, &candidate);
     if (openResult == ESP_OK && candidate != nullptr) {
-      openedInterface = interfaceIndex;
+      profile = UsbCdcDeviceProfile();
+      profile.interfaceIndex = interfaceIndex;
       break;
     }
   }
 
   if (candidate == nullptr || openResult != ESP_OK) {
-    retireFailedOpenCallbackContext(impl);
+    retireFailedOpenCallbackContext(port);
     UsbCdcControlEvent failed;
     failed.type = UsbCdcControlType::OPEN_FAILED;
     failed.code = openResult;
-    failed.session = impl->activeSession;
-    impl->lifecycle.apply(failed, nowMs);
-    impl->currentDetail = "No compatible CDC interface; retry scheduled";
+    failed.session = port->activeSession;
+    port->lifecycle.apply(failed, nowMs);
+    port->setDetail("No compatible CDC interface; retry scheduled");
     return;
   }
 
-  impl->cdcHandle = candidate;
+  port->cdcHandle = candidate;
+  port->reconnect.noteOpened(fastPath);
+  if (!fastPath &&
+      cdc_acm_host_device_ids_get(candidate, &profile.vid, &profile.pid) !=
+        ESP_OK) {
+    // Still usable; without IDs the next attach simply probes again.
+    profile.vid = CDC_HOST_ANY_VID;
+    profile.pid = CDC_HOST_ANY_PID;
+  }
   UsbCdcControlEvent opened;
   opened.type = UsbCdcControlType::OPEN_SUCCEEDED;
-  opened.session = impl->activeSession;
-  impl->lifecycle.apply(opened, nowMs);
-  drainLifecycleQueue(impl, nowMs);
-  closeOwnedHandle(impl, nowMs);
-  if (!configurationMayContinue(impl, candidate, configToken)) return;
+  opened.session = port->activeSession;
+  port->lifecycle.apply(opened, nowMs);
+  drainLifecycleQueue(port, nowMs);
+  closeOwnedHandle(port, nowMs);
+  if (!configurationMayContinue(port, candidate, configToken)) return;
 
   cdc_acm_line_coding_t lineCoding = {
     .dwDTERate = 9600,
@@ -899,95 +1141,133 @@ static void attemptOpenAndConfigure(UsbCdcTransport* self, uint64_t nowMs) {
     .bDataBits = 8,
   };
   esp_err_t lineResult = cdc_acm_host_line_coding_set(candidate, &lineCoding);
-  drainLifecycleQueue(impl, nowMs);
-  closeOwnedHandle(impl, nowMs);
-  if (!configurationMayContinue(impl, candidate, configToken)) return;
+  drainLifecycleQueue(port, nowMs);
+  closeOwnedHandle(port, nowMs);
+  if (!configurationMayContinue(port, candidate, configToken)) return;
   if (lineResult != ESP_OK) {
-    failConfiguration(impl, nowMs, lineResult);
+    failConfiguration(port, nowMs, lineResult);
     return;
   }
 
   esp_err_t controlResult =
     cdc_acm_host_set_control_line_state(candidate, true, true);
-  drainLifecycleQueue(impl, nowMs);
-  closeOwnedHandle(impl, nowMs);
-  if (!configurationMayContinue(impl, candidate, configToken)) return;
+  drainLifecycleQueue(port, nowMs);
+  closeOwnedHandle(port, nowMs);
+  if (!configurationMayContinue(port, candidate, configToken)) return;
   if (controlResult != ESP_OK) {
-    failConfiguration(impl, nowMs, controlResult);
+    failConfiguration(port, nowMs, controlResult);
     return;
   }
 
-  uint32_t epoch = impl->shared.producerEpoch();
+  uint32_t epoch = port->shared.producerEpoch();
   UsbCdcOrderedPublishResult startResult = enqueueOrdered(
-    impl, UsbCdcOrderedType::STREAM_RESET, impl->activeSession, epoch, 0, true);
-  if (!configurationMayContinue(impl, candidate, configToken)) {
-    drainLifecycleQueue(impl, nowMs);
-    closeOwnedHandle(impl, nowMs);
+    port, UsbCdcOrderedType::STREAM_RESET, port->activeSession, epoch, 0, true);
+  if (!configurationMayContinue(port, candidate, configToken)) {
+    drainLifecycleQueue(port, nowMs);
+    closeOwnedHandle(port, nowMs);
     return;
   }
-  bool committed = impl->shared.commitConfiguration(configToken, startResult);
+  bool committed = port->shared.commitConfiguration(configToken, startResult);
   if (!committed) {
-    impl->currentDetail = "CDC configuration superseded by terminal event";
-    drainLifecycleQueue(impl, nowMs);
-    closeOwnedHandle(impl, nowMs);
+    port->setDetail("CDC configuration superseded by terminal event");
+    drainLifecycleQueue(port, nowMs);
+    closeOwnedHandle(port, nowMs);
     return;
   }
 
   UsbCdcControlEvent configured;
   configured.type = UsbCdcControlType::CONFIG_SUCCEEDED;
-  configured.session = impl->activeSession;
-  impl->lifecycle.apply(configured, nowMs);
-  impl->currentDetail = "CDC device ready on interface ";
-  impl->currentDetail += openedInterface;
+  configured.session = port->activeSession;
+  port->lifecycle.apply(configured, nowMs);
+  if (port->lifecycle.connected()) {
+    port->reconnect.noteReady(profile, static_cast<uint32_t>(millis()));
+  }
+  port->setDetail(fastPath ? "CDC device ready (cached profile) on interface "
+                           : "CDC device ready on interface ",
+                  profile.interfaceIndex);
 }
 #endif
 
-void UsbCdcTransport::poll() {
-#if !SOC_USB_OTG_SUPPORTED
-  return;
-#else
-  if (!impl->beginCalled) return;
-  reapRetiredCallbackContexts(impl);
-  uint64_t nowMs = impl->monotonicMillis();
-  drainLifecycleQueue(impl, nowMs);
-  closeOwnedHandle(impl, nowMs);
+#if SOC_USB_OTG_SUPPORTED
+// Owner task. Detail text shows whole seconds at high water, so a change in
+// that second (or in any counter) is what marks the detail dirty.
+static void sampleRxOccupancy(UsbCdcPort* port, uint64_t nowMs) {
+  const uint32_t occupancy = static_cast<uint32_t>(
+    port->rxChunkRemaining() + xStreamBufferBytesAvailable(port->rxStream));
+  port->rxOccupancy.sampleOwner(occupancy, static_cast<uint32_t>(nowMs));
+  const UsbCdcRxTelemetry next = port->rxOccupancy.snapshot();
+  UsbCdcRxTelemetry& reported = port->reportedRxTelemetry;
+  bool changed = next.highWatermarkBytes != reported.highWatermarkBytes ||
+                 next.timeAtHighWaterMs / 1000U !=
+                   reported.timeAtHighWaterMs / 1000U;
+  for (size_t i = 0; i < kUsbCdcRxLevelCount; ++i) {
+    changed = changed || next.overflowByLevel[i] != reported.overflowByLevel[i];
+  }
+  if (!changed) return;
+  reported = next;
+  port->detailChanged = true;
+}
+#endif
+
+#if SOC_USB_OTG_SUPPORTED
+static void pollPort(UsbCdcPort* port, uint64_t nowMs) {
+  drainLifecycleQueue(port, nowMs);
+  closeOwnedHandle(port, nowMs);
 
   UsbCdcControlEvent tick;
   tick.type = UsbCdcControlType::RETRY_TICK;
-  impl->lifecycle.apply(tick, nowMs);
-  attemptOpenAndConfigure(this, nowMs);
-  drainLifecycleQueue(impl, nowMs);
-  closeOwnedHandle(impl, nowMs);
+  port->lifecycle.apply(tick, nowMs);
+  attemptOpenAndConfigure(port, nowMs);
+  drainLifecycleQueue(port, nowMs);
+  closeOwnedHandle(port, nowMs);
 
-  switch (impl->lifecycle.phase()) {
+  switch (port->lifecycle.phase()) {
     case UsbCdcPhase::READY:
-      impl->currentState = xStreamBufferBytesAvailable(impl->rxStream) > 0
+      port->currentState = port->bufferedBytes() > 0
         ? TRANSPORT_STATE_RECEIVING : TRANSPORT_STATE_READY;
       break;
     case UsbCdcPhase::WAITING_DEVICE:
     case UsbCdcPhase::RETRY_WAIT:
     case UsbCdcPhase::OPENING:
     case UsbCdcPhase::CONFIGURING:
-      impl->currentState = TRANSPORT_STATE_WAITING_DEVICE;
+      port->currentState = TRANSPORT_STATE_WAITING_DEVICE;
       break;
     case UsbCdcPhase::ERROR:
-      impl->currentState = TRANSPORT_STATE_ERROR;
+      port->currentState = TRANSPORT_STATE_ERROR;
       break;
     default:
-      impl->currentState = TRANSPORT_STATE_STARTING;
+      port->currentState = TRANSPORT_STATE_STARTING;
       break;
   }
-  impl->currentDiagnostics = impl->shared.diagnosticsSnapshot();
-  impl->currentReconnectCount = impl->lifecycle.reconnectCount();
+  port->currentDiagnostics = port->shared.diagnosticsSnapshot();
+  port->currentReconnectCount = port->lifecycle.reconnectCount();
+  sampleRxOccupancy(port, nowMs);
+}
+#endif
+
+void UsbCdcTransport::poll() {
+#if !SOC_USB_OTG_SUPPORTED
+  return;
+#else
+  if (!impl->beginCalled) return;
+  reapRetiredCallbackContexts(impl);
+  uint64_t nowMs = impl->monotonicMillis();
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    pollPort(&impl->ports[index], nowMs);
+  }
 #endif
 }
 
 int UsbCdcTransport::available() {
-  if (impl == nullptr || impl->rxStream == nullptr) return 0;
-  size_t count = xStreamBufferBytesAvailable(impl->rxStream);
+  if (impl == nullptr) return 0;
+  size_t count = 0;
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    const UsbCdcPort& port = impl->ports[index];
+    count += port.bufferedBytes();
 #if SOC_USB_OTG_SUPPORTED
-  count += impl->shared.pendingCount();
+    if (port.rxStream != nullptr) count += port.shared.pendingCount();
 #endif
+  }
   return count > static_cast<size_t>(INT_MAX) ? INT_MAX
                                                : static_cast<int>(count);
 }
@@ -998,20 +1278,40 @@ int UsbCdcTransport::read() {
   return event.byte;
 }
 
-bool UsbCdcTransport::nextRxEvent(MonitorRxEvent& output) {
-#if !SOC_USB_OTG_SUPPORTED
-  (void)output;
-  return false;
-#else
-  if (impl == nullptr || impl->rxStream == nullptr) return false;
-  Impl* activeImpl = impl;
+#if SOC_USB_OTG_SUPPORTED
+// Chunk bytes were already counted by the cursor when received, and no
+// control can be due before the chunk drains, so the cursor epoch applies.
+static bool takeRxChunkByte(UsbCdcPort* port,
+                            MonitorRxEvent& output) {
+  if (port->rxChunkRemaining() == 0) return false;
+  uint8_t& slot = port->rxChunk[port->rxChunkOffset++];
+  output.type = MonitorRxEventType::BYTE;
+  output.byte = slot;
+  output.device = port->index;
+  output.epoch = port->cursor.epoch();
+  slot = 0;
+  if (port->rxChunkRemaining() == 0) {
+    port->rxChunkOffset = 0;
+    port->rxChunkLength = 0;
+  }
+  return true;
+}
+#endif
+
+#if SOC_USB_OTG_SUPPORTED
+static bool nextPortRxEvent(UsbCdcPort* port, MonitorRxEvent& output) {
+  if (port->rxStream == nullptr) return false;
+  if (takeRxChunkByte(port, output)) return true;
 
   for (size_t attempt = 0; attempt < kOrderedChannelDepth + 2; ++attempt) {
+    // Load before the claim; see usbCdcBulkReceiveLimit().
+    const uint32_t acceptedSnapshot =
+      port->acceptedByteSequence.load(std::memory_order_acquire);
     UsbCdcOrderedDelivery delivery;
     UsbCdcOrderedClaimResult claim =
-      activeImpl->shared.claim(activeImpl->cursor, delivery,
-        activeImpl->lifecycle.connected(), [activeImpl]() {
-          activeImpl->overflowMarkerPublished.store(
+      port->shared.claim(port->cursor, delivery,
+        port->lifecycle.connected(), [port]() {
+          port->overflowMarkerPublished.store(
             false, std::memory_order_release);
         });
 
@@ -1021,83 +1321,280 @@ bool UsbCdcTransport::nextRxEvent(MonitorRxEvent& output) {
         overflow.type = UsbCdcControlType::RX_OVERFLOW;
         overflow.count = delivery.event.droppedBytes;
         overflow.session = delivery.event.session;
-        activeImpl->lifecycle.apply(overflow, 0);
+        port->lifecycle.apply(overflow, 0);
       }
       if (delivery.producerResumed) {
         UsbCdcControlEvent recovered;
         recovered.type = UsbCdcControlType::RX_CAPACITY_RECOVERED;
         recovered.session = delivery.event.session;
-        activeImpl->lifecycle.apply(recovered, 0);
+        port->lifecycle.apply(recovered, 0);
       }
-      impl->cursor.applyControl(delivery.event);
+      port->cursor.applyControl(delivery.event);
       output.type = delivery.event.type == UsbCdcOrderedType::STREAM_RESET
         ? MonitorRxEventType::STREAM_RESET
         : MonitorRxEventType::DISCONTINUITY;
       output.byte = 0;
+      output.device = port->index;
       output.epoch = delivery.event.epoch;
       return true;
     }
     if (claim == UsbCdcOrderedClaimResult::STALE_QUEUE_DISCARDED) continue;
     if (claim == UsbCdcOrderedClaimResult::STALE_FALLBACK_DISCARDED) {
-      uint64_t nowMs = impl->monotonicMillis();
+      uint64_t nowMs = port->host->monotonicMillis();
       UsbCdcControlEvent failure;
       failure.type = UsbCdcControlType::CONTROL_QUEUE_OVERFLOW;
       failure.code = ESP_ERR_INVALID_STATE;
-      failure.session = impl->activeSession;
-      if (applyTerminalEventOrDefer(impl, failure, nowMs)) {
-        closeOwnedHandle(impl, nowMs);
+      failure.session = port->activeSession;
+      if (applyTerminalEventOrDefer(port, failure, nowMs)) {
+        closeOwnedHandle(port, nowMs);
       }
       continue;
     }
 
-    uint8_t value = 0;
-    if (xStreamBufferReceive(impl->rxStream, &value, 1, 0) == 1) {
-      output.type = MonitorRxEventType::BYTE;
-      output.byte = value;
-      output.epoch = impl->cursor.epoch();
-      impl->cursor.noteByteDelivered();
-      value = 0;
-      impl->currentState = TRANSPORT_STATE_RECEIVING;
-      return true;
+    const size_t limit = usbCdcBulkReceiveLimit(
+      port->cursor, acceptedSnapshot, delivery, sizeof(port->rxChunk));
+    if (limit == 0) return false;
+    const size_t received =
+      xStreamBufferReceive(port->rxStream, port->rxChunk, limit, 0);
+    if (received == 0) return false;
+    port->cursor.noteBytesDelivered(static_cast<uint32_t>(received));
+    port->drainedByteSequence.store(port->cursor.deliveredByteSequence(),
+                                    std::memory_order_release);
+    port->rxChunkOffset = 0;
+    port->rxChunkLength = received;
+    port->currentState = TRANSPORT_STATE_RECEIVING;
+    return takeRxChunkByte(port, output);
+  }
+  return false;
+}
+#endif
+
+// A port keeps the consumer until its current chunk drains, then the next
+// port is tried, so one busy monitor cannot starve the others.
+bool UsbCdcTransport::nextRxEvent(MonitorRxEvent& output) {
+#if !SOC_USB_OTG_SUPPORTED
+  (void)output;
+  return false;
+#else
+  if (impl == nullptr) return false;
+  for (uint8_t attempt = 0; attempt < impl->portCount; ++attempt) {
+    UsbCdcPort* port = &impl->ports[impl->nextRxPort];
+    const bool delivered = nextPortRxEvent(port, output);
+    if (!delivered || port->rxChunkRemaining() == 0) {
+      impl->nextRxPort = static_cast<uint8_t>(
+        (impl->nextRxPort + 1U) % impl->portCount);
     }
-    return false;
+    if (delivered) return true;
   }
   return false;
 #endif
 }
 
+// Every byte and lifecycle fact is produced by the CDC driver or the daemon,
+// so with a callback installed the owner only needs to wake for retry
+// timers. Refused after begin(): the producers read it unsynchronized.
+bool UsbCdcTransport::setWakeCallback(MonitorWakeCallback callback,
+                                      void* context) {
+#if !SOC_USB_OTG_SUPPORTED
+  (void)callback;
+  (void)context;
+  return false;
+#else
+  if (impl == nullptr || impl->beginCalled) return false;
+  impl->wakeCallback = callback;
+  impl->wakeContext = context;
+  return callback != nullptr;
+#endif
+}
+
 const char* UsbCdcTransport::name() const { return "USB OTG Host"; }
 
+// The most capable port speaks for the transport; per-device state is in
+// deviceSummary() and detail().
+static uint8_t stateRank(MonitorTransportState state) {
+  switch (state) {
+    case TRANSPORT_STATE_RECEIVING:      return 5;
+    case TRANSPORT_STATE_READY:          return 4;
+    case TRANSPORT_STATE_WAITING_DEVICE: return 3;
+    case TRANSPORT_STATE_STARTING:       return 2;
+    case TRANSPORT_STATE_UNSUPPORTED:    return 1;
+    default:                             return 0;
+  }
+}
+
 MonitorTransportState UsbCdcTransport::state() const {
-  return impl == nullptr ? TRANSPORT_STATE_ERROR : impl->currentState;
+  if (impl == nullptr) return TRANSPORT_STATE_ERROR;
+  MonitorTransportState result = impl->ports[0].currentState;
+  for (uint8_t index = 1; index < impl->portCount; ++index) {
+    const MonitorTransportState candidate = impl->ports[index].currentState;
+    if (stateRank(candidate) > stateRank(result)) result = candidate;
+  }
+  return result;
 }
 
-String UsbCdcTransport::detail() const {
-  if (impl == nullptr) return String("USB transport unavailable");
-  String result = impl->currentDetail;
+static void appendPortDetail(String& result, const UsbCdcPort& port) {
+  result += port.currentDetail;
   result += " | loss_events=";
-  result += impl->currentDiagnostics.lossEpisodes;
+  result += port.currentDiagnostics.lossEpisodes;
   result += " dropped_bytes=";
-  result += impl->currentDiagnostics.droppedBytes;
+  result += port.currentDiagnostics.droppedBytes;
   result += " overflow_events=";
-  result += impl->currentDiagnostics.overflowEpisodes;
+  result += port.currentDiagnostics.overflowEpisodes;
   result += " reconnects=";
-  result += impl->currentReconnectCount;
+  result += port.currentReconnectCount;
+  const UsbCdcRxTelemetry& rx = port.reportedRxTelemetry;
+  result += " rx_buffer=";
+  result += rx.capacityBytes;
+  result += rx.psram ? "/psram" : "/internal";
+  result += " rx_high_water=";
+  result += rx.highWatermarkBytes;
+  result += " rx_high_water_s=";
+  result += rx.timeAtHighWaterMs / 1000U;
+  result += " overflow_by_level=";
+  for (size_t i = 0; i < kUsbCdcRxLevelCount; ++i) {
+    if (i > 0) result += '/';
+    result += rx.overflowByLevel[i];
+  }
+  const UsbCdcReconnectTelemetry& reconnect = port.reconnect.telemetry();
+  result += " fast_reopens=";
+  result += reconnect.fastPathOpens;
+  result += " ready_ms_hist=";
+  for (size_t i = 0; i < kUsbCdcReadyBucketCount; ++i) {
+    if (i > 0) result += '/';
+    result += reconnect.readyByBucket[i];
+  }
+  result += " ready_ms_last=";
+  result += reconnect.lastReadyMs;
+  result += " ready_ms_max=";
+  result += reconnect.maxReadyMs;
+}
+
+String UsbCdcTransport::detail() const {
+  if (impl == nullptr) return String("USB transport unavailable");
+  String result;
+  if (impl->portCount == 1) {
+    appendPortDetail(result, impl->ports[0]);
+    return result;
+  }
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    if (index > 0) result += " || ";
+    result += "dev";
+    result += index;
+    result += ": ";
+    appendPortDetail(result, impl->ports[index]);
+  }
   return result;
 }
 
+// Owner task only: compares POD fields and formats nothing, so the ingest
+// loop can poll it every tick and call detail() only on a version change.
+MonitorTransportStatus UsbCdcTransport::status() const {
+  MonitorTransportStatus next;
+  if (impl == nullptr) {
+    next.state = TRANSPORT_STATE_ERROR;
+    return next;
+  }
+  next.state = state();
+  bool changed = false;
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    UsbCdcPort& port = impl->ports[index];
+    const MonitorDeviceSummary device = port.summary();
+    next.dataLossCount = saturatingAdd(next.dataLossCount,
+                                       device.dataLossCount);
+    next.reconnectCount = saturatingAdd(next.reconnectCount,
+                                        device.reconnectCount);
+    next.droppedBytes = saturatingAdd(next.droppedBytes, device.droppedBytes);
+    next.overflowEpisodes = saturatingAdd(
+      next.overflowEpisodes, port.currentDiagnostics.overflowEpisodes);
+    changed = changed || port.detailChanged ||
+              device != impl->publishedDevices[index];
+    impl->publishedDevices[index] = device;
+    port.detailChanged = false;
+  }
+  advanceMonitorTransportStatus(impl->publishedStatus, next, changed);
+  return impl->publishedStatus;
+}
+
 uint32_t UsbCdcTransport::dataLossCount() const {
-  return impl == nullptr ? 0 : impl->currentDiagnostics.lossEpisodes;
+  uint32_t total = 0;
+  for (uint8_t index = 0; impl != nullptr && index < impl->portCount; ++index) {
+    total = saturatingAdd(total,
+                          impl->ports[index].currentDiagnostics.lossEpisodes);
+  }
+  return total;
 }
 
 uint32_t UsbCdcTransport::reconnectCount() const {
-  return impl == nullptr ? 0 : impl->currentReconnectCount;
+  uint32_t total = 0;
+  for (uint8_t index = 0; impl != nullptr && index < impl->portCount; ++index) {
+    total = saturatingAdd(total, impl->ports[index].currentReconnectCount);
+  }
+  return total;
+}
+
+// Most recent accept across ports, compared by age so micros() wrap is safe.
+bool UsbCdcTransport::lastRxAcceptedUs(uint32_t& acceptedUs) const {
+  if (impl == nullptr) return false;
+  const uint32_t nowUs = static_cast<uint32_t>(micros());
+  bool found = false;
+  for (uint8_t index = 0; index < impl->portCount; ++index) {
+    uint32_t candidate = 0;
+    if (!deviceRxAcceptedUs(index, candidate)) continue;
+    if (!found || nowUs - candidate < nowUs - acceptedUs) {
+      acceptedUs = candidate;
+      found = true;
+    }
+  }
+  return found;
+}
+
+uint8_t UsbCdcTransport::deviceCount() const {
+  return impl == nullptr ? 1 : impl->portCount;
+}
+
+MonitorDeviceSummary UsbCdcTransport::deviceSummary(uint8_t device) const {
+  if (impl == nullptr || device >= impl->portCount) {
+    return MonitorDeviceSummary{};
+  }
+  return impl->ports[device].summary();
+}
+
+bool UsbCdcTransport::deviceRxAcceptedUs(uint8_t device,
+                                         uint32_t& acceptedUs) const {
+  if (impl == nullptr || device >= impl->portCount) return false;
+  const UsbCdcPort& port = impl->ports[device];
+  if (!port.rxAcceptedEver.load(std::memory_order_acquire)) return false;
+  acceptedUs = port.lastRxAcceptedUs.load(std::memory_order_relaxed);
+  return true;
 }
 
 uint32_t UsbCdcTransport::droppedByteCount() const {
-  return impl == nullptr ? 0 : impl->currentDiagnostics.droppedBytes;
+  uint32_t total = 0;
+  for (uint8_t index = 0; impl != nullptr && index < impl->portCount; ++index) {
+    total = saturatingAdd(total,
+                          impl->ports[index].currentDiagnostics.droppedBytes);
+  }
+  return total;
+}
+
+UsbCdcRxTelemetry UsbCdcTransport::rxTelemetry(uint8_t device) const {
+  if (impl == nullptr || device >= impl->portCount) return UsbCdcRxTelemetry{};
+  return impl->ports[device].rxOccupancy.snapshot();
+}
+
+UsbCdcReconnectTelemetry UsbCdcTransport::reconnectTelemetry(
+    uint8_t device) const {
+  if (impl == nullptr || device >= impl->portCount) {
+    return UsbCdcReconnectTelemetry{};
+  }
+  return impl->ports[device].reconnect.telemetry();
 }
 
 uint32_t UsbCdcTransport::overflowEpisodeCount() const {
-  return impl == nullptr ? 0 : impl->currentDiagnostics.overflowEpisodes;
+  uint32_t total = 0;
+  for (uint8_t index = 0; impl != nullptr && index < impl->portCount; ++index) {
+    total = saturatingAdd(
+      total, impl->ports[index].currentDiagnostics.overflowEpisodes);
+  }
+  return total;
 }
@@ -8,11 +8,13 @@
 #ifndef HOST_ARDUINO_SHIM_H
 #define HOST_ARDUINO_SHIM_H
 
+#include <atomic>
 #include <cctype>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <mutex>
 #include <string>
 
 // ---- 可注入的 String allocation failure ----
@@ -34,8 +36,9 @@ inline bool __stringAllocationAllowed() {
 }
 
 // ---- fake clock：millis()/delay() 不真的睡，測試可用 delay() 快轉 ----
-inline unsigned long& __millisCounter() {
-  static unsigned long v = 0;
+// atomic：USB transport 模擬中 callback thread 會讀 micros()。
+inline std::atomic<unsigned long>& __millisCounter() {
+  static std::atomic<unsigned long> v{0};
   return v;
 }
 inline unsigned long& __delayCallCount() {
@@ -43,6 +46,7 @@ inline unsigned long& __delayCallCount() {
   return v;
 }
 inline unsigned long millis() { return __millisCounter(); }
+inline unsigned long micros() { return __millisCounter() * 1000UL; }
 inline void delay(unsigned long ms) {
   __delayCallCount()++;
   __millisCounter() += ms;
@@ -77,23 +81,48 @@ inline unsigned long& __sensitiveByteClearCount() {
   static unsigned long value = 0;
   return value;
 }
+// 與 HardwareSerial 一樣可由多個 task 同時呼叫；ingest stress 在 TSan 下會驗證。
+inline std::mutex& __serialMutex() {
+  static std::mutex value;
+  return value;
+}
 class HostSerial {
 public:
   void begin(unsigned long) {}
-  void print(char value) { __serialOutput().push_back(value); }
+  void print(char value) { append(std::string(1, value)); }
   void print(const char* value) {
-    if (value) __serialOutput().append(value);
+    if (value) append(value);
   }
-  void print(int value) { __serialOutput().append(std::to_string(value)); }
-  void print(unsigned int value) { __serialOutput().append(std::to_string(value)); }
-  void print(long value) { __serialOutput().append(std::to_string(value)); }
-  void print(unsigned long value) { __serialOutput().append(std::to_string(value)); }
+  void print(int value) { append(std::to_string(value)); }
+  void print(unsigned int value) { append(std::to_string(value)); }
+  void print(long value) { append(std::to_string(value)); }
+  void print(unsigned long value) { append(std::to_string(value)); }
   template <typename T> void print(const T&) {}
   template <typename T> void println(const T& value) {
-    print(value);
+    std::lock_guard<std::mutex> lock(__serialMutex());
+    printUnlocked(value);
     __serialOutput().push_back('\n');
   }
-  void println() { __serialOutput().push_back('\n'); }
+  void println() { append("\n"); }
+
+private:
+  static void append(const std::string& value) {
+    std::lock_guard<std::mutex> lock(__serialMutex());
+    __serialOutput().append(value);
+  }
+  static void printUnlocked(char value) { __serialOutput().push_back(value); }
+  static void printUnlocked(const char* value) {
+    if (value) __serialOutput().append(value);
+  }
+  static void printUnlocked(int value) { __serialOutput().append(std::to_string(value)); }
+  static void printUnlocked(unsigned int value) {
+    __serialOutput().append(std::to_string(value));
+  }
+  static void printUnlocked(long value) { __serialOutput().append(std::to_string(value)); }
+  static void printUnlocked(unsigned long value) {
+    __serialOutput().append(std::to_string(value));
+  }
+  template <typename T> static void printUnlocked(const T&) {}
 };
 inline HostSerial Serial;
 
@@ -165,6 +194,9 @@ public:
   String& operator+=(const char* p) { _s.append(p); return *this; }
   String& operator+=(const String& o) { _s.append(o._s); return *this; }
   String& operator+=(int v) { _s.append(std::to_string(v)); return *this; }
+  String& operator+=(unsigned int v) { _s.append(std::to_string(v)); return *this; }
+  String& operator+=(long v) { _s.append(std::to_string(v)); return *this; }
+  String& operator+=(unsigned long v) { _s.append(std::to_string(v)); return *this; }
 
   bool operator==(const char* p) const { return _s == p; }
   bool operator==(const String& o) const { return _s == o._s; }
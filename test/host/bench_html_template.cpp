@@ -0,0 +1,270 @@
+// Time and heap allocations to render a full /history page, built the old
+// way (String concatenation, then copied into the response window) and the
+// new way (a precompiled HtmlTemplateCursor table plus rows written straight
+// into the window with BoundedHtmlWriter). Both paths run the same row
+// helper template, shaped like WebHandler::appendHistoryTableRow, over a
+// full 20-record ring; the output must be byte-identical.
+//
+// Allocations are counted by replacing the global operator new; the host
+// String is std::string-backed, so its growth shows up there just as heap
+// churn does on the device.
+//
+// With no arguments this is a short smoke pass for
+// scripts/run_concurrency_stress.sh; scripts/run_html_benchmark.sh runs
+// `--report` and prints "bench <name> <value>" lines.
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "lib/HtmlTemplate.h"
+
+namespace {
+
+size_t allocationCount = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  ++allocationCount;
+  void* block = std::malloc(size == 0 ? 1 : size);
+  if (block == nullptr) throw std::bad_alloc();
+  return block;
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+
+namespace {
+
+using bp_html::BoundedHtmlWriter;
+using bp_html::HtmlSegment;
+using bp_html::HtmlTemplateCursor;
+using bp_html::RenderProgress;
+
+// Same size as BoundedHttpResponse::kStreamWindow on the device.
+constexpr size_t kWindow = 16384 - 6 - 2 - 5;
+constexpr size_t kRecords = 20;
+
+struct Record {
+  uint64_t recordSequence;
+  uint64_t sessionSequence;
+  char timestamp[20];
+  int32_t systolic;
+  int32_t diastolic;
+  int32_t pulse;
+  uint8_t movementCount;
+};
+
+Record records[kRecords];
+
+void fillRecords() {
+  for (size_t i = 0; i < kRecords; ++i) {
+    Record& record = records[i];
+    record.recordSequence = 1000 + i;
+    record.sessionSequence = 7;
+    std::snprintf(record.timestamp, sizeof(record.timestamp),
+                  "2026-07-11 09:%02u:00", static_cast<unsigned>(i));
+    record.systolic = 118 + static_cast<int32_t>(i);
+    record.diastolic = 76 + static_cast<int32_t>(i % 7);
+    record.pulse = 64 + static_cast<int32_t>(i % 11);
+    record.movementCount = i % 5 == 0 ? 1 : 0;
+  }
+}
+
+template <typename Out>
+void appendValueCell(Out& html, int32_t value) {
+  html += "<td class='num'>";
+  html += value;
+  html += "</td>";
+}
+
+template <typename Out>
+void appendRow(Out& html, const Record& record) {
+  html += "<tr><td>";
+  html += record.recordSequence;
+  html += "</td><td>";
+  html += record.sessionSequence;
+  html += "</td><td>";
+  html += record.timestamp;
+  html += "</td><td>device</td>";
+  appendValueCell(html, record.systolic);
+  appendValueCell(html, record.diastolic);
+  appendValueCell(html, record.pulse);
+  html += "<td>ok";
+  html += record.movementCount > 0 ? "（偵測到移動）" : "（未偵測到移動）";
+  html += "</td><td>無需複核</td></tr>";
+}
+
+template <typename Out>
+void appendPageStart(Out& html) {
+  html += "<!DOCTYPE html><html lang='zh-Hant'><head><meta charset='UTF-8'>";
+  html += "<title>";
+  bp_html::appendHtmlEscaped(html, "血壓歷史記錄");
+  html += "</title><link rel='stylesheet' href='/static/style.css'></head>";
+  html += "<body><nav><a href='/'>監控</a><a href='/history' "
+          "aria-current='page'>歷史</a></nav><main>";
+}
+
+constexpr char kTableHead[] =
+  "<section class='panel history-table'><div class='table-scroll'><table>"
+  "<caption>已保存的不識別量測歷史</caption><thead><tr>"
+  "<th scope='col'>記錄序號</th><th scope='col'>工作階段序號</th>"
+  "<th scope='col'>測量時間</th><th scope='col'>時間來源</th>"
+  "<th scope='col'>收縮壓 (mmHg)</th><th scope='col'>舒張壓 (mmHg)</th>"
+  "<th scope='col'>脈搏 (bpm)</th><th scope='col'>品質</th>"
+  "<th scope='col'>複核提示</th></tr></thead><tbody>";
+constexpr char kTableTail[] = "</tbody></table></div></section>";
+constexpr char kPageEnd[] = "</main></body></html>";
+
+constexpr uint8_t kPageStartSlot = 0;
+
+constexpr HtmlSegment kHead[] = {
+  bp_html::htmlSlot(kPageStartSlot),
+  bp_html::htmlLiteral(kTableHead),
+};
+
+constexpr HtmlSegment kTail[] = {
+  bp_html::htmlLiteral(kTableTail),
+  bp_html::htmlLiteral(kPageEnd),
+};
+
+void renderSlot(void*, uint8_t slot, BoundedHtmlWriter& html) {
+  if (slot == kPageStartSlot) appendPageStart(html);
+}
+
+// Old path: build the page in a String, then copy it out window by window.
+size_t renderWithString(char* window, std::string* sink) {
+  String html;
+  appendPageStart(html);
+  html += kTableHead;
+  for (const Record& record : records) appendRow(html, record);
+  html += kTableTail;
+  html += kPageEnd;
+  size_t offset = 0;
+  while (offset < html.length()) {
+    const size_t count = html.length() - offset < kWindow
+      ? html.length() - offset : kWindow;
+    std::memcpy(window, html.c_str() + offset, count);
+    if (sink != nullptr) sink->append(window, count);
+    offset += count;
+  }
+  return offset;
+}
+
+// New path: the same shape as WebHandler::fillHistoryPageWindow.
+size_t renderWithTemplate(char* window, std::string* sink) {
+  HtmlTemplateCursor page;
+  page.begin(kHead);
+  size_t next = 0;
+  bool rowsDone = false;
+  size_t total = 0;
+  while (true) {
+    size_t written = 0;
+    bool finished = false;
+    while (true) {
+      if (!page.done()) {
+        const RenderProgress progress =
+          page.render(window, kWindow, written, renderSlot, nullptr);
+        if (progress == RenderProgress::FAILED) {
+          std::fprintf(stderr, "html benchmark: slot does not fit\n");
+          std::exit(1);
+        }
+        if (progress == RenderProgress::FULL) break;
+        if (rowsDone) {
+          finished = true;
+          break;
+        }
+      }
+      if (next == kRecords) {
+        rowsDone = true;
+        page.begin(kTail);
+        continue;
+      }
+      BoundedHtmlWriter html(window + written, kWindow - written);
+      appendRow(html, records[next]);
+      if (html.overflowed()) break;
+      written += html.length();
+      ++next;
+    }
+    if (sink != nullptr) sink->append(window, written);
+    total += written;
+    if (finished) return total;
+  }
+}
+
+struct Result {
+  double nsPerPage;
+  double allocationsPerPage;
+};
+
+template <typename Render>
+Result measure(Render render, char* window, size_t pages) {
+  size_t bytes = 0;
+  const size_t allocationsBefore = allocationCount;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < pages; ++i) bytes += render(window, nullptr);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const size_t allocations = allocationCount - allocationsBefore;
+  if (bytes == 0) std::exit(1);
+  const double ns = static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  return {ns / static_cast<double>(pages),
+          static_cast<double>(allocations) / static_cast<double>(pages)};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool report = false;
+  size_t pages = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--report") == 0) {
+      report = true;
+    } else if (std::strcmp(argv[i], "--pages") == 0 && i + 1 < argc) {
+      pages = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "usage: %s [--report] [--pages N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (pages == 0) pages = report ? 20000 : 200;
+
+  fillRecords();
+  static char window[kWindow];
+  std::string legacy;
+  std::string streamed;
+  renderWithString(window, &legacy);
+  renderWithTemplate(window, &streamed);
+  if (legacy != streamed) {
+    std::fprintf(stderr, "html benchmark: template output differs\n");
+    return 1;
+  }
+
+  const Result string = measure(renderWithString, window, pages);
+  const Result templated = measure(renderWithTemplate, window, pages);
+  if (templated.allocationsPerPage != 0) {
+    std::fprintf(stderr, "html benchmark: template path allocated\n");
+    return 1;
+  }
+
+  if (report) {
+    std::printf("bench html_page_ns/string %.0f\n", string.nsPerPage);
+    std::printf("bench html_page_ns/template %.0f\n", templated.nsPerPage);
+    std::printf("bench html_page_allocs/string %.1f\n",
+                string.allocationsPerPage);
+    std::printf("bench html_page_allocs/template %.1f\n",
+                templated.allocationsPerPage);
+    return 0;
+  }
+  std::printf("HTML template benchmark smoke pass: %zu pages of %zu bytes, "
+              "identical output, no template allocations.\n",
+              pages, streamed.size());
+  return 0;
+}
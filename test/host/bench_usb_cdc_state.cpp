@@ -0,0 +1,399 @@
+// ns/op micro-benchmarks for UsbCdcSynchronizedState, using the exact
+// instantiation every UsbCdcPort holds (decltype(UsbCdcPort::shared)). On the
+// host its critical section is the std::mutex portMUX shim, so the numbers
+// rank changes against each other; they are not ESP32 cycle counts.
+//
+// Uncontended runs time one thread. Contended runs pair each producer (the
+// CDC driver task) with a consumer polling like pollPort()/nextRxEvent():
+// diagnosticsSnapshot() plus claim(). Pairs get separate states, as ports do,
+// and 1, 2 and 4 pairs run at once.
+//
+// With no arguments this is a short smoke pass for
+// scripts/run_concurrency_stress.sh (including the ThreadSanitizer build).
+// scripts/run_usb_cdc_benchmark.sh runs `--report` and compares the
+// "bench <name> <ns>" lines against a stored baseline.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fake_cdc_acm_host.h"
+#include "src/transports/UsbCdcTransport.cpp"
+
+namespace {
+
+using PortState = decltype(UsbCdcPort::shared);
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t kSession = 1;
+constexpr uint32_t kTransferBytes = 64;
+
+// A configured session with one callback context, as after
+// attemptOpenAndConfigure() commits.
+struct Fixture {
+  Fixture() {
+    state.startSession(kSession);
+    slot = static_cast<size_t>(state.acquireContext(kSession));
+    state.commitConfiguration(state.configurationToken(),
+                              UsbCdcOrderedPublishResult::QUEUED);
+    cursor.beginSession(kSession, 0, 0);
+  }
+
+  PortState state;
+  size_t slot = 0;
+  UsbCdcOrderedCursor cursor;
+};
+
+UsbCdcOrderedEvent marker(uint32_t epoch) {
+  UsbCdcOrderedEvent event;
+  event.type = UsbCdcOrderedType::DISCONTINUITY;
+  event.session = kSession;
+  event.epoch = epoch;
+  event.byteBoundary = 0;
+  return event;
+}
+
+double nsPerOp(Clock::duration elapsed, uint64_t ops) {
+  if (ops == 0) return 0;
+  return static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+    static_cast<double>(ops);
+}
+
+// Keeps a result observable so the optimizer cannot drop the loop.
+std::atomic<uint64_t> gSink{0};
+int gFailures = 0;
+
+void expect(bool condition, const char* what) {
+  if (condition) return;
+  gFailures++;
+  std::fprintf(stderr, "USB CDC state benchmark failed: %s\n", what);
+}
+
+// ---- Uncontended ----
+
+double benchAcquireCallback(uint64_t iterations) {
+  Fixture fixture;
+  uint64_t admitted = 0;
+  const Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    auto lease = fixture.state.acquireCallback(fixture.slot, kSession);
+    if (lease) admitted++;
+  }
+  const Clock::duration elapsed = Clock::now() - start;
+  expect(admitted == iterations, "acquireCallback admits a live session");
+  gSink.fetch_add(admitted, std::memory_order_relaxed);
+  return nsPerOp(elapsed, iterations);
+}
+
+// One callback lease is held, as in cdcDataCallback's fallback path; each
+// byte-commit lease is released before the next.
+double benchByteCommit(uint64_t iterations) {
+  Fixture fixture;
+  auto lease = fixture.state.acquireCallback(fixture.slot, kSession);
+  uint64_t admitted = 0;
+  const Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    UsbCdcByteAdmission admission = UsbCdcByteAdmission::REJECTED_INACTIVE;
+    auto commit = fixture.state.acquireByteCommitOrRecordDrop(
+      fixture.slot, kSession, 0, kTransferBytes, admission);
+    if (commit) admitted++;
+  }
+  const Clock::duration elapsed = Clock::now() - start;
+  expect(admitted == iterations,
+         "acquireByteCommitOrRecordDrop admits under a callback lease");
+  gSink.fetch_add(admitted, std::memory_order_relaxed);
+  return nsPerOp(elapsed, iterations);
+}
+
+double benchAdmittedByteCommit(uint64_t iterations) {
+  Fixture fixture;
+  uint64_t admitted = 0;
+  const Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    auto commit = fixture.state.acquireAdmittedByteCommit(fixture.slot,
+                                                          kSession);
+    if (commit) admitted++;
+  }
+  const Clock::duration elapsed = Clock::now() - start;
+  expect(admitted == iterations, "lock-free admission holds when steady");
+  gSink.fetch_add(admitted, std::memory_order_relaxed);
+  return nsPerOp(elapsed, iterations);
+}
+
+// Fills the ring (never the fallback) and drains it, timing each half.
+void benchPublishClaim(uint64_t iterations, double& publishNs,
+                       double& claimNs) {
+  Fixture fixture;
+  Clock::duration publishTime{};
+  Clock::duration claimTime{};
+  uint64_t published = 0;
+  uint64_t claimed = 0;
+  uint32_t epoch = 0;
+  while (published < iterations) {
+    const Clock::time_point publishStart = Clock::now();
+    for (size_t i = 0; i < kOrderedChannelDepth; ++i) {
+      if (fixture.state.publish(marker(++epoch), false) ==
+          UsbCdcOrderedPublishResult::QUEUED) {
+        published++;
+      }
+    }
+    const Clock::time_point claimStart = Clock::now();
+    for (size_t i = 0; i < kOrderedChannelDepth; ++i) {
+      UsbCdcOrderedDelivery delivery;
+      if (fixture.state.claim(fixture.cursor, delivery, true) ==
+          UsbCdcOrderedClaimResult::CLAIMED) {
+        claimed++;
+      }
+    }
+    const Clock::time_point end = Clock::now();
+    publishTime += claimStart - publishStart;
+    claimTime += end - claimStart;
+  }
+  expect(claimed == published, "every published marker is claimed");
+  publishNs = nsPerOp(publishTime, published);
+  claimNs = nsPerOp(claimTime, claimed);
+}
+
+double benchClaimEmpty(uint64_t iterations) {
+  Fixture fixture;
+  uint64_t none = 0;
+  const Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    UsbCdcOrderedDelivery delivery;
+    if (fixture.state.claim(fixture.cursor, delivery, true) ==
+        UsbCdcOrderedClaimResult::NONE) {
+      none++;
+    }
+  }
+  const Clock::duration elapsed = Clock::now() - start;
+  expect(none == iterations, "empty channel claims nothing");
+  gSink.fetch_add(none, std::memory_order_relaxed);
+  return nsPerOp(elapsed, iterations);
+}
+
+// ---- Contended ----
+
+enum class ProducerOp { ACQUIRE_CALLBACK, BYTE_COMMIT, PUBLISH };
+
+struct PairResult {
+  double producerNs = 0;
+  double consumerNs = 0;
+};
+
+// One producer/consumer pair on its own state. The consumer models an owner
+// pass: diagnosticsSnapshot(), then claim() until the channel is empty, and it
+// yields when idle the way the ingest task blocks. Only time spent inside the
+// state is counted, so the consumer's ns/op is per claim() call and a
+// producer waiting for ring space is not charged for the wait.
+PairResult runPair(ProducerOp op, uint64_t iterations,
+                   std::atomic<int>& ready, int participants) {
+  Fixture fixture;
+  std::atomic<bool> producerDone{false};
+  PairResult result;
+  uint64_t claimed = 0;
+  uint64_t published = 0;
+
+  auto waitForAll = [&ready, participants]() {
+    ready.fetch_add(1, std::memory_order_acq_rel);
+    while (ready.load(std::memory_order_acquire) < participants) {
+      std::this_thread::yield();
+    }
+  };
+
+  std::thread consumer([&]() {
+    waitForAll();
+    Clock::duration busy{};
+    uint64_t claims = 0;
+    while (true) {
+      const bool done = producerDone.load(std::memory_order_acquire);
+      const Clock::time_point start = Clock::now();
+      gSink.fetch_add(fixture.state.diagnosticsSnapshot().droppedBytes,
+                      std::memory_order_relaxed);
+      bool claimedAny = false;
+      while (true) {
+        UsbCdcOrderedDelivery delivery;
+        const UsbCdcOrderedClaimResult claim =
+          fixture.state.claim(fixture.cursor, delivery, true);
+        claims++;
+        if (claim != UsbCdcOrderedClaimResult::CLAIMED) break;
+        fixture.cursor.applyControl(delivery.event);
+        claimed++;
+        claimedAny = true;
+      }
+      busy += Clock::now() - start;
+      if (claimedAny) continue;
+      if (done) break;
+      std::this_thread::yield();
+    }
+    result.consumerNs = nsPerOp(busy, claims);
+  });
+
+  waitForAll();
+  uint64_t admitted = 0;
+  if (op == ProducerOp::PUBLISH) {
+    Clock::duration busy{};
+    uint32_t epoch = 0;
+    while (published < iterations) {
+      // Leave one slot free so a slow consumer never pushes the producer
+      // into the fallback, which would quarantine the session.
+      const size_t pending = fixture.state.pendingCount();
+      if (pending + 1 >= kOrderedChannelDepth) {
+        std::this_thread::yield();
+        continue;
+      }
+      const uint64_t batch = std::min<uint64_t>(
+        kOrderedChannelDepth - 1 - pending, iterations - published);
+      const Clock::time_point start = Clock::now();
+      for (uint64_t i = 0; i < batch; ++i) {
+        if (fixture.state.publish(marker(++epoch), false) ==
+            UsbCdcOrderedPublishResult::QUEUED) {
+          admitted++;
+        }
+        published++;
+      }
+      busy += Clock::now() - start;
+    }
+    result.producerNs = nsPerOp(busy, published);
+  } else {
+    auto lease = op == ProducerOp::BYTE_COMMIT
+      ? fixture.state.acquireCallback(fixture.slot, kSession)
+      : PortState::CallbackLease{};
+    const Clock::time_point start = Clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+      if (op == ProducerOp::ACQUIRE_CALLBACK) {
+        auto callback = fixture.state.acquireCallback(fixture.slot, kSession);
+        if (callback) admitted++;
+      } else {
+        UsbCdcByteAdmission admission = UsbCdcByteAdmission::REJECTED_INACTIVE;
+        auto commit = fixture.state.acquireByteCommitOrRecordDrop(
+          fixture.slot, kSession, 0, kTransferBytes, admission);
+        if (commit) admitted++;
+      }
+    }
+    result.producerNs = nsPerOp(Clock::now() - start, iterations);
+  }
+  producerDone.store(true, std::memory_order_release);
+  consumer.join();
+  expect(admitted == iterations, "contended producer is never refused");
+  expect(claimed == published, "contended consumer claims every marker");
+  return result;
+}
+
+PairResult runPairs(ProducerOp op, uint64_t iterations, int pairs) {
+  std::vector<PairResult> results(static_cast<size_t>(pairs));
+  std::vector<std::thread> threads;
+  std::atomic<int> ready{0};
+  for (int pair = 0; pair < pairs; ++pair) {
+    threads.emplace_back([&, pair]() {
+      results[static_cast<size_t>(pair)] =
+        runPair(op, iterations, ready, pairs * 2);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  PairResult mean;
+  for (const PairResult& result : results) {
+    mean.producerNs += result.producerNs / pairs;
+    mean.consumerNs += result.consumerNs / pairs;
+  }
+  return mean;
+}
+
+// ---- Reporting ----
+
+struct Sample {
+  std::string name;
+  double ns;
+};
+
+// Best of `repetitions`: the minimum is the least noisy estimate of cost.
+void keepBest(std::vector<Sample>& samples, const std::string& name,
+              double ns) {
+  for (Sample& sample : samples) {
+    if (sample.name == name) {
+      sample.ns = std::min(sample.ns, ns);
+      return;
+    }
+  }
+  samples.push_back(Sample{name, ns});
+}
+
+void runAll(std::vector<Sample>& samples, uint64_t iterations) {
+  keepBest(samples, "acquire_callback/uncontended",
+           benchAcquireCallback(iterations));
+  keepBest(samples, "acquire_byte_commit_or_record_drop/uncontended",
+           benchByteCommit(iterations));
+  keepBest(samples, "acquire_admitted_byte_commit/uncontended",
+           benchAdmittedByteCommit(iterations));
+  double publishNs = 0;
+  double claimNs = 0;
+  benchPublishClaim(iterations, publishNs, claimNs);
+  keepBest(samples, "publish/uncontended", publishNs);
+  keepBest(samples, "claim/uncontended", claimNs);
+  keepBest(samples, "claim_empty/uncontended", benchClaimEmpty(iterations));
+
+  // Contended runs are shorter: each pass spins 2-8 threads.
+  const uint64_t contended = iterations / 4 == 0 ? 1 : iterations / 4;
+  for (int pairs : {1, 2, 4}) {
+    const std::string suffix = "/pairs" + std::to_string(pairs);
+    const PairResult callback =
+      runPairs(ProducerOp::ACQUIRE_CALLBACK, contended, pairs);
+    keepBest(samples, "acquire_callback" + suffix, callback.producerNs);
+    const PairResult commit =
+      runPairs(ProducerOp::BYTE_COMMIT, contended, pairs);
+    keepBest(samples, "acquire_byte_commit_or_record_drop" + suffix,
+             commit.producerNs);
+    const PairResult ordered = runPairs(ProducerOp::PUBLISH, contended, pairs);
+    keepBest(samples, "publish" + suffix, ordered.producerNs);
+    keepBest(samples, "claim" + suffix, ordered.consumerNs);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool report = false;
+  uint64_t iterations = 0;
+  int repetitions = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--report") == 0) {
+      report = true;
+    } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      iterations = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+      repetitions = std::atoi(argv[++i]);
+    } else {
+      std::fprintf(stderr, "usage: %s [--report] [--iterations N] "
+                   "[--repetitions N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (iterations == 0) iterations = report ? 50000 : 2000;
+  if (repetitions <= 0) repetitions = report ? 15 : 1;
+
+  // glibc skips atomic lock operations until a second thread exists; start
+  // one so uncontended runs time the same lock path as contended ones.
+  std::thread([]() {}).join();
+
+  std::vector<Sample> samples;
+  for (int repetition = 0; repetition < repetitions; ++repetition) {
+    runAll(samples, iterations);
+  }
+  if (gFailures != 0) return 1;
+  if (report) {
+    for (const Sample& sample : samples) {
+      std::printf("bench %s %.1f\n", sample.name.c_str(), sample.ns);
+    }
+    return 0;
+  }
+  std::printf("USB CDC state benchmark smoke pass: %zu measurements, "
+              "acquireCallback %.1f ns, claim %.1f ns uncontended.\n",
+              samples.size(), samples[0].ns, samples[4].ns);
+  return 0;
+}
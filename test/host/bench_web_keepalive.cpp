@@ -0,0 +1,325 @@
+// Requests per second from one polling client over loopback TCP, with the
+// connection closed after every response (the old behaviour) and with
+// HTTP/1.1 keep-alive. The server side is the real BoundedConnectionTable
+// and BoundedHttpTransaction driven in the same order as
+// BoundedWebServer::serviceConnection, with POSIX sockets in place of lwIP
+// and a canned /api/latest-sized JSON body in place of the handler.
+//
+// Loopback has no radio latency, so the gap here is the connect/close cost
+// of the host TCP stack alone; on clinic Wi-Fi each saved handshake is also
+// a saved round trip.
+//
+// With no arguments this is a short smoke pass for
+// scripts/run_concurrency_stress.sh; scripts/run_web_benchmark.sh runs
+// `--report` and prints "bench <name> <requests/s>" lines.
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "lib/BoundedConnectionTable.h"
+
+namespace {
+
+using bp_http::BodyMode;
+using bp_http::TransactionState;
+using bp_web::BoundedConnection;
+using bp_web::BoundedConnectionTable;
+using bp_web::BoundedSocketOps;
+using bp_web::IngressIoResult;
+using bp_web::SocketReadResult;
+using bp_web::SocketReadStatus;
+using bp_web::SocketShutdownStatus;
+using bp_web::SocketWriteResult;
+using bp_web::SocketWriteStatus;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kSlots = bp_web::kBoundedWebSlots;
+
+[[noreturn]] void fail(const char* what) {
+  std::fprintf(stderr, "web keep-alive benchmark failed: %s (errno %d)\n",
+               what, errno);
+  std::exit(1);
+}
+
+uint32_t hostClock(void*) {
+  return static_cast<uint32_t>(
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      Clock::now().time_since_epoch()).count());
+}
+
+SocketReadResult hostReceive(void*, int socket, uint8_t* target,
+                             size_t capacity) {
+  const ssize_t received = ::recv(socket, target, capacity, MSG_DONTWAIT);
+  if (received > 0) {
+    return {SocketReadStatus::DATA, static_cast<size_t>(received)};
+  }
+  if (received == 0) return {SocketReadStatus::PEER_CLOSED, 0};
+  if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+    return {SocketReadStatus::WOULD_BLOCK, 0};
+  }
+  return {SocketReadStatus::ERROR, 0};
+}
+
+SocketWriteResult hostSend(void*, int socket, const uint8_t* bytes,
+                           size_t length) {
+  const ssize_t sent = ::send(socket, bytes, length,
+                              MSG_DONTWAIT | MSG_NOSIGNAL);
+  if (sent > 0) {
+    return {SocketWriteStatus::PROGRESS, static_cast<size_t>(sent)};
+  }
+  if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK ||
+                   errno == EINTR)) {
+    return {SocketWriteStatus::WOULD_BLOCK, 0};
+  }
+  return {SocketWriteStatus::ERROR, 0};
+}
+
+SocketShutdownStatus hostShutdown(void*, int socket) {
+  return ::shutdown(socket, SHUT_WR) == 0 ? SocketShutdownStatus::COMPLETE
+                                          : SocketShutdownStatus::ERROR;
+}
+
+std::string cannedResponse() {
+  // About the size of a /api/latest body with one device.
+  std::string body = "{\"revision\":\"42\",\"records\":[";
+  while (body.size() < 560) body += "{\"sys\":120,\"dia\":80,\"pul\":70},";
+  body.back() = ']';
+  body += '}';
+  return "HTTP/1.1 200 OK\r\n"
+         "Content-Type: application/json\r\n"
+         "Content-Length: " + std::to_string(body.size()) + "\r\n"
+         "Cache-Control: no-store, max-age=0\r\n"
+         "Pragma: no-cache\r\n"
+         "X-Content-Type-Options: nosniff\r\n"
+         "Connection: close\r\n\r\n" + body;
+}
+
+struct Server {
+  explicit Server(bool keepAlive)
+    : keepAlive(keepAlive),
+      table(BoundedSocketOps{nullptr, hostClock, hostReceive, hostSend,
+                             hostShutdown}),
+      response(cannedResponse()) {
+    listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) fail("socket");
+    const int yes = 1;
+    (void)::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address),
+               sizeof(address)) != 0 ||
+        ::listen(listener, 8) != 0) {
+      fail("bind/listen");
+    }
+    socklen_t length = sizeof(address);
+    if (::getsockname(listener, reinterpret_cast<sockaddr*>(&address),
+                      &length) != 0) {
+      fail("getsockname");
+    }
+    port = ntohs(address.sin_port);
+    (void)::fcntl(listener, F_SETFL,
+                  ::fcntl(listener, F_GETFL) | O_NONBLOCK);
+  }
+
+  ~Server() { ::close(listener); }
+
+  void finish(BoundedConnection& connection) {
+    const int socket = connection.socket();
+    connection.close();
+    if (socket >= 0) ::close(socket);
+  }
+
+  void service(BoundedConnection& connection) {
+    bp_http::BoundedHttpTransaction& transaction = connection.transaction;
+    const uint32_t now = hostClock(nullptr);
+    (void)transaction.poll(now);
+    const TransactionState state = transaction.state();
+    if (state == TransactionState::AWAITING_REQUEST ||
+        state == TransactionState::READING_HEADERS) {
+      const IngressIoResult received = connection.receive();
+      if (received == IngressIoResult::PROGRESS) {
+        const bp_http::TransactionConsume consumed = transaction.consume(
+          connection.ingress.data(), connection.ingress.length(), now);
+        if (consumed.consumed == 0 ||
+            !connection.ingress.consume(consumed.consumed)) {
+          transaction.abort();
+        }
+      } else if (received != IngressIoResult::WOULD_BLOCK) {
+        transaction.abort();
+      }
+    }
+    if (transaction.state() == TransactionState::WAIT_POLICY) {
+      (void)transaction.acceptPolicy(BodyMode::NONE, 0, now);
+    }
+    if (transaction.state() == TransactionState::DISPATCH_READY &&
+        transaction.beginDispatch(now)) {
+      (void)transaction.capture(
+        reinterpret_cast<const uint8_t*>(response.data()), response.size());
+      if (!keepAlive || connection.ingress.length() != 0) {
+        transaction.closeAfterResponse();
+      }
+      connection.ingress.clear();
+      (void)transaction.finishDispatch(now);
+    }
+    connection.pumpResponse(hostClock(nullptr));
+    if (transaction.awaitNextRequest(hostClock(nullptr))) return;
+    if (transaction.terminal()) finish(connection);
+  }
+
+  void run() {
+    while (!stop.load(std::memory_order_acquire)) {
+      while (BoundedConnection* connection = table.acquire()) {
+        const int socket = ::accept(listener, nullptr, nullptr);
+        if (socket < 0) break;
+        const int yes = 1;
+        (void)::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &yes,
+                           sizeof(yes));
+        connection->open(socket, 0, 0, hostClock(nullptr));
+        accepted.fetch_add(1, std::memory_order_relaxed);
+      }
+      table.forEachActive(
+        [this](BoundedConnection& connection) { service(connection); });
+    }
+    for (size_t i = 0; i < kSlots; ++i) {
+      if (table.slot(i).active()) finish(table.slot(i));
+    }
+  }
+
+  const bool keepAlive;
+  BoundedConnectionTable<kSlots> table;
+  const std::string response;
+  int listener = -1;
+  uint16_t port = 0;
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> accepted{0};
+};
+
+int connectTo(uint16_t port) {
+  const int socket = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (socket < 0) fail("client socket");
+  const int yes = 1;
+  (void)::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::connect(socket, reinterpret_cast<sockaddr*>(&address),
+                sizeof(address)) != 0) {
+    fail("connect");
+  }
+  return socket;
+}
+
+// Reads one response; true when the server keeps the connection.
+bool readResponse(int socket, std::string& buffer) {
+  buffer.clear();
+  char chunk[2048];
+  size_t bodyStart = std::string::npos;
+  size_t total = 0;
+  for (;;) {
+    const ssize_t received = ::recv(socket, chunk, sizeof(chunk), 0);
+    if (received <= 0) fail("response cut short");
+    buffer.append(chunk, static_cast<size_t>(received));
+    if (bodyStart == std::string::npos) {
+      const size_t end = buffer.find("\r\n\r\n");
+      if (end == std::string::npos) continue;
+      bodyStart = end + 4;
+      const size_t field = buffer.find("Content-Length: ");
+      if (field == std::string::npos || field > end) fail("no length");
+      total = bodyStart + std::strtoul(buffer.c_str() + field + 16,
+                                       nullptr, 10);
+    }
+    if (buffer.size() >= total) break;
+  }
+  if (buffer.compare(0, 15, "HTTP/1.1 200 OK") != 0) fail("status");
+  return buffer.find("Connection: keep-alive\r\n") != std::string::npos;
+}
+
+struct Result {
+  double requestsPerSecond;
+  size_t connections;
+};
+
+Result runClient(bool keepAlive, size_t requests) {
+  Server server(keepAlive);
+  std::thread serverThread([&server]() { server.run(); });
+
+  static const char kRequest[] =
+    "GET /api/latest HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+    "If-None-Match: W/\"0\"\r\n\r\n";
+  std::string buffer;
+  int socket = -1;
+  const Clock::time_point started = Clock::now();
+  for (size_t i = 0; i < requests; ++i) {
+    if (socket < 0) socket = connectTo(server.port);
+    if (::send(socket, kRequest, sizeof(kRequest) - 1, MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(sizeof(kRequest) - 1)) {
+      fail("request send");
+    }
+    if (!readResponse(socket, buffer)) {
+      ::close(socket);
+      socket = -1;
+    }
+  }
+  const double seconds =
+    std::chrono::duration<double>(Clock::now() - started).count();
+  if (socket >= 0) ::close(socket);
+
+  server.stop.store(true, std::memory_order_release);
+  serverThread.join();
+  return {static_cast<double>(requests) / seconds,
+          server.accepted.load(std::memory_order_relaxed)};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool report = false;
+  size_t requests = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--report") == 0) {
+      report = true;
+    } else if (std::strcmp(argv[i], "--requests") == 0 && i + 1 < argc) {
+      requests = std::strtoul(argv[++i], nullptr, 10);
+    } else {
+      std::fprintf(stderr, "usage: %s [--report] [--requests N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (requests == 0) requests = report ? 20000 : 200;
+
+  const Result closing = runClient(false, requests);
+  const Result keeping = runClient(true, requests);
+
+  const size_t cap = bp_http::BoundedHttpTransaction::kMaxRequestsPerConnection;
+  if (closing.connections != requests) fail("close mode reused a socket");
+  if (keeping.connections != (requests + cap - 1) / cap) {
+    fail("keep-alive did not honour the per-connection cap");
+  }
+
+  if (report) {
+    std::printf("bench web_requests_per_s/close %.0f\n",
+                closing.requestsPerSecond);
+    std::printf("bench web_requests_per_s/keep_alive %.0f\n",
+                keeping.requestsPerSecond);
+    return 0;
+  }
+  std::printf("Web keep-alive benchmark smoke pass: %zu requests, "
+              "%zu connections closing, %zu kept alive.\n",
+              requests, closing.connections, keeping.connections);
+  return 0;
+}
@@ -0,0 +1,199 @@
+// Host fake of the ESP-IDF UART driver calls UartTransport makes. A test plays
+// the ISR: hostUartReceive() appends bytes to the driver ring buffer and posts
+// UART_DATA, or UART_BUFFER_FULL when they do not fit; hostUartFifoOverflow()
+// posts UART_FIFO_OVF for bytes the hardware FIFO lost.
+#ifndef HOST_DRIVER_UART_H
+#define HOST_DRIVER_UART_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+typedef int uart_port_t;
+#define UART_NUM_0 0
+#define UART_NUM_1 1
+#define UART_NUM_2 2
+#define UART_PIN_NO_CHANGE (-1)
+
+enum uart_word_length_t {
+  UART_DATA_5_BITS = 0,
+  UART_DATA_6_BITS,
+  UART_DATA_7_BITS,
+  UART_DATA_8_BITS,
+};
+enum uart_parity_t { UART_PARITY_DISABLE = 0, UART_PARITY_EVEN = 2,
+                     UART_PARITY_ODD = 3 };
+enum uart_stop_bits_t { UART_STOP_BITS_1 = 1, UART_STOP_BITS_1_5,
+                        UART_STOP_BITS_2 };
+enum uart_hw_flowcontrol_t { UART_HW_FLOWCTRL_DISABLE = 0 };
+enum uart_sclk_t { UART_SCLK_DEFAULT = 0 };
+
+struct uart_config_t {
+  int baud_rate;
+  uart_word_length_t data_bits;
+  uart_parity_t parity;
+  uart_stop_bits_t stop_bits;
+  uart_hw_flowcontrol_t flow_ctrl;
+  uint8_t rx_flow_ctrl_thresh;
+  uart_sclk_t source_clk;
+};
+
+enum uart_event_type_t {
+  UART_DATA = 0,
+  UART_BREAK,
+  UART_BUFFER_FULL,
+  UART_FIFO_OVF,
+  UART_FRAME_ERR,
+  UART_PARITY_ERR,
+  UART_DATA_BREAK,
+  UART_PATTERN_DET,
+  UART_EVENT_MAX,
+};
+
+struct uart_event_t {
+  uart_event_type_t type;
+  size_t size;
+  bool timeout_flag;
+};
+
+struct HostUart {
+  bool installed = false;
+  esp_err_t installResult = ESP_OK;
+  size_t ringCapacity = 0;
+  std::deque<uint8_t> ring;
+  StaticQueue_t queue;
+  std::vector<uint8_t> queueStorage;
+  uart_config_t config = {};
+  int txPin = UART_PIN_NO_CHANGE;
+  int rxPin = UART_PIN_NO_CHANGE;
+  uint32_t readCalls = 0;
+  uint32_t flushes = 0;
+  // uart_set_baudrate() calls: runtime line switches, not reinstalls.
+  uint32_t reconfigurations = 0;
+};
+
+inline HostUart& hostUart() {
+  static HostUart uart;
+  return uart;
+}
+
+inline void hostUartReset() {
+  HostUart& uart = hostUart();
+  uart.installed = false;
+  uart.installResult = ESP_OK;
+  uart.ring.clear();
+  uart.readCalls = 0;
+  uart.flushes = 0;
+  uart.reconfigurations = 0;
+}
+
+inline void hostUartPost(uart_event_type_t type, size_t size) {
+  uart_event_t event = {};
+  event.type = type;
+  event.size = size;
+  xQueueSendToBack(&hostUart().queue, &event, 0);
+}
+
+// Bytes that do not fit the ring are lost, as in the driver's RX ISR.
+inline void hostUartReceive(const uint8_t* data, size_t length) {
+  HostUart& uart = hostUart();
+  size_t stored = 0;
+  while (stored < length && uart.ring.size() < uart.ringCapacity) {
+    uart.ring.push_back(data[stored++]);
+  }
+  if (stored > 0) hostUartPost(UART_DATA, stored);
+  if (stored < length) hostUartPost(UART_BUFFER_FULL, 0);
+}
+
+inline void hostUartFifoOverflow() { hostUartPost(UART_FIFO_OVF, 0); }
+
+// A byte sampled at the wrong baud rate or framing.
+inline void hostUartFrameError() { hostUartPost(UART_FRAME_ERR, 0); }
+
+inline esp_err_t uart_driver_install(uart_port_t, int rx_buffer_size,
+                                     int, int queue_size,
+                                     QueueHandle_t* uart_queue, int) {
+  HostUart& uart = hostUart();
+  if (uart.installResult != ESP_OK) return uart.installResult;
+  if (uart.installed) return ESP_FAIL;
+  uart.ringCapacity = static_cast<size_t>(rx_buffer_size);
+  uart.queueStorage.assign(
+    static_cast<size_t>(queue_size) * sizeof(uart_event_t), 0);
+  *uart_queue = xQueueCreateStatic(queue_size, sizeof(uart_event_t),
+                                   uart.queueStorage.data(), &uart.queue);
+  uart.installed = true;
+  return ESP_OK;
+}
+
+inline esp_err_t uart_driver_delete(uart_port_t) {
+  HostUart& uart = hostUart();
+  if (!uart.installed) return ESP_FAIL;
+  uart.installed = false;
+  uart.ring.clear();
+  return ESP_OK;
+}
+
+inline esp_err_t uart_param_config(uart_port_t, const uart_config_t* config) {
+  hostUart().config = *config;
+  return ESP_OK;
+}
+
+inline esp_err_t uart_set_pin(uart_port_t, int tx, int rx, int, int) {
+  hostUart().txPin = tx;
+  hostUart().rxPin = rx;
+  return ESP_OK;
+}
+
+inline esp_err_t uart_set_baudrate(uart_port_t, uint32_t baudrate) {
+  hostUart().config.baud_rate = static_cast<int>(baudrate);
+  hostUart().reconfigurations++;
+  return ESP_OK;
+}
+
+inline esp_err_t uart_set_word_length(uart_port_t, uart_word_length_t bits) {
+  hostUart().config.data_bits = bits;
+  return ESP_OK;
+}
+
+inline esp_err_t uart_set_parity(uart_port_t, uart_parity_t parity) {
+  hostUart().config.parity = parity;
+  return ESP_OK;
+}
+
+inline esp_err_t uart_set_stop_bits(uart_port_t, uart_stop_bits_t stop_bits) {
+  hostUart().config.stop_bits = stop_bits;
+  return ESP_OK;
+}
+
+inline int uart_read_bytes(uart_port_t, void* buffer, uint32_t length,
+                           TickType_t) {
+  HostUart& uart = hostUart();
+  if (!uart.installed) return -1;
+  uart.readCalls++;
+  uint8_t* out = static_cast<uint8_t*>(buffer);
+  int count = 0;
+  while (count < static_cast<int>(length) && !uart.ring.empty()) {
+    out[count++] = uart.ring.front();
+    uart.ring.pop_front();
+  }
+  return count;
+}
+
+inline esp_err_t uart_get_buffered_data_len(uart_port_t, size_t* size) {
+  *size = hostUart().ring.size();
+  return ESP_OK;
+}
+
+inline esp_err_t uart_flush_input(uart_port_t) {
+  hostUart().flushes++;
+  hostUart().ring.clear();
+  return ESP_OK;
+}
+
+#endif
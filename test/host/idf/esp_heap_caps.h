@@ -0,0 +1,26 @@
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+// The host board has no PSRAM unless a harness says so.
+inline bool& __hostPsramAvailable() {
+  static bool value = false;
+  return value;
+}
+
+inline void* heap_caps_calloc(size_t count, size_t size, uint32_t caps) {
+  if ((caps & MALLOC_CAP_SPIRAM) != 0 && !__hostPsramAvailable()) {
+    return nullptr;
+  }
+  return calloc(count, size);
+}
+
+inline void heap_caps_free(void* pointer) { free(pointer); }
+
+#endif
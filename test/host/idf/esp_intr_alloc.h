@@ -0,0 +1,6 @@
+#ifndef HOST_ESP_INTR_ALLOC_H
+#define HOST_ESP_INTR_ALLOC_H
+
+#define ESP_INTR_FLAG_LOWMED (1 << 1)
+
+#endif
@@ -0,0 +1,383 @@
+// Host fake of the USB Host library and the vendored cdc_acm_host driver,
+// enough to run src/transports/UsbCdcTransport.cpp on Linux. A harness plays
+// the monitors: hostUsbAttach()/hostUsbDisconnect() plug and unplug a device,
+// hostUsbTransfer() delivers one bulk IN transfer through the data callback.
+//
+// Like the real driver, callbacks for one device are serialized and
+// cdc_acm_host_close() does not return while one is running, so a closed
+// handle never calls back. Opens do not wait for connection_timeout_ms: the
+// transport only opens after DEVICE_ATTACHED, so an absent device fails fast.
+#ifndef HOST_FAKE_CDC_ACM_HOST_H
+#define HOST_FAKE_CDC_ACM_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <mutex>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "usb/usb_host.h"
+#include "src/third_party/espressif_usb_host_cdc_acm/usb/cdc_acm_host.h"
+
+static constexpr uint8_t kHostUsbDevices = 3;
+
+struct cdc_dev_s {
+  uint8_t index = 0;
+  // Identity the open filters on; hostUsbReset() gives each slot its own PID
+  // and the data interface at index 0.
+  uint16_t vid = 0;
+  uint16_t pid = 0;
+  uint8_t interfaceIndex = 0;
+  bool attached = false;
+  bool open = false;
+  cdc_acm_host_dev_callback_t eventCallback = nullptr;
+  cdc_acm_data_callback_t dataCallback = nullptr;
+  void* userArg = nullptr;
+  // Held for the whole callback, and by close(), to serialize the two.
+  std::mutex callbackMutex;
+};
+
+struct HostUsbCounters {
+  uint32_t opens = 0;
+  uint32_t closes = 0;
+  uint64_t deliveredBytes = 0;
+  uint64_t undeliveredBytes = 0;
+  // Every cdc_acm_host_open() call, including the ones that find nothing.
+  uint32_t openCalls = 0;
+  // Returns from usb_host_lib_handle_events(), timeouts included: the host
+  // daemon's wakeup count.
+  uint32_t hostEventWakeups = 0;
+  // Line codings applied, and how many differed from 9600 8N1.
+  uint32_t lineCodings = 0;
+  uint32_t nonDefaultLineCodings = 0;
+};
+
+struct HostUsbBus {
+  std::mutex mutex;
+  std::condition_variable changed;
+  bool hostInstalled = false;
+  bool driverInstalled = false;
+  bool unblockRequested = false;
+  uint32_t pendingFlags = 0;
+  cdc_acm_new_dev_callback_t newDeviceCallback = nullptr;
+  cdc_dev_s devices[kHostUsbDevices];
+  HostUsbCounters counters;
+  // Failure injection: each non-zero countdown fails that many calls.
+  int openFailures = 0;
+  int lineCodingFailures = 0;
+};
+
+inline HostUsbBus& hostUsbBus() {
+  static HostUsbBus bus;
+  return bus;
+}
+
+inline void hostUsbReset() {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  bus.hostInstalled = false;
+  bus.driverInstalled = false;
+  bus.unblockRequested = false;
+  bus.pendingFlags = 0;
+  bus.newDeviceCallback = nullptr;
+  for (uint8_t i = 0; i < kHostUsbDevices; ++i) {
+    cdc_dev_s& device = bus.devices[i];
+    device.index = i;
+    device.vid = 0x0590;
+    device.pid = static_cast<uint16_t>(0x0100 + i);
+    device.interfaceIndex = 0;
+    device.attached = false;
+    device.open = false;
+    device.eventCallback = nullptr;
+    device.dataCallback = nullptr;
+    device.userArg = nullptr;
+  }
+  bus.counters = HostUsbCounters();
+  bus.openFailures = 0;
+  bus.lineCodingFailures = 0;
+}
+
+inline HostUsbCounters hostUsbCounters() {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  return bus.counters;
+}
+
+inline bool hostUsbAnyOpen() {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  for (const cdc_dev_s& device : bus.devices) {
+    if (device.open) return true;
+  }
+  return false;
+}
+
+inline bool hostUsbDriverInstalled() {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  return bus.driverInstalled;
+}
+
+// ---- Harness side: the monitors ----
+
+// Before attach: which VID/PID the monitor reports and where its data
+// interface sits.
+inline void hostUsbSetIdentity(uint8_t index, uint16_t vid, uint16_t pid,
+                               uint8_t interfaceIndex) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  bus.devices[index].vid = vid;
+  bus.devices[index].pid = pid;
+  bus.devices[index].interfaceIndex = interfaceIndex;
+}
+
+inline void hostUsbAttach(uint8_t index) {
+  HostUsbBus& bus = hostUsbBus();
+  cdc_acm_new_dev_callback_t callback = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(bus.mutex);
+    cdc_dev_s& device = bus.devices[index];
+    if (device.attached) return;
+    device.attached = true;
+    if (bus.driverInstalled) callback = bus.newDeviceCallback;
+  }
+  if (callback != nullptr) {
+    callback(reinterpret_cast<usb_device_handle_t>(&bus.devices[index]));
+  }
+}
+
+// Unplug: an open handle gets DEVICE_DISCONNECTED and stays allocated until
+// the owner closes it, as with the real driver.
+inline void hostUsbDisconnect(uint8_t index) {
+  HostUsbBus& bus = hostUsbBus();
+  cdc_dev_s& device = bus.devices[index];
+  std::lock_guard<std::mutex> callbackGuard(device.callbackMutex);
+  cdc_acm_host_dev_callback_t callback = nullptr;
+  void* userArg = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(bus.mutex);
+    if (!device.attached) return;
+    device.attached = false;
+    if (device.open) {
+      callback = device.eventCallback;
+      userArg = device.userArg;
+    }
+  }
+  if (callback != nullptr) {
+    cdc_acm_host_dev_event_data_t event = {};
+    event.type = CDC_ACM_HOST_DEVICE_DISCONNECTED;
+    event.data.cdc_hdl = &device;
+    callback(&event, userArg);
+  }
+}
+
+// One bulk IN transfer. Returns false when no open handle received it.
+inline bool hostUsbTransfer(uint8_t index, const uint8_t* data,
+                            size_t length) {
+  HostUsbBus& bus = hostUsbBus();
+  cdc_dev_s& device = bus.devices[index];
+  std::lock_guard<std::mutex> callbackGuard(device.callbackMutex);
+  cdc_acm_data_callback_t callback = nullptr;
+  void* userArg = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(bus.mutex);
+    if (device.attached && device.open) {
+      callback = device.dataCallback;
+      userArg = device.userArg;
+    }
+    if (callback != nullptr) {
+      bus.counters.deliveredBytes += length;
+    } else {
+      bus.counters.undeliveredBytes += length;
+    }
+  }
+  if (callback == nullptr) return false;
+  callback(data, length, userArg);
+  return true;
+}
+
+// ---- USB Host library ----
+
+inline esp_err_t usb_host_install(const usb_host_config_t*) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (bus.hostInstalled) return ESP_ERR_INVALID_STATE;
+  bus.hostInstalled = true;
+  bus.pendingFlags = 0;
+  return ESP_OK;
+}
+
+inline esp_err_t usb_host_uninstall(void) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (!bus.hostInstalled || bus.driverInstalled) return ESP_ERR_INVALID_STATE;
+  bus.hostInstalled = false;
+  return ESP_OK;
+}
+
+inline esp_err_t usb_host_lib_handle_events(TickType_t timeoutTicks,
+                                            uint32_t* eventFlags) {
+  HostUsbBus& bus = hostUsbBus();
+  std::unique_lock<std::mutex> lock(bus.mutex);
+  const bool woke = __hostRtosWait(bus.changed, lock, timeoutTicks, [&bus]() {
+    return bus.unblockRequested || bus.pendingFlags != 0;
+  });
+  bus.counters.hostEventWakeups++;
+  if (!woke) return ESP_ERR_TIMEOUT;
+  bus.unblockRequested = false;
+  if (eventFlags != nullptr) *eventFlags = bus.pendingFlags;
+  bus.pendingFlags = 0;
+  return ESP_OK;
+}
+
+inline esp_err_t usb_host_lib_unblock(void) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  bus.unblockRequested = true;
+  bus.changed.notify_all();
+  return ESP_OK;
+}
+
+inline esp_err_t usb_host_device_free_all(void) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  bus.pendingFlags |= USB_HOST_LIB_EVENT_FLAGS_ALL_FREE;
+  bus.changed.notify_all();
+  return ESP_OK;
+}
+
+// ---- cdc_acm_host driver ----
+
+inline esp_err_t cdc_acm_host_install(
+    const cdc_acm_host_driver_config_t* config) {
+  HostUsbBus& bus = hostUsbBus();
+  cdc_acm_new_dev_callback_t callback = nullptr;
+  bool attached[kHostUsbDevices] = {};
+  {
+    std::lock_guard<std::mutex> guard(bus.mutex);
+    if (!bus.hostInstalled || bus.driverInstalled) {
+      return ESP_ERR_INVALID_STATE;
+    }
+    bus.driverInstalled = true;
+    callback = config != nullptr ? config->new_dev_cb : nullptr;
+    bus.newDeviceCallback = callback;
+    for (uint8_t i = 0; i < kHostUsbDevices; ++i) {
+      attached[i] = bus.devices[i].attached;
+    }
+  }
+  // Devices already on the bus enumerate once the client registers.
+  for (uint8_t i = 0; callback != nullptr && i < kHostUsbDevices; ++i) {
+    if (attached[i]) {
+      callback(reinterpret_cast<usb_device_handle_t>(&bus.devices[i]));
+    }
+  }
+  return ESP_OK;
+}
+
+inline esp_err_t cdc_acm_host_uninstall(void) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (!bus.driverInstalled) return ESP_ERR_INVALID_STATE;
+  for (const cdc_dev_s& device : bus.devices) {
+    if (device.open) return ESP_ERR_INVALID_STATE;
+  }
+  bus.driverInstalled = false;
+  bus.newDeviceCallback = nullptr;
+  bus.pendingFlags |= USB_HOST_LIB_EVENT_FLAGS_NO_CLIENTS;
+  bus.changed.notify_all();
+  return ESP_OK;
+}
+
+inline esp_err_t cdc_acm_host_open(uint16_t vid, uint16_t pid,
+                                   uint8_t interfaceIndex,
+                                   const cdc_acm_host_device_config_t* config,
+                                   cdc_acm_dev_hdl_t* handle) {
+  if (config == nullptr || handle == nullptr) return ESP_ERR_INVALID_ARG;
+  *handle = nullptr;
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (!bus.driverInstalled) return ESP_ERR_INVALID_STATE;
+  bus.counters.openCalls++;
+  if (bus.openFailures > 0) {
+    bus.openFailures--;
+    return ESP_ERR_NOT_FOUND;
+  }
+  // Like the real driver, the first matching device is the one opened; a
+  // missing interface on it fails the call rather than trying the next.
+  for (cdc_dev_s& device : bus.devices) {
+    if (!device.attached) continue;
+    if ((vid != CDC_HOST_ANY_VID && vid != device.vid) ||
+        (pid != CDC_HOST_ANY_PID && pid != device.pid)) {
+      continue;
+    }
+    if (device.open) {
+      if (config->skip_opened_devices) continue;
+      return ESP_ERR_INVALID_STATE;
+    }
+    if (interfaceIndex != device.interfaceIndex) return ESP_ERR_NOT_FOUND;
+    device.open = true;
+    device.eventCallback = config->event_cb;
+    device.dataCallback = config->data_cb;
+    device.userArg = config->user_arg;
+    bus.counters.opens++;
+    *handle = &device;
+    return ESP_OK;
+  }
+  return ESP_ERR_NOT_FOUND;
+}
+
+inline esp_err_t cdc_acm_host_close(cdc_acm_dev_hdl_t handle) {
+  if (handle == nullptr) return ESP_ERR_INVALID_ARG;
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> callbackGuard(handle->callbackMutex);
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (!handle->open) return ESP_ERR_INVALID_STATE;
+  handle->open = false;
+  handle->eventCallback = nullptr;
+  handle->dataCallback = nullptr;
+  handle->userArg = nullptr;
+  bus.counters.closes++;
+  return ESP_OK;
+}
+
+inline esp_err_t cdc_acm_host_device_ids_get(cdc_acm_dev_hdl_t handle,
+                                             uint16_t* vid, uint16_t* pid) {
+  if (handle == nullptr) return ESP_ERR_INVALID_ARG;
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (!handle->open) return ESP_ERR_INVALID_STATE;
+  if (vid != nullptr) *vid = handle->vid;
+  if (pid != nullptr) *pid = handle->pid;
+  return ESP_OK;
+}
+
+inline esp_err_t cdc_acm_host_line_coding_set(
+    cdc_acm_dev_hdl_t handle, const cdc_acm_line_coding_t* lineCoding) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (handle == nullptr || !handle->open) return ESP_ERR_INVALID_STATE;
+  if (!handle->attached) return ESP_ERR_INVALID_RESPONSE;
+  if (bus.lineCodingFailures > 0) {
+    bus.lineCodingFailures--;
+    return ESP_ERR_INVALID_RESPONSE;
+  }
+  bus.counters.lineCodings++;
+  if (lineCoding == nullptr || lineCoding->dwDTERate != 9600 ||
+      lineCoding->bCharFormat != 0 || lineCoding->bParityType != 0 ||
+      lineCoding->bDataBits != 8) {
+    bus.counters.nonDefaultLineCodings++;
+  }
+  return ESP_OK;
+}
+
+inline esp_err_t cdc_acm_host_set_control_line_state(cdc_acm_dev_hdl_t handle,
+                                                     bool, bool) {
+  HostUsbBus& bus = hostUsbBus();
+  std::lock_guard<std::mutex> guard(bus.mutex);
+  if (handle == nullptr || !handle->open) return ESP_ERR_INVALID_STATE;
+  return handle->attached ? ESP_OK : ESP_ERR_INVALID_RESPONSE;
+}
+
+#endif
@@ -0,0 +1,45 @@
+// Host shim for the FreeRTOS types UsbCdcTransport.cpp uses. Tasks are
+// std::threads, ticks are milliseconds and critical sections are mutexes, so
+// ThreadSanitizer sees every hand-off the firmware relies on.
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define portMAX_DELAY 0xffffffffUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+
+struct portMUX_TYPE {
+  std::mutex mutex;
+};
+#define portMUX_INITIALIZER_UNLOCKED portMUX_TYPE{}
+#define portENTER_CRITICAL(mux) ((mux)->mutex.lock())
+#define portEXIT_CRITICAL(mux) ((mux)->mutex.unlock())
+
+// Waits on `ready` for up to `ticks`; portMAX_DELAY waits forever.
+template <typename Predicate>
+inline bool __hostRtosWait(std::condition_variable& signal,
+                           std::unique_lock<std::mutex>& lock,
+                           TickType_t ticks, Predicate ready) {
+  if (ticks == portMAX_DELAY) {
+    signal.wait(lock, ready);
+    return true;
+  }
+  return signal.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+#endif
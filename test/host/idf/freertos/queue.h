@@ -0,0 +1,84 @@
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+#include <string.h>
+
+struct StaticQueue_t {
+  std::mutex mutex;
+  std::condition_variable changed;
+  uint8_t* storage = nullptr;
+  UBaseType_t length = 0;
+  UBaseType_t itemSize = 0;
+  UBaseType_t head = 0;
+  UBaseType_t count = 0;
+};
+typedef StaticQueue_t* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreateStatic(UBaseType_t length,
+                                        UBaseType_t itemSize,
+                                        uint8_t* storage,
+                                        StaticQueue_t* queue) {
+  if (queue == nullptr || storage == nullptr || length == 0) return nullptr;
+  queue->storage = storage;
+  queue->length = length;
+  queue->itemSize = itemSize;
+  queue->head = 0;
+  queue->count = 0;
+  return queue;
+}
+
+inline BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item,
+                                   TickType_t ticks) {
+  if (queue == nullptr) return pdFAIL;
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!__hostRtosWait(queue->changed, lock, ticks,
+                      [queue]() { return queue->count < queue->length; })) {
+    return pdFAIL;
+  }
+  const UBaseType_t tail = (queue->head + queue->count) % queue->length;
+  memcpy(queue->storage + tail * queue->itemSize, item, queue->itemSize);
+  queue->count++;
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* item,
+                                TickType_t ticks) {
+  if (queue == nullptr) return pdFAIL;
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!__hostRtosWait(queue->changed, lock, ticks,
+                      [queue]() { return queue->count > 0; })) {
+    return pdFAIL;
+  }
+  memcpy(item, queue->storage + queue->head * queue->itemSize,
+         queue->itemSize);
+  queue->head = (queue->head + 1) % queue->length;
+  queue->count--;
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  if (queue == nullptr) return 0;
+  std::lock_guard<std::mutex> guard(queue->mutex);
+  return queue->count;
+}
+
+inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+  if (queue == nullptr) return 0;
+  std::lock_guard<std::mutex> guard(queue->mutex);
+  return queue->length - queue->count;
+}
+
+inline BaseType_t xQueueReset(QueueHandle_t queue) {
+  if (queue == nullptr) return pdFAIL;
+  std::lock_guard<std::mutex> guard(queue->mutex);
+  queue->head = 0;
+  queue->count = 0;
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+#endif
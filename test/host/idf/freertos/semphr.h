@@ -0,0 +1,43 @@
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+// Binary semaphores only; that is all the transport creates.
+struct StaticSemaphore_t {
+  std::mutex mutex;
+  std::condition_variable changed;
+  bool available = false;
+};
+typedef StaticSemaphore_t* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinaryStatic(
+    StaticSemaphore_t* semaphore) {
+  if (semaphore == nullptr) return nullptr;
+  std::lock_guard<std::mutex> guard(semaphore->mutex);
+  semaphore->available = false;
+  return semaphore;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore,
+                                 TickType_t ticks) {
+  if (semaphore == nullptr) return pdFAIL;
+  std::unique_lock<std::mutex> lock(semaphore->mutex);
+  if (!__hostRtosWait(semaphore->changed, lock, ticks,
+                      [semaphore]() { return semaphore->available; })) {
+    return pdFAIL;
+  }
+  semaphore->available = false;
+  return pdPASS;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  if (semaphore == nullptr) return pdFAIL;
+  std::lock_guard<std::mutex> guard(semaphore->mutex);
+  if (semaphore->available) return pdFAIL;
+  semaphore->available = true;
+  semaphore->changed.notify_all();
+  return pdPASS;
+}
+
+#endif
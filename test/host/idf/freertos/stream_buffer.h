@@ -0,0 +1,92 @@
+#ifndef HOST_FREERTOS_STREAM_BUFFER_H
+#define HOST_FREERTOS_STREAM_BUFFER_H
+
+#include "FreeRTOS.h"
+
+// Like FreeRTOS, a buffer created over N bytes of storage holds N - 1, and a
+// send that does not fit writes what it can.
+struct StaticStreamBuffer_t {
+  std::mutex mutex;
+  std::condition_variable changed;
+  uint8_t* storage = nullptr;
+  size_t size = 0;
+  size_t head = 0;
+  size_t count = 0;
+  size_t triggerLevel = 1;
+};
+typedef StaticStreamBuffer_t* StreamBufferHandle_t;
+
+inline StreamBufferHandle_t xStreamBufferCreateStatic(
+    size_t storageBytes, size_t triggerLevel, uint8_t* storage,
+    StaticStreamBuffer_t* buffer) {
+  if (buffer == nullptr || storage == nullptr || storageBytes < 2) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> guard(buffer->mutex);
+  buffer->storage = storage;
+  buffer->size = storageBytes;
+  buffer->head = 0;
+  buffer->count = 0;
+  buffer->triggerLevel = triggerLevel == 0 ? 1 : triggerLevel;
+  return buffer;
+}
+
+inline size_t xStreamBufferSend(StreamBufferHandle_t buffer, const void* data,
+                                size_t length, TickType_t ticks) {
+  if (buffer == nullptr) return 0;
+  std::unique_lock<std::mutex> lock(buffer->mutex);
+  const size_t capacity = buffer->size - 1;
+  __hostRtosWait(buffer->changed, lock, ticks,
+                 [buffer, capacity]() { return buffer->count < capacity; });
+  const size_t space = capacity - buffer->count;
+  const size_t sent = length < space ? length : space;
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < sent; ++i) {
+    buffer->storage[(buffer->head + buffer->count + i) % buffer->size] =
+      bytes[i];
+  }
+  buffer->count += sent;
+  if (sent > 0) buffer->changed.notify_all();
+  return sent;
+}
+
+inline size_t xStreamBufferReceive(StreamBufferHandle_t buffer, void* data,
+                                   size_t length, TickType_t ticks) {
+  if (buffer == nullptr) return 0;
+  std::unique_lock<std::mutex> lock(buffer->mutex);
+  __hostRtosWait(buffer->changed, lock, ticks, [buffer]() {
+    return buffer->count >= buffer->triggerLevel;
+  });
+  const size_t received = length < buffer->count ? length : buffer->count;
+  uint8_t* bytes = static_cast<uint8_t*>(data);
+  for (size_t i = 0; i < received; ++i) {
+    bytes[i] = buffer->storage[(buffer->head + i) % buffer->size];
+  }
+  buffer->head = (buffer->head + received) % buffer->size;
+  buffer->count -= received;
+  if (received > 0) buffer->changed.notify_all();
+  return received;
+}
+
+inline size_t xStreamBufferBytesAvailable(StreamBufferHandle_t buffer) {
+  if (buffer == nullptr) return 0;
+  std::lock_guard<std::mutex> guard(buffer->mutex);
+  return buffer->count;
+}
+
+inline size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t buffer) {
+  if (buffer == nullptr) return 0;
+  std::lock_guard<std::mutex> guard(buffer->mutex);
+  return buffer->size - 1 - buffer->count;
+}
+
+inline BaseType_t xStreamBufferReset(StreamBufferHandle_t buffer) {
+  if (buffer == nullptr) return pdFAIL;
+  std::lock_guard<std::mutex> guard(buffer->mutex);
+  buffer->head = 0;
+  buffer->count = 0;
+  buffer->changed.notify_all();
+  return pdPASS;
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+#include <thread>
+#include <vector>
+
+typedef void (*TaskFunction_t)(void*);
+typedef std::thread* TaskHandle_t;
+
+// Created tasks are joined by hostJoinTasks() rather than detached, so a
+// harness can assert that every task really returned.
+inline std::mutex& __hostTaskMutex() {
+  static std::mutex value;
+  return value;
+}
+inline std::vector<std::thread>& __hostTasks() {
+  static std::vector<std::thread> value;
+  return value;
+}
+inline int& __hostTaskCreateFailures() {
+  static int value = 0;
+  return value;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char*,
+                                          uint32_t, void* arg, UBaseType_t,
+                                          TaskHandle_t* handle, BaseType_t) {
+  std::lock_guard<std::mutex> guard(__hostTaskMutex());
+  if (__hostTaskCreateFailures() > 0) {
+    __hostTaskCreateFailures()--;
+    return pdFAIL;
+  }
+  __hostTasks().emplace_back(task, arg);
+  if (handle != nullptr) *handle = &__hostTasks().back();
+  return pdPASS;
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+#define taskYIELD() std::this_thread::yield()
+
+// Returning from the task function ends the thread; there is nothing to
+// unwind early on the host.
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline void hostJoinTasks() {
+  std::vector<std::thread> tasks;
+  {
+    std::lock_guard<std::mutex> guard(__hostTaskMutex());
+    tasks.swap(__hostTasks());
+  }
+  for (std::thread& task : tasks) {
+    if (task.joinable()) task.join();
+  }
+}
+
+#endif
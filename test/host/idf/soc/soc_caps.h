@@ -0,0 +1,7 @@
+#ifndef HOST_SOC_CAPS_H
+#define HOST_SOC_CAPS_H
+
+// The simulated target is an ESP32-S3 with the OTG peripheral.
+#define SOC_USB_OTG_SUPPORTED 1
+
+#endif
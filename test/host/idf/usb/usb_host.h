@@ -0,0 +1,36 @@
+#ifndef HOST_USB_HOST_H
+#define HOST_USB_HOST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef struct usb_device_handle_s* usb_device_handle_t;
+
+typedef union {
+  struct {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+  };
+  uint8_t val[2];
+} usb_standard_desc_t;
+
+typedef struct {
+  bool skip_phy_setup;
+  bool root_port_unpowered;
+  int intr_flags;
+} usb_host_config_t;
+
+#define USB_HOST_LIB_EVENT_FLAGS_NO_CLIENTS 0x01
+#define USB_HOST_LIB_EVENT_FLAGS_ALL_FREE 0x02
+
+esp_err_t usb_host_install(const usb_host_config_t* config);
+esp_err_t usb_host_uninstall(void);
+esp_err_t usb_host_lib_handle_events(TickType_t timeout_ticks,
+                                     uint32_t* event_flags_ret);
+esp_err_t usb_host_lib_unblock(void);
+esp_err_t usb_host_device_free_all(void);
+
+#endif
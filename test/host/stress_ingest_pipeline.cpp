@@ -0,0 +1,323 @@
+// Host stress for the DataProcessor ingest/web split. The ingest half runs on
+// its own std::thread exactly as the pinned FreeRTOS task does on target; the
+// main thread plays loop() and applies results. Built by
+// scripts/run_concurrency_stress.sh, including the ThreadSanitizer pass.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// MeasurementPolicy.h has a pre-existing GCC-only -Wclass-memaccess warning
+// and this stress target is built with -Werror.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wclass-memaccess"
+#endif
+#include "lib/DataProcessor.h"
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+class LockedFakeTransport : public MonitorTransport {
+public:
+  bool begin() override { return true; }
+  void poll() override {}
+  int available() override {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(bytes.size());
+  }
+  int read() override {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (bytes.empty()) return -1;
+    const uint8_t value = bytes.front();
+    bytes.pop_front();
+    return value;
+  }
+  const char* name() const override { return "STRESS"; }
+  MonitorTransportState state() const override { return TRANSPORT_STATE_READY; }
+  String detail() const override { return String("stress"); }
+
+  void feed(const char* value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (*value) bytes.push_back(static_cast<uint8_t>(*value++));
+  }
+  bool empty() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes.empty();
+  }
+
+private:
+  std::mutex mutex;
+  std::deque<uint8_t> bytes;
+};
+
+static int stressIngestTaskSplit() {
+  static constexpr int kFrames = 1500;
+  Preferences::__reset();
+  BP_Parser parser{String("OMRON-HBP9030")};
+  BP_RecordManager records{5};
+  ReceiveDiagnostic diagnostic;
+  String transportName;
+  String transportStatus;
+  MonitorTransportSummary summary;
+  MeasurementSnapshotPublisher snapshot;
+  LockedFakeTransport transport;
+  DataProcessor processor{&parser, &records, &diagnostic, &transportName,
+                          &transportStatus, &summary, &snapshot, &transport};
+  records.loadFromStorage();
+  processor.setup();
+  processor.useConcurrentIngest(true);
+
+  std::atomic<bool> feederDone{false};
+  std::atomic<bool> stopIngest{false};
+  std::atomic<bool> stopReader{false};
+  std::atomic<int> readerFailure{0};
+  std::atomic<uint32_t> snapshotReads{0};
+  std::thread feeder([&]() {
+    char frame[80];
+    for (int i = 0; i < kFrames; ++i) {
+      std::snprintf(frame, sizeof(frame),
+                    "2026,07,11,09,05,12345678901234567890,0,%03d,080,072,0\r\n",
+                    100 + (i % 80));
+      transport.feed(frame);
+      if (i % 64 == 0) std::this_thread::yield();
+    }
+    feederDone.store(true, std::memory_order_release);
+  });
+  std::thread ingest([&]() {
+    while (!stopIngest.load(std::memory_order_acquire)) {
+      processor.ingestIncomingData();
+      processor.checkActivity();
+      std::this_thread::yield();
+    }
+  });
+
+  // Web reader: every snapshot must be internally consistent (revision,
+  // latest record and diagnostic from the same publication) and monotonic.
+  std::thread reader([&]() {
+    uint64_t lastSeen = 0;
+    while (!stopReader.load(std::memory_order_acquire)) {
+      const MeasurementSnapshot view = snapshot.read();
+      snapshotReads.fetch_add(1, std::memory_order_relaxed);
+      if (view.revision < lastSeen) readerFailure.store(1);
+      if (view.revision > 0) {
+        const int expected = 100 + static_cast<int>((view.revision - 1) % 80);
+        if (view.latest.recordSequence != view.revision ||
+            view.latest.systolic != expected ||
+            view.diagnostic.systolic != expected ||
+            view.diagnostic.status != ReceiveDiagnosticStatus::VALID) {
+          readerFailure.store(2);
+        }
+      }
+      lastSeen = view.revision;
+    }
+  });
+
+  uint64_t lastRevision = 0;
+  uint32_t idleRounds = 0;
+  int failure = 0;
+  while (records.getRevision() < static_cast<uint64_t>(kFrames)) {
+    processor.processIncomingData();
+    const uint64_t revision = records.getRevision();
+    if (revision < lastRevision) failure = 1;
+    if (revision != lastRevision) {
+      const int expected = 100 + static_cast<int>((revision - 1) % 80);
+      if (records.getLatestRecord().systolic != expected) failure = 2;
+      if (diagnostic.status != ReceiveDiagnosticStatus::VALID) failure = 3;
+      idleRounds = 0;
+    } else if (feederDone.load(std::memory_order_acquire) &&
+               transport.empty() && ++idleRounds > 2000000U) {
+      failure = 4;  // A result was lost between the two threads.
+      break;
+    }
+    lastRevision = revision;
+    std::this_thread::yield();
+  }
+  stopIngest.store(true, std::memory_order_release);
+  stopReader.store(true, std::memory_order_release);
+  ingest.join();
+  reader.join();
+  feeder.join();
+  if (readerFailure.load() != 0) failure = 10 + readerFailure.load();
+  processor.processIncomingData();
+
+  if (failure != 0 || records.getRevision() != static_cast<uint64_t>(kFrames) ||
+      summary.state != TRANSPORT_STATE_READY) {
+    std::fprintf(stderr, "ingest split stress failed: revision=%llu failure=%d\n",
+                 static_cast<unsigned long long>(records.getRevision()), failure);
+    return 1;
+  }
+  std::printf("Ingest task split stress passed: %d frames in order, "
+              "%u consistent snapshot reads.\n",
+              kFrames, snapshotReads.load());
+  return 0;
+}
+
+// Several monitors behind one hub: each producer thread stands in for one
+// CDC data callback and commits 64-byte transfers, so frames from different
+// devices interleave mid-line the way a hub delivers them.
+class MultiDeviceFakeTransport : public MonitorTransport {
+public:
+  explicit MultiDeviceFakeTransport(uint8_t devices) : _devices(devices) {}
+
+  bool begin() override { return true; }
+  void poll() override {}
+  int available() override {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(events.size());
+  }
+  int read() override {
+    MonitorRxEvent event;
+    if (!nextRxEvent(event) || event.type != MonitorRxEventType::BYTE) return -1;
+    return event.byte;
+  }
+  bool nextRxEvent(MonitorRxEvent& event) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (events.empty()) return false;
+    event = events.front();
+    events.pop_front();
+    return true;
+  }
+  const char* name() const override { return "STRESS-HUB"; }
+  MonitorTransportState state() const override { return TRANSPORT_STATE_READY; }
+  String detail() const override { return String("stress hub"); }
+  uint8_t deviceCount() const override { return _devices; }
+
+  void feedTransfer(uint8_t device, const char* data, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < length; ++i) {
+      MonitorRxEvent event;
+      event.type = MonitorRxEventType::BYTE;
+      event.byte = static_cast<uint8_t>(data[i]);
+      event.device = device;
+      events.push_back(event);
+    }
+  }
+  bool empty() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events.empty();
+  }
+
+private:
+  const uint8_t _devices;
+  std::mutex mutex;
+  std::deque<MonitorRxEvent> events;
+};
+
+static int multiDeviceSystolic(uint8_t device, int index) {
+  return 100 + device * 30 + index % 30;
+}
+
+static int stressMultiDeviceIngest() {
+  static constexpr uint8_t kDevices = kMaxMonitorDevices;
+  static constexpr int kFramesPerDevice = 150;
+  static constexpr int kTotal = kDevices * kFramesPerDevice;
+  static constexpr size_t kTransferBytes = 64;
+  Preferences::__reset();
+  BP_Parser parser{String("OMRON-HBP9030")};
+  BP_RecordManager records{kTotal};
+  ReceiveDiagnostic diagnostic;
+  String transportName;
+  String transportStatus;
+  MonitorTransportSummary summary;
+  MeasurementSnapshotPublisher snapshot;
+  MultiDeviceFakeTransport transport(kDevices);
+  DataProcessor processor{&parser, &records, &diagnostic, &transportName,
+                          &transportStatus, &summary, &snapshot, &transport};
+  records.loadFromStorage();
+  processor.setup();
+  processor.useConcurrentIngest(true);
+
+  std::atomic<int> producersDone{0};
+  std::atomic<bool> stopIngest{false};
+  std::atomic<size_t> bytesFed{0};
+  const auto started = std::chrono::steady_clock::now();
+  std::thread producers[kDevices];
+  for (uint8_t device = 0; device < kDevices; ++device) {
+    producers[device] = std::thread([&, device]() {
+      std::string stream;
+      char frame[80];
+      for (int i = 0; i < kFramesPerDevice; ++i) {
+        std::snprintf(frame, sizeof(frame),
+                      "2026,07,11,09,05,12345678901234567890,0,%03d,080,072,0\r\n",
+                      multiDeviceSystolic(device, i));
+        stream += frame;
+      }
+      for (size_t offset = 0; offset < stream.size(); offset += kTransferBytes) {
+        const size_t length = stream.size() - offset < kTransferBytes
+          ? stream.size() - offset : kTransferBytes;
+        transport.feedTransfer(device, stream.data() + offset, length);
+        std::this_thread::yield();
+      }
+      bytesFed.fetch_add(stream.size(), std::memory_order_relaxed);
+      producersDone.fetch_add(1, std::memory_order_release);
+    });
+  }
+  std::thread ingest([&]() {
+    while (!stopIngest.load(std::memory_order_acquire)) {
+      processor.ingestIncomingData();
+      std::this_thread::yield();
+    }
+  });
+
+  uint32_t idleRounds = 0;
+  uint64_t lastRevision = 0;
+  int failure = 0;
+  while (records.getRevision() < static_cast<uint64_t>(kTotal)) {
+    processor.processIncomingData();
+    const uint64_t revision = records.getRevision();
+    if (revision != lastRevision) {
+      idleRounds = 0;
+    } else if (producersDone.load(std::memory_order_acquire) == kDevices &&
+               transport.empty() && ++idleRounds > 2000000U) {
+      failure = 1;  // A frame was lost or corrupted by interleaving.
+      break;
+    }
+    lastRevision = revision;
+    std::this_thread::yield();
+  }
+  const double seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - started).count();
+  stopIngest.store(true, std::memory_order_release);
+  ingest.join();
+  for (std::thread& producer : producers) producer.join();
+  processor.processIncomingData();
+
+  // Oldest to newest: each device's records must appear in send order.
+  int nextIndex[kDevices] = {};
+  for (int i = records.getRecordCount() - 1; i >= 0 && failure == 0; --i) {
+    const BPData& record = records.getRecord(i);
+    if (record.deviceSlot >= kDevices) {
+      failure = 2;
+    } else if (record.systolic !=
+               multiDeviceSystolic(record.deviceSlot,
+                                   nextIndex[record.deviceSlot]++)) {
+      failure = 3;
+    }
+  }
+  for (uint8_t device = 0; device < kDevices && failure == 0; ++device) {
+    if (nextIndex[device] != kFramesPerDevice) failure = 4;
+  }
+  if (failure == 0 && summary.deviceCount != kDevices) failure = 5;
+
+  if (failure != 0 || records.getRevision() != static_cast<uint64_t>(kTotal)) {
+    std::fprintf(stderr, "multi-device ingest stress failed: revision=%llu "
+                 "failure=%d\n",
+                 static_cast<unsigned long long>(records.getRevision()), failure);
+    return 1;
+  }
+  std::printf("Multi-device ingest stress passed: %d devices x %d frames in "
+              "per-device order, %.0f KiB/s through ingest.\n",
+              kDevices, kFramesPerDevice,
+              bytesFed.load() / 1024.0 / (seconds > 0 ? seconds : 1));
+  return 0;
+}
+
+int main() {
+  if (stressIngestTaskSplit() != 0) return 1;
+  return stressMultiDeviceIngest();
+}
@@ -1,5 +1,6 @@
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -30,6 +31,20 @@ public:
     return true;
   }
 
+  // Consumer-side bulk receive, like xStreamBufferReceive(..., length, 0).
+  size_t popBulk(T* values, size_t maxCount) {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    const size_t head = _head.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (count < maxCount && tail != head) {
+      values[count++] = _items[tail];
+      _items[tail] = T{};
+      tail = (tail + 1) % Capacity;
+    }
+    _tail.store(tail, std::memory_order_release);
+    return count;
+  }
+
   bool empty() const {
     return _tail.load(std::memory_order_acquire) ==
            _head.load(std::memory_order_acquire);
@@ -41,6 +56,25 @@ private:
   std::atomic<size_t> _tail{0};
 };
 
+// std::mutex that counts acquisitions, so the benchmark can report lock round
+// trips per transfer exactly instead of inferring them from timing.
+class CountingMutex {
+public:
+  void lock() {
+    _mutex.lock();
+    acquisitions().fetch_add(1, std::memory_order_relaxed);
+  }
+  void unlock() { _mutex.unlock(); }
+
+  static std::atomic<uint64_t>& acquisitions() {
+    static std::atomic<uint64_t> count{0};
+    return count;
+  }
+
+private:
+  std::mutex _mutex;
+};
+
 static UsbCdcOrderedEvent control(uint32_t epoch, uint32_t boundary,
                                   uint32_t dropped = 1) {
   UsbCdcOrderedEvent event;
@@ -125,6 +159,126 @@ static int stressOrderedByteBoundary() {
   return 0;
 }
 
+struct BulkConsumerStats {
+  uint32_t delivered = 0;
+  uint32_t markers = 0;
+  uint32_t synchronizedOps = 0;  // Productive claims plus stream receives.
+  int failure = 0;
+};
+
+// Mirrors UsbCdcTransport: the producer accepts whole USB packets and bumps
+// the accepted-byte counter after the stream send; the consumer samples that
+// counter, claims, then receives up to usbCdcBulkReceiveLimit() bytes.
+// chunkCapacity == 1 reproduces the former one-byte-per-claim consumer.
+static BulkConsumerStats runBulkConsumer(size_t chunkCapacity) {
+  static constexpr uint32_t kPacket = 64;
+  static constexpr uint32_t kPackets = 4000;
+  static constexpr uint32_t kPacketsPerControl = 7;
+  static constexpr uint32_t kBoundaryStride = kPacket * kPacketsPerControl;
+  SpscRing<uint8_t, 1025> bytes;
+  UsbCdcSynchronizedState<std::mutex, 12, 2> controls;
+  controls.startSession(1);
+  std::atomic<uint32_t> accepted{0};
+  std::atomic<bool> producerDone{false};
+
+  std::thread producer([&]() {
+    uint32_t epoch = 0;
+    uint32_t value = 0;
+    for (uint32_t packet = 1; packet <= kPackets; ++packet) {
+      for (uint32_t i = 0; i < kPacket; ++i) {
+        while (!bytes.push(static_cast<uint8_t>(value % 251U))) {
+          std::this_thread::yield();
+        }
+        value++;
+      }
+      accepted.fetch_add(kPacket, std::memory_order_release);
+      if (packet % kPacketsPerControl == 0) {
+        while (controls.pendingCount() >= 12) std::this_thread::yield();
+        controls.publish(control(++epoch, accepted.load(
+          std::memory_order_acquire)), true);
+      }
+    }
+    producerDone.store(true, std::memory_order_release);
+  });
+
+  BulkConsumerStats stats;
+  UsbCdcOrderedCursor cursor;
+  cursor.beginSession(1, 0, 0);
+  uint8_t chunk[64] = {};
+  if (chunkCapacity > sizeof(chunk)) chunkCapacity = sizeof(chunk);
+  while (true) {
+    const uint32_t snapshot = accepted.load(std::memory_order_acquire);
+    UsbCdcOrderedDelivery delivery;
+    UsbCdcOrderedClaimResult claim = controls.claim(cursor, delivery, false);
+    if (claim == UsbCdcOrderedClaimResult::CLAIMED) {
+      if (delivery.event.byteBoundary != cursor.deliveredByteSequence()) {
+        stats.failure = 3;
+      }
+      cursor.applyControl(delivery.event);
+      stats.markers++;
+      stats.synchronizedOps++;
+      continue;
+    }
+    const size_t limit =
+      usbCdcBulkReceiveLimit(cursor, snapshot, delivery, chunkCapacity);
+    const size_t received = limit == 0 ? 0 : bytes.popBulk(chunk, limit);
+    if (received > 0) {
+      const uint32_t start = stats.delivered;
+      const uint32_t end = start + static_cast<uint32_t>(received);
+      // A chunk may end on a control boundary but never straddle one.
+      if ((start / kBoundaryStride) != ((end - 1) / kBoundaryStride) &&
+          end % kBoundaryStride != 0) {
+        stats.failure = 4;
+      }
+      for (size_t i = 0; i < received; ++i) {
+        if (chunk[i] != static_cast<uint8_t>((start + i) % 251U)) {
+          stats.failure = 5;
+        }
+      }
+      cursor.noteBytesDelivered(static_cast<uint32_t>(received));
+      stats.delivered = end;
+      stats.synchronizedOps += 2;
+      continue;
+    }
+    if (producerDone.load(std::memory_order_acquire) && bytes.empty() &&
+        controls.pendingCount() == 0) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  producer.join();
+  if (stats.delivered != kPackets * kPacket ||
+      stats.markers != kPackets / kPacketsPerControl) {
+    stats.failure = stats.failure == 0 ? 6 : stats.failure;
+  }
+  return stats;
+}
+
+static int stressBulkReceiveBoundary() {
+  const BulkConsumerStats perByte = runBulkConsumer(1);
+  const BulkConsumerStats bulk = runBulkConsumer(64);
+  if (perByte.failure != 0 || bulk.failure != 0) {
+    std::fprintf(stderr, "bulk receive stress failed: per_byte=%d bulk=%d\n",
+                 perByte.failure, bulk.failure);
+    return 27;
+  }
+  const double perByteOps =
+    static_cast<double>(perByte.synchronizedOps) / perByte.delivered;
+  const double bulkOps =
+    static_cast<double>(bulk.synchronizedOps) / bulk.delivered;
+  if (bulkOps * 10.0 > perByteOps) {
+    std::fprintf(stderr,
+                 "bulk receive did not cut consumer work: %.4f vs %.4f ops/byte\n",
+                 bulkOps, perByteOps);
+    return 28;
+  }
+  std::printf("USB bulk receive stress passed: %u bytes, %u controls, "
+              "%.4f vs %.4f synchronized ops/byte (%.0fx).\n",
+              bulk.delivered, bulk.markers, bulkOps, perByteOps,
+              perByteOps / bulkOps);
+  return 0;
+}
+
 static int stressFallbackClaimAndPublish() {
   static constexpr uint32_t kControls = 100000;
   UsbCdcSynchronizedState<std::mutex, 4, 2> channel;
@@ -447,9 +601,162 @@ static int deterministicQueuedResumeWithFallbackRace() {
   return 0;
 }
 
+// Lock-free admitted commits racing a terminal latch: once the terminal side
+// has observed quiescence and stamped its boundary, no later commit may add
+// bytes, exactly like the leased path above.
+static int stressAdmittedCommitVsTerminal() {
+  static constexpr uint32_t kSessions = 5000;
+  for (uint32_t session = 1; session <= kSessions; ++session) {
+    UsbCdcSynchronizedState<std::mutex, 4, 1> shared;
+    shared.startSession(session);
+    int slot = shared.acquireContext(session);
+    if (slot < 0) return 29;
+    const size_t index = static_cast<size_t>(slot);
+    UsbCdcConfigToken token = shared.configurationToken();
+    if (!shared.commitConfiguration(token,
+                                    UsbCdcOrderedPublishResult::QUEUED)) {
+      return 30;
+    }
+    std::atomic<uint32_t> accepted{0};
+    std::atomic<bool> start{false};
+    std::atomic<bool> boundaryStamped{false};
+    std::atomic<uint32_t> lateCommits{0};
+
+    std::thread callback([&]() {
+      while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+      for (uint32_t transfer = 0; transfer < 64; ++transfer) {
+        auto commit = shared.acquireAdmittedByteCommit(index, session);
+        if (!commit) continue;
+        if (boundaryStamped.load(std::memory_order_acquire)) {
+          lateCommits.fetch_add(1, std::memory_order_relaxed);
+        }
+        accepted.fetch_add(1, std::memory_order_release);
+      }
+    });
+    start.store(true, std::memory_order_release);
+    if ((session & 3U) == 0) std::this_thread::yield();
+    shared.latchTerminal(session);
+    while (!shared.callbacksQuiescent(index, session)) {
+      std::this_thread::yield();
+    }
+    const uint32_t boundary = accepted.load(std::memory_order_acquire);
+    boundaryStamped.store(true, std::memory_order_release);
+    callback.join();
+    if (lateCommits.load() != 0 ||
+        accepted.load(std::memory_order_acquire) != boundary) {
+      std::fprintf(stderr, "admitted commit crossed terminal boundary: "
+                   "session=%u boundary=%u accepted=%u\n",
+                   session, boundary, accepted.load());
+      return 31;
+    }
+  }
+  std::printf("USB lock-free admission terminal race passed: %u sessions.\n",
+              kSessions);
+  return 0;
+}
+
+struct TransferBenchmark {
+  double nsPerTransfer = 0;
+  double locksPerTransfer = 0;
+  uint32_t claims = 0;
+};
+
+// Producer runs the per-transfer admission a USB data callback performs while
+// a consumer polls claim() as nextRxEvent() does. `lockFree` selects the
+// steady-state acquireAdmittedByteCommit() path; otherwise the producer runs
+// the leased sequence (acquireCallback, producerEpoch, byte commit, two
+// releases) and the consumer pays one lock per poll, as the former locked
+// claim did.
+static TransferBenchmark runTransferBenchmark(bool lockFree) {
+  static constexpr uint32_t kTransfers = 200000;
+  static constexpr uint32_t kPacket = 64;
+  UsbCdcSynchronizedState<CountingMutex, 16, 1> shared;
+  shared.startSession(1);
+  const size_t slot = static_cast<size_t>(shared.acquireContext(1));
+  shared.commitConfiguration(shared.configurationToken(),
+                             UsbCdcOrderedPublishResult::QUEUED);
+  std::atomic<uint32_t> accepted{0};
+  std::atomic<bool> producerDone{false};
+  std::atomic<bool> consumerReady{false};
+  TransferBenchmark result;
+
+  std::thread consumer([&]() {
+    UsbCdcOrderedCursor cursor;
+    cursor.beginSession(1, 0, 0);
+    consumerReady.store(true, std::memory_order_release);
+    while (!producerDone.load(std::memory_order_acquire)) {
+      UsbCdcOrderedDelivery delivery;
+      if (!lockFree) shared.quarantined();
+      if (shared.claim(cursor, delivery, true) ==
+          UsbCdcOrderedClaimResult::CLAIMED) {
+        result.claims++;
+      }
+      const uint32_t snapshot = accepted.load(std::memory_order_acquire);
+      cursor.noteBytesDelivered(snapshot - cursor.deliveredByteSequence());
+    }
+  });
+  while (!consumerReady.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  const uint64_t locksBefore = CountingMutex::acquisitions().load();
+  const auto started = std::chrono::steady_clock::now();
+  for (uint32_t transfer = 0; transfer < kTransfers; ++transfer) {
+    if (lockFree) {
+      auto commit = shared.acquireAdmittedByteCommit(slot, 1);
+      if (commit) accepted.fetch_add(kPacket, std::memory_order_release);
+    } else {
+      auto lease = shared.acquireCallback(slot, 1);
+      const uint32_t epoch = shared.producerEpoch();
+      UsbCdcByteAdmission admission = UsbCdcByteAdmission::REJECTED_INACTIVE;
+      auto commit = shared.acquireByteCommitOrRecordDrop(
+        slot, 1, epoch, kPacket, admission);
+      if (lease && commit) {
+        accepted.fetch_add(kPacket, std::memory_order_release);
+      }
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - started;
+  const uint64_t producerLocks = CountingMutex::acquisitions().load() - locksBefore;
+  producerDone.store(true, std::memory_order_release);
+  consumer.join();
+
+  result.nsPerTransfer = static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+    kTransfers;
+  // Includes the consumer's polls during the run: that is the contention.
+  result.locksPerTransfer = static_cast<double>(producerLocks) / kTransfers;
+  if (accepted.load() != kTransfers * kPacket) result.claims = UINT32_MAX;
+  return result;
+}
+
+static int benchmarkTransferContention() {
+  const TransferBenchmark locked = runTransferBenchmark(false);
+  const TransferBenchmark lockFree = runTransferBenchmark(true);
+  if (locked.claims == UINT32_MAX || lockFree.claims == UINT32_MAX) {
+    std::fprintf(stderr, "transfer benchmark lost admissions\n");
+    return 32;
+  }
+  // Lock counts are deterministic; timings are informational (TSan and
+  // shared CI hosts make them noisy).
+  if (locked.locksPerTransfer < 5.0 || lockFree.locksPerTransfer != 0.0) {
+    std::fprintf(stderr, "transfer benchmark lock counts: locked=%.2f "
+                 "lock-free=%.2f per transfer\n",
+                 locked.locksPerTransfer, lockFree.locksPerTransfer);
+    return 33;
+  }
+  std::printf("USB transfer contention benchmark: locked %.1f ns/transfer "
+              "(%.2f locks), lock-free %.1f ns/transfer (%.2f locks).\n",
+              locked.nsPerTransfer, locked.locksPerTransfer,
+              lockFree.nsPerTransfer, lockFree.locksPerTransfer);
+  return 0;
+}
+
 int main() {
   int result = stressOrderedByteBoundary();
   if (result != 0) return result;
+  result = stressBulkReceiveBoundary();
+  if (result != 0) return result;
   result = stressFallbackClaimAndPublish();
   if (result != 0) return result;
   result = stressTerminalVsConfigGate();
@@ -458,5 +765,9 @@ int main() {
   if (result != 0) return result;
   result = deterministicQuarantineClaimRace();
   if (result != 0) return result;
-  return deterministicQueuedResumeWithFallbackRace();
+  result = deterministicQueuedResumeWithFallbackRace();
+  if (result != 0) return result;
+  result = stressAdmittedCommitVsTerminal();
+  if (result != 0) return result;
+  return benchmarkTransferContention();
 }
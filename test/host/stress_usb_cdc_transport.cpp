@@ -0,0 +1,587 @@
+// Host simulation of the real src/transports/UsbCdcTransport.cpp. The IDF and
+// FreeRTOS APIs come from test/host/idf, the USB bus from fake_cdc_acm_host.h:
+// producer threads play the driver task delivering bulk transfers, a chaos
+// thread unplugs and replugs monitors, and the main thread is the owner task.
+// Reports throughput, loss, reconnect time and idle wakeups; built by
+// scripts/run_concurrency_stress.sh, including the ThreadSanitizer pass.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "fake_cdc_acm_host.h"
+#include "src/transports/UsbCdcTransport.cpp"
+
+namespace {
+
+constexpr size_t kTransferBytes = 64;
+// Mirrors kIngestIdleWaitMs in BP_checker.ino.
+constexpr uint32_t kIngestIdleWaitMs = 100;
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// One monitor's driver task: numbered bytes in 64-byte transfers, paced by
+// intervalUs (0 = as fast as the callback returns).
+class Producer {
+public:
+  Producer(uint8_t device, uint32_t intervalUs)
+      : _device(device), _intervalUs(intervalUs) {}
+
+  void start() {
+    _thread = std::thread([this]() {
+      uint8_t next = 0;
+      while (!_stop.load(std::memory_order_acquire)) {
+        uint8_t chunk[kTransferBytes];
+        for (uint8_t& byte : chunk) byte = next++;
+        hostUsbTransfer(_device, chunk, sizeof(chunk));
+        if (_limit != 0 && ++_sent >= _limit) break;
+        if (_intervalUs > 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(_intervalUs));
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      _done.store(true, std::memory_order_release);
+    });
+  }
+
+  void limitTransfers(uint32_t limit) { _limit = limit; }
+  bool done() const { return _done.load(std::memory_order_acquire); }
+
+  void stop() {
+    _stop.store(true, std::memory_order_release);
+    if (_thread.joinable()) _thread.join();
+  }
+
+private:
+  const uint8_t _device;
+  const uint32_t _intervalUs;
+  uint32_t _limit = 0;
+  uint32_t _sent = 0;
+  std::atomic<bool> _stop{false};
+  std::atomic<bool> _done{false};
+  std::thread _thread;
+};
+
+// The owner task: poll(), drain, advance the fake clock one millisecond.
+// Bytes must stay consecutive per device except across a reported
+// DISCONTINUITY or STREAM_RESET.
+struct Owner {
+  explicit Owner(UsbCdcTransport& transportRef) : transport(transportRef) {}
+
+  void pump(size_t budget = SIZE_MAX) {
+    transport.poll();
+    MonitorRxEvent event;
+    for (size_t n = 0; n < budget && transport.nextRxEvent(event); ++n) {
+      account(event);
+    }
+    delay(1);
+  }
+
+  bool pumpUntil(const std::function<bool()>& done, double timeoutSeconds,
+                 size_t budget = SIZE_MAX) {
+    const Clock::time_point start = Clock::now();
+    while (!done()) {
+      if (secondsSince(start) > timeoutSeconds) return false;
+      pump(budget);
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    return true;
+  }
+
+  // The extra pump refreshes the owner-side diagnostics after the last claim.
+  void drain() {
+    pumpUntil([this]() { return transport.available() == 0; }, 5.0);
+    pump();
+  }
+
+  bool connected() const {
+    const MonitorTransportState state = transport.state();
+    return state == TRANSPORT_STATE_READY || state == TRANSPORT_STATE_RECEIVING;
+  }
+
+  void account(const MonitorRxEvent& event) {
+    if (event.device >= kMaxMonitorDevices) {
+      orderFailures++;
+      return;
+    }
+    if (event.type != MonitorRxEventType::BYTE) {
+      controls++;
+      resync[event.device] = true;
+      return;
+    }
+    if (!resync[event.device] &&
+        event.byte != static_cast<uint8_t>(lastByte[event.device] + 1)) {
+      orderFailures++;
+    }
+    resync[event.device] = false;
+    lastByte[event.device] = event.byte;
+    received[event.device]++;
+  }
+
+  uint64_t receivedTotal() const {
+    uint64_t total = 0;
+    for (uint64_t count : received) total += count;
+    return total;
+  }
+
+  UsbCdcTransport& transport;
+  uint64_t received[kMaxMonitorDevices] = {};
+  uint8_t lastByte[kMaxMonitorDevices] = {};
+  bool resync[kMaxMonitorDevices] = {true, true, true};
+  uint32_t controls = 0;
+  uint32_t orderFailures = 0;
+};
+
+int gFailures = 0;
+
+void expect(bool condition, const char* scenario, const char* what) {
+  if (condition) return;
+  gFailures++;
+  std::fprintf(stderr, "USB CDC transport simulation failed: %s: %s\n",
+               scenario, what);
+}
+
+// Daemon joined and bus cleared so the next scenario starts cold.
+void finishScenario(const char* scenario) {
+  hostJoinTasks();
+  expect(!hostUsbAnyOpen(), scenario, "destructor closed every handle");
+  expect(!hostUsbDriverInstalled(), scenario, "destructor uninstalled driver");
+  hostUsbReset();
+}
+
+void runScenario(const char* scenario, uint32_t intervalUs, size_t budget,
+                 uint32_t transfers) {
+  hostUsbReset();
+  double seconds = 0;
+  uint64_t received = 0;
+  uint32_t dropped = 0;
+  uint32_t lossEvents = 0;
+  HostUsbCounters counters;
+  {
+    UsbCdcTransport transport(kUsbCdcRxMinBytes);
+    Owner owner(transport);
+    expect(transport.begin(), scenario, "begin");
+    hostUsbAttach(0);
+    expect(owner.pumpUntil([&]() { return owner.connected(); }, 5.0), scenario,
+           "device reaches READY");
+
+    Producer producer(0, intervalUs);
+    producer.limitTransfers(transfers);
+    const Clock::time_point start = Clock::now();
+    producer.start();
+    owner.pumpUntil([&]() { return producer.done(); }, 60.0, budget);
+    producer.stop();
+    owner.drain();
+    seconds = secondsSince(start);
+
+    counters = hostUsbCounters();
+    received = owner.receivedTotal();
+    dropped = transport.droppedByteCount();
+    lossEvents = transport.dataLossCount();
+    expect(owner.orderFailures == 0, scenario, "bytes stay in order");
+    expect(received + dropped == counters.deliveredBytes, scenario,
+           "every delivered byte is received or counted as dropped");
+    expect((dropped == 0) == (lossEvents == 0), scenario,
+           "dropped bytes always surface as a loss event");
+  }
+  finishScenario(scenario);
+  std::printf("USB CDC transport %s: %.0f KiB/s delivered, %.0f KiB/s "
+              "received, %u bytes dropped (%.2f%%) in %u loss events.\n",
+              scenario, counters.deliveredBytes / 1024.0 / seconds,
+              received / 1024.0 / seconds, dropped,
+              counters.deliveredBytes == 0
+                ? 0.0 : 100.0 * dropped / counters.deliveredBytes,
+              lossEvents);
+}
+
+void runReconnectScenario() {
+  const char* scenario = "reconnect";
+  static constexpr int kCycles = 12;
+  hostUsbReset();
+  // Data interface at index 1, so only the first connection has to probe.
+  hostUsbSetIdentity(0, 0x0590, 0x0100, 1);
+  uint32_t reconnectMs[kCycles] = {};
+  int reconnected = 0;
+  uint32_t reconnects = 0;
+  UsbCdcReconnectTelemetry telemetry;
+  uint32_t openCalls = 0;
+  uint32_t lineCodings = 0;
+  uint32_t nonDefaultLineCodings = 0;
+  {
+    UsbCdcTransport transport(kUsbCdcRxMinBytes);
+    Owner owner(transport);
+    expect(transport.begin(), scenario, "begin");
+    hostUsbAttach(0);
+    expect(owner.pumpUntil([&]() { return owner.connected(); }, 5.0), scenario,
+           "device reaches READY");
+
+    Producer producer(0, 20);
+    producer.start();
+    std::atomic<bool> chaosDone{false};
+    std::thread chaos([&]() {
+      for (int cycle = 0; cycle < kCycles; ++cycle) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        const uint32_t opensBefore = hostUsbCounters().opens;
+        hostUsbDisconnect(0);  // Mid-transfer: the producer keeps sending.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        hostUsbAttach(0);
+        const unsigned long attachedMs = millis();
+        const Clock::time_point start = Clock::now();
+        while (hostUsbCounters().opens == opensBefore && secondsSince(start) < 10) {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        if (hostUsbCounters().opens == opensBefore) break;
+        reconnectMs[reconnected++] = static_cast<uint32_t>(millis() - attachedMs);
+      }
+      chaosDone.store(true, std::memory_order_release);
+    });
+    owner.pumpUntil([&]() { return chaosDone.load(std::memory_order_acquire); },
+                    120.0);
+    chaos.join();
+    owner.pumpUntil([&]() { return owner.connected(); }, 10.0);
+    producer.stop();
+    owner.drain();
+    reconnects = transport.reconnectCount();
+    telemetry = transport.reconnectTelemetry();
+    openCalls = hostUsbCounters().openCalls;
+    lineCodings = hostUsbCounters().lineCodings;
+    nonDefaultLineCodings = hostUsbCounters().nonDefaultLineCodings;
+    expect(owner.orderFailures == 0, scenario,
+           "no byte crosses a disconnect without a boundary");
+    expect(owner.controls >= static_cast<uint32_t>(kCycles), scenario,
+           "every disconnect is reported to the consumer");
+    expect(owner.receivedTotal() <= hostUsbCounters().deliveredBytes, scenario,
+           "nothing is fabricated");
+  }
+  finishScenario(scenario);
+  expect(reconnected == kCycles, scenario, "every replug reopens the device");
+  expect(reconnects == static_cast<uint32_t>(kCycles), scenario,
+         "reconnect counter matches replugs");
+  expect(telemetry.probedOpens == 1, scenario, "only the first open probes");
+  expect(telemetry.fastPathOpens == static_cast<uint32_t>(kCycles), scenario,
+         "every replug takes the cached-profile path");
+  expect(telemetry.samples() == static_cast<uint32_t>(kCycles), scenario,
+         "every reconnect lands in the time-to-READY histogram");
+  expect(openCalls == 2 + static_cast<uint32_t>(kCycles), scenario,
+         "a returning device costs one open call");
+  expect(lineCodings == 1 + static_cast<uint32_t>(kCycles) &&
+           nonDefaultLineCodings == 0,
+         scenario, "fast-path and probed opens both apply 9600 8N1");
+  uint32_t minMs = UINT32_MAX, maxMs = 0;
+  uint64_t sumMs = 0;
+  for (int i = 0; i < reconnected; ++i) {
+    minMs = reconnectMs[i] < minMs ? reconnectMs[i] : minMs;
+    maxMs = reconnectMs[i] > maxMs ? reconnectMs[i] : maxMs;
+    sumMs += reconnectMs[i];
+  }
+  std::printf("USB CDC transport reconnect: %d/%d replugs reopened, attach to "
+              "open %u/%llu/%u ms (min/avg/max, transport clock).\n",
+              reconnected, kCycles, reconnected ? minMs : 0,
+              static_cast<unsigned long long>(reconnected ? sumMs / reconnected
+                                                          : 0),
+              maxMs);
+  std::printf("USB CDC transport reconnect: %u fast-path and %u probed opens "
+              "in %u open calls; attach to READY histogram (ms",
+              telemetry.fastPathOpens, telemetry.probedOpens, openCalls);
+  for (size_t i = 0; i + 1 < kUsbCdcReadyBucketCount; ++i) {
+    std::printf(" <=%u", kUsbCdcReadyBucketLimitsMs[i]);
+  }
+  std::printf(" >):");
+  for (size_t i = 0; i < kUsbCdcReadyBucketCount; ++i) {
+    std::printf(" %u", telemetry.readyByBucket[i]);
+  }
+  std::printf(", max %u ms.\n", telemetry.maxReadyMs);
+}
+
+// A different monitor on a port with a cached profile must still be found,
+// and a returning one whose first opens fail retries on the fast schedule.
+void runDeviceSwapScenario() {
+  const char* scenario = "device swap";
+  hostUsbReset();
+  UsbCdcReconnectTelemetry telemetry;
+  uint64_t retryReadyMs = 0;
+  {
+    UsbCdcTransport transport(kUsbCdcRxMinBytes);
+    Owner owner(transport);
+    expect(transport.begin(), scenario, "begin");
+    hostUsbAttach(0);
+    expect(owner.pumpUntil([&]() { return owner.connected(); }, 5.0), scenario,
+           "first monitor reaches READY");
+    hostUsbDisconnect(0);
+    expect(owner.pumpUntil([&]() { return !owner.connected(); }, 5.0),
+           scenario, "unplug is seen");
+    hostUsbAttach(1);
+    expect(owner.pumpUntil([&]() { return owner.connected(); }, 5.0), scenario,
+           "a different monitor is probed and opened");
+    telemetry = transport.reconnectTelemetry();
+
+    hostUsbDisconnect(1);
+    expect(owner.pumpUntil([&]() { return !owner.connected(); }, 5.0),
+           scenario, "second unplug is seen");
+    {
+      std::lock_guard<std::mutex> guard(hostUsbBus().mutex);
+      hostUsbBus().openFailures = 2;
+    }
+    const unsigned long attachedMs = millis();
+    hostUsbAttach(1);
+    expect(owner.pumpUntil([&]() { return owner.connected(); }, 10.0),
+           scenario, "returning monitor recovers from failed opens");
+    retryReadyMs = millis() - attachedMs;
+  }
+  finishScenario(scenario);
+  expect(telemetry.fastPathOpens == 0 && telemetry.probedOpens == 2, scenario,
+         "a swapped device is probed, not forced onto the old profile");
+  expect(retryReadyMs < 1000, scenario,
+         "fast retries beat the one-second back-off");
+  std::printf("USB CDC transport device swap: new monitor probed; returning "
+              "monitor READY %llu ms after failed opens (transport "
+              "clock).\n", static_cast<unsigned long long>(retryReadyMs));
+}
+
+void runHubScenario() {
+  const char* scenario = "hub";
+  hostUsbReset();
+  uint64_t received[2] = {};
+  {
+    UsbCdcTransport transport(kUsbCdcRxMinBytes, 2);
+    Owner owner(transport);
+    expect(transport.begin(), scenario, "begin");
+    hostUsbAttach(0);
+    hostUsbAttach(1);
+    expect(owner.pumpUntil([&]() {
+             return transport.deviceSummary(0).state != TRANSPORT_STATE_WAITING_DEVICE &&
+                    transport.deviceSummary(1).state != TRANSPORT_STATE_WAITING_DEVICE &&
+                    hostUsbCounters().opens == 2;
+           }, 10.0), scenario, "each port claims its own device");
+    Producer first(0, 0);
+    Producer second(1, 0);
+    first.limitTransfers(1500);
+    second.limitTransfers(1500);
+    first.start();
+    second.start();
+    owner.pumpUntil([&]() { return first.done() && second.done(); }, 60.0);
+    first.stop();
+    second.stop();
+    owner.drain();
+    received[0] = owner.received[0];
+    received[1] = owner.received[1];
+    expect(owner.orderFailures == 0, scenario, "per-device order holds");
+    expect(owner.receivedTotal() + transport.droppedByteCount() ==
+             hostUsbCounters().deliveredBytes, scenario,
+           "per-port accounting sums to delivered bytes");
+  }
+  finishScenario(scenario);
+  expect(received[0] > 0 && received[1] > 0, scenario,
+         "both monitors are served");
+  std::printf("USB CDC transport hub: device 0 %llu bytes, device 1 %llu "
+              "bytes, order kept per device.\n",
+              static_cast<unsigned long long>(received[0]),
+              static_cast<unsigned long long>(received[1]));
+}
+
+// The firmware's ingest task on its own thread, which becomes the transport
+// owner: either one tick between passes (the polling loop) or blocked on the
+// transport's wake callback with the firmware's idle timeout.
+class IngestLoop {
+public:
+  IngestLoop(UsbCdcTransport& transport, bool eventDriven)
+      : _owner(transport), _eventDriven(eventDriven) {}
+
+  static void wake(void* context) {
+    auto* loop = static_cast<IngestLoop*>(context);
+    std::lock_guard<std::mutex> guard(loop->_mutex);
+    loop->_pending = true;
+    loop->_signal.notify_one();
+  }
+
+  void start() {
+    _thread = std::thread([this]() {
+      while (!_stop.load(std::memory_order_acquire)) {
+        _owner.pump();
+        _connected.store(_owner.connected(), std::memory_order_release);
+        _passes.fetch_add(1, std::memory_order_relaxed);
+        waitForWork();
+      }
+    });
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      _stop.store(true, std::memory_order_release);
+      _signal.notify_one();
+    }
+    if (_thread.joinable()) _thread.join();
+  }
+
+  uint32_t passes() const { return _passes.load(std::memory_order_relaxed); }
+  bool connected() const { return _connected.load(std::memory_order_acquire); }
+  // After stop() only: the owner's counters belong to the loop thread.
+  const Owner& owner() const { return _owner; }
+
+private:
+  void waitForWork() {
+    if (!_eventDriven) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _signal.wait_for(lock, std::chrono::milliseconds(kIngestIdleWaitMs),
+                     [this]() {
+                       return _pending ||
+                              _stop.load(std::memory_order_acquire);
+                     });
+    _pending = false;
+  }
+
+  Owner _owner;
+  const bool _eventDriven;
+  std::mutex _mutex;
+  std::condition_variable _signal;
+  bool _pending = false;
+  std::atomic<bool> _stop{false};
+  std::atomic<bool> _connected{false};
+  std::atomic<uint32_t> _passes{0};
+  std::thread _thread;
+};
+
+bool waitFor(const std::function<bool()>& done, double timeoutSeconds) {
+  const Clock::time_point start = Clock::now();
+  while (!done()) {
+    if (secondsSince(start) > timeoutSeconds) return false;
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+  return true;
+}
+
+// Idle cost and replug latency of one owner strategy: wakeups per second of
+// the owner and the host daemon on a quiet bus, then attach to open in real
+// time (not the transport clock, which only advances per owner pass).
+void runWakeScenario(bool eventDriven) {
+  const char* scenario = eventDriven ? "event-driven owner" : "polling owner";
+  static constexpr int kCycles = 8;
+  static constexpr int kIdleMs = 500;
+  hostUsbReset();
+  double ownerPerSecond = 0;
+  double daemonPerSecond = 0;
+  uint64_t reconnectUs[kCycles] = {};
+  int reconnected = 0;
+  {
+    UsbCdcTransport transport(kUsbCdcRxMinBytes);
+    IngestLoop loop(transport, eventDriven);
+    if (eventDriven) {
+      expect(transport.setWakeCallback(&IngestLoop::wake, &loop), scenario,
+             "transport accepts a wake callback before begin");
+    }
+    expect(transport.begin(), scenario, "begin");
+    expect(!transport.setWakeCallback(&IngestLoop::wake, &loop), scenario,
+           "wake callback is fixed once producers run");
+    loop.start();
+    hostUsbAttach(0);
+    expect(waitFor([&]() { return loop.connected(); }, 5.0), scenario,
+           "device reaches READY");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const uint32_t passesBefore = loop.passes();
+    const uint32_t daemonBefore = hostUsbCounters().hostEventWakeups;
+    const Clock::time_point idleStart = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(kIdleMs));
+    const double idleSeconds = secondsSince(idleStart);
+    ownerPerSecond = (loop.passes() - passesBefore) / idleSeconds;
+    daemonPerSecond =
+      (hostUsbCounters().hostEventWakeups - daemonBefore) / idleSeconds;
+
+    for (int cycle = 0; cycle < kCycles; ++cycle) {
+      hostUsbDisconnect(0);
+      if (!waitFor([&]() { return !loop.connected(); }, 5.0)) break;
+      const uint32_t opensBefore = hostUsbCounters().opens;
+      const Clock::time_point attached = Clock::now();
+      hostUsbAttach(0);
+      if (!waitFor([&]() { return hostUsbCounters().opens != opensBefore; },
+                   5.0)) {
+        break;
+      }
+      reconnectUs[reconnected++] = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now() - attached).count());
+      if (!waitFor([&]() { return loop.connected(); }, 5.0)) break;
+    }
+    loop.stop();
+    expect(loop.owner().orderFailures == 0, scenario, "no ordering failures");
+  }
+  finishScenario(scenario);
+  expect(reconnected == kCycles, scenario, "every replug reopens the device");
+  if (eventDriven) {
+    expect(daemonPerSecond == 0, scenario,
+           "host daemon sleeps while the bus is idle");
+    expect(ownerPerSecond <= 1000.0 / kIngestIdleWaitMs + 2, scenario,
+           "owner wakes only for the idle timeout");
+  }
+  uint64_t minUs = UINT64_MAX, maxUs = 0, sumUs = 0;
+  for (int i = 0; i < reconnected; ++i) {
+    minUs = reconnectUs[i] < minUs ? reconnectUs[i] : minUs;
+    maxUs = reconnectUs[i] > maxUs ? reconnectUs[i] : maxUs;
+    sumUs += reconnectUs[i];
+  }
+  std::printf("USB CDC transport %s: idle bus %.0f owner and %.0f host "
+              "daemon wakeups/s; attach to open %llu/%llu/%llu us "
+              "(min/avg/max).\n",
+              scenario, ownerPerSecond, daemonPerSecond,
+              static_cast<unsigned long long>(reconnected ? minUs : 0),
+              static_cast<unsigned long long>(reconnected ? sumUs / reconnected
+                                                          : 0),
+              static_cast<unsigned long long>(maxUs));
+}
+
+// The destructor must close the handle and stop the daemon while a
+// transfer may be mid-callback.
+void runTeardownScenario() {
+  const char* scenario = "teardown";
+  hostUsbReset();
+  Producer producer(0, 0);
+  {
+    UsbCdcTransport transport(kUsbCdcRxMinBytes);
+    Owner owner(transport);
+    expect(transport.begin(), scenario, "begin");
+    hostUsbAttach(0);
+    expect(owner.pumpUntil([&]() { return owner.connected(); }, 5.0), scenario,
+           "device reaches READY");
+    producer.start();
+    owner.pumpUntil([]() { return hostUsbCounters().deliveredBytes > 4096; },
+                    10.0);
+  }
+  const uint64_t deliveredAtClose = hostUsbCounters().deliveredBytes;
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  expect(hostUsbCounters().deliveredBytes == deliveredAtClose, scenario,
+         "no callback reaches a destroyed transport");
+  producer.stop();
+  finishScenario(scenario);
+  std::printf("USB CDC transport teardown under traffic: handle closed, "
+              "daemon joined.\n");
+}
+
+}  // namespace
+
+int main() {
+  runScenario("paced", 50, SIZE_MAX, 4000);
+  runScenario("burst", 0, SIZE_MAX, 4000);
+  runScenario("slow consumer", 10, 24, 3000);
+  runReconnectScenario();
+  runDeviceSwapScenario();
+  runHubScenario();
+  runWakeScenario(false);
+  runWakeScenario(true);
+  runTeardownScenario();
+  if (gFailures != 0) return 1;
+  std::printf("USB CDC transport simulation passed.\n");
+  return 0;
+}
@@ -0,0 +1,203 @@
+// Host tests for the fixed connection table: admission stops at the slot
+// count, closing a slot wipes it for reuse, and the round-robin pump gives
+// every sending slot the same budget while a blocked peer only loses its
+// own turn.
+
+#include <Arduino.h>
+
+#include "lib/BoundedConnectionTable.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <string>
+
+using namespace bp_web;
+using bp_http::BodyMode;
+using bp_http::TransactionState;
+
+static constexpr size_t kTestSlots = 4;
+
+struct FakeNetwork {
+  uint32_t now = 100;
+  size_t readCalls = 0;
+  size_t sent[kTestSlots] = {};
+  bool blocked[kTestSlots] = {};
+};
+
+static uint32_t fakeClock(void* context) {
+  return static_cast<FakeNetwork*>(context)->now;
+}
+
+static SocketReadResult fakeRead(void* context, int, uint8_t*, size_t) {
+  ++static_cast<FakeNetwork*>(context)->readCalls;
+  return {SocketReadStatus::WOULD_BLOCK, 0};
+}
+
+// Socket descriptors in these tests are the slot index.
+static SocketWriteResult fakeWrite(void* context, int socket,
+                                   const uint8_t*, size_t length) {
+  auto* fake = static_cast<FakeNetwork*>(context);
+  if (fake->blocked[socket]) return {SocketWriteStatus::WOULD_BLOCK, 0};
+  fake->sent[socket] += length;
+  return {SocketWriteStatus::PROGRESS, length};
+}
+
+static SocketShutdownStatus fakeShutdown(void*, int) {
+  return SocketShutdownStatus::COMPLETE;
+}
+
+static BoundedSocketOps makeOps(FakeNetwork& fake) {
+  return {&fake, fakeClock, fakeRead, fakeWrite, fakeShutdown};
+}
+
+static std::string makeResponse(size_t bodyLength) {
+  std::string response =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: " + std::to_string(bodyLength) + "\r\n"
+    "Cache-Control: no-store, max-age=0\r\n"
+    "Pragma: no-cache\r\n"
+    "X-Content-Type-Options: nosniff\r\n"
+    "Connection: close\r\n\r\n";
+  response.append(bodyLength, 'x');
+  return response;
+}
+
+// Drives one slot from accept to a captured response waiting on the socket.
+static bool startSending(BoundedConnection& connection,
+                         const std::string& response, uint32_t nowMs) {
+  static const char request[] =
+    "GET / HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n";
+  bp_http::BoundedHttpTransaction& transaction = connection.transaction;
+  (void)transaction.consume(reinterpret_cast<const uint8_t*>(request),
+                            sizeof(request) - 1, nowMs);
+  return transaction.acceptPolicy(BodyMode::NONE, 0, nowMs) &&
+         transaction.beginDispatch(nowMs) &&
+         transaction.capture(
+           reinterpret_cast<const uint8_t*>(response.data()),
+           response.size()) == response.size() &&
+         transaction.finishDispatch(nowMs) &&
+         transaction.state() == TransactionState::SENDING_RESPONSE;
+}
+
+static void testAdmissionStopsAtSlotCount() {
+  FakeNetwork fake;
+  BoundedConnectionTable<kTestSlots> table(makeOps(fake));
+  CHECK_EQ(table.activeCount(), 0U, "table starts empty");
+  for (size_t i = 0; i < kTestSlots; ++i) {
+    BoundedConnection* slot = table.acquire();
+    CHECK_TRUE(slot != nullptr, "free slot is admitted");
+    CHECK_EQ(table.indexOf(*slot), i, "admission takes the first free slot");
+    slot->open(static_cast<int>(i), 0x0A000001, 0x0A000002 + i, fake.now);
+  }
+  CHECK_TRUE(table.full(), "every slot busy");
+  CHECK_TRUE(table.acquire() == nullptr,
+             "a full table admits nothing; the client stays queued");
+
+  BoundedConnection& second = table.slot(1);
+  second.role = AccessRole::STAFF;
+  second.deferredContext = &fake;
+  second.close();
+  CHECK_TRUE(!table.full(), "closing frees the slot");
+  CHECK_TRUE(table.acquire() == &second, "freed slot is admitted again");
+  CHECK_EQ(second.socket(), -1, "closed slot forgets its socket");
+  CHECK_EQ(second.remoteAddress, 0U, "closed slot forgets its peer");
+  CHECK_TRUE(second.role == AccessRole::NONE, "closed slot drops its grant");
+  CHECK_TRUE(second.deferredContext == nullptr,
+             "closed slot drops its deferred action");
+  CHECK_TRUE(second.transaction.terminal(),
+             "closing an open transaction aborts it");
+}
+
+static void testRoundRobinSharesTheSendBudget() {
+  FakeNetwork fake;
+  BoundedConnectionTable<kTestSlots> table(makeOps(fake));
+  const std::string response = makeResponse(4000);
+  for (size_t i = 0; i < 3; ++i) {
+    BoundedConnection* slot = table.acquire();
+    slot->open(static_cast<int>(i), 1, 2, fake.now);
+    CHECK_TRUE(startSending(*slot, response, fake.now), "slot is sending");
+  }
+  // Slot 2's peer stops reading; the other two must not wait for it.
+  fake.blocked[2] = true;
+
+  table.forEachActive(
+    [&](BoundedConnection& connection) { connection.pumpResponse(fake.now); });
+  CHECK_EQ(fake.sent[0], bp_http::BoundedHttpResponse::kSendBudget,
+           "one send budget per slot per pass");
+  CHECK_EQ(fake.sent[1], fake.sent[0], "same budget for every reader");
+  CHECK_EQ(fake.sent[2], 0U, "blocked peer only skips its own turn");
+
+  size_t passes = 1;
+  while (table.slot(0).transaction.state() ==
+           TransactionState::SENDING_RESPONSE && passes < 64) {
+    table.forEachActive(
+      [&](BoundedConnection& connection) {
+        connection.pumpResponse(fake.now);
+      });
+    ++passes;
+    CHECK_EQ(fake.sent[1], fake.sent[0], "readers stay in lockstep");
+  }
+  CHECK_EQ(fake.sent[0], response.size(), "first reader got everything");
+  CHECK_EQ(static_cast<int>(table.slot(1).transaction.state()),
+           static_cast<int>(TransactionState::COMPLETE),
+           "second reader finished in the same pass");
+  CHECK_EQ(static_cast<int>(table.slot(2).transaction.state()),
+           static_cast<int>(TransactionState::SENDING_RESPONSE),
+           "blocked reader is still waiting, not aborted");
+
+  fake.blocked[2] = false;
+  table.slot(2).pumpResponse(fake.now);
+  CHECK_EQ(fake.sent[2], bp_http::BoundedHttpResponse::kSendBudget,
+           "blocked reader resumes where it stopped");
+}
+
+static void testServiceOrderRotates() {
+  FakeNetwork fake;
+  BoundedConnectionTable<kTestSlots> table(makeOps(fake));
+  for (size_t i = 0; i < kTestSlots; ++i) {
+    table.acquire()->open(static_cast<int>(i), 1, 2, fake.now);
+  }
+  table.slot(2).close();
+  size_t first[3] = {};
+  for (size_t& start : first) {
+    bool seen = false;
+    size_t visits = 0;
+    table.forEachActive([&](BoundedConnection& connection) {
+      if (!seen) start = table.indexOf(connection);
+      seen = true;
+      ++visits;
+    });
+    CHECK_EQ(visits, kTestSlots - 1, "every active slot visited once");
+  }
+  CHECK_EQ(first[0], 0U, "first pass starts at slot 0");
+  CHECK_EQ(first[1], 1U, "next pass starts one further");
+  CHECK_EQ(first[2], 3U, "a free slot is skipped, not served");
+}
+
+static void testUnparsedTailIsReadBeforeTheSocket() {
+  FakeNetwork fake;
+  BoundedConnectionTable<kTestSlots> table(makeOps(fake));
+  BoundedConnection& connection = *table.acquire();
+  connection.open(0, 1, 2, fake.now);
+  CHECK_EQ(static_cast<int>(connection.receive()),
+           static_cast<int>(IngressIoResult::WOULD_BLOCK),
+           "empty ingress reads the socket");
+  CHECK_EQ(fake.readCalls, 1U, "one read per turn");
+
+  uint8_t* target = connection.ingress.writableData();
+  std::memcpy(target, "GET", 3);
+  CHECK_TRUE(connection.ingress.commit(3), "tail staged");
+  CHECK_EQ(static_cast<int>(connection.receive()),
+           static_cast<int>(IngressIoResult::PROGRESS),
+           "pending tail is progress without a read");
+  CHECK_EQ(fake.readCalls, 1U, "socket untouched while a tail waits");
+}
+
+int main() {
+  testAdmissionStopsAtSlotCount();
+  testRoundRobinSharesTheSendBudget();
+  testServiceOrderRotates();
+  testUnparsedTailIsReadBeforeTheSocket();
+  return testReport();
+}
@@ -265,6 +265,69 @@ static void testSensitiveHeadersAndMalformedLines() {
            "trailing HTAB in header value rejected");
 }
 
+static void testIfNoneMatchCaptureAndComparison() {
+  BoundedHttpRequest request;
+  request.reset(300);
+  feedAll(request,
+          "GET /static/style-0123.css HTTP/1.1\r\n"
+          "Host: bp.local\r\n"
+          "If-None-Match: W/\"old\", \"0123\"\r\n"
+          "\r\n", 300);
+  CHECK_EQ(static_cast<int>(request.state()),
+           static_cast<int>(RequestState::WAIT_POLICY),
+           "conditional GET accepted");
+  CHECK_STR(request.view().ifNoneMatch, "W/\"old\", \"0123\"",
+            "If-None-Match captured");
+  CHECK_TRUE(etagListMatches(request.view().ifNoneMatch, "\"0123\""),
+             "tag later in the list matches");
+  CHECK_TRUE(etagListMatches("W/\"0123\"", "\"0123\""),
+             "weak comparison ignores W/");
+  CHECK_TRUE(etagListMatches("\"0123\"", "W/\"0123\""),
+             "weak current tag matches its strong form");
+  CHECK_TRUE(!etagListMatches(" , ", "W/"), "empty current tag never matches");
+  CHECK_TRUE(etagListMatches("*", "\"0123\""), "* matches any tag");
+  CHECK_TRUE(!etagListMatches("\"01234\"", "\"0123\""),
+             "prefix is not a match");
+  CHECK_TRUE(!etagListMatches("0123", "\"0123\""),
+             "unquoted tag is not a match");
+  CHECK_TRUE(!etagListMatches("", "\"0123\""), "absent header never matches");
+  CHECK_TRUE(!etagListMatches(" , ,", "\"0123\""), "empty list never matches");
+
+  CHECK_EQ(static_cast<int>(parseState(
+             "GET / HTTP/1.1\r\nHost: bp.local\r\n"
+             "If-None-Match: \"a\"\r\nIf-None-Match: \"b\"\r\n\r\n")),
+           static_cast<int>(RequestState::REJECT),
+           "duplicate If-None-Match rejected");
+  CHECK_EQ(static_cast<int>(parseError(
+             "GET / HTTP/1.1\r\nHost: bp.local\r\nIf-None-Match: \"" +
+             std::string(140, 'a') + "\"\r\n\r\n")),
+           static_cast<int>(RequestError::HEADER_FIELDS_TOO_LARGE),
+           "oversize If-None-Match is 431");
+}
+
+static void testConnectionCloseToken() {
+  BoundedHttpRequest request;
+  request.reset(300);
+  feedAll(request,
+          "GET /api/latest HTTP/1.1\r\nHost: bp.local\r\n"
+          "Connection: keep-alive, Close\r\n\r\n", 300);
+  CHECK_EQ(static_cast<int>(request.state()),
+           static_cast<int>(RequestState::WAIT_POLICY),
+           "Connection header accepted");
+  CHECK_TRUE(request.view().connectionClose,
+             "close token found in a list, any case");
+
+  request.reset(400);
+  feedAll(request,
+          "GET / HTTP/1.1\r\nHost: bp.local\r\n"
+          "Connection: keep-alive\r\nConnection: closed\r\n\r\n", 400);
+  CHECK_EQ(static_cast<int>(request.state()),
+           static_cast<int>(RequestState::WAIT_POLICY),
+           "repeated Connection header is a list, not a duplicate");
+  CHECK_TRUE(!request.view().connectionClose,
+             "only the exact close token counts");
+}
+
 static void testContentLengthAndFreshHost() {
   const char* invalidLengths[] = {
     "", "-1", "+1", "1x", "1,2", "1 2", "4294967296",
@@ -1065,6 +1128,8 @@ int main() {
   testPostAndQueryAreSeparated();
   testStrictRequestLineAndLimits();
   testSensitiveHeadersAndMalformedLines();
+  testIfNoneMatchCaptureAndComparison();
+  testConnectionCloseToken();
   testContentLengthAndFreshHost();
   testHeaderLineTotalAndCountLimits();
   testFragmentationBudgetAndStrictCrlf();
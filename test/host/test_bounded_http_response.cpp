@@ -389,6 +389,347 @@ static void testHttpEnvelopeValidationFailsClosed() {
            "envelope validation makes no allocation attempt");
 }
 
+struct CountingStream {
+  size_t total;
+  size_t produced;
+  size_t calls;
+  size_t largestWindow;
+  bool failAfterFirst;
+};
+
+static StreamFill fillCounting(void* context, uint8_t* window,
+                               size_t capacity, size_t& written) {
+  auto* stream = static_cast<CountingStream*>(context);
+  ++stream->calls;
+  if (capacity > stream->largestWindow) stream->largestWindow = capacity;
+  if (stream->failAfterFirst && stream->calls > 1) return StreamFill::FAILED;
+  written = 0;
+  while (written < capacity && stream->produced < stream->total) {
+    window[written++] = static_cast<uint8_t>('a' + stream->produced % 26);
+    ++stream->produced;
+  }
+  return stream->produced == stream->total ? StreamFill::DONE
+                                           : StreamFill::MORE;
+}
+
+static const char kStreamHead[] =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/csv; charset=UTF-8\r\n"
+  "Cache-Control: no-store, max-age=0\r\n"
+  "Pragma: no-cache\r\n"
+  "X-Content-Type-Options: nosniff\r\n"
+  "Accept-Ranges: none\r\n"
+  "Transfer-Encoding: chunked\r\n"
+  "Connection: close\r\n"
+  "\r\n";
+
+static bool decodeChunked(const std::string& body, std::string& decoded) {
+  size_t cursor = 0;
+  decoded.clear();
+  while (true) {
+    const size_t lineEnd = body.find("\r\n", cursor);
+    if (lineEnd == std::string::npos || lineEnd == cursor) return false;
+    const size_t size = std::strtoul(
+      body.substr(cursor, lineEnd - cursor).c_str(), nullptr, 16);
+    cursor = lineEnd + 2;
+    if (size == 0) return body.compare(cursor, std::string::npos, "\r\n") == 0;
+    if (cursor + size + 2 > body.size() ||
+        body.compare(cursor + size, 2, "\r\n") != 0) {
+      return false;
+    }
+    decoded.append(body, cursor, size);
+    cursor += size + 2;
+  }
+}
+
+static bool validateCacheableEnvelope(const std::string& wire) {
+  BoundedHttpResponse response;
+  response.begin();
+  CHECK_TRUE(response.allowCaching(), "building response may opt in");
+  (void)response.append(
+    reinterpret_cast<const uint8_t*>(wire.data()), wire.size());
+  return response.validHttp1Envelope();
+}
+
+static void testCacheableEnvelopeIsExplicitAndExact() {
+  const std::string immutable =
+    "HTTP/1.1 304 Not Modified\r\n"
+    "Content-Type: text/css\r\n"
+    "Content-Length: 0\r\n"
+    "Cache-Control: private, max-age=31536000, immutable\r\n"
+    "X-Content-Type-Options: nosniff\r\n"
+    "ETag: \"0123\"\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+  CHECK_TRUE(validateCacheableEnvelope(immutable),
+             "cacheable response accepts the immutable policy");
+  CHECK_TRUE(!validateEnvelope(immutable),
+             "immutable policy is rejected unless caching was allowed");
+
+  std::string withPragma = immutable;
+  withPragma.insert(withPragma.find("X-Content"), "Pragma: no-cache\r\n");
+  CHECK_TRUE(!validateCacheableEnvelope(withPragma),
+             "cacheable response must not carry Pragma");
+
+  std::string noStore = immutable;
+  noStore.replace(noStore.find("private, max-age=31536000, immutable"),
+                  std::strlen("private, max-age=31536000, immutable"),
+                  "no-store, max-age=0");
+  CHECK_TRUE(!validateCacheableEnvelope(noStore),
+             "cacheable mode expects exactly one cache policy");
+
+  BoundedHttpResponse response;
+  response.begin();
+  CHECK_TRUE(response.allowCaching(), "opt in");
+  response.begin();
+  CHECK_TRUE(!response.cacheable(), "begin restores no-store");
+  (void)response.append(reinterpret_cast<const uint8_t*>("x"), 1);
+  CHECK_TRUE(response.finalize(1), "finalize");
+  CHECK_TRUE(!response.allowCaching(), "sending response cannot opt in");
+}
+
+static void testStreamingResponseIsChunkedAndUnbounded() {
+  const size_t total = BoundedHttpResponse::kCapacity * 3 + 17;
+  CountingStream source{total, 0, 0, 0, false};
+  BoundedHttpResponse response;
+  response.begin();
+  (void)response.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                        sizeof(kStreamHead) - 1);
+  CHECK_TRUE(response.stream(fillCounting, &source),
+             "generator attaches while building");
+  CHECK_TRUE(!response.stream(fillCounting, &source),
+             "second generator is refused");
+  CHECK_TRUE(response.validHttp1Envelope(),
+             "chunked head without Content-Length is a valid stream envelope");
+  CHECK_TRUE(response.finalize(10), "stream head finalizes");
+  CHECK_EQ(source.calls, 0UL, "generator runs only after the head is sent");
+
+  const std::string wire = drainResponse(response, 1000);
+  CHECK_EQ(static_cast<int>(response.state()),
+           static_cast<int>(ResponseState::COMPLETE),
+           "stream completes after the last chunk");
+  CHECK_TRUE(!response.streaming(), "completed stream drops the generator");
+  CHECK_TRUE(wire.compare(0, sizeof(kStreamHead) - 1, kStreamHead) == 0,
+             "head goes out unchanged");
+  std::string decoded;
+  CHECK_TRUE(decodeChunked(wire.substr(sizeof(kStreamHead) - 1), decoded),
+             "body is well-formed chunked encoding");
+  CHECK_EQ(decoded.size(), total, "body exceeds the fixed buffer");
+  CHECK_TRUE(decoded[0] == 'a' && decoded[26] == 'a' &&
+               decoded[total - 1] == static_cast<char>('a' + (total - 1) % 26),
+             "body bytes arrive in order");
+  CHECK_TRUE(source.largestWindow <= BoundedHttpResponse::kStreamWindow,
+             "generator never sees more than one window");
+  CHECK_EQ(source.calls, 4UL, "one generator call per window");
+}
+
+static void testStreamingEnvelopeAndFailureRules() {
+  CountingStream source{0, 0, 0, 0, false};
+  std::string withLength = kStreamHead;
+  withLength.insert(withLength.find("Connection:"), "Content-Length: 0\r\n");
+  BoundedHttpResponse lengthAndChunked;
+  lengthAndChunked.begin();
+  (void)lengthAndChunked.append(
+    reinterpret_cast<const uint8_t*>(withLength.data()), withLength.size());
+  (void)lengthAndChunked.stream(fillCounting, &source);
+  CHECK_TRUE(!lengthAndChunked.validHttp1Envelope(),
+             "stream with Content-Length is rejected");
+
+  std::string withBody = std::string(kStreamHead) + "early";
+  BoundedHttpResponse bodyInHead;
+  bodyInHead.begin();
+  (void)bodyInHead.append(reinterpret_cast<const uint8_t*>(withBody.data()),
+                          withBody.size());
+  (void)bodyInHead.stream(fillCounting, &source);
+  CHECK_TRUE(!bodyInHead.validHttp1Envelope(),
+             "body bytes captured before the generator are rejected");
+
+  BoundedHttpResponse noGenerator;
+  noGenerator.begin();
+  (void)noGenerator.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                           sizeof(kStreamHead) - 1);
+  CHECK_TRUE(!noGenerator.validHttp1Envelope(),
+             "chunked head without a generator is rejected");
+
+  BoundedHttpResponse empty;
+  empty.begin();
+  (void)empty.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                     sizeof(kStreamHead) - 1);
+  (void)empty.stream(fillCounting, &source);
+  CHECK_TRUE(empty.finalize(1), "empty stream finalizes");
+  const std::string emptyWire = drainResponse(empty);
+  CHECK_TRUE(emptyWire.size() >= 5 &&
+               emptyWire.compare(emptyWire.size() - 5, 5, "0\r\n\r\n") == 0 &&
+               emptyWire.size() == sizeof(kStreamHead) - 1 + 5,
+             "empty body is only the last chunk");
+
+  CountingStream failing{BoundedHttpResponse::kCapacity * 2, 0, 0, 0, true};
+  BoundedHttpResponse failed;
+  failed.begin();
+  (void)failed.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                      sizeof(kStreamHead) - 1);
+  (void)failed.stream(fillCounting, &failing);
+  CHECK_TRUE(failed.finalize(1), "failing stream finalizes");
+  const std::string failedWire = drainResponse(failed);
+  CHECK_EQ(static_cast<int>(failed.state()),
+           static_cast<int>(ResponseState::ABORTED),
+           "generator failure aborts instead of faking the last chunk");
+  CHECK_TRUE(failedWire.find("0\r\n\r\n") == std::string::npos,
+             "aborted stream never sends the terminator");
+
+  CountingStream slow{BoundedHttpResponse::kCapacity * 4, 0, 0, 0, false};
+  BoundedHttpResponse deadline;
+  deadline.begin();
+  (void)deadline.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                        sizeof(kStreamHead) - 1);
+  (void)deadline.stream(fillCounting, &slow);
+  CHECK_TRUE(deadline.finalize(100), "deadline stream finalizes");
+  while (deadline.state() == ResponseState::SENDING && slow.calls < 2) {
+    const ResponseChunk chunk = deadline.nextChunk();
+    if (!deadline.acknowledge(chunk.length)) break;
+  }
+  CHECK_TRUE(!deadline.enforceDeadline(1600),
+             "generated windows do not extend the send deadline");
+  CHECK_EQ(static_cast<int>(deadline.state()),
+           static_cast<int>(ResponseState::ABORTED),
+           "stream past its deadline aborts");
+
+  std::vector<uint8_t> tooMuch(BoundedHttpResponse::kCapacity + 1, 'x');
+  BoundedHttpResponse overflow;
+  overflow.begin();
+  (void)overflow.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                        sizeof(kStreamHead) - 1);
+  (void)overflow.stream(fillCounting, &source);
+  (void)overflow.append(tooMuch.data(), tooMuch.size());
+  CHECK_TRUE(overflow.finalize(1), "overflowed stream finalizes");
+  CHECK_TRUE(!overflow.streaming(), "overflow drops the generator");
+  CHECK_TRUE(drainResponse(overflow).find("503") != std::string::npos,
+             "overflowed stream head becomes the fixed 503");
+}
+
+// Event source: one queued event per fill, IDLE in between, DONE when closed.
+struct EventQueue {
+  int pending;
+  int calls;
+  bool closed;
+};
+
+static StreamFill fillEvents(void* context, uint8_t* window,
+                             size_t capacity, size_t& written) {
+  auto* events = static_cast<EventQueue*>(context);
+  events->calls++;
+  written = 0;
+  if (events->pending > 0 && capacity >= 6) {
+    std::memcpy(window, "data:x", 6);
+    written = 6;
+    events->pending--;
+  }
+  return events->closed ? StreamFill::DONE : StreamFill::IDLE;
+}
+
+static void testIdleStreamWaitsForPollWithoutDeadline() {
+  EventQueue events{1, 0, false};
+  BoundedHttpResponse response;
+  response.begin();
+  (void)response.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                        sizeof(kStreamHead) - 1);
+  (void)response.stream(fillEvents, &events);
+  CHECK_TRUE(response.finalize(100), "event stream finalizes");
+
+  std::string wire;
+  while (!response.awaitingStream() &&
+         response.state() == ResponseState::SENDING) {
+    const ResponseChunk chunk = response.nextChunk();
+    wire.append(reinterpret_cast<const char*>(chunk.data), chunk.length);
+    if (!response.acknowledge(chunk.length)) break;
+  }
+  CHECK_TRUE(response.awaitingStream(), "drained idle window waits");
+  CHECK_EQ(events.calls, 1, "idle window is not refilled on acknowledge");
+  CHECK_EQ(response.nextChunk().length, 0U, "nothing offered while idle");
+  CHECK_TRUE(wire.find("6\r\ndata:x\r\n") != std::string::npos,
+             "first event is one chunk");
+
+  CHECK_TRUE(response.enforceDeadline(60000),
+             "an idle stream has no send deadline");
+  CHECK_TRUE(response.pollStream(60000), "empty poll keeps the stream");
+  CHECK_TRUE(response.awaitingStream(), "still idle");
+  CHECK_EQ(events.calls, 2, "poll asks the generator again");
+
+  events.pending = 1;
+  CHECK_TRUE(response.pollStream(70000), "event arrives");
+  CHECK_TRUE(!response.awaitingStream(), "window ready to send");
+  CHECK_TRUE(response.enforceDeadline(70000 + 1499),
+             "a window after idle gets its own deadline");
+  CHECK_TRUE(!response.enforceDeadline(70000 + 1500),
+             "an undrained window still times out");
+  CHECK_EQ(static_cast<int>(response.state()),
+           static_cast<int>(ResponseState::ABORTED),
+           "stalled reader aborts the event stream");
+
+  EventQueue closing{0, 0, false};
+  BoundedHttpResponse finished;
+  finished.begin();
+  (void)finished.append(reinterpret_cast<const uint8_t*>(kStreamHead),
+                        sizeof(kStreamHead) - 1);
+  (void)finished.stream(fillEvents, &closing);
+  CHECK_TRUE(finished.finalize(1), "closing stream finalizes");
+  while (!finished.awaitingStream() &&
+         finished.state() == ResponseState::SENDING) {
+    const ResponseChunk chunk = finished.nextChunk();
+    if (!finished.acknowledge(chunk.length)) break;
+  }
+  closing.closed = true;
+  CHECK_TRUE(finished.pollStream(2), "close is picked up on poll");
+  const std::string tail = drainResponse(finished);
+  CHECK_TRUE(tail == "0\r\n\r\n", "closing sends only the last chunk");
+  CHECK_EQ(static_cast<int>(finished.state()),
+           static_cast<int>(ResponseState::COMPLETE),
+           "closed event stream completes");
+}
+
+static void testKeepAliveRewritesOnlyTheCloseLine() {
+  BoundedHttpResponse response;
+  response.begin();
+  static const char captured[] =
+    "HTTP/1.1 200 OK\r\nContent-Length: 5\r\nConnection: close\r\n"
+    "X-Content-Type-Options: nosniff\r\n\r\nhello";
+  (void)response.append(reinterpret_cast<const uint8_t*>(captured),
+                        sizeof(captured) - 1);
+  CHECK_TRUE(response.keepAlive(5, 31), "close line rewritten");
+  CHECK_TRUE(response.finalize(100), "rewritten response finalizes");
+  CHECK_STR(drainResponse(response).c_str(),
+            "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n"
+            "Connection: keep-alive\r\nKeep-Alive: timeout=5, max=31\r\n"
+            "X-Content-Type-Options: nosniff\r\n\r\nhello",
+            "headers after the line and the body move intact");
+
+  BoundedHttpResponse bodyOnly;
+  bodyOnly.begin();
+  static const char noHeader[] =
+    "HTTP/1.1 200 OK\r\nContent-Length: 17\r\n\r\nConnection: close";
+  (void)bodyOnly.append(reinterpret_cast<const uint8_t*>(noHeader),
+                        sizeof(noHeader) - 1);
+  CHECK_TRUE(!bodyOnly.keepAlive(5, 31), "body bytes are never rewritten");
+  CHECK_TRUE(bodyOnly.finalize(100), "untouched response still sends");
+  CHECK_STR(drainResponse(bodyOnly).c_str(), noHeader,
+            "failed rewrite leaves the response as captured");
+
+  BoundedHttpResponse streamed;
+  streamed.begin();
+  (void)streamed.append(reinterpret_cast<const uint8_t*>(captured), 40);
+  CountingStream counting{};
+  CHECK_TRUE(streamed.stream(fillCounting, &counting), "stream installed");
+  CHECK_TRUE(!streamed.keepAlive(5, 31), "a stream always closes");
+
+  BoundedHttpResponse full;
+  full.begin();
+  std::string large(captured, sizeof(captured) - 1);
+  large.append(BoundedHttpResponse::kCapacity - large.size(), 'x');
+  (void)full.append(reinterpret_cast<const uint8_t*>(large.data()),
+                    large.size());
+  CHECK_TRUE(!full.keepAlive(5, 31), "no room means close");
+}
+
 int main() {
   testTransactionalResponseSupportsPartialSends();
   testOverflowAtomicallyBecomesFixed503();
@@ -396,5 +737,10 @@ int main() {
   testCapacityWipeAndAllocationContract();
   testOutstandingOfferIsIdempotentUntilAck();
   testHttpEnvelopeValidationFailsClosed();
+  testCacheableEnvelopeIsExplicitAndExact();
+  testStreamingResponseIsChunkedAndUnbounded();
+  testStreamingEnvelopeAndFailureRules();
+  testIdleStreamWaitsForPollWithoutDeadline();
+  testKeepAliveRewritesOnlyTheCloseLine();
   return testReport();
 }
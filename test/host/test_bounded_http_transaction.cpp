@@ -35,7 +35,8 @@ static size_t feedUntilBoundary(BoundedHttpTransaction& transaction,
                                 const std::string& wire, uint32_t nowMs) {
   size_t offset = 0;
   while (offset < wire.size() &&
-         (transaction.state() == TransactionState::READING_HEADERS ||
+         (transaction.state() == TransactionState::AWAITING_REQUEST ||
+          transaction.state() == TransactionState::READING_HEADERS ||
           transaction.state() == TransactionState::READING_BODY)) {
     const TransactionConsume part = transaction.consume(
       reinterpret_cast<const uint8_t*>(wire.data() + offset),
@@ -870,6 +871,179 @@ static void testStreamConsumerCanRejectBodyWithBoundedResponse() {
              "body rejection is invalid after response begins");
 }
 
+static StreamFill fillLargeBody(void* context, uint8_t* window,
+                                size_t capacity, size_t& written) {
+  size_t& remaining = *static_cast<size_t*>(context);
+  written = remaining < capacity ? remaining : capacity;
+  std::memset(window, 'r', written);
+  remaining -= written;
+  return remaining == 0 ? StreamFill::DONE : StreamFill::MORE;
+}
+
+static void testStreamedResponseOutlivesCaptureLimit() {
+  BoundedHttpTransaction transaction;
+  transaction.begin(300);
+  static const char request[] =
+    "GET /export.csv HTTP/1.1\r\nHost: 10.0.0.5\r\n\r\n";
+  (void)feedUntilBoundary(transaction, request, 300);
+  CHECK_TRUE(transaction.acceptPolicy(BodyMode::NONE, 0, 301),
+             "stream fixture accepts its policy");
+  size_t remaining = BoundedHttpResponse::kCapacity * 2;
+  CHECK_TRUE(!transaction.captureStream(fillLargeBody, &remaining),
+             "generator cannot attach before dispatch");
+  CHECK_TRUE(transaction.beginDispatch(302), "stream fixture dispatches");
+  static const char head[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/csv; charset=UTF-8\r\n"
+    "Cache-Control: no-store, max-age=0\r\n"
+    "Pragma: no-cache\r\n"
+    "X-Content-Type-Options: nosniff\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Connection: close\r\n\r\n";
+  (void)transaction.capture(reinterpret_cast<const uint8_t*>(head),
+                            sizeof(head) - 1);
+  CHECK_TRUE(!transaction.capturedResponseIsValidHttp1(),
+             "chunked head alone is not a complete response");
+  CHECK_TRUE(transaction.captureStream(fillLargeBody, &remaining),
+             "generator attaches during capture");
+  CHECK_TRUE(transaction.capturedResponseIsValidHttp1(),
+             "chunked head plus generator is a valid stream");
+  CHECK_TRUE(transaction.finishDispatch(303), "stream enters send phase");
+  CHECK_EQ(transaction.queuedStatus(), 0,
+           "stream is not downgraded to a 503");
+  const std::string wire = drain(transaction, 1024);
+  CHECK_EQ(static_cast<int>(transaction.state()),
+           static_cast<int>(TransactionState::COMPLETE),
+           "streamed response completes");
+  CHECK_EQ(remaining, 0UL, "generator produced the whole body");
+  CHECK_TRUE(wire.size() > BoundedHttpResponse::kCapacity * 2,
+             "wire carries more than the capture buffer holds");
+  CHECK_TRUE(wire.compare(wire.size() - 5, 5, "0\r\n\r\n") == 0,
+             "wire ends with the last chunk");
+}
+
+static const char kKeepAliveResponse[] =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: application/json\r\n"
+  "Content-Length: 2\r\n"
+  "Cache-Control: no-store, max-age=0\r\n"
+  "Pragma: no-cache\r\n"
+  "X-Content-Type-Options: nosniff\r\n"
+  "Connection: close\r\n\r\n{}";
+
+// One GET through dispatch and capture; returns the wire bytes sent.
+static std::string serveGet(BoundedHttpTransaction& transaction,
+                            const std::string& extraHeaders,
+                            uint32_t nowMs) {
+  const std::string request =
+    "GET /api/latest HTTP/1.1\r\nHost: 10.0.0.5\r\n" + extraHeaders +
+    "\r\n";
+  (void)feedUntilBoundary(transaction, request, nowMs);
+  if (!transaction.acceptPolicy(BodyMode::NONE, 0, nowMs) ||
+      !transaction.beginDispatch(nowMs)) {
+    return std::string();
+  }
+  (void)transaction.capture(
+    reinterpret_cast<const uint8_t*>(kKeepAliveResponse),
+    sizeof(kKeepAliveResponse) - 1);
+  if (!transaction.finishDispatch(nowMs)) return std::string();
+  return drain(transaction);
+}
+
+static void testKeepAliveServesTheNextRequestOnTheSameSocket() {
+  BoundedHttpTransaction transaction;
+  transaction.begin(1000);
+  std::string wire = serveGet(transaction, "", 1000);
+  CHECK_TRUE(wire.find("Connection: keep-alive\r\n") != std::string::npos,
+             "captured close line becomes keep-alive");
+  CHECK_TRUE(wire.find("Keep-Alive: timeout=5, max=31\r\n") !=
+               std::string::npos,
+             "client told the idle timeout and remaining requests");
+  CHECK_TRUE(wire.find("Connection: close") == std::string::npos,
+             "no close line left");
+  CHECK_TRUE(transaction.awaitNextRequest(1010),
+             "complete persistent response waits for the next request");
+  CHECK_EQ(static_cast<int>(transaction.state()),
+           static_cast<int>(TransactionState::AWAITING_REQUEST),
+           "between requests");
+  CHECK_TRUE(!transaction.terminal(), "the slot stays open");
+  CHECK_TRUE(transaction.poll(1010 + 3000),
+             "idle longer than the header deadline is not a timeout");
+
+  // The header deadline starts with the first byte of the next request.
+  wire = serveGet(transaction, "", 4000);
+  CHECK_TRUE(wire.find("HTTP/1.1 200 OK\r\n") == 0,
+             "second request on the socket is served");
+  CHECK_EQ(transaction.requestsServed(), 1U, "one request before this one");
+  CHECK_TRUE(wire.find("max=30\r\n") != std::string::npos,
+             "remaining count goes down");
+
+  CHECK_TRUE(transaction.awaitNextRequest(4100), "still persistent");
+  CHECK_TRUE(transaction.poll(4100 + BoundedHttpTransaction::kKeepAliveIdleMs -
+                              1),
+             "idle just under the limit");
+  CHECK_TRUE(!transaction.poll(4100 + BoundedHttpTransaction::kKeepAliveIdleMs),
+             "idle limit reached");
+  CHECK_EQ(static_cast<int>(transaction.state()),
+           static_cast<int>(TransactionState::ABORTED),
+           "idle expiry closes without a response");
+  CHECK_EQ(transaction.nextOutput().length, 0U, "nothing queued for the peer");
+}
+
+static void testKeepAliveEndsOnCloseCapAndErrors() {
+  BoundedHttpTransaction asked;
+  asked.begin(100);
+  std::string wire = serveGet(asked, "Connection: close\r\n", 100);
+  CHECK_TRUE(wire.find("Connection: close\r\n") != std::string::npos,
+             "client close keeps the captured close line");
+  CHECK_TRUE(!asked.awaitNextRequest(110), "client close ends the connection");
+
+  BoundedHttpTransaction server;
+  server.begin(100);
+  (void)feedUntilBoundary(server,
+                          "GET / HTTP/1.1\r\nHost: 10.0.0.5\r\n\r\n", 100);
+  (void)server.acceptPolicy(BodyMode::NONE, 0, 100);
+  (void)server.beginDispatch(100);
+  (void)server.capture(reinterpret_cast<const uint8_t*>(kKeepAliveResponse),
+                       sizeof(kKeepAliveResponse) - 1);
+  server.closeAfterResponse();
+  CHECK_TRUE(server.finishDispatch(100), "response still sent");
+  CHECK_TRUE(!server.persistent(), "server-side close wins");
+  (void)drain(server);
+  CHECK_TRUE(!server.awaitNextRequest(110), "closed after the response");
+
+  BoundedHttpTransaction denied;
+  denied.begin(100);
+  (void)feedUntilBoundary(denied,
+                          "GET / HTTP/1.1\r\nHost: 10.0.0.5\r\n\r\n", 100);
+  CHECK_TRUE(denied.rejectPolicy(404, 100), "denial queued");
+  CHECK_TRUE(!denied.persistent(), "an error response always closes");
+
+  BoundedHttpTransaction capped;
+  capped.begin(0);
+  uint32_t served = 0;
+  uint32_t now = 0;
+  for (;;) {
+    wire = serveGet(capped, "", now);
+    ++served;
+    now += 10;
+    if (!capped.awaitNextRequest(now)) break;
+    if (served > BoundedHttpTransaction::kMaxRequestsPerConnection) break;
+  }
+  CHECK_EQ(served, BoundedHttpTransaction::kMaxRequestsPerConnection,
+           "request count per connection is capped");
+  CHECK_TRUE(wire.find("Connection: close\r\n") != std::string::npos,
+             "the last response announces the close");
+  CHECK_TRUE(capped.terminal(), "connection done after the cap");
+
+  BoundedHttpTransaction reopened;
+  reopened.begin(0);
+  (void)serveGet(reopened, "", 0);
+  CHECK_TRUE(reopened.awaitNextRequest(10), "persistent");
+  reopened.begin(20);
+  CHECK_EQ(reopened.requestsServed(), 0U, "a new socket starts a new count");
+}
+
 int main() {
   testDeniedPolicyNeverConsumesBody();
   testAllowedBodyAndCapturedResponseLifecycle();
@@ -881,5 +1055,8 @@ int main() {
   testStreamAbsoluteDeadlineWrapAndSmallFormDeadline();
   testStreamInvalidDrainWipeDestructorAndNoAllocation();
   testStreamConsumerCanRejectBodyWithBoundedResponse();
+  testStreamedResponseOutlivesCaptureLimit();
+  testKeepAliveServesTheNextRequestOnTheSameSocket();
+  testKeepAliveEndsOnCloseCapAndErrors();
   return testReport();
 }
@@ -0,0 +1,121 @@
+// Host tests for the streaming JSON writer: output is byte-identical to the
+// ArduinoJson serialization it replaces, strings are escaped, uint64
+// identifiers stay decimal strings, and a full buffer is reported instead of
+// emitting truncated JSON.
+
+#include <Arduino.h>
+
+#include "lib/BoundedJsonWriter.h"
+#include "test_support.h"
+
+#include <cstdint>
+#include <string>
+
+using bp_json::BoundedJsonWriter;
+
+static String text(const char* buffer, const BoundedJsonWriter& json) {
+  return String(std::string(buffer, json.length()).c_str());
+}
+
+static void testRecordMatchesTheSerializedDocument() {
+  char buffer[256];
+  BoundedJsonWriter json(buffer, sizeof(buffer));
+  const uint8_t slot = 2;
+  const int32_t systolic = 128;
+  json.beginObject();
+  json.uint64Field("record_sequence", UINT64_MAX);
+  json.field("timestamp", "2026-07-11 09:00:00");
+  json.field("systolic", systolic);
+  json.field("movement_count", -1);
+  json.field("valid", true);
+  json.field("device_slot", slot);
+  json.key("review_state");
+  json.nullValue();
+  json.endObject();
+  CHECK_TRUE(!json.overflowed(), "record fits");
+  CHECK_STR(text(buffer, json),
+            "{\"record_sequence\":\"18446744073709551615\","
+            "\"timestamp\":\"2026-07-11 09:00:00\","
+            "\"systolic\":128,\"movement_count\":-1,"
+            "\"valid\":true,\"device_slot\":2,"
+            "\"review_state\":null}",
+            "compact output in call order, uint64 as a decimal string");
+}
+
+static void testNestedContainersAndOpenArrays() {
+  char buffer[128];
+  BoundedJsonWriter head(buffer, sizeof(buffer));
+  head.beginObject();
+  head.field("has_more", false);
+  head.key("records");
+  head.beginArray();
+  CHECK_STR(text(buffer, head), "{\"has_more\":false,\"records\":[",
+            "head leaves the record array open for streamed rows");
+
+  BoundedJsonWriter first(buffer, sizeof(buffer));
+  first.beginObject();
+  first.field("n", 1U);
+  first.endObject();
+  char next[64];
+  BoundedJsonWriter second(next, sizeof(next));
+  second.continueSequence();
+  second.beginObject();
+  second.key("list");
+  second.beginArray();
+  second.value(1);
+  second.value("a");
+  second.beginArray();
+  second.endArray();
+  second.endArray();
+  second.endObject();
+  CHECK_STR(text(buffer, first), "{\"n\":1}",
+            "first streamed row has no separator");
+  CHECK_STR(text(next, second),
+            ",{\"list\":[1,\"a\",[]]}",
+            "continued rows are comma separated, nested commas are local");
+}
+
+static void testStringsAreEscaped() {
+  char buffer[128];
+  BoundedJsonWriter json(buffer, sizeof(buffer));
+  json.value("q\"b\\s/\b\f\n\r\t\x01 時間未同步");
+  CHECK_STR(text(buffer, json),
+            "\"q\\\"b\\\\s/\\b\\f\\n\\r\\t\\u0001 時間未同步\"",
+            "quotes, backslashes and controls escaped; UTF-8 passed through");
+  BoundedJsonWriter absent(buffer, sizeof(buffer));
+  absent.value(static_cast<const char*>(nullptr));
+  CHECK_STR(text(buffer, absent), "null", "null string is null");
+}
+
+static void testOverflowIsReportedNotTruncated() {
+  char buffer[8];
+  BoundedJsonWriter json(buffer, sizeof(buffer));
+  json.beginObject();
+  json.field("k", "value");
+  CHECK_TRUE(json.overflowed(), "too-small buffer overflows");
+  CHECK_TRUE(json.length() <= sizeof(buffer), "never writes past capacity");
+
+  BoundedJsonWriter unbalanced(buffer, sizeof(buffer));
+  unbalanced.endArray();
+  CHECK_TRUE(unbalanced.overflowed(), "closing an unopened container fails");
+
+  char deep[64];
+  BoundedJsonWriter nested(deep, sizeof(deep));
+  for (size_t i = 0; i <= BoundedJsonWriter::kMaxDepth; ++i) {
+    nested.beginArray();
+  }
+  CHECK_TRUE(nested.overflowed(), "nesting beyond kMaxDepth fails");
+
+  BoundedJsonWriter empty(nullptr, 16);
+  empty.value(true);
+  CHECK_TRUE(empty.overflowed() && empty.length() == 0,
+             "missing buffer has no capacity");
+}
+
+int main() {
+  testRecordMatchesTheSerializedDocument();
+  testNestedContainersAndOpenArrays();
+  testStringsAreEscaped();
+  testOverflowIsReportedNotTruncated();
+  return testReport();
+}
@@ -34,7 +34,10 @@ public:
   }
   const char* name() const override { return "FAKE"; }
   MonitorTransportState state() const override { return st; }
-  String detail() const override { return det; }
+  String detail() const override {
+    ++detailCalls;
+    return det;
+  }
 
   void feed(const char* value) {
     while (*value) feedByte(static_cast<uint8_t>(*value++));
@@ -46,29 +49,57 @@ public:
     lossCount++;
     MonitorRxEvent event;
     event.type = MonitorRxEventType::DISCONTINUITY;
-    event.epoch = lossCount;
+    event.device = device;
+    event.epoch = ++epochs[device];
     q.push_back(event);
   }
   void feedStreamReset() {
     lossCount++;
     MonitorRxEvent event;
     event.type = MonitorRxEventType::STREAM_RESET;
-    event.epoch = lossCount;
+    event.device = device;
+    event.epoch = ++epochs[device];
     q.push_back(event);
   }
   uint32_t dataLossCount() const override { return lossCount; }
+  uint8_t deviceCount() const override { return devices; }
+  bool lastRxAcceptedUs(uint32_t& acceptedUs) const override {
+    if (!rxAccepted) return false;
+    acceptedUs = rxAcceptedUs;
+    return true;
+  }
+  void replaceDetail(const char* value) {
+    det = value;
+    markStatusChanged();
+  }
+  void noteFraming(uint8_t slot, const MonitorFramingReport& report) override {
+    framing[slot].bytes += report.bytes;
+    framing[slot].validFrames += report.validFrames;
+    framing[slot].rejectedFrames += report.rejectedFrames;
+    framingCalls++;
+  }
 
   std::deque<MonitorRxEvent> q;
   uint32_t lossCount = 0;
   MonitorTransportState st = TRANSPORT_STATE_READY;
   String det = "ok";
+  mutable int detailCalls = 0;
+  bool rxAccepted = false;
+  uint32_t rxAcceptedUs = 0;
+  // 多台血壓計：feed*() 以 device 標記來源，各自維護 epoch。
+  uint8_t devices = 1;
+  uint8_t device = 0;
+  uint32_t epochs[kMaxMonitorDevices] = {};
+  MonitorFramingReport framing[kMaxMonitorDevices];
+  int framingCalls = 0;
 
 private:
   void feedByte(uint8_t byte) {
     MonitorRxEvent event;
     event.type = MonitorRxEventType::BYTE;
     event.byte = byte;
-    event.epoch = lossCount;
+    event.device = device;
+    event.epoch = epochs[device];
     q.push_back(event);
   }
 };
@@ -76,10 +107,15 @@ private:
 struct World {
   BP_Parser parser{String("OMRON-HBP9030")};
   BP_RecordManager records{5};
-  String lastData, transportName, transportStatus;
+  ReceiveDiagnostic diagnostic;
+  String transportName, transportStatus;
+  MonitorTransportSummary transportSummary;
+  MeasurementSnapshotPublisher snapshot;
   FakeTransport transport;
-  DataProcessor proc{&parser, &records, &lastData,
-                     &transportName, &transportStatus, &transport};
+  MeasurementLatencyTracker latency;
+  DataProcessor proc{&parser, &records, &diagnostic,
+                     &transportName, &transportStatus, &transportSummary,
+                     &snapshot, &transport, &latency};
 
   World() {
     Preferences::__reset();
@@ -94,6 +130,13 @@ struct World {
   }
 };
 
+// 診斷只在網頁要求時渲染；測試以同一個 renderer 檢查使用者會看到的片段。
+static String rendered(const World& world) {
+  String html;
+  appendReceiveDiagnosticHtml(html, world.diagnostic);
+  return html;
+}
+
 static bool contains(const String& value, const char* needle) {
   return strstr(value.c_str(), needle) != nullptr;
 }
@@ -208,9 +251,9 @@ static void testInvalidErrorAndMotionPolicy() {
   invalid.transport.feed("hello garbage\n");
   invalid.proc.processIncomingData();
   CHECK_EQ(invalid.records.getRecordCount(), 0, "invalid frame not persisted");
-  CHECK_TRUE(contains(invalid.lastData, "malformed"),
+  CHECK_TRUE(contains(rendered(invalid), "malformed"),
              "invalid frame exposes stable sanitized reason");
-  CHECK_TRUE(!contains(invalid.lastData, "hello"),
+  CHECK_TRUE(!contains(rendered(invalid), "hello"),
              "invalid diagnostic never echoes input");
 
   World monitorError;
@@ -240,7 +283,7 @@ static void testOverflowDroppedThenRecovers() {
   world.transport.feed(oversized.c_str());
   world.proc.processIncomingData();
   CHECK_EQ(world.records.getRecordCount(), 0, "overflow frame not persisted");
-  CHECK_TRUE(contains(world.lastData, "overflow"),
+  CHECK_TRUE(contains(rendered(world), "overflow"),
              "overflow exposes stable sanitized reason");
 
   feedLine(world.transport, kFrame120);
@@ -248,6 +291,39 @@ static void testOverflowDroppedThenRecovers() {
   CHECK_EQ(world.records.getRecordCount(), 1, "clean frame after overflow accepted");
 }
 
+static void testFramingReportScoresLineSettings() {
+  World world;
+  feedLine(world.transport, kFrame120);
+  feedLine(world.transport, "garbage");
+  String oversized;
+  for (int i = 0; i < 300; ++i) oversized += 'x';
+  oversized += "\r\n";
+  world.transport.feed(oversized.c_str());
+  world.proc.processIncomingData();
+  const MonitorFramingReport& report = world.transport.framing[0];
+  CHECK_EQ(world.transport.framingCalls, 1, "one report per ingest pass");
+  CHECK_EQ(report.validFrames, 1U, "parsed frame proves the line setting");
+  CHECK_EQ(report.rejectedFrames, 2U, "malformed and overflowed frames count");
+  CHECK_EQ(report.bytes,
+           static_cast<uint32_t>(strlen(kFrame120) + 2 + 9 + 302),
+           "every framed byte counted");
+
+  // 時間戳無效的量測被拒收，但 frame 仍依協定解出：線路設定是對的。
+  feedLine(world.transport,
+           "2026,13,11,09,05,12345678901234567890,0,120,080,072,0");
+  world.proc.processIncomingData();
+  CHECK_EQ(world.transport.framing[0].validFrames, 2U,
+           "refused measurement still decoded");
+
+  World custom;
+  custom.parser.setModel(String("CUSTOM"));
+  custom.proc.processIncomingData();
+  feedLine(custom.transport, kFrame120);
+  custom.proc.processIncomingData();
+  CHECK_EQ(custom.transport.framingCalls, 0,
+           "unsupported model gives no line evidence");
+}
+
 static void testDeviceTimeIsAuthoritativeAndNonblocking() {
   World world;
   __fakeTimeValid() = true;
@@ -283,9 +359,9 @@ static void testIdentityNeverReachesDiagnosticsOrRecord() {
   world.proc.processIncomingData();
 
   CHECK_EQ(world.records.getRecordCount(), 1, "privacy probe remains valid");
-  CHECK_TRUE(!contains(world.lastData, kLeakMarker),
+  CHECK_TRUE(!contains(rendered(world), kLeakMarker),
              "subject ID absent from web diagnostic");
-  CHECK_TRUE(!contains(world.lastData, kLeakMarkerHex),
+  CHECK_TRUE(!contains(rendered(world), kLeakMarkerHex),
              "subject ID hex absent from web diagnostic");
   CHECK_TRUE(!contains(__serialOutput(), kLeakMarker),
              "subject ID absent from production Serial output");
@@ -296,7 +372,7 @@ static void testIdentityNeverReachesDiagnosticsOrRecord() {
   CHECK_TRUE(!HasRawData<BPData>::value,
              "persistable BPData has no raw-frame field");
 
-  expectNoEncodedIdentity(world.lastData,
+  expectNoEncodedIdentity(rendered(world),
                           "encoded identity absent from valid diagnostic");
   expectNoEncodedIdentity(__serialOutput(),
                           "encoded identity absent from valid Serial output");
@@ -320,7 +396,7 @@ static void testIdentityNeverReachesDiagnosticsOrRecord() {
   error.proc.processIncomingData();
   CHECK_EQ(error.records.getRecordCount(), 0,
            "identity canary error frame never persists");
-  expectNoEncodedIdentity(error.lastData,
+  expectNoEncodedIdentity(rendered(error),
                           "encoded identity absent from rejected diagnostic");
   expectNoEncodedIdentity(__serialOutput(),
                           "encoded identity absent from rejected Serial output");
@@ -341,7 +417,7 @@ static void testInvalidDeviceTimeIsNotRepaired() {
            "invalid device date is never repaired with system time");
   CHECK_EQ(__getLocalTimeCallCount(), 0UL,
            "invalid device date does not consult system clock");
-  CHECK_TRUE(contains(world.lastData, "invalid_timestamp"),
+  CHECK_TRUE(contains(rendered(world), "invalid_timestamp"),
              "invalid device date has stable sanitized reason");
 }
 
@@ -394,7 +470,7 @@ static void testOrderedTransportLossRecovery() {
   world.proc.processIncomingData();
   CHECK_EQ(world.records.getRecordCount(), 0,
            "bytes spanning loss are discarded through CRLF");
-  CHECK_TRUE(contains(world.lastData, "discontinuity"),
+  CHECK_TRUE(contains(rendered(world), "discontinuity"),
              "loss exposes stable sanitized diagnostic");
   CHECK_EQ(world.transport.dataLossCount(), 1U,
            "data-loss counter is monotonic and explicit");
@@ -442,6 +518,42 @@ static void testCleanReconnectBoundaryKeepsFirstNewFrame() {
            "pre-reconnect partial cannot contaminate clean frame");
 }
 
+static void testInterleavedDevicesFrameIndependently() {
+  World world;
+  FakeTransport& transport = world.transport;
+  transport.devices = 2;
+  const size_t splitAt = 21;
+  transport.device = 0;
+  transport.feedBytes(reinterpret_cast<const uint8_t*>(kFrame120), splitAt);
+  transport.device = 1;
+  transport.feedBytes(reinterpret_cast<const uint8_t*>(kFrame130), splitAt);
+  transport.feedDiscontinuity();
+  transport.device = 0;
+  transport.feedBytes(reinterpret_cast<const uint8_t*>(kFrame120 + splitAt),
+                      strlen(kFrame120) - splitAt);
+  transport.feed("\r\n");
+  transport.device = 1;
+  transport.feedBytes(reinterpret_cast<const uint8_t*>(kFrame130 + splitAt),
+                      strlen(kFrame130) - splitAt);
+  transport.feed("\r\n");
+  world.proc.processIncomingData();
+  CHECK_EQ(world.records.getRecordCount(), 1,
+           "loss on one monitor leaves the other's partial frame intact");
+  CHECK_EQ(world.records.getLatestRecord().systolic, 120,
+           "interleaved bytes reassemble per device");
+  CHECK_EQ(world.records.getLatestRecord().deviceSlot, 0,
+           "record tagged with its source slot");
+
+  feedLine(transport, kFrame130);
+  world.proc.processIncomingData();
+  CHECK_EQ(world.records.getRecordCount(), 2,
+           "first clean frame after the loss is accepted");
+  CHECK_EQ(world.records.getLatestRecord().deviceSlot, 1,
+           "second monitor's record carries slot 1");
+  CHECK_EQ(world.transportSummary.deviceCount, 2,
+           "web-side summary lists every monitor");
+}
+
 static void testTransportStatusSync() {
   World world;
   CHECK_TRUE(contains(world.transportStatus, "就緒"), "status label from state");
@@ -452,6 +564,130 @@ static void testTransportStatusSync() {
   world.proc.processIncomingData();
   CHECK_TRUE(contains(world.transportStatus, "錯誤"), "status follows change");
   CHECK_TRUE(contains(world.transportStatus, "boom"), "detail follows change");
+  CHECK_EQ(static_cast<int>(world.transportSummary.state),
+           static_cast<int>(TRANSPORT_STATE_ERROR),
+           "web-side summary follows transport state");
+  world.transport.feedDiscontinuity();
+  world.proc.processIncomingData();
+  CHECK_EQ(world.transportSummary.dataLossCount, 1U,
+           "web-side summary follows loss counter without detail change");
+}
+
+static void testTransportDetailFormattedOnlyOnVersionChange() {
+  World world;
+  const int afterSetup = world.transport.detailCalls;
+  CHECK_TRUE(afterSetup > 0, "setup formats the initial detail");
+  for (int i = 0; i < 20; ++i) world.proc.processIncomingData();
+  CHECK_EQ(world.transport.detailCalls, afterSetup,
+           "unchanged status never formats detail text");
+
+  world.transport.replaceDetail("re-probing");
+  world.proc.processIncomingData();
+  CHECK_EQ(world.transport.detailCalls, afterSetup + 1,
+           "version bump formats detail exactly once");
+  CHECK_TRUE(contains(world.transportStatus, "re-probing"),
+             "detail-only change reaches the web side");
+  world.proc.processIncomingData();
+  CHECK_EQ(world.transport.detailCalls, afterSetup + 1,
+           "same version is not formatted again");
+
+  MonitorTransportStatus published;
+  MonitorTransportStatus next;
+  next.state = TRANSPORT_STATE_READY;
+  CHECK_TRUE(advanceMonitorTransportStatus(published, next, false),
+             "field change advances the version");
+  CHECK_EQ(published.version, 1U, "first change publishes version 1");
+  CHECK_TRUE(!advanceMonitorTransportStatus(published, next, false),
+             "identical fields keep the version");
+  CHECK_TRUE(advanceMonitorTransportStatus(published, next, true),
+             "detail change alone advances the version");
+  CHECK_EQ(published.version, 2U, "version is monotonic");
+}
+
+static void testLatencyTraceFollowsMeasurementStages() {
+  World world;
+  __millisCounter() = 2000;
+  world.transport.rxAccepted = true;
+  world.transport.rxAcceptedUs = 1995000;
+  feedLine(world.transport, kFrame120);
+  world.proc.processIncomingData();
+  const MeasurementLatencyHistogram& usb =
+    world.latency.histogram(MeasurementLatencyStage::USB_TO_FRAME);
+  CHECK_EQ(usb.sampleCount(), 1U, "accepted frame records USB stage");
+  CHECK_EQ(usb.lastUs(), 5000U, "USB stage starts at transport accept time");
+  CHECK_EQ(world.latency.histogram(MeasurementLatencyStage::PARSED_TO_DURABLE)
+             .sampleCount(), 1U, "durable stage recorded on persist");
+  CHECK_EQ(world.latency.histogram(MeasurementLatencyStage::DURABLE_TO_SERVED)
+             .sampleCount(), 0U, "served stage waits for a page");
+
+  world.transport.rxAccepted = false;
+  feedLine(world.transport, "garbage");
+  world.proc.processIncomingData();
+  CHECK_EQ(world.latency.histogram(MeasurementLatencyStage::FRAME_TO_PARSED)
+             .sampleCount(), 1U, "rejected frames are not traced");
+  feedLine(world.transport, kFrame130);
+  world.proc.processIncomingData();
+  CHECK_EQ(usb.sampleCount(), 1U,
+           "transport without accept time skips the USB stage");
+  CHECK_EQ(world.latency.histogram(MeasurementLatencyStage::FRAME_TO_PARSED)
+             .sampleCount(), 2U, "parse stage recorded per accepted frame");
+}
+
+static void testConcurrentIngestHandsOffThroughQueue() {
+  World world;
+  world.proc.useConcurrentIngest(true);
+  feedLine(world.transport, kFrame120);
+  CHECK_TRUE(!world.proc.processIncomingData(),
+             "web side never drains the transport in concurrent mode");
+  CHECK_EQ(world.transport.q.size(), strlen(kFrame120) + 2,
+           "bytes stay with the ingest owner");
+
+  CHECK_TRUE(!world.proc.ingestIncomingData(), "one frame fits the queue");
+  CHECK_EQ(world.records.getRecordCount(), 0,
+           "ingest side never persists directly");
+  CHECK_EQ(world.snapshot.read().revision, 0ULL,
+           "snapshot is not published before the web side applies");
+  CHECK_TRUE(world.proc.processIncomingData(), "web side applies result");
+  CHECK_EQ(world.records.getRecordCount(), 1, "queued measurement persisted");
+  const MeasurementSnapshot published = world.snapshot.read();
+  CHECK_EQ(published.revision, world.records.getRevision(),
+           "applied batch publishes the new revision");
+  CHECK_EQ(published.latest.systolic, 120, "snapshot carries latest vitals");
+  CHECK_EQ(static_cast<int>(published.diagnostic.status),
+           static_cast<int>(ReceiveDiagnosticStatus::VALID),
+           "snapshot carries the matching diagnostic");
+  CHECK_EQ(static_cast<int>(world.diagnostic.status),
+           static_cast<int>(ReceiveDiagnosticStatus::VALID),
+           "web side records accepted diagnostic");
+
+  const size_t burst = DataProcessor::kIngestQueueDepth + 4;
+  for (size_t i = 0; i < burst; ++i) world.transport.feed("x\r\n");
+  CHECK_TRUE(world.proc.ingestIncomingData(),
+             "full queue applies backpressure instead of dropping results");
+  CHECK_TRUE(!world.transport.q.empty(),
+             "unread bytes remain buffered in the transport");
+  size_t rounds = 0;
+  while (world.proc.ingestIncomingData() && rounds++ < burst) {
+    world.proc.processIncomingData();
+  }
+  world.proc.processIncomingData();
+  CHECK_TRUE(world.transport.q.empty(), "backlog drains after web side catches up");
+  CHECK_EQ(static_cast<int>(world.diagnostic.status),
+           static_cast<int>(ReceiveDiagnosticStatus::MALFORMED),
+           "every backlogged frame still reaches the web side");
+
+  world.parser.setModel(String("CUSTOM"));
+  world.transport.feed("SYS:120");
+  world.proc.ingestIncomingData();
+  world.proc.processIncomingData();
+  CHECK_TRUE(world.diagnostic.status != ReceiveDiagnosticStatus::UNSUPPORTED_MODEL,
+             "model change is not visible to ingest before it is published");
+  world.transport.feed("SYS:120");
+  world.proc.ingestIncomingData();
+  world.proc.processIncomingData();
+  CHECK_EQ(static_cast<int>(world.diagnostic.status),
+           static_cast<int>(ReceiveDiagnosticStatus::UNSUPPORTED_MODEL),
+           "published model change reaches the ingest parser");
 }
 
 static void testStorageFailureIsNeverRenderedOrLoggedAsAccepted() {
@@ -467,13 +703,13 @@ static void testStorageFailureIsNeverRenderedOrLoggedAsAccepted() {
       : 1;
     CHECK_EQ(world.records.getRecordCount(), durableCount,
              "failed add reconciles to complete pre/post durable history");
-    CHECK_TRUE(contains(world.lastData, "storage_error"),
+    CHECK_TRUE(contains(rendered(world), "storage_error"),
                "operator sees storage-specific diagnostic");
-    CHECK_TRUE(contains(world.lastData, "重新量測"),
+    CHECK_TRUE(contains(rendered(world), "重新量測"),
                "storage diagnostic gives an actionable retry instruction");
-    CHECK_TRUE(contains(world.lastData, "歷史記錄"),
+    CHECK_TRUE(contains(rendered(world), "歷史記錄"),
                "ambiguous write tells operator to check history before retry");
-    CHECK_TRUE(!contains(world.lastData, "data-status='valid'"),
+    CHECK_TRUE(!contains(rendered(world), "data-status='valid'"),
                "failed or ambiguous add is never rendered accepted");
     CHECK_TRUE(!contains(__serialOutput(), "measurement_accepted"),
                "failed or ambiguous add is never logged accepted");
@@ -482,12 +718,63 @@ static void testStorageFailureIsNeverRenderedOrLoggedAsAccepted() {
   }
 }
 
+static void testDiagnosticIsStructuredUntilRendered() {
+  CHECK_TRUE(std::is_trivially_copyable<ReceiveDiagnostic>::value,
+             "receive diagnostic is a fixed-size POD");
+
+  World world;
+  CHECK_TRUE(world.diagnostic.isWaiting(), "fresh diagnostic waits");
+  CHECK_STR(rendered(world), "", "waiting diagnostic renders nothing");
+
+  delay(42);
+  feedLine(world.transport, kFrame120);
+  world.proc.processIncomingData();
+  CHECK_EQ(static_cast<int>(world.diagnostic.status),
+           static_cast<int>(ReceiveDiagnosticStatus::VALID),
+           "accepted frame records valid status code");
+  CHECK_EQ(static_cast<int>(world.diagnostic.action),
+           static_cast<int>(ReceiveDiagnosticAction::MEASUREMENT_ACCEPTED),
+           "accepted frame records action id");
+  CHECK_TRUE(world.diagnostic.hasVitals, "accepted frame attaches vitals");
+  CHECK_EQ(world.diagnostic.systolic, 120, "diagnostic SYS");
+  CHECK_EQ(world.diagnostic.diastolic, 80, "diagnostic DIA");
+  CHECK_EQ(world.diagnostic.pulse, 72, "diagnostic PULSE");
+  CHECK_STR(world.diagnostic.deviceTimestamp, "2026-07-11 09:05:00",
+            "diagnostic keeps device timestamp");
+  CHECK_EQ(world.diagnostic.recordedAtMs, 42U, "diagnostic records uptime");
+  CHECK_TRUE(contains(rendered(world), "data-status='valid'"),
+             "renderer emits allowlisted status marker");
+  CHECK_TRUE(contains(rendered(world), "SYS 120 / DIA 80 / PULSE 72"),
+             "renderer emits vitals");
+
+  world.transport.feed("garbage\r\n");
+  world.proc.processIncomingData();
+  CHECK_EQ(static_cast<int>(world.diagnostic.status),
+           static_cast<int>(ReceiveDiagnosticStatus::MALFORMED),
+           "rejected frame replaces status");
+  CHECK_TRUE(!world.diagnostic.hasVitals, "rejected frame carries no vitals");
+  CHECK_TRUE(!contains(rendered(world), "SYS"),
+             "rejected diagnostic renders no stale vitals");
+
+  ReceiveDiagnostic bootFailure;
+  bootFailure.set(ReceiveDiagnosticStatus::STORAGE_ERROR,
+                  ReceiveDiagnosticAction::HISTORY_LOAD_FAILED, 0);
+  String html;
+  appendReceiveDiagnosticHtml(html, bootFailure);
+  CHECK_TRUE(contains(html, "data-status='storage_error'"),
+             "boot storage failure keeps stable status marker");
+  CHECK_TRUE(contains(html, "儲存診斷") &&
+             contains(html, "請聯絡管理人員檢查儲存空間"),
+             "boot storage failure renders storage guidance");
+}
+
 int main() {
   testCompleteAndSplitLines();
   testTwoFramesInOneBurst();
   testUnsupportedModelsNeverPersist();
   testInvalidErrorAndMotionPolicy();
   testOverflowDroppedThenRecovers();
+  testFramingReportScoresLineSettings();
   testDeviceTimeIsAuthoritativeAndNonblocking();
   testIdentityNeverReachesDiagnosticsOrRecord();
   testInvalidDeviceTimeIsNotRepaired();
@@ -495,7 +782,12 @@ int main() {
   testOrderedTransportLossRecovery();
   testModelSwitchClearsPartialFrame();
   testCleanReconnectBoundaryKeepsFirstNewFrame();
+  testInterleavedDevicesFrameIndependently();
   testTransportStatusSync();
+  testTransportDetailFormattedOnlyOnVersionChange();
+  testLatencyTraceFollowsMeasurementStages();
+  testConcurrentIngestHandsOffThroughQueue();
   testStorageFailureIsNeverRenderedOrLoggedAsAccepted();
+  testDiagnosticIsStructuredUntilRendered();
   return testReport();
 }
@@ -0,0 +1,161 @@
+// Host tests for precompiled page templates: the bounded writer renders the
+// same text as String for the same operands, literals split across small
+// windows, a slot that does not fit is retried whole in the next window, and
+// a slot larger than an empty window fails instead of truncating markup.
+
+#include <Arduino.h>
+
+#include "lib/HtmlTemplate.h"
+#include "test_support.h"
+
+#include <cstdint>
+#include <string>
+
+using bp_html::BoundedHtmlWriter;
+using bp_html::HtmlSegment;
+using bp_html::HtmlTemplateCursor;
+using bp_html::RenderProgress;
+
+static String text(const char* buffer, size_t length) {
+  return String(std::string(buffer, length).c_str());
+}
+
+template <typename Out>
+static void appendCell(Out& html, const char* label, int32_t value) {
+  html += "<td data-label='";
+  bp_html::appendHtmlEscaped(html, label);
+  html += "'>";
+  html += value;
+  html += '/';
+  html += static_cast<uint64_t>(UINT64_MAX);
+  html += "</td>";
+}
+
+static void testWriterMatchesString() {
+  String expected;
+  appendCell(expected, "<SYS> & 'DIA'", -12);
+
+  char buffer[128];
+  BoundedHtmlWriter html(buffer, sizeof(buffer));
+  appendCell(html, "<SYS> & 'DIA'", -12);
+  CHECK_TRUE(!html.overflowed(), "cell fits");
+  CHECK_STR(text(buffer, html.length()), expected.c_str(),
+            "writer matches String");
+  CHECK_STR(expected,
+            "<td data-label='&lt;SYS&gt; &amp; &#39;DIA&#39;'>"
+            "-12/18446744073709551615</td>",
+            "escaped label and decimal numbers");
+
+  String limits;
+  limits += static_cast<long>(INT64_MIN);
+  limits += ' ';
+  limits += 0;
+  char numbers[64];
+  BoundedHtmlWriter edge(numbers, sizeof(numbers));
+  edge += static_cast<long>(INT64_MIN);
+  edge += ' ';
+  edge += 0;
+  CHECK_STR(text(numbers, edge.length()), limits.c_str(),
+            "integer limits match String");
+
+  char small[8];
+  BoundedHtmlWriter tight(small, sizeof(small));
+  tight += "<td>";
+  tight += "12345";
+  CHECK_TRUE(tight.overflowed(), "full buffer latches overflow");
+
+  BoundedHtmlWriter missing(nullptr, 16);
+  missing += 'x';
+  CHECK_TRUE(missing.overflowed() && missing.length() == 0,
+             "missing buffer has no capacity");
+}
+
+struct SlotContext {
+  const char* value;
+  int calls;
+};
+
+static void renderSlot(void* context, uint8_t slot, BoundedHtmlWriter& out) {
+  SlotContext& state = *static_cast<SlotContext*>(context);
+  state.calls++;
+  if (slot == 1) out += state.value;
+}
+
+static constexpr HtmlSegment kPage[] = {
+  bp_html::htmlLiteral("<main>"),
+  bp_html::htmlSlot(1),
+  bp_html::htmlLiteral("</main>"),
+};
+
+// Renders the whole page through windows of `capacity` bytes.
+static std::string renderAll(const char* value, size_t capacity,
+                             RenderProgress& last, int& windows) {
+  SlotContext context{value, 0};
+  HtmlTemplateCursor cursor;
+  cursor.begin(kPage);
+  std::string out;
+  char window[64];
+  windows = 0;
+  do {
+    size_t written = 0;
+    last = cursor.render(window, capacity, written, renderSlot, &context);
+    out.append(window, written);
+    windows++;
+  } while (last == RenderProgress::FULL && windows < 32);
+  return out;
+}
+
+static void testLiteralsAndSlotsAcrossWindows() {
+  RenderProgress last = RenderProgress::FAILED;
+  int windows = 0;
+  CHECK_STR(String(renderAll("120/80", 64, last, windows).c_str()),
+            "<main>120/80</main>", "one window");
+  CHECK_TRUE(last == RenderProgress::DONE, "page completes");
+  CHECK_EQ(windows, 1, "single window");
+
+  // "<main>" fills the first window exactly, the slot the second, and the
+  // seven-byte tail splits across the last two.
+  CHECK_STR(String(renderAll("120/80", 6, last, windows).c_str()),
+            "<main>120/80</main>", "exact-fit windows");
+  CHECK_TRUE(last == RenderProgress::DONE, "small windows complete");
+  CHECK_EQ(windows, 4, "literal, slot and split tail windows");
+
+  // Literals split mid-text; the slot moves whole to a fresh window.
+  CHECK_STR(String(renderAll("12345", 7, last, windows).c_str()),
+            "<main>12345</main>", "split windows");
+  CHECK_TRUE(last == RenderProgress::DONE, "split literals complete");
+  CHECK_EQ(windows, 3, "slot retried in the next window");
+}
+
+static void testOversizedSlotFails() {
+  SlotContext context{"0123456789", 0};
+  HtmlTemplateCursor cursor;
+  cursor.begin(kPage);
+  char window[8];
+  size_t written = 0;
+  CHECK_TRUE(cursor.render(window, sizeof(window), written, renderSlot,
+                           &context) == RenderProgress::FULL,
+             "slot retried after literal");
+  CHECK_EQ(static_cast<int>(written), 6, "literal written before the retry");
+  written = 0;
+  CHECK_TRUE(cursor.render(window, sizeof(window), written, renderSlot,
+                           &context) == RenderProgress::FAILED,
+             "slot larger than a window fails");
+  CHECK_EQ(static_cast<int>(written), 0, "nothing written for an oversized slot");
+  CHECK_TRUE(!cursor.done(), "failed slot is not skipped");
+
+  HtmlTemplateCursor empty;
+  empty.begin(nullptr, 0);
+  written = 0;
+  CHECK_TRUE(empty.done() &&
+               empty.render(window, sizeof(window), written, renderSlot,
+                            &context) == RenderProgress::DONE,
+             "empty table is done");
+}
+
+int main() {
+  testWriterMatchesString();
+  testLiteralsAndSlotsAcrossWindows();
+  testOversizedSlotFails();
+  return testReport();
+}
@@ -0,0 +1,76 @@
+// Host tests for the rolling per-stage measurement latency histograms.
+
+#include "lib/MeasurementLatency.h"
+#include "test_support.h"
+
+static void testHistogramBucketsAndRollingWindow() {
+  MeasurementLatencyHistogram histogram;
+  CHECK_EQ(histogram.sampleCount(), 0U, "fresh histogram is empty");
+  histogram.add(800);        // <= 1 ms
+  histogram.add(1000);       // bucket bound is inclusive
+  histogram.add(45000);      // <= 100 ms
+  histogram.add(2500000);    // <= 3 s
+  histogram.add(20000000);   // beyond 10 s
+  uint16_t counts[MeasurementLatencyHistogram::kBucketCount];
+  histogram.bucketCounts(counts);
+  CHECK_EQ(counts[0], 2, "sub-millisecond samples share the first bucket");
+  CHECK_EQ(counts[2], 1, "NVS-scale samples land in the 100 ms bucket");
+  CHECK_EQ(counts[4], 1, "poll-scale samples land in the 3 s bucket");
+  CHECK_EQ(counts[6], 1, "overflow bucket collects the rest");
+  CHECK_EQ(histogram.lastUs(), 20000000U, "last sample kept");
+  CHECK_EQ(histogram.maxUs(), 20000000U, "max over the window");
+  CHECK_STR(MeasurementLatencyHistogram::bucketLabel(6), "inf",
+            "overflow bucket label");
+
+  for (size_t i = 0; i < MeasurementLatencyHistogram::kWindow; ++i) {
+    histogram.add(500);
+  }
+  histogram.bucketCounts(counts);
+  CHECK_EQ(histogram.sampleCount(), MeasurementLatencyHistogram::kWindow,
+           "window is bounded");
+  CHECK_EQ(counts[0], MeasurementLatencyHistogram::kWindow,
+           "old samples roll out of the window");
+  CHECK_EQ(histogram.maxUs(), 500U, "max forgets rolled-out samples");
+}
+
+static void testTrackerRecordsStagesAndFirstServeOnly() {
+  MeasurementLatencyTracker tracker;
+  MeasurementLatencyTrace trace;
+  trace.hasRxAccepted = true;
+  trace.rxAcceptedUs = 100;
+  trace.frameCompleteUs = 2100;
+  trace.parsedUs = 2400;
+  tracker.recordDurable(trace, 7, 52400, 60);
+  CHECK_EQ(tracker.histogram(MeasurementLatencyStage::USB_TO_FRAME).lastUs(),
+           2000U, "USB stage");
+  CHECK_EQ(tracker.histogram(MeasurementLatencyStage::FRAME_TO_PARSED).lastUs(),
+           300U, "parse stage");
+  CHECK_EQ(tracker.histogram(MeasurementLatencyStage::PARSED_TO_DURABLE).lastUs(),
+           50000U, "durable stage");
+
+  tracker.noteServed(6, 1000);
+  CHECK_EQ(tracker.histogram(MeasurementLatencyStage::DURABLE_TO_SERVED)
+             .sampleCount(), 0U, "older revision does not count as served");
+  tracker.noteServed(7, 3060);
+  tracker.noteServed(7, 9000);
+  const MeasurementLatencyHistogram& served =
+    tracker.histogram(MeasurementLatencyStage::DURABLE_TO_SERVED);
+  CHECK_EQ(served.sampleCount(), 1U, "only the first serve is recorded");
+  CHECK_EQ(served.lastUs(), 3000000U, "served stage measured from durable");
+
+  trace.hasRxAccepted = false;
+  tracker.recordDurable(trace, 8, 0, 100);
+  CHECK_EQ(tracker.histogram(MeasurementLatencyStage::USB_TO_FRAME)
+             .sampleCount(), 1U, "missing accept time skips USB stage");
+  tracker.noteServed(8, 100 + 5000000U);
+  CHECK_EQ(served.lastUs(), UINT32_MAX,
+           "served stage saturates instead of wrapping");
+  CHECK_STR(measurementLatencyStageCode(MeasurementLatencyStage::PARSED_TO_DURABLE),
+            "parsed_to_durable", "stable stage code");
+}
+
+int main() {
+  testHistogramBucketsAndRollingWindow();
+  testTrackerRecordsStagesAndFirstServeOnly();
+  return testReport();
+}
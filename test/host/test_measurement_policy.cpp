@@ -427,6 +427,18 @@ static void testOpaqueSequenceDecimalFormatting() {
   char tooSmall[20] = {};
   CHECK_TRUE(!formatOpaqueSequence(UINT64_MAX, tooSmall, sizeof(tooSmall)),
              "opaque sequence formatting rejects truncation");
+
+  uint64_t parsed = 0;
+  CHECK_TRUE(parseOpaqueSequence(encoded, parsed) && parsed == UINT64_MAX,
+             "formatted opaque sequence parses back exactly");
+  CHECK_TRUE(parseOpaqueSequence("0", parsed) && parsed == 0U,
+             "zero cursor parses");
+  const char* rejected[] = {"", "-1", "+1", "01", "1.0", " 1", "1x",
+                            "18446744073709551616"};
+  for (const char* text : rejected) {
+    CHECK_TRUE(!parseOpaqueSequence(text, parsed),
+               "non-canonical or overflowing opaque sequence is rejected");
+  }
 }
 
 int main() {
@@ -0,0 +1,191 @@
+// Host tests for the seqlock-published web measurement snapshot. Concurrent
+// reader/writer coverage lives in stress_ingest_pipeline.cpp (TSan gate).
+
+#include <Arduino.h>
+
+#include <cstring>
+#include <type_traits>
+
+#include "lib/MeasurementSnapshot.h"
+#include "test_support.h"
+
+static BPData deviceRecord(int systolic) {
+  BPData record;
+  record.timestamp = "2026-07-11 09:05:00";
+  record.timestampSource = BPTimestampSource::DEVICE;
+  record.systolic = systolic;
+  record.diastolic = 80;
+  record.pulse = 72;
+  record.movementCount = 1;
+  record.quality = BPMeasurementQuality::MOTION;
+  record.valid = true;
+  return record;
+}
+
+static void testSeqlockPublishesWholeValues() {
+  struct Pair {
+    uint64_t a;
+    uint32_t b;
+  };
+  SeqlockSnapshot<Pair> lock;
+  CHECK_EQ(lock.publication(), 0U, "fresh snapshot has no publications");
+  CHECK_EQ(lock.read().a, 0ULL, "fresh snapshot reads value-initialized data");
+
+  lock.publish(Pair{7, 8});
+  CHECK_EQ(lock.publication(), 1U, "publish advances publication count");
+  CHECK_EQ(lock.read().a, 7ULL, "reader sees first publication");
+  CHECK_EQ(lock.read().b, 8U, "reader sees every field of one publication");
+
+  lock.publish(Pair{9, 10});
+  lock.publish(Pair{11, 12});
+  const Pair latest = lock.read();
+  CHECK_EQ(latest.a, 11ULL, "double buffer returns newest after wrap");
+  CHECK_EQ(latest.b, 12U, "double buffer never mixes slots");
+  CHECK_EQ(lock.publication(), 3U, "every publish is counted");
+}
+
+static void testCaptureCopiesLatestAndFreshnessInputs() {
+  CHECK_TRUE(std::is_trivially_copyable<MeasurementSnapshot>::value,
+             "measurement snapshot is seqlock-safe POD");
+  Preferences::__reset();
+  __millisCounter() = 1000;
+  BP_RecordManager records{5};
+  records.loadFromStorage();
+  ReceiveDiagnostic diagnostic;
+  MonitorTransportSummary transport;
+  transport.state = TRANSPORT_STATE_READY;
+  transport.dataLossCount = 3;
+
+  MeasurementSnapshot empty = captureMeasurementSnapshot(records, diagnostic,
+                                                         transport);
+  CHECK_TRUE(!empty.hasRecord(), "empty history has no latest record");
+  CHECK_TRUE(!empty.hasSuccessfulReceive, "no receive before first record");
+  CHECK_EQ(empty.transport.dataLossCount, 3U, "transport counters captured");
+
+  CHECK_TRUE(records.addRecord(deviceRecord(121)), "fixture record persists");
+  diagnostic.set(ReceiveDiagnosticStatus::VALID,
+                 ReceiveDiagnosticAction::MEASUREMENT_ACCEPTED, 1000);
+  MeasurementSnapshotPublisher publisher;
+  publisher.publish(captureMeasurementSnapshot(records, diagnostic, transport));
+  const MeasurementSnapshot snapshot = publisher.read();
+  CHECK_EQ(snapshot.revision, records.getRevision(), "revision captured");
+  CHECK_EQ(snapshot.recordCount, 1, "record count captured");
+  CHECK_EQ(snapshot.latest.systolic, 121, "latest vitals captured");
+  CHECK_EQ(snapshot.latest.movementCount, 1, "movement metadata captured");
+  CHECK_STR(snapshot.latest.timestamp, "2026-07-11 09:05:00",
+            "latest timestamp copied into fixed buffer");
+  CHECK_TRUE(snapshot.receivedThisBoot, "this-boot receive captured");
+  CHECK_EQ(static_cast<int>(snapshot.diagnostic.status),
+           static_cast<int>(ReceiveDiagnosticStatus::VALID),
+           "diagnostic captured");
+
+  uint64_t ageMs = 0;
+  CHECK_TRUE(snapshot.lastSuccessfulReceiveAgeMs(1600, ageMs),
+             "receive age available from snapshot");
+  CHECK_EQ(ageMs, 600ULL, "receive age uses reader clock sample");
+  CHECK_TRUE(!snapshot.lastSuccessfulReceiveAgeMs(999, ageMs),
+             "receive age never underflows");
+  const MeasurementFreshnessInput input = snapshot.freshnessInput(1600, 5000);
+  CHECK_TRUE(input.hasRecord && input.valid && input.transportConnected,
+             "freshness input mirrors snapshot");
+  CHECK_EQ(input.lastSuccessfulReceiveMs, 1000ULL,
+           "freshness input carries absolute receive time");
+
+  const BPData roundTrip = snapshot.latest.toBPData();
+  CHECK_STR(roundTrip.timestamp, "2026-07-11 09:05:00",
+            "reader-side BPData keeps timestamp");
+  CHECK_EQ(static_cast<int>(roundTrip.quality),
+           static_cast<int>(BPMeasurementQuality::MOTION),
+           "reader-side BPData keeps quality");
+}
+
+static void testEtagChangesWithEveryInput() {
+  MeasurementEtagParts base;
+  base.bootNonce = 0xdeadbeefU;
+  base.revision = 0x1122334455667788ULL;
+  base.recordCount = 100;
+  base.policyVersion = 3;
+  base.transportVersion = 41;
+  base.diagnosticStamp = 9000;
+  base.freshness = 2;
+  base.role = 1;
+  char tag[kMeasurementEtagCapacity];
+  formatMeasurementEtag(tag, base);
+  CHECK_STR(tag, "W/\"deadbeef-1122334455667788-64-3-29-2328-21\"",
+            "tag is weak, quoted and fixed in field order");
+
+  char again[kMeasurementEtagCapacity];
+  formatMeasurementEtag(again, base);
+  CHECK_TRUE(std::strcmp(tag, again) == 0, "same inputs, same tag");
+
+  MeasurementEtagParts changed[8] = {base, base, base, base,
+                                     base, base, base, base};
+  changed[0].bootNonce++;
+  changed[1].revision++;
+  changed[2].recordCount--;
+  changed[3].policyVersion++;
+  changed[4].transportVersion++;
+  changed[5].diagnosticStamp++;
+  changed[6].freshness = 1;
+  changed[7].role = 2;
+  for (const MeasurementEtagParts& parts : changed) {
+    formatMeasurementEtag(again, parts);
+    CHECK_TRUE(std::strcmp(tag, again) != 0, "each input changes the tag");
+  }
+
+  MeasurementEtagParts widest;
+  widest.bootNonce = UINT32_MAX;
+  widest.revision = UINT64_MAX;
+  widest.recordCount = -1;
+  widest.policyVersion = UINT32_MAX;
+  widest.transportVersion = UINT32_MAX;
+  widest.diagnosticStamp = UINT32_MAX;
+  widest.freshness = 0xff;
+  widest.role = 0xff;
+  formatMeasurementEtag(again, widest);
+  CHECK_EQ(std::strlen(again), 68U, "widest tag fits without truncation");
+}
+
+static void testEventKindFollowsTheChangedInput() {
+  MeasurementEtagParts sent;
+  sent.revision = 7;
+  sent.recordCount = 3;
+  sent.policyVersion = 2;
+  sent.transportVersion = 10;
+  sent.diagnosticStamp = 500;
+  sent.freshness = 1;
+  CHECK_EQ(static_cast<int>(classifyMeasurementEvent(sent, sent)),
+           static_cast<int>(MeasurementEventKind::NONE),
+           "unchanged state pushes nothing");
+
+  MeasurementEtagParts next = sent;
+  next.diagnosticStamp++;
+  CHECK_STR(measurementEventName(classifyMeasurementEvent(sent, next)),
+            "diagnostic", "new diagnostic");
+  next = sent;
+  next.freshness = 2;
+  CHECK_STR(measurementEventName(classifyMeasurementEvent(sent, next)),
+            "diagnostic", "freshness change is a diagnostic event");
+  next.transportVersion++;
+  CHECK_STR(measurementEventName(classifyMeasurementEvent(sent, next)),
+            "transport", "transport outranks diagnostics");
+  next.revision++;
+  CHECK_STR(measurementEventName(classifyMeasurementEvent(sent, next)),
+            "measurement", "new record outranks everything");
+  next = sent;
+  next.policyVersion++;
+  CHECK_STR(measurementEventName(classifyMeasurementEvent(sent, next)),
+            "measurement", "policy change re-sends the measurement");
+  next = sent;
+  next.recordCount = 0;
+  CHECK_STR(measurementEventName(classifyMeasurementEvent(sent, next)),
+            "measurement", "cleared history is a measurement event");
+}
+
+int main() {
+  testSeqlockPublishesWholeValues();
+  testCaptureCopiesLatestAndFreshnessInputs();
+  testEtagChangesWithEveryInput();
+  testEventKindFollowsTheChangedInput();
+  return testReport();
+}
@@ -274,6 +274,41 @@ static void testGoldenLittleEndianWireLayout() {
            "state sequence-floor offset is fixed and 64-bit LE");
 }
 
+static void testDeviceSlotTagIsOptionalAndFailsClosed() {
+  Preferences::__reset();
+  BP_RecordManager manager(3);
+  initializeEmpty(manager);
+  CHECK_TRUE(addAndReport(manager,
+                          makeRecord("2026-07-11 09:05:00", 120, 80, 72)),
+             "single-monitor add");
+  BPData tagged = makeRecord("2026-07-11 09:06:00", 130, 85, 75);
+  tagged.deviceSlot = 2;
+  CHECK_TRUE(addAndReport(manager, std::move(tagged)), "tagged add");
+  CHECK_EQ(Preferences::__getRawBytes("bp_records", "v3_0").size(), 64UL,
+           "slot 0 stays untagged and byte-identical");
+  const std::vector<uint8_t> taggedBytes =
+    Preferences::__getRawBytes("bp_records", "v3_1");
+  CHECK_EQ(taggedBytes.size(), 65UL, "tag adds one byte before the CRC");
+  CHECK_EQ(taggedBytes.size() == 65 ? taggedBytes[60] : 0, 2,
+           "tag byte holds the device slot");
+
+  BP_RecordManager rebooted(3);
+  CHECK_TRUE(loadAndReport(rebooted), "mixed tagged reload succeeds");
+  CHECK_EQ(rebooted.getLatestRecord().deviceSlot, 2, "device slot round-trip");
+  CHECK_EQ(rebooted.getRecord(1).deviceSlot, 0, "untagged slot decodes as 0");
+
+  std::vector<uint8_t> zeroTag = taggedBytes;
+  if (zeroTag.size() == 65) {
+    zeroTag[60] = 0;
+    rewriteTestCrc(zeroTag);
+  }
+  Preferences::__putRawBytes("bp_records", "v3_1", zeroTag);
+  BP_RecordManager ambiguous(3);
+  CHECK_TRUE(!loadAndReport(ambiguous),
+             "valid-CRC zero tag is ambiguous and reports degraded load");
+  CHECK_EQ(ambiguous.getRecordCount(), 1, "zero-tagged slot is ignored");
+}
+
 static void testFreshStateInitializationCuts() {
   for (const auto mode : {Preferences::FailureMode::HARD_CUT_BEFORE_APPLY,
                           Preferences::FailureMode::HARD_CUT_AFTER_APPLY}) {
@@ -362,6 +397,146 @@ static void testRingWrapAndSequenceFloor() {
            "clear retains sequence floor and never reuses sequence");
 }
 
+static void testSequenceCursorSurvivesShiftingIndexes() {
+  Preferences::__reset();
+  BP_RecordManager manager(4);
+  initializeEmpty(manager);
+  CHECK_EQ(manager.indexBeforeSequence(UINT64_MAX), -1,
+           "empty history has no record before any cursor");
+  CHECK_EQ(manager.indexAfterSequence(0), -1,
+           "empty history has no record after any cursor");
+  for (int i = 1; i <= 6; ++i) {
+    CHECK_TRUE(addAndReport(manager,
+                           makeRecord("2026-07-11 09:00:00", 100 + i, 70, 60)),
+               "cursor fixture add persists");
+  }
+  // Retained sequences, newest first: 6 5 4 3.
+  CHECK_EQ(manager.indexBeforeSequence(UINT64_MAX), 0,
+           "open cursor starts at the newest record");
+  CHECK_EQ(manager.indexBeforeSequence(5), 2, "record before 5 is 4");
+  CHECK_EQ(manager.indexBeforeSequence(3), -1, "nothing before the oldest");
+  CHECK_EQ(manager.indexBeforeSequence(2), -1,
+           "evicted cursor below the ring has nothing before it");
+  CHECK_EQ(manager.indexAfterSequence(0), 3,
+           "zero cursor starts at the oldest record");
+  CHECK_EQ(manager.indexAfterSequence(4), 1, "record after 4 is 5");
+  CHECK_EQ(manager.indexAfterSequence(6), -1, "nothing after the newest");
+  CHECK_EQ(manager.indexAfterSequence(UINT64_MAX), -1,
+           "maximum cursor never wraps");
+
+  const int before = manager.indexBeforeSequence(5);
+  CHECK_TRUE(addAndReport(manager,
+                         makeRecord("2026-07-11 09:10:00", 140, 90, 70)),
+             "add between chunks persists");
+  CHECK_EQ(recordSequenceOf(manager.getRecord(before)), 5ULL,
+           "the old index now points at the cursor record itself");
+  CHECK_EQ(recordSequenceOf(
+             manager.getRecord(manager.indexBeforeSequence(5))), 4ULL,
+           "resuming by sequence still finds the next record");
+}
+
+static void testContentVersionTracksEveryChange() {
+  Preferences::__reset();
+  BP_RecordManager manager(2);
+  initializeEmpty(manager);
+  const uint64_t empty = manager.contentVersion();
+  CHECK_TRUE(manager.clearRecords(), "clearing an empty store persists");
+  CHECK_EQ(manager.getRevision(), 0ULL, "empty clear keeps revision zero");
+  CHECK_TRUE(manager.contentVersion() != empty,
+             "clear changes content even when the revision does not");
+
+  uint64_t previous = manager.contentVersion();
+  for (int i = 1; i <= 3; ++i) {
+    CHECK_TRUE(addAndReport(manager,
+                           makeRecord("2026-07-11 09:00:00", 100 + i, 70, 60)),
+               "content fixture add persists");
+    CHECK_TRUE(manager.contentVersion() != previous,
+               "every add, including a ring overwrite, changes content");
+    previous = manager.contentVersion();
+  }
+  (void)manager.getRecord(0);
+  (void)manager.indexBeforeSequence(UINT64_MAX);
+  CHECK_EQ(manager.contentVersion(), previous, "reads leave content unchanged");
+  CHECK_TRUE(manager.loadFromStorage(), "reload succeeds");
+  CHECK_TRUE(manager.contentVersion() != previous, "reload changes content");
+}
+
+static void testDeltaPagesFollowTheSequenceCursor() {
+  Preferences::__reset();
+  BP_RecordManager manager(4);
+  initializeEmpty(manager);
+  BP_RecordManager::SequencePage page = manager.pageAfterSequence(0, 10);
+  CHECK_EQ(page.count, 0, "empty history has an empty first page");
+  CHECK_TRUE(!page.gap && !page.hasMore, "empty history is not a gap");
+  CHECK_EQ(page.nextSince, 0ULL, "empty page keeps the cursor");
+
+  for (int i = 1; i <= 3; ++i) {
+    CHECK_TRUE(addAndReport(manager,
+                           makeRecord("2026-07-11 09:00:00", 100 + i, 70, 60)),
+               "delta fixture add persists");
+  }
+  page = manager.pageAfterSequence(0, 2);
+  CHECK_EQ(page.count, 2, "page stops at the limit");
+  CHECK_EQ(recordSequenceOf(manager.getRecord(page.firstIndex)), 1ULL,
+           "page starts at the oldest unseen record");
+  CHECK_EQ(page.nextSince, 2ULL, "cursor is the last returned record");
+  CHECK_TRUE(page.hasMore && !page.gap, "more records wait, none lost");
+  page = manager.pageAfterSequence(page.nextSince, 2);
+  CHECK_EQ(page.count, 1, "second page returns the remainder");
+  CHECK_EQ(page.nextSince, 3ULL, "cursor reaches the newest record");
+  CHECK_TRUE(!page.hasMore, "caught up");
+  page = manager.pageAfterSequence(3, 2);
+  CHECK_EQ(page.count, 0, "poll without new data is empty");
+  CHECK_EQ(page.nextSince, 3ULL, "empty poll keeps the cursor");
+
+  for (int i = 4; i <= 7; ++i) {
+    CHECK_TRUE(addAndReport(manager,
+                           makeRecord("2026-07-11 09:05:00", 100 + i, 70, 60)),
+               "wrap fixture add persists");
+  }
+  // Retained sequences, oldest first: 4 5 6 7.
+  page = manager.pageAfterSequence(3, 10);
+  CHECK_TRUE(!page.gap, "cursor just below the ring lost nothing");
+  CHECK_EQ(page.count, 4, "all retained records are new");
+  page = manager.pageAfterSequence(2, 10);
+  CHECK_TRUE(page.gap, "overwritten record 3 is reported as a gap");
+  CHECK_EQ(recordSequenceOf(manager.getRecord(page.firstIndex)), 4ULL,
+           "gap page still starts at the oldest retained record");
+  page = manager.pageAfterSequence(0, 10);
+  CHECK_TRUE(!page.gap, "full resync after a ring wrap is not a gap");
+  CHECK_EQ(page.count, 4, "full resync returns every retained record");
+  CHECK_EQ(recordSequenceOf(manager.getRecord(page.firstIndex)), 4ULL,
+           "full resync starts at the oldest retained record");
+  CHECK_EQ(page.nextSince, 7ULL, "full resync reaches the newest record");
+
+  page = manager.pageAfterSequence(9, 10);
+  CHECK_TRUE(page.gap, "cursor ahead of the store must resync");
+  CHECK_EQ(page.nextSince, 7ULL, "resync cursor is the current revision");
+  CHECK_TRUE(clearAndReport(manager), "delta clear persists");
+  page = manager.pageAfterSequence(7, 10);
+  CHECK_TRUE(page.gap && page.count == 0, "cleared history is a gap");
+  CHECK_EQ(page.nextSince, 0ULL, "cleared history restarts the cursor");
+  page = manager.pageAfterSequence(0, 10);
+  CHECK_TRUE(!page.gap && page.count == 0,
+             "full resync of cleared history is empty, not a gap");
+  for (int i = 8; i <= 9; ++i) {
+    CHECK_TRUE(addAndReport(manager,
+                           makeRecord("2026-07-11 09:10:00", 100 + i, 70, 60)),
+               "post-clear delta add persists");
+  }
+  // Retained sequences, oldest first: 8 9.
+  page = manager.pageAfterSequence(0, 10);
+  CHECK_TRUE(!page.gap, "full resync after a clear is not a gap");
+  CHECK_EQ(page.count, 2, "full resync after a clear returns new records");
+  CHECK_EQ(recordSequenceOf(manager.getRecord(page.firstIndex)), 8ULL,
+           "full resync after a clear starts at the oldest retained record");
+  page = manager.pageAfterSequence(5, 10);
+  CHECK_TRUE(page.gap, "stale cursor below the oldest retained record is a gap");
+  CHECK_EQ(page.count, 2, "stale cursor still receives the retained records");
+  CHECK_EQ(manager.pageAfterSequence(UINT64_MAX, 10).count, 0,
+           "maximum cursor never wraps");
+}
+
 static void testSmallCapacityBoundsAndInvalidRoundTrip() {
   Preferences::__reset();
   BP_RecordManager manager(1);
@@ -1292,9 +1467,13 @@ static void testSameProcessRetryReconcilesCleanupFailures() {
 int main() {
   testApiAndStructuredRoundTrip();
   testGoldenLittleEndianWireLayout();
+  testDeviceSlotTagIsOptionalAndFailsClosed();
   testFreshStateInitializationCuts();
   testPreferencesLifecycleAndBeginFailures();
   testRingWrapAndSequenceFloor();
+  testSequenceCursorSurvivesShiftingIndexes();
+  testDeltaPagesFollowTheSequenceCursor();
+  testContentVersionTracksEveryChange();
   testSmallCapacityBoundsAndInvalidRoundTrip();
   testAddFaultReconciliation();
   testHardCutAppendAndFullRingOverwrite();
@@ -0,0 +1,108 @@
+// Host tests for the rendered-page cache: entries are kept per route and
+// role, a lookup with a newer key misses and wipes the stale body, oversized
+// bodies are refused, and invalidate() clears every entry.
+
+#include <Arduino.h>
+
+#include "lib/RenderedPageCache.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <string>
+
+using bp_web::AccessRole;
+using bp_web::RenderedPageCache;
+using bp_web::RenderedPageKey;
+
+using TestCache = RenderedPageCache<2, 16>;
+
+static String found(TestCache& cache, size_t route, AccessRole role,
+                    const RenderedPageKey& key) {
+  size_t length = 0;
+  const char* body = cache.find(route, role, key, length);
+  if (body == nullptr) return String("<miss>");
+  return String(std::string(body, length).c_str());
+}
+
+static RenderedPageKey key(uint64_t content, uint32_t policy) {
+  RenderedPageKey result;
+  result.contentVersion = content;
+  result.policyVersion = policy;
+  return result;
+}
+
+static void testEntriesAreKeptPerRouteAndRole() {
+  static TestCache cache;
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(1, 1)), "<miss>",
+            "empty cache misses");
+  CHECK_TRUE(cache.store(0, AccessRole::STAFF, key(1, 1), "staff", 5),
+             "staff body stored");
+  CHECK_TRUE(cache.store(0, AccessRole::ADMIN, key(1, 1), "admin+clear", 11),
+             "admin body stored");
+  CHECK_TRUE(cache.store(1, AccessRole::STAFF, key(1, 1), "other", 5),
+             "second route stored");
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(1, 1)), "staff",
+            "staff never sees the admin variant");
+  CHECK_STR(found(cache, 0, AccessRole::ADMIN, key(1, 1)), "admin+clear",
+            "admin variant kept separately");
+  CHECK_STR(found(cache, 1, AccessRole::STAFF, key(1, 1)), "other",
+            "routes kept separately");
+
+  CHECK_TRUE(!cache.store(0, AccessRole::NONE, key(1, 1), "anon", 4),
+             "anonymous role has no entry");
+  CHECK_STR(found(cache, 0, AccessRole::NONE, key(1, 1)), "<miss>",
+            "anonymous role never hits");
+  CHECK_TRUE(!cache.store(2, AccessRole::STAFF, key(1, 1), "x", 1),
+             "unknown route has no entry");
+}
+
+static void testNewerKeysMissAndWipe() {
+  static TestCache cache;
+  CHECK_TRUE(cache.store(0, AccessRole::STAFF, key(1, 1), "records", 7),
+             "fixture stored");
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(2, 1)), "<miss>",
+            "new record content misses");
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(1, 1)), "<miss>",
+            "stale body was wiped, not kept for the old key");
+
+  CHECK_TRUE(cache.store(0, AccessRole::STAFF, key(2, 1), "records", 7),
+             "refilled");
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(2, 2)), "<miss>",
+            "policy update misses");
+
+  CHECK_TRUE(cache.store(0, AccessRole::STAFF, key(3, 2), "longer body", 11),
+             "longer body stored");
+  CHECK_TRUE(cache.store(0, AccessRole::STAFF, key(4, 2), "short", 5),
+             "shorter body replaces it");
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(4, 2)), "short",
+            "replacement served whole");
+
+  char big[17];
+  memset(big, 'x', sizeof(big));
+  CHECK_TRUE(!cache.store(0, AccessRole::STAFF, key(5, 2), big, sizeof(big)),
+             "body beyond capacity refused");
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(4, 2)), "<miss>",
+            "refused store drops the previous body");
+}
+
+static void testInvalidateClearsEverything() {
+  static TestCache cache;
+  CHECK_TRUE(cache.store(0, AccessRole::STAFF, key(1, 1), "a", 1) &&
+               cache.store(0, AccessRole::ADMIN, key(1, 1), "b", 1) &&
+               cache.store(1, AccessRole::ADMIN, key(1, 1), "c", 1),
+             "fixtures stored");
+  cache.invalidate();
+  CHECK_STR(found(cache, 0, AccessRole::STAFF, key(1, 1)), "<miss>",
+            "staff entry cleared");
+  CHECK_STR(found(cache, 0, AccessRole::ADMIN, key(1, 1)), "<miss>",
+            "admin entry cleared");
+  CHECK_STR(found(cache, 1, AccessRole::ADMIN, key(1, 1)), "<miss>",
+            "every route cleared");
+}
+
+int main() {
+  testEntriesAreKeptPerRouteAndRole();
+  testNewerKeysMissAndWipe();
+  testInvalidateClearsEverything();
+  return testReport();
+}
@@ -0,0 +1,123 @@
+// Host tests for the UART line-setting detector: packing for NVS, candidate
+// order, lock on valid frames, and the evidence needed to move on.
+
+#include <Arduino.h>
+
+#include "lib/transports/UartLineDetector.h"
+#include "test_support.h"
+
+static const UartLineSetting kCandidates[] = {
+  {9600, 8, 'N', 1},
+  {19200, 8, 'N', 1},
+  {9600, 7, 'E', 2},
+};
+static constexpr size_t kCount = sizeof(kCandidates) / sizeof(kCandidates[0]);
+
+static void testPackRoundTripsAndRejectsGarbage() {
+  for (const UartLineSetting& setting : kCandidates) {
+    UartLineSetting decoded;
+    CHECK_TRUE(uartLineUnpack(uartLinePack(setting), decoded), "unpacks");
+    CHECK_TRUE(decoded == setting, "round trip is exact");
+  }
+  UartLineSetting decoded;
+  CHECK_TRUE(!uartLineUnpack(0, decoded), "zero means nothing persisted");
+  CHECK_TRUE(!uartLineUnpack(0xFFFFFFFFU, decoded), "garbage word refused");
+  UartLineSetting odd;
+  odd.parity = 'X';
+  CHECK_EQ(uartLinePack(odd), 0U, "invalid setting never packs");
+}
+
+static void testSearchLocksOnFirstValidFrame() {
+  UartLineDetector detector;
+  detector.begin(kCandidates, kCount, 0);
+  CHECK_TRUE(detector.current() == kCandidates[0], "starts at the first");
+  CHECK_TRUE(!detector.locked(), "searching");
+
+  CHECK_TRUE(!detector.note(40, 0, 1, 0), "one reject is not enough");
+  CHECK_TRUE(detector.note(40, 0, 1, 0), "second reject moves on");
+  CHECK_TRUE(detector.current() == kCandidates[1], "next candidate");
+
+  CHECK_TRUE(!detector.note(60, 1, 0, 0), "valid frame does not switch");
+  CHECK_TRUE(detector.locked(), "valid frame locks");
+  CHECK_EQ(detector.telemetry().locks, 1U, "lock counted");
+  CHECK_EQ(detector.telemetry().switches, 1U, "one switch");
+  CHECK_EQ(detector.telemetry().framesPerKiB(), 17U, "score from the lock");
+}
+
+static void testMajorityRejectsDelayTheLock() {
+  UartLineDetector detector;
+  detector.begin(kCandidates, kCount, 0);
+  detector.note(40, 0, 1, 0);
+  detector.note(40, 1, 2, 0);
+  CHECK_TRUE(!detector.locked(), "more rejects than frames is no lock");
+  detector.note(40, 1, 0, 0);
+  CHECK_TRUE(!detector.locked(), "still behind: 2 frames, 3 rejects");
+  detector.note(40, 1, 0, 0);
+  CHECK_TRUE(detector.locked(), "frames catch up, lock");
+}
+
+static void testByteBudgetWithoutFrames() {
+  UartLineDetector detector;
+  detector.begin(kCandidates, kCount, 0);
+  // Fixed-length protocols may never find a sync word at the wrong rate.
+  CHECK_TRUE(!detector.note(kUartLineSearchBytes - 1, 0, 0, 0), "under budget");
+  CHECK_TRUE(detector.note(1, 0, 0, 0), "byte budget moves on");
+  detector.note(kUartLineSearchBytes, 0, 0, 0);
+  CHECK_TRUE(detector.current() == kCandidates[2], "third candidate");
+  detector.note(kUartLineSearchBytes, 0, 0, 0);
+  CHECK_TRUE(detector.current() == kCandidates[0], "list wraps around");
+}
+
+static void testLockedSettingToleratesNoise() {
+  UartLineDetector detector;
+  detector.begin(kCandidates, kCount, uartLinePack(kCandidates[2]));
+  CHECK_TRUE(detector.locked(), "persisted setting starts locked");
+  CHECK_TRUE(detector.current() == kCandidates[2], "persisted setting used");
+
+  for (uint32_t i = 0; i + 1 < kUartLineLockedRejects; ++i) {
+    CHECK_TRUE(!detector.note(40, 0, 1, 0), "noise below the locked limit");
+  }
+  detector.note(40, 1, 0, 0);
+  for (uint32_t i = 0; i + 1 < kUartLineLockedRejects; ++i) {
+    detector.note(40, 0, 1, 0);
+  }
+  CHECK_TRUE(detector.locked(), "a valid frame resets the evidence");
+
+  // Cable swapped to a monitor at another rate: line errors pile up.
+  CHECK_TRUE(detector.note(10, 0, 0, kUartLineLockedLineErrors),
+             "line errors drop the lock");
+  CHECK_TRUE(!detector.locked(), "searching again");
+  CHECK_TRUE(detector.current() == kCandidates[0],
+             "search resumes after the dropped setting");
+}
+
+static void testPersistedSettingOutsideTheList() {
+  UartLineSetting custom;
+  custom.baudRate = 1200;
+  UartLineDetector detector;
+  detector.begin(kCandidates, kCount, uartLinePack(custom));
+  CHECK_TRUE(detector.current() == custom, "custom setting kept");
+  detector.note(kUartLineLockedBytes, 0, 0, 0);
+  CHECK_TRUE(detector.current() == kCandidates[0],
+             "falls back to the configured list");
+}
+
+static void testSingleCandidateNeverSwitches() {
+  UartLineDetector detector;
+  detector.begin(kCandidates, 1, 0);
+  CHECK_TRUE(!detector.note(kUartLineSearchBytes, 0, 5, 5),
+             "nothing else to try");
+  CHECK_TRUE(detector.current() == kCandidates[0], "fixed setting kept");
+  CHECK_EQ(detector.telemetry().switches, 0U, "no switch counted");
+}
+
+int main() {
+  testPackRoundTripsAndRejectsGarbage();
+  testSearchLocksOnFirstValidFrame();
+  testMajorityRejectsDelayTheLock();
+  testByteBudgetWithoutFrames();
+  testLockedSettingToleratesNoise();
+  testPersistedSettingOutsideTheList();
+  testSingleCandidateNeverSwitches();
+  return testReport();
+}
@@ -0,0 +1,267 @@
+// Host tests for UartTransport on the fake ESP-IDF UART driver: bulk reads per
+// UART_DATA run, ordered loss markers for FIFO and ring-buffer overflows, and
+// runtime line-setting switches driven by framing feedback.
+
+#include <Arduino.h>
+
+#include <string>
+
+#include "lib/transports/UartTransport.h"
+#include "test_support.h"
+
+static const UartLineSetting kCandidates[] = {
+  {9600, 8, 'N', 1},
+  {19200, 8, 'N', 1},
+  {9600, 7, 'E', 1},
+};
+static constexpr size_t kCandidateCount =
+  sizeof(kCandidates) / sizeof(kCandidates[0]);
+
+struct Uart {
+  explicit Uart(uint32_t persisted = 0)
+    : transport(UART_NUM_1, 44, 43, kCandidates, kCandidateCount, persisted) {}
+  UartTransport transport;
+};
+
+static void receive(const char* text) {
+  hostUartReceive(reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+// Drains the transport; loss and reset markers show up as '|'.
+static std::string drain(UartTransport& transport, uint32_t* lastEpoch) {
+  std::string out;
+  bool slotZero = true;
+  MonitorRxEvent event;
+  while (transport.nextRxEvent(event)) {
+    slotZero = slotZero && event.device == 0;
+    if (event.type != MonitorRxEventType::BYTE) {
+      out.push_back('|');
+    } else {
+      out.push_back(static_cast<char>(event.byte));
+    }
+    if (lastEpoch != nullptr) *lastEpoch = event.epoch;
+  }
+  CHECK_TRUE(slotZero, "single-device transport uses slot 0");
+  return out;
+}
+
+static void testBeginInstallsDriver() {
+  hostUartReset();
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  CHECK_TRUE(transport.begin(), "driver installs");
+  CHECK_EQ(hostUart().config.baud_rate, 9600, "baud configured");
+  CHECK_EQ(hostUart().rxPin, 44, "RX pin routed");
+  CHECK_EQ(hostUart().txPin, 43, "TX pin routed");
+  CHECK_EQ(transport.state(), TRANSPORT_STATE_READY, "ready after begin");
+  CHECK_STR(transport.detail(),
+            "UART fallback active (RX:44, TX:43, 9600bps 8N1, searching)",
+            "detail names the wiring and line setting");
+}
+
+static void testInstallFailureIsReported() {
+  hostUartReset();
+  hostUart().installResult = ESP_ERR_NO_MEM;
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  CHECK_TRUE(!transport.begin(), "begin reports failure");
+  CHECK_EQ(transport.state(), TRANSPORT_STATE_ERROR, "error state");
+  MonitorRxEvent event;
+  CHECK_TRUE(!transport.nextRxEvent(event), "no events without a driver");
+  CHECK_STR(transport.detail(), "UART driver install failed (UART1)",
+            "detail explains the failure");
+}
+
+static void testDataRunsAreReadInBulk() {
+  hostUartReset();
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  transport.begin();
+  receive("120,80,");
+  receive("72\r\n");
+  transport.poll();
+  CHECK_EQ(transport.state(), TRANSPORT_STATE_RECEIVING, "bytes pending");
+  CHECK_EQ(transport.available(), 11, "available counts driver bytes");
+
+  uint32_t epoch = 99;
+  CHECK_TRUE(drain(transport, &epoch) == "120,80,72\r\n", "bytes in order");
+  CHECK_EQ(epoch, 0U, "no loss, first epoch");
+  CHECK_EQ(hostUart().readCalls, 2U, "one read per UART_DATA run");
+  uint32_t acceptedUs = 0;
+  CHECK_TRUE(transport.lastRxAcceptedUs(acceptedUs), "receive time stamped");
+  CHECK_EQ(transport.dataLossCount(), 0U, "no loss counted");
+
+  transport.poll();
+  CHECK_EQ(transport.state(), TRANSPORT_STATE_READY, "idle again");
+}
+
+static void testFifoOverflowBecomesOrderedMarker() {
+  hostUartReset();
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  transport.begin();
+  const uint32_t versionBefore = transport.status().version;
+
+  receive("AB");
+  hostUartFifoOverflow();
+  // Bytes the driver buffered after the overrun are flushed with it.
+  hostUart().ring.push_back('x');
+  receive("CD");
+
+  uint32_t epoch = 0;
+  CHECK_TRUE(drain(transport, &epoch) == "AB|", "pre-gap bytes, then marker");
+  CHECK_EQ(epoch, 1U, "marker opens a new epoch");
+  CHECK_EQ(hostUart().flushes, 1U, "driver input flushed");
+  CHECK_EQ(transport.dataLossCount(), 1U, "one loss episode");
+
+  const MonitorTransportStatus status = transport.status();
+  CHECK_EQ(status.dataLossCount, 1U, "status carries loss count");
+  CHECK_EQ(status.overflowEpisodes, 1U, "status carries overflow episodes");
+  CHECK_EQ(status.droppedBytes, 3U, "flushed bytes counted as dropped");
+  CHECK_TRUE(status.version != versionBefore, "status version advanced");
+  CHECK_EQ(transport.deviceSummary(0).droppedBytes, 3U,
+           "device summary carries dropped bytes");
+  CHECK_STR(transport.detail(),
+            "UART fallback active (RX:44, TX:43, 9600bps 8N1, searching) "
+            "fifo_overflows=1 buffer_full=0 dropped_bytes=3",
+            "detail reports loss counters");
+
+  receive("EF");
+  CHECK_TRUE(drain(transport, &epoch) == "EF", "reception resumes");
+  CHECK_EQ(epoch, 1U, "later bytes carry the marker epoch");
+}
+
+static void testBufferFullIsOneGap() {
+  hostUartReset();
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  transport.begin();
+
+  std::string burst(kUartDriverRxBufferBytes + 10, 'z');
+  receive(burst.c_str());
+  hostUartFifoOverflow();
+
+  uint32_t epoch = 0;
+  const std::string out = drain(transport, &epoch);
+  CHECK_EQ(out.size(), static_cast<size_t>(kUartDriverRxBufferBytes + 1),
+           "buffered bytes delivered before one marker");
+  CHECK_EQ(out.back(), '|', "marker last");
+  CHECK_EQ(epoch, 1U, "one epoch for the gap");
+  CHECK_EQ(transport.dataLossCount(), 1U,
+           "overflow queued behind buffer-full is the same gap");
+  CHECK_TRUE(hostUart().readCalls >= kUartDriverRxBufferBytes /
+               kUartRxChunkBytes, "ring drained in chunks");
+}
+
+static void testReadSkipsNothingBeforeMarker() {
+  hostUartReset();
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  transport.begin();
+  receive("A");
+  hostUartFifoOverflow();
+  CHECK_EQ(transport.read(), 'A', "legacy read returns the byte");
+  CHECK_EQ(transport.read(), -1, "legacy read stops at the marker");
+}
+
+static void testRejectedFramesSwitchTheLine() {
+  hostUartReset();
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  transport.begin();
+  receive("garbled");
+  CHECK_TRUE(drain(transport, nullptr) == "garbled", "bytes delivered");
+
+  // Buffered under the old setting, not yet read.
+  receive("stale");
+  MonitorFramingReport report;
+  report.bytes = 80;
+  report.rejectedFrames = kUartLineSearchRejects;
+  transport.noteFraming(0, report);
+  CHECK_EQ(hostUart().config.baud_rate, 19200, "next candidate applied");
+  CHECK_EQ(hostUart().reconfigurations, 1U, "switched without reinstall");
+
+  MonitorRxEvent event;
+  CHECK_TRUE(transport.nextRxEvent(event), "marker after switch");
+  CHECK_EQ(event.type, MonitorRxEventType::STREAM_RESET,
+           "switch restarts the framer");
+  CHECK_EQ(event.epoch, 1U, "switch opens a new epoch");
+  uint32_t epoch = event.epoch;
+  CHECK_TRUE(drain(transport, &epoch).empty(),
+             "old-setting bytes never reach the framer");
+  CHECK_EQ(transport.dataLossCount(), 0U, "a switch is not a data loss");
+  uint32_t packed = 0;
+  CHECK_TRUE(!transport.lockedLineSetting(packed), "nothing locked yet");
+
+  receive("120,80,72\r\n");
+  CHECK_TRUE(drain(transport, &epoch) == "120,80,72\r\n",
+             "first frame at the new setting is delivered");
+  CHECK_EQ(epoch, 1U, "bytes carry the switch epoch");
+  report = MonitorFramingReport();
+  report.bytes = 11;
+  report.validFrames = 1;
+  transport.noteFraming(0, report);
+  CHECK_TRUE(transport.lockedLineSetting(packed), "valid frame locks");
+  UartLineSetting locked;
+  CHECK_TRUE(uartLineUnpack(packed, locked), "published setting unpacks");
+  CHECK_EQ(locked.baudRate, 19200U, "winner is the setting that framed");
+  CHECK_STR(transport.detail(),
+            "UART fallback active (RX:44, TX:43, 19200bps 8N1, locked) "
+            "line_switches=1 frames_per_kib=93",
+            "detail reports the lock and its score");
+}
+
+static void testLineErrorsCountAsEvidence() {
+  hostUartReset();
+  Uart uart;
+  UartTransport& transport = uart.transport;
+  transport.begin();
+  for (uint32_t i = 0; i < kUartLineSearchLineErrors; ++i) {
+    hostUartFrameError();
+  }
+  receive("?");
+  drain(transport, nullptr);
+  MonitorFramingReport report;
+  report.bytes = 1;
+  transport.noteFraming(0, report);
+  CHECK_EQ(hostUart().config.baud_rate, 19200,
+           "framing errors move to the next candidate");
+}
+
+static void testPersistedSettingStartsLocked() {
+  hostUartReset();
+  UartLineSetting persisted;
+  persisted.baudRate = 9600;
+  persisted.dataBits = 7;
+  persisted.parity = 'E';
+  Uart uart(uartLinePack(persisted));
+  UartTransport& transport = uart.transport;
+  transport.begin();
+  CHECK_EQ(hostUart().config.data_bits, UART_DATA_7_BITS,
+           "persisted word length installed");
+  CHECK_EQ(hostUart().config.parity, UART_PARITY_EVEN,
+           "persisted parity installed");
+  uint32_t packed = 0;
+  CHECK_TRUE(transport.lockedLineSetting(packed), "persisted counts as locked");
+  CHECK_EQ(packed, uartLinePack(persisted), "same setting published");
+
+  // A noisy cable does not drop a locked setting on one bad frame.
+  MonitorFramingReport report;
+  report.bytes = 40;
+  report.rejectedFrames = 1;
+  transport.noteFraming(0, report);
+  CHECK_EQ(hostUart().reconfigurations, 0U, "one reject keeps the lock");
+}
+
+int main() {
+  testBeginInstallsDriver();
+  testInstallFailureIsReported();
+  testDataRunsAreReadInBulk();
+  testFifoOverflowBecomesOrderedMarker();
+  testBufferFullIsOneGap();
+  testReadSkipsNothingBeforeMarker();
+  testRejectedFramesSwitchTheLine();
+  testLineErrorsCountAsEvidence();
+  testPersistedSettingStartsLocked();
+  return testReport();
+}
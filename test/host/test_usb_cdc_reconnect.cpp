@@ -0,0 +1,76 @@
+// Host tests for the USB CDC reconnect profile cache and time-to-READY
+// histogram.
+
+#include <Arduino.h>
+
+#include "lib/transports/UsbCdcReconnect.h"
+#include "test_support.h"
+
+static UsbCdcDeviceProfile omronProfile() {
+  UsbCdcDeviceProfile profile;
+  profile.vid = 0x0590;
+  profile.pid = 0x0116;
+  profile.interfaceIndex = 1;
+  return profile;
+}
+
+static void testBucketsCoverEveryDuration() {
+  CHECK_EQ(usbCdcReadyBucket(0), static_cast<size_t>(0), "instant is fastest");
+  CHECK_EQ(usbCdcReadyBucket(10), static_cast<size_t>(0),
+           "limits are inclusive");
+  CHECK_EQ(usbCdcReadyBucket(11), static_cast<size_t>(1), "next bucket");
+  CHECK_EQ(usbCdcReadyBucket(1000), kUsbCdcReadyBucketCount - 2,
+           "one second is the last bounded bucket");
+  CHECK_EQ(usbCdcReadyBucket(UINT32_MAX), kUsbCdcReadyBucketCount - 1,
+           "everything slower lands in the overflow bucket");
+}
+
+static void testOnlyReturningDevicesAreTimed() {
+  UsbCdcReconnectTracker tracker;
+  tracker.noteAttached(100, false);
+  tracker.noteOpened(false);
+  tracker.noteReady(omronProfile(), 400);
+  CHECK_EQ(tracker.telemetry().samples(), 0U,
+           "first connection after boot is not a reconnect");
+  CHECK_TRUE(tracker.profile().valid, "READY caches the profile");
+  CHECK_EQ(tracker.profile().pid, static_cast<uint16_t>(0x0116),
+           "profile keeps the device identity");
+  CHECK_EQ(tracker.telemetry().probedOpens, 1U, "probe counted");
+
+  tracker.noteAttached(1000, false);
+  tracker.noteAttached(1020, false);
+  tracker.noteOpened(true);
+  tracker.noteReady(tracker.profile(), 1030);
+  const UsbCdcReconnectTelemetry telemetry = tracker.telemetry();
+  CHECK_EQ(telemetry.samples(), 1U, "one reconnect recorded");
+  CHECK_EQ(telemetry.lastReadyMs, 30U,
+           "timed from the first attach, not a repeated one");
+  CHECK_EQ(telemetry.readyByBucket[2], 1U, "30 ms lands in <=50");
+  CHECK_EQ(telemetry.fastPathOpens, 1U, "fast path counted");
+}
+
+static void testAttachWhileConnectedIsIgnored() {
+  UsbCdcReconnectTracker tracker;
+  tracker.noteReady(omronProfile(), 0);
+  // Behind a hub every port hears every attach; a READY port must not start
+  // a timer that only a later, unrelated READY would stop.
+  tracker.noteAttached(50, true);
+  tracker.noteReady(tracker.profile(), 5000);
+  CHECK_EQ(tracker.telemetry().samples(), 0U,
+           "attach seen while READY is not a reconnect");
+
+  tracker.noteAttached(UINT32_MAX - 5, false);
+  tracker.noteReady(tracker.profile(), 1994);
+  CHECK_EQ(tracker.telemetry().lastReadyMs, 2000U,
+           "elapsed time survives millis() wrap");
+  CHECK_EQ(tracker.telemetry().readyByBucket[kUsbCdcReadyBucketCount - 1], 1U,
+           "slow reconnect is visible in the overflow bucket");
+  CHECK_EQ(tracker.telemetry().maxReadyMs, 2000U, "max retained");
+}
+
+int main() {
+  testBucketsCoverEveryDuration();
+  testOnlyReturningDevicesAreTimed();
+  testAttachWhileConnectedIsIgnored();
+  return testReport();
+}
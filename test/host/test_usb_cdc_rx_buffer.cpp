@@ -0,0 +1,87 @@
+// Host tests for USB CDC RX buffer sizing and occupancy telemetry.
+
+#include <Arduino.h>
+
+#include "lib/transports/UsbCdcRxBuffer.h"
+#include "test_support.h"
+
+static void testLevelsAndClamp() {
+  CHECK_EQ(static_cast<int>(usbCdcRxLevel(0, 1024)),
+           static_cast<int>(UsbCdcRxLevel::BELOW_QUARTER), "empty is low");
+  CHECK_EQ(static_cast<int>(usbCdcRxLevel(256, 1024)),
+           static_cast<int>(UsbCdcRxLevel::BELOW_HALF),
+           "quarter boundary belongs to the next level");
+  CHECK_EQ(static_cast<int>(usbCdcRxLevel(767, 1024)),
+           static_cast<int>(UsbCdcRxLevel::BELOW_THREE_QUARTERS),
+           "just under three quarters");
+  CHECK_EQ(static_cast<int>(usbCdcRxLevel(768, 1024)),
+           static_cast<int>(UsbCdcRxLevel::HIGH_WATER),
+           "three quarters is high water");
+  CHECK_STR(usbCdcRxLevelCode(UsbCdcRxLevel::HIGH_WATER), "ge75",
+            "stable level code");
+
+  CHECK_EQ(usbCdcRxClampCapacity(10, false), kUsbCdcRxMinBytes,
+           "requests below the floor are raised");
+  CHECK_EQ(usbCdcRxClampCapacity(65536, false), kUsbCdcRxMaxInternalBytes,
+           "internal RAM has a lower ceiling");
+  CHECK_EQ(usbCdcRxClampCapacity(65536, true), kUsbCdcRxMaxPsramBytes,
+           "PSRAM allows a larger buffer");
+}
+
+static void testMonitorTracksWatermarkOverflowAndTime() {
+  UsbCdcRxOccupancyMonitor monitor;
+  monitor.configure(1024, true);
+  monitor.noteAccepted(64);
+  monitor.noteAccepted(700);
+  monitor.noteAccepted(128);
+  UsbCdcRxTelemetry telemetry = monitor.snapshot();
+  CHECK_EQ(telemetry.capacityBytes, 1024U, "capacity reported");
+  CHECK_TRUE(telemetry.psram, "memory kind reported");
+  CHECK_EQ(telemetry.highWatermarkBytes, 700U, "high watermark keeps the peak");
+
+  monitor.noteOverflow(100);
+  monitor.noteOverflow(900);
+  monitor.noteOverflow(1000);
+  telemetry = monitor.snapshot();
+  CHECK_EQ(telemetry.overflowByLevel[0], 1U, "burst overflow from a low level");
+  CHECK_EQ(telemetry.overflowByLevel[3], 2U,
+           "consumer-lag overflows from high water");
+  CHECK_EQ(telemetry.overflowEpisodes(), 3U, "episodes summed across levels");
+  CHECK_EQ(telemetry.highWatermarkBytes, 1024U, "overflow pins the watermark");
+
+  monitor.sampleOwner(900, 1000);
+  monitor.sampleOwner(100, 1250);
+  monitor.sampleOwner(800, 2000);
+  monitor.sampleOwner(800, 2600);
+  CHECK_EQ(monitor.snapshot().timeAtHighWaterMs, 850U,
+           "only intervals that started at high water are counted");
+}
+
+static void testNextCapacityGrowsOnlyUnderPressure() {
+  UsbCdcRxTelemetry quiet;
+  quiet.capacityBytes = 1024;
+  quiet.highWatermarkBytes = 300;
+  CHECK_EQ(usbCdcRxNextCapacity(quiet, kUsbCdcRxMaxInternalBytes),
+           static_cast<size_t>(1024), "quiet buffer keeps its size");
+
+  UsbCdcRxTelemetry high = quiet;
+  high.highWatermarkBytes = 800;
+  CHECK_EQ(usbCdcRxNextCapacity(high, kUsbCdcRxMaxInternalBytes),
+           static_cast<size_t>(2048), "high water doubles the next buffer");
+
+  UsbCdcRxTelemetry overflowed = quiet;
+  overflowed.capacityBytes = 3072;
+  overflowed.overflowByLevel[1] = 1;
+  CHECK_EQ(usbCdcRxNextCapacity(overflowed, kUsbCdcRxMaxInternalBytes),
+           kUsbCdcRxMaxInternalBytes, "growth stops at the memory ceiling");
+  overflowed.capacityBytes = kUsbCdcRxMaxInternalBytes;
+  CHECK_EQ(usbCdcRxNextCapacity(overflowed, kUsbCdcRxMaxInternalBytes),
+           kUsbCdcRxMaxInternalBytes, "ceiling is stable");
+}
+
+int main() {
+  testLevelsAndClamp();
+  testMonitorTracksWatermarkOverflowAndTime();
+  testNextCapacityGrowsOnlyUnderPressure();
+  return testReport();
+}
@@ -121,6 +121,46 @@ static void testErrorDisconnectClosesOnceAndReconnects() {
   CHECK_EQ(state.reconnectCount(), 1U, "successful reconnection counted once");
 }
 
+static void testReturningDeviceRetriesOpenFast() {
+  UsbCdcLifecycle state;
+  installReady(state);
+  state.apply(event(UsbCdcControlType::DEVICE_ATTACHED), 0);
+  state.apply(event(UsbCdcControlType::OPEN_STARTED), 0);
+  state.apply(event(UsbCdcControlType::OPEN_FAILED, -1), 0);
+  CHECK_EQ(state.retryAtMs(), static_cast<uint64_t>(1000),
+           "a first-time device uses the normal back-off");
+  state.apply(event(UsbCdcControlType::RETRY_TICK), 1000);
+  state.apply(event(UsbCdcControlType::OPEN_STARTED), 1000);
+  state.apply(event(UsbCdcControlType::OPEN_SUCCEEDED), 1000);
+  state.apply(event(UsbCdcControlType::CONFIG_SUCCEEDED), 1000);
+
+  state.apply(event(UsbCdcControlType::DEVICE_DISCONNECTED), 2000);
+  CHECK_TRUE(state.takeCloseRequest(), "unplug closes the handle");
+  state.apply(event(UsbCdcControlType::HANDLE_CLOSED), 2000);
+  state.apply(event(UsbCdcControlType::DEVICE_ATTACHED), 3000);
+  uint64_t now = 3000;
+  for (uint8_t attempt = 0; attempt < USB_CDC_FAST_OPEN_RETRIES; ++attempt) {
+    state.apply(event(UsbCdcControlType::OPEN_STARTED), now);
+    state.apply(event(UsbCdcControlType::OPEN_FAILED, -1), now);
+    CHECK_EQ(state.retryAtMs(), now + USB_CDC_FAST_OPEN_RETRY_MS,
+             "a returning device retries on the fast schedule");
+    now = state.retryAtMs();
+    state.apply(event(UsbCdcControlType::RETRY_TICK), now);
+  }
+  state.apply(event(UsbCdcControlType::OPEN_STARTED), now);
+  state.apply(event(UsbCdcControlType::OPEN_FAILED, -1), now);
+  CHECK_EQ(state.retryAtMs(), now + 1000,
+           "fast retries are bounded, then the back-off resumes");
+
+  state.apply(event(UsbCdcControlType::RETRY_TICK), state.retryAtMs());
+  state.apply(event(UsbCdcControlType::OPEN_STARTED), state.retryAtMs());
+  state.apply(event(UsbCdcControlType::OPEN_SUCCEEDED), state.retryAtMs());
+  state.apply(event(UsbCdcControlType::CONFIG_SUCCEEDED), state.retryAtMs());
+  state.apply(event(UsbCdcControlType::TRANSFER_ERROR, -2), 9000);
+  CHECK_EQ(state.retryAtMs(), static_cast<uint64_t>(10000),
+           "an error on a READY device is not a returning attach");
+}
+
 static void testOverflowCountersAndRecovery() {
   UsbCdcLifecycle state;
   connectReady(state);
@@ -451,6 +491,39 @@ static void testOrderedChannelFallbackIsAtomicAndOrdered() {
            "stale fallback discard clears its slot atomically");
 }
 
+static void testBulkReceiveLimitStopsAtControlBoundary() {
+  UsbCdcOrderedChannel<4> channel;
+  UsbCdcOrderedCursor cursor;
+  cursor.beginSession(1, 10, 0);
+  UsbCdcOrderedDelivery delivery;
+  CHECK_EQ(static_cast<int>(channel.claim(cursor, delivery)),
+           static_cast<int>(UsbCdcOrderedClaimResult::NONE),
+           "empty channel has nothing to claim");
+  CHECK_EQ(usbCdcBulkReceiveLimit(cursor, 200, delivery, 64),
+           static_cast<size_t>(64), "empty channel is bounded by chunk size");
+  CHECK_EQ(usbCdcBulkReceiveLimit(cursor, 40, delivery, 64),
+           static_cast<size_t>(30), "limit never passes the accepted snapshot");
+
+  channel.publish(orderedEvent(UsbCdcOrderedType::DISCONTINUITY, 1, 1, 25, 3),
+                  true);
+  CHECK_EQ(static_cast<int>(channel.claim(cursor, delivery)),
+           static_cast<int>(UsbCdcOrderedClaimResult::BLOCKED),
+           "future boundary blocks the control");
+  CHECK_EQ(delivery.bytesBeforeControl, 15U,
+           "blocked claim reports bytes before the boundary");
+  CHECK_EQ(usbCdcBulkReceiveLimit(cursor, 200, delivery, 64),
+           static_cast<size_t>(15), "bulk receive stops at the boundary");
+  cursor.noteBytesDelivered(15);
+  CHECK_EQ(static_cast<int>(channel.claim(cursor, delivery)),
+           static_cast<int>(UsbCdcOrderedClaimResult::CLAIMED),
+           "control claims exactly after its bytes");
+  CHECK_EQ(delivery.bytesBeforeControl, UINT32_MAX,
+           "claimed delivery carries no byte bound");
+  cursor.applyControl(delivery.event);
+  CHECK_EQ(usbCdcBulkReceiveLimit(cursor, 5, delivery, 64),
+           static_cast<size_t>(0), "snapshot behind the cursor yields nothing");
+}
+
 static void testSessionGateLinearizesConfigAndTerminalEvents() {
   UsbCdcSessionGate gate;
   gate.startSession(7);
@@ -665,6 +738,85 @@ static void testByteCommitLeaseLinearizesTerminalBoundary() {
              "terminal boundary may snapshot only after both leases release");
 }
 
+static void testAdmittedByteCommitFollowsLifecycleWithoutLock() {
+  UsbCdcSynchronizedState<std::mutex, 2, 1> shared;
+  shared.startSession(32);
+  int slot = shared.acquireContext(32);
+  CHECK_TRUE(slot >= 0, "lock-free admission fixture acquires context");
+  const size_t index = static_cast<size_t>(slot);
+  CHECK_TRUE(!shared.acquireAdmittedByteCommit(index, 32),
+             "lock-free admission waits for configuration commit");
+  UsbCdcConfigToken token = shared.configurationToken();
+  CHECK_TRUE(shared.commitConfiguration(
+               token, UsbCdcOrderedPublishResult::QUEUED),
+             "lock-free admission fixture enables producer");
+  CHECK_TRUE(!shared.acquireAdmittedByteCommit(index, 33),
+             "lock-free admission rejects another session");
+
+  {
+    auto commit = shared.acquireAdmittedByteCommit(index, 32);
+    CHECK_TRUE(static_cast<bool>(commit),
+               "enabled session is admitted without the lock");
+    shared.publishQuarantineBarrier(
+      orderedEvent(UsbCdcOrderedType::DISCONTINUITY, 32, 1, 0, 2));
+    CHECK_TRUE(!shared.acquireAdmittedByteCommit(index, 32),
+               "quarantine revokes lock-free admission");
+    CHECK_TRUE(!shared.callbacksQuiescent(index, 32),
+               "quiescence waits for a lock-free byte commit");
+  }
+  CHECK_TRUE(shared.callbacksQuiescent(index, 32),
+             "releasing the lock-free commit restores quiescence");
+
+  UsbCdcOrderedCursor cursor;
+  cursor.beginSession(32, 0, 0);
+  UsbCdcOrderedDelivery delivery;
+  CHECK_EQ(static_cast<int>(shared.claim(cursor, delivery, true)),
+           static_cast<int>(UsbCdcOrderedClaimResult::CLAIMED),
+           "quarantine barrier claims through the locked path");
+  CHECK_TRUE(delivery.producerResumed, "barrier claim resumes producer");
+  CHECK_TRUE(static_cast<bool>(shared.acquireAdmittedByteCommit(index, 32)),
+             "resume republishes lock-free admission");
+
+  CHECK_TRUE(shared.latchTerminal(32), "terminal fixture latches");
+  CHECK_TRUE(!shared.acquireAdmittedByteCommit(index, 32),
+             "terminal latch revokes lock-free admission");
+}
+
+static void testUnlockedClaimLeavesBarriersToLockedPath() {
+  UsbCdcOrderedChannel<4> channel;
+  UsbCdcOrderedCursor cursor;
+  cursor.beginSession(1, 0, 0);
+  UsbCdcOrderedDelivery delivery;
+  UsbCdcOrderedClaimResult result = UsbCdcOrderedClaimResult::CLAIMED;
+  CHECK_TRUE(channel.claimUnlocked(cursor, delivery, result) &&
+               result == UsbCdcOrderedClaimResult::NONE,
+             "empty ring answers without the lock");
+
+  channel.publish(orderedEvent(UsbCdcOrderedType::STREAM_RESET, 1, 1, 0),
+                  true);
+  channel.publish(orderedEvent(UsbCdcOrderedType::DISCONTINUITY, 1, 2, 4, 1),
+                  true, true);
+  CHECK_TRUE(channel.claimUnlocked(cursor, delivery, result) &&
+               result == UsbCdcOrderedClaimResult::CLAIMED,
+             "plain due control claims without the lock");
+  CHECK_EQ(delivery.event.epoch, 1U, "unlocked claim keeps FIFO order");
+  cursor.applyControl(delivery.event);
+  CHECK_TRUE(channel.claimUnlocked(cursor, delivery, result) &&
+               result == UsbCdcOrderedClaimResult::BLOCKED,
+             "future barrier blocks without the lock");
+  CHECK_EQ(delivery.bytesBeforeControl, 4U,
+           "unlocked block reports the byte bound");
+  cursor.noteBytesDelivered(4);
+  CHECK_TRUE(!channel.claimUnlocked(cursor, delivery, result),
+             "due barrier defers to the locked claim");
+  CHECK_EQ(channel.pendingCount(), static_cast<size_t>(1),
+           "deferred barrier stays queued");
+  CHECK_EQ(static_cast<int>(channel.claim(cursor, delivery)),
+           static_cast<int>(UsbCdcOrderedClaimResult::CLAIMED),
+           "locked claim takes the barrier");
+  CHECK_TRUE(delivery.quarantineBarrier, "barrier identity preserved");
+}
+
 static void testOverflowQuarantineAggregatesAndResumes() {
   UsbCdcSynchronizedState<std::mutex, 2, 1> queued;
   queued.startSession(31);
@@ -1189,6 +1341,7 @@ int main() {
   testInstallFailureRetriesWithBackoff();
   testOpenConfigureAndRetry();
   testErrorDisconnectClosesOnceAndReconnects();
+  testReturningDeviceRetriesOpenFast();
   testOverflowCountersAndRecovery();
   testPodQueuesReserveCriticalCapacity();
   testClosePendingDoesNotConsumeRetry();
@@ -1198,6 +1351,7 @@ int main() {
   testInstallRecoveryResetsBackoffAndCapsIt();
   testOrderedByteBoundaryCursor();
   testOrderedChannelFallbackIsAtomicAndOrdered();
+  testBulkReceiveLimitStopsAtControlBoundary();
   testSessionGateLinearizesConfigAndTerminalEvents();
   testImmutableContextSlotsAndSessionWrap();
   testTeardownRequiresEveryHostMilestone();
@@ -1205,6 +1359,8 @@ int main() {
   testSynchronizedContextCloseProtocol();
   testFailedOpenContextReapsAfterLateCallbackLease();
   testByteCommitLeaseLinearizesTerminalBoundary();
+  testAdmittedByteCommitFollowsLifecycleWithoutLock();
+  testUnlockedClaimLeavesBarriersToLockedPath();
   testOverflowQuarantineAggregatesAndResumes();
   testConfigurationHandleGuard();
   testStartResetCannotReleaseLaterOverflowBarrier();
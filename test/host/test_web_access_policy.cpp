@@ -65,7 +65,7 @@ static AccessRole authenticate(const std::string& header,
 }
 
 static void testCompileTimeRouteRegistry() {
-  static_assert(kRoutePolicyCount == 21,
+  static_assert(kRoutePolicyCount == 23,
                 "every supported GET/POST route must be classified");
   static_assert(routeTableIsValid(),
                 "route registry must be unique and fail closed");
@@ -77,30 +77,33 @@ static void testCompileTimeRouteRegistry() {
     uint32_t bodyCap;
     RouteBodyKind bodyKind;
     bool mutation;
+    bool noStore;
   };
 
   static const ExpectedRoute expected[] = {
-    {HttpMethod::GET,  "/claim", AccessRole::NONE, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::POST, "/claim", AccessRole::NONE, 96, RouteBodyKind::FORM, true},
-    {HttpMethod::GET,  "/", AccessRole::STAFF, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::GET,  "/data", AccessRole::STAFF, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::GET,  "/history", AccessRole::STAFF, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::GET,  "/export.csv", AccessRole::STAFF, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::GET,  "/api/history", AccessRole::STAFF, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::GET,  "/api/latest", AccessRole::STAFF, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::GET,  "/config", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::POST, "/configure", AccessRole::ADMIN, 512, RouteBodyKind::FORM, true},
-    {HttpMethod::POST, "/clear_history", AccessRole::ADMIN, 0, RouteBodyKind::NONE, true},
-    {HttpMethod::GET,  "/bp_model", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::POST, "/set_bp_model", AccessRole::ADMIN, 64, RouteBodyKind::FORM, true},
-    {HttpMethod::GET,  "/security", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::POST, "/rotate_credentials", AccessRole::ADMIN, 64, RouteBodyKind::FORM, true},
-    {HttpMethod::GET,  "/measurement_policy", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::POST, "/set_measurement_policy", AccessRole::ADMIN, 512, RouteBodyKind::FORM, true},
-    {HttpMethod::POST, "/reset", AccessRole::ADMIN, 0, RouteBodyKind::NONE, true},
-    {HttpMethod::GET, "/firmware_update", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false},
-    {HttpMethod::POST, "/authorize_firmware", AccessRole::ADMIN, 1024, RouteBodyKind::FORM, true},
-    {HttpMethod::POST, "/install_firmware", AccessRole::ADMIN, 1310720, RouteBodyKind::STREAM, true},
+    {HttpMethod::GET,  "/claim", AccessRole::NONE, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::POST, "/claim", AccessRole::NONE, 96, RouteBodyKind::FORM, true, true},
+    {HttpMethod::GET,  "/", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::GET,  "/data", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::GET,  "/history", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::GET,  "/export.csv", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::GET,  "/api/history", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::GET,  "/api/latest", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::GET,  "/api/events", AccessRole::STAFF, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::GET,  "/config", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::POST, "/configure", AccessRole::ADMIN, 512, RouteBodyKind::FORM, true, true},
+    {HttpMethod::POST, "/clear_history", AccessRole::ADMIN, 0, RouteBodyKind::NONE, true, true},
+    {HttpMethod::GET,  "/bp_model", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::POST, "/set_bp_model", AccessRole::ADMIN, 64, RouteBodyKind::FORM, true, true},
+    {HttpMethod::GET,  "/security", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::POST, "/rotate_credentials", AccessRole::ADMIN, 64, RouteBodyKind::FORM, true, true},
+    {HttpMethod::GET,  "/measurement_policy", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::POST, "/set_measurement_policy", AccessRole::ADMIN, 512, RouteBodyKind::FORM, true, true},
+    {HttpMethod::POST, "/reset", AccessRole::ADMIN, 0, RouteBodyKind::NONE, true, true},
+    {HttpMethod::GET, "/firmware_update", AccessRole::ADMIN, 0, RouteBodyKind::NONE, false, true},
+    {HttpMethod::POST, "/authorize_firmware", AccessRole::ADMIN, 1024, RouteBodyKind::FORM, true, true},
+    {HttpMethod::POST, "/install_firmware", AccessRole::ADMIN, 1310720, RouteBodyKind::STREAM, true, true},
+    {HttpMethod::GET, kStyleCssPath, AccessRole::STAFF, 0, RouteBodyKind::NONE, false, false},
   };
 
   CHECK_EQ(sizeof(expected) / sizeof(expected[0]), kRoutePolicyCount,
@@ -115,7 +118,10 @@ static void testCompileTimeRouteRegistry() {
     CHECK_EQ(static_cast<int>(policy->bodyKind),
              static_cast<int>(item.bodyKind), "route body kind metadata");
     CHECK_EQ(policy->mutation, item.mutation, "route mutation metadata");
-    CHECK_TRUE(policy->noStore, "every product response is no-store");
+    CHECK_EQ(policy->noStore, item.noStore,
+             "only the hashed static asset may be cached");
+    CHECK_EQ(isStaticAssetRoute(*policy), !item.noStore,
+             "cacheable route is a static asset");
   }
 
   CHECK_TRUE(findRoutePolicy(HttpMethod::GET, "/missing") == nullptr,
@@ -210,6 +216,30 @@ static void testRoleToSurfacePolicy() {
              "corrupt surface fails closed");
 }
 
+static void testRenderedPageCacheAllowList() {
+  CHECK_TRUE(renderedPageCacheable(HttpMethod::GET, "/history"),
+             "history page may be cached");
+  size_t cacheable = 0;
+  for (size_t i = 0; i < kRoutePolicyCount; ++i) {
+    const RoutePolicy& route = kRoutePolicies[i];
+    if (!renderedPageCacheable(route.method, route.path)) continue;
+    cacheable++;
+    CHECK_TRUE(route.method == HttpMethod::GET && !route.mutation &&
+                 route.requiredRole == AccessRole::STAFF,
+               "cacheable page is a staff GET");
+  }
+  CHECK_EQ(static_cast<int>(cacheable), 1,
+           "only the history page is cacheable");
+  CHECK_TRUE(!renderedPageCacheable(HttpMethod::GET, "/security"),
+             "admin security page is never cached");
+  CHECK_TRUE(!renderedPageCacheable(HttpMethod::GET, "/claim"),
+             "claim page with one-time secrets is never cached");
+  CHECK_TRUE(!renderedPageCacheable(HttpMethod::GET, "/history/x"),
+             "unregistered path is never cached");
+  CHECK_TRUE(!renderedPageCacheable(HttpMethod::GET, nullptr),
+             "missing path is never cached");
+}
+
 static void testClaimBoundary() {
   for (HttpMethod method : {HttpMethod::GET, HttpMethod::POST}) {
     CHECK_EQ(static_cast<int>(authorizeRoute(
@@ -290,7 +320,8 @@ static void testDeviceSecurityClaimStateIsThePolicyState() {
 
 static void testClaimedRoleMatrix() {
   static const char* staffReads[] = {
-    "/", "/data", "/history", "/export.csv", "/api/history", "/api/latest"
+    "/", "/data", "/history", "/export.csv", "/api/history", "/api/latest",
+    "/api/events"
   };
   for (const char* path : staffReads) {
     CHECK_EQ(static_cast<int>(authorizeRoute(
@@ -669,6 +700,7 @@ static void testUnsignedClockWrap() {
 int main() {
   testCompileTimeRouteRegistry();
   testRoleToSurfacePolicy();
+  testRenderedPageCacheAllowList();
   testClaimBoundary();
   testDeviceSecurityClaimStateIsThePolicyState();
   testClaimedRoleMatrix();
@@ -506,8 +506,9 @@ static void testEveryRegistryRoutePassesOneCentralGate() {
     CHECK_TRUE(result.allowed, "every classified product route can pass gate");
     CHECK_TRUE(result.route == &route,
                "gate returns exact constexpr route metadata");
-    CHECK_TRUE(result.route != nullptr && result.route->noStore,
-               "every allowed route remains no-store");
+    CHECK_TRUE(result.route != nullptr &&
+                 (result.route->noStore || isStaticAssetRoute(route)),
+               "every allowed product route remains no-store");
     CHECK_EQ(result.bodyCap, route.bodyCap,
              "gate propagates exact route body cap");
     CHECK_EQ(static_cast<int>(result.bodyMode),
@@ -577,7 +578,8 @@ static void testGateIsAllocationFreeAndFuzzFailsClosed() {
                "fuzzed gate returns a declared HTTP outcome");
     CHECK_TRUE(!result.allowed ||
                  (result.status == 0 && result.route != nullptr &&
-                  result.route->noStore),
+                  (result.route->noStore ||
+                   isStaticAssetRoute(*result.route))),
                "fuzzed allow always has classified no-store route");
   }
 }
@@ -41,8 +41,8 @@ for token in \
   'const bool historyLoaded = recordManager.loadFromStorage();' \
   'if (!historyLoaded)' \
   'history_load_failed' \
-  "data-status='storage_error'" \
-  '請聯絡管理人員檢查儲存空間' \
+  'ReceiveDiagnosticStatus::STORAGE_ERROR' \
+  'ReceiveDiagnosticAction::HISTORY_LOAD_FAILED' \
   'history_load_succeeded count=' \
   'loadHistoryFromStorage();'
 do
@@ -52,6 +52,18 @@ do
   }
 done
 
+DIAGNOSTIC="$ROOT/lib/ReceiveDiagnostic.h"
+for token in \
+  'case ReceiveDiagnosticAction::HISTORY_LOAD_FAILED:' \
+  '請聯絡管理人員檢查儲存空間' \
+  'ReceiveDiagnosticStatus::STORAGE_ERROR:      return "storage_error";'
+do
+  grep -Fq -- "$token" "$DIAGNOSTIC" || {
+    echo "missing startup storage diagnostic copy: $token" >&2
+    exit 1
+  }
+done
+
 load_line=$(grep -nF 'const bool historyLoaded = recordManager.loadFromStorage();' "$SKETCH" | head -1 | cut -d: -f1)
 failure_line=$(grep -nF 'history_load_failed' "$SKETCH" | head -1 | cut -d: -f1)
 return_line=$(awk -v start="$failure_line" \